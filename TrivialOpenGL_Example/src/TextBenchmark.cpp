@@ -0,0 +1,177 @@
+/**
+* @file TextBenchmark.cpp
+* @author underwatergrasshopper
+*/
+
+#include "TextBenchmark.h"
+
+#include <stdio.h>
+#include <chrono>
+#include <TrivialOpenGL.h>
+
+enum : uint16_t {
+    FONT_SIZE       = 12,   // in pixels
+    LINE_COUNT      = 250,
+    FRAME_COUNT     = 200,  // measured frames of each rendering path, per round
+    PATH_COUNT      = 6,
+};
+
+namespace {
+    TOGL_SizeU16            s_size = {1200, 800};
+
+    TOGL_TextDrawer         s_text_drawer;
+    TOGL_StaticText         s_static_text;
+    TOGL_FineText           s_text;
+    uint32_t                s_text_glyph_count;
+
+    // Current round. Paths: [0] - not batched, [1] - batched, [2] - batched instances (OpenGL 3.3), [3] - run cache, 
+    // [4] - batched instances with lines outside of window culled, [5] - static text.
+    const char*             s_path_names[PATH_COUNT] = {"not batched", "batched", "instanced", "cached", "culled", "static"};
+    uint32_t                s_frame_ix;
+    double                  s_frame_time_sum[PATH_COUNT];        // in seconds
+    uint64_t                s_draw_call_count_sum[PATH_COUNT];
+}
+
+static void Resize(uint16_t width, uint16_t height) {
+    glViewport(0, 0, width, height);
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+    glOrtho(0, width, 0, height, 1, -1);
+
+    s_size = {width, height};
+}
+
+// About 20k glyphs of colored log text.
+static void MakeText() {
+    const char*             levels[] = {"INFO ", "DEBUG", "WARN ", "ERROR"};
+    const TOGL_Color4U8     colors[] = {{255, 255, 255, 255}, {128, 128, 128, 255}, {255, 200, 0, 255}, {255, 64, 64, 255}};
+
+    s_text.Clear();
+    s_text_glyph_count = 0;
+
+    for (uint32_t line_ix = 0; line_ix < LINE_COUNT; ++line_ix) {
+        const uint32_t level_ix = (line_ix * 7) % 11 % 4;
+
+        char line[128];
+        snprintf(line, sizeof(line), "[%06u] %s Uploaded atlas page %3u, glyphs: %4u, time: %6.3f ms, budget: %5.2f%%\n", 
+            line_ix, levels[level_ix], line_ix % 64, (line_ix * 37) % 4096, line_ix * 0.137, (line_ix % 100) * 1.01);
+
+        s_text.Append(colors[level_ix]);
+        s_text.Append(line);
+
+        s_text_glyph_count += uint32_t(strlen(line)) - 1;
+    }
+}
+
+int RunTextBenchmark() {
+    TOGL_Data data = {};
+
+    data.window_name        = "Text Benchmark";
+    data.area               = {0, 0, s_size.width, s_size.height};
+    data.style              |= TOGL_WINDOW_STYLE_BIT_CENTERED;
+    data.style              |= TOGL_WINDOW_STYLE_BIT_DRAW_AREA_SIZE;
+
+    data.do_on_create = []() {
+        glPushAttrib(GL_ALL_ATTRIB_BITS);
+
+        TOGL_SizeU16 size = TOGL_GetDrawAreaSize();
+        Resize(size.width, size.height);
+
+        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+        TOGL_LoadFont("Courier New", FONT_SIZE, TOGL_FONT_SIZE_UNIT_ID_PIXELS, TOGL_FONT_STYLE_ID_NORMAL, TOGL_FONT_CHAR_SET_ID_ENGLISH);
+
+        if (!TOGL_IsFontOk()) {
+            printf("Error: %s.", TOGL_GetFontErrMsg().c_str());
+            fflush(stdout);
+        }
+
+        MakeText();
+
+        s_static_text.SetFont(TOGL_ToGlobalFont());
+        s_static_text.SetText(s_text);
+
+        s_frame_ix = 0;
+
+        printf("text: %u lines, %u glyphs\n", LINE_COUNT, s_text_glyph_count);
+        puts("Each round renders text in each path, one after another. Frame time includes glFinish.");
+        puts("X - Exit");
+        fflush(stdout);
+    };
+
+    data.do_on_destroy = []() {
+        s_static_text.Release();
+        TOGL_UnloadFont();
+
+        glPopAttrib();
+
+        puts("Bye. Bye.");
+        fflush(stdout);
+    };
+
+    data.do_on_resize = [](uint16_t width, uint16_t height) {
+        Resize(width, height);
+    };
+
+    data.draw = []() {
+        const uint32_t  path_ix = s_frame_ix / FRAME_COUNT;
+        const TOGL_PointI pos   = {0, s_size.height - FONT_SIZE};
+
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glMatrixMode(GL_MODELVIEW);
+        glLoadIdentity();
+
+        s_text_drawer.SetBatching(path_ix >= 1 && path_ix <= 4);
+        s_text_drawer.SetInstancing(path_ix >= 2);
+        s_text_drawer.SetRunCaching(path_ix == 3);
+        s_text_drawer.SetCulling(path_ix == 4);
+        s_text_drawer.NextFrame();
+        s_text_drawer.ResetStats();
+        s_text_drawer.SetPos(pos);
+
+        // Static text is built before first measured frame.
+        if (path_ix == 5) s_static_text.Build();
+
+        const auto start = std::chrono::steady_clock::now();
+
+        if (path_ix == 5) {
+            s_static_text.Render(pos);
+        } else {
+            s_text_drawer.RenderText(TOGL_ToGlobalFont(), s_text);
+        }
+        glFinish();
+
+        const auto stop = std::chrono::steady_clock::now();
+
+        s_frame_time_sum[path_ix]       += std::chrono::duration<double>(stop - start).count();
+        s_draw_call_count_sum[path_ix]  += (path_ix == 5) ? s_static_text.GetDrawCallCount() : s_text_drawer.ToStats().draw_call_count;
+
+        s_frame_ix += 1;
+
+        if (s_frame_ix == FRAME_COUNT * PATH_COUNT) {
+            double frame_time[PATH_COUNT];
+            for (uint32_t ix = 0; ix < PATH_COUNT; ++ix) {
+                frame_time[ix] = s_frame_time_sum[ix] / FRAME_COUNT * 1000.0;
+
+                printf("%-12s %8.3f ms/frame  %8llu draw calls/frame  x%.2f\n", 
+                    s_path_names[ix], frame_time[ix], (unsigned long long)(s_draw_call_count_sum[ix] / FRAME_COUNT), frame_time[0] / frame_time[ix]);
+
+                s_frame_time_sum[ix]        = 0;
+                s_draw_call_count_sum[ix]   = 0;
+            }
+            fflush(stdout);
+
+            s_frame_ix = 0;
+        }
+    };
+
+    data.do_on_key = [](TOGL_KeyId key_id, bool is_down, const TOGL_Extra& extra) {
+        if (key_id == 'X' && !is_down) {
+            TOGL_RequestClose();
+        }
+    };
+
+    return TOGL_Run(data);
+}
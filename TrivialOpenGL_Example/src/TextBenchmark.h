@@ -0,0 +1,11 @@
+/**
+* @file TextBenchmark.h
+* @author underwatergrasshopper
+*/
+
+#ifndef TEXTBENCHMARK_H_
+#define TEXTBENCHMARK_H_
+
+int RunTextBenchmark();
+
+#endif // TEXTBENCHMARK_H_
@@ -16,6 +16,7 @@
 #include "TextBox.h"
 #include "BorderlessWindow.h"
 #include "TopToBottomText.h"
+#include "TextBenchmark.h"
 
 //------------------------------------------------------------------------------
 
@@ -458,6 +459,15 @@ int main(int argc, char *argv[]) {
         return RunTextBox();
     });
 
+    ////////////////////////////////////////////////////////////////////////////////
+    // text_benchmark
+    ////////////////////////////////////////////////////////////////////////////////
+
+    // Compares frame time and draw calls of not batched and batched TOGL_TextDrawer::RenderText, and of TOGL_StaticText.
+    example_manager.AddExample("text_benchmark", {}, {}, [](const std::string& name, const std::set<std::string>& options) {
+        return RunTextBenchmark();
+    });
+
     ////////////////////////////////////////////////////////////////////////////////
     // move_and_resize
     ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,18 @@
+// Runs tests of parts of library, which depend only on standard library (see PortableTest.h).
+// Built without Windows and OpenGL, so these parts are tested on any platform.
+
+#include <TrivialTestKit.h>
+
+#include "PortableTest.h"
+
+int main() {
+    TTK_ADD_TEST(TestTOGL_TrueType, 0);
+    TTK_ADD_TEST(TestTOGL_FontCache, 0);
+    TTK_ADD_TEST(TestTOGL_GlyphTable, 0);
+    TTK_ADD_TEST(TestTOGL_MetricsFont, 0);
+    TTK_ADD_TEST(TestTOGL_UnicodeRangeSet, 0);
+    TTK_ADD_TEST(TestTOGL_CodePointRecord, 0);
+    TTK_ADD_TEST(TestTOGL_DistanceField, 0);
+
+    return !TTK_Run();
+}
@@ -0,0 +1,872 @@
+/**
+* @file PortableTest.h
+* @author underwatergrasshopper
+*/
+
+#ifndef PORTABLETEST_H_
+#define PORTABLETEST_H_
+
+// Tests of parts of library, which depend only on standard library. 
+// Included by main.cpp and by portable test (see portable/main.cpp), which is built without Windows and OpenGL.
+
+#include <TrivialTestKit.h>
+#include <ToStr.h>
+
+#include "TrivialOpenGL_FontCore.h"
+
+// Returns content of font file with 4 glyphs: 
+// 0 - missing glyph (empty), 1 - space (empty), 2 - square from (100, 0) to (900, 800), 3 - glyph 2 scaled by 0.5 and moved by (50, -100).
+// Character map: ' ' -> 1, 'A' -> 2, 'B' -> 3, 'C' -> 2 (through glyph index array).
+std::vector<uint8_t> MakeTestTrueTypeFont() {
+    struct Writer {
+        std::vector<uint8_t> data;
+
+        void U16(uint32_t value) { data.push_back(uint8_t(value >> 8)); data.push_back(uint8_t(value)); }
+        void U32(uint32_t value) { U16(value >> 16); U16(value & 0xFFFF); }
+        void Zeros(size_t count) { data.insert(data.end(), count, 0); }
+    };
+
+    Writer head;
+    head.U32(0x00010000);       // version
+    head.U32(0);                // font revision
+    head.U32(0);                // checksum adjustment
+    head.U32(0x5F0F3CF5);       // magic number
+    head.U16(0);                // flags
+    head.U16(1000);             // units per em
+    head.Zeros(32);
+    head.U16(0);                // index to loc format (short)
+    head.U16(0);                // glyph data format
+
+    Writer maxp;
+    maxp.U32(0x00005000);
+    maxp.U16(4);                // number of glyphs
+
+    Writer hhea;
+    hhea.U32(0x00010000);
+    hhea.U16(800);              // ascender
+    hhea.U16(uint16_t(-200));   // descender
+    hhea.U16(0);                // line gap
+    hhea.Zeros(24);
+    hhea.U16(4);                // number of h metrics
+
+    Writer hmtx;
+    hmtx.U16(500);  hmtx.U16(0);
+    hmtx.U16(250);  hmtx.U16(0);
+    hmtx.U16(1000); hmtx.U16(100);
+    hmtx.U16(1000); hmtx.U16(100);
+
+    Writer cmap;
+    cmap.U16(0);                // version
+    cmap.U16(1);                // number of subtables
+    cmap.U16(3); cmap.U16(1); cmap.U32(12);
+
+    const uint16_t ends[]       = {0x20,    0x41,   0x42,   0x43,   0xFFFF};
+    const uint16_t starts[]     = {0x20,    0x41,   0x42,   0x43,   0xFFFF};
+    const uint16_t deltas[]     = {0xFFE1,  0xFFC1, 0xFFC1, 0,      1};
+    const uint16_t segment_count = 5;
+
+    cmap.U16(4);                // format
+    cmap.U16(16 + segment_count * 8 + 2);
+    cmap.U16(0);                // language
+    cmap.U16(segment_count * 2);
+    cmap.Zeros(6);
+    for (uint16_t value : ends) cmap.U16(value);
+    cmap.U16(0);
+    for (uint16_t value : starts) cmap.U16(value);
+    for (uint16_t value : deltas) cmap.U16(value);
+    for (uint16_t ix = 0; ix < segment_count; ++ix) {
+        // Segment of 'C' points to glyph index array, which is right after id range offsets.
+        cmap.U16((ix == 3) ? (segment_count - ix) * 2 : 0);
+    }
+    cmap.U16(2);                // glyph index array
+
+    Writer glyf;
+    // square
+    glyf.U16(1);                // number of contours
+    glyf.U16(100); glyf.U16(0); glyf.U16(900); glyf.U16(800);
+    glyf.U16(3);                // end point of contour
+    glyf.U16(0);                // instruction length
+    for (int ix = 0; ix < 4; ++ix) glyf.data.push_back(0x01);  // on curve, coordinates as 16 bit deltas
+    glyf.U16(100); glyf.U16(800);   glyf.U16(0);    glyf.U16(uint16_t(-800));
+    glyf.U16(0);   glyf.U16(0);     glyf.U16(800);  glyf.U16(0);
+    const uint16_t square_size = uint16_t(glyf.data.size());
+
+    // composite
+    glyf.U16(uint16_t(-1));
+    glyf.U16(100); glyf.U16(uint16_t(-100)); glyf.U16(500); glyf.U16(300);
+    glyf.U16(0x0001 | 0x0002 | 0x0008);  // words, xy values, scale
+    glyf.U16(2);
+    glyf.U16(50); glyf.U16(uint16_t(-100));
+    glyf.U16(0x2000);           // 0.5 in F2Dot14
+    const uint16_t composite_size = uint16_t(glyf.data.size()) - square_size;
+
+    Writer loca;
+    loca.U16(0);
+    loca.U16(0);
+    loca.U16(0);
+    loca.U16(square_size / 2);
+    loca.U16((square_size + composite_size) / 2);
+
+    const std::pair<const char*, const Writer*> tables[] = {
+        {"cmap", &cmap}, {"glyf", &glyf}, {"head", &head}, {"hhea", &hhea}, {"hmtx", &hmtx}, {"loca", &loca}, {"maxp", &maxp},
+    };
+    const uint16_t table_count = uint16_t(sizeof(tables) / sizeof(tables[0]));
+
+    Writer file;
+    file.U32(0x00010000);
+    file.U16(table_count);
+    file.Zeros(6);
+
+    uint32_t offset = 12 + table_count * 16;
+    for (const auto& table : tables) {
+        file.U32(TOGL_MakeTrueTypeTag(table.first[0], table.first[1], table.first[2], table.first[3]));
+        file.U32(0);
+        file.U32(offset);
+        file.U32(uint32_t(table.second->data.size()));
+
+        offset += uint32_t((table.second->data.size() + 3) / 4 * 4);
+    }
+    for (const auto& table : tables) {
+        file.data.insert(file.data.end(), table.second->data.begin(), table.second->data.end());
+        file.Zeros((4 - table.second->data.size() % 4) % 4);
+    }
+
+    return file.data;
+}
+
+void TestTOGL_TrueType() {
+    // --- Table Checksum --- //
+    {
+        const uint8_t table[] = {0x00, 0x01, 0x00, 0x00, 0x12, 0x34, 0x56, 0x78, 0xAB};
+
+        TTK_ASSERT(TOGL_ComputeTrueTypeTableChecksum(table, 0) == 0);
+        TTK_ASSERT(TOGL_ComputeTrueTypeTableChecksum(table, 8) == 0x12355678);
+        TTK_ASSERT(TOGL_ComputeTrueTypeTableChecksum(table, 9) == 0xBD355678);
+    }
+
+    // --- Parser --- //
+    {
+        const std::vector<uint8_t> data = MakeTestTrueTypeFont();
+
+        TOGL_TrueTypeFont font;
+        TTK_ASSERT_M(font.Load(data.data(), data.size()), font.GetErrMsg());
+        TTK_ASSERT(font.IsLoaded());
+
+        TTK_ASSERT(font.GetUnitsPerEm() == 1000);
+        TTK_ASSERT(font.GetAscent() == 800);
+        TTK_ASSERT(font.GetDescent() == 200);
+        TTK_ASSERT(font.GetGlyphCount() == 4);
+
+        TTK_ASSERT(font.GetGlyphIndex(' ') == 1);
+        TTK_ASSERT(font.GetGlyphIndex('A') == 2);
+        TTK_ASSERT(font.GetGlyphIndex('B') == 3);
+        TTK_ASSERT(font.GetGlyphIndex('C') == 2);
+        TTK_ASSERT(font.GetGlyphIndex('D') == 0);
+        TTK_ASSERT(font.GetGlyphIndex(0x1F600) == 0);
+        TTK_ASSERT(!font.HasGlyph(0x10));
+
+        TTK_ASSERT(font.GetAdvanceWidth(1) == 250);
+        TTK_ASSERT(font.GetAdvanceWidth(2) == 1000);
+        TTK_ASSERT(font.GetLeftSideBearing(2) == 100);
+
+        std::vector<TOGL_TrueTypeContour> contours;
+
+        TTK_ASSERT(font.GetGlyphContours(1, contours));
+        TTK_ASSERT(contours.empty());
+
+        TTK_ASSERT(font.GetGlyphContours(2, contours));
+        TTK_ASSERT(contours.size() == 1 && contours[0].size() == 4);
+        TTK_ASSERT(contours[0][0].x == 100 && contours[0][0].y == 0 && contours[0][0].is_on_curve);
+        TTK_ASSERT(contours[0][2].x == 900 && contours[0][2].y == 800);
+
+        TTK_ASSERT(font.GetGlyphContours(3, contours));
+        TTK_ASSERT(contours.size() == 1 && contours[0].size() == 4);
+        TTK_ASSERT(contours[0][0].x == 100 && contours[0][0].y == -100);
+        TTK_ASSERT(contours[0][2].x == 500 && contours[0][2].y == 300);
+
+        TTK_ASSERT(!font.GetGlyphContours(4, contours));
+
+        // glyph source
+        TOGL_TrueTypeGlyphSource source(std::make_shared<TOGL_TrueTypeFont>(font), 20);
+        TTK_ASSERT(source.GetFontHeight() == 20);
+        TTK_ASSERT(source.GetFontAscent() == 16);
+        TTK_ASSERT(source.GetFontDescent() == 4);
+        TTK_ASSERT(source.GetGlyphWidth('A') == 20);
+
+        TOGL_GlyphBitmap bitmap;
+        TTK_ASSERT(source.GetGlyphBitmap('A', bitmap));
+        TTK_ASSERT(bitmap.x == 2 && bitmap.y == 4 && bitmap.width == 16 && bitmap.height == 16);
+        TTK_ASSERT(bitmap.alphas.size() == 16 * 16);
+        TTK_ASSERT(std::count(bitmap.alphas.begin(), bitmap.alphas.end(), 255) == 16 * 16);
+
+        TTK_ASSERT(source.GetGlyphBitmap(' ', bitmap));
+        TTK_ASSERT(bitmap.width == 0 && bitmap.height == 0 && bitmap.alphas.empty());
+
+        // corrupted
+        TTK_ASSERT(!font.Load(data.data(), 100));
+        TTK_ASSERT(!font.IsOk() && !font.IsLoaded());
+        TTK_ASSERT(font.GetGlyphIndex('A') == 0);
+    }
+
+    // --- Rasterizer --- //
+    {
+        TOGL_GlyphRasterizer rasterizer;
+        std::vector<uint8_t> alphas;
+
+        // square shifted by half pixel
+        rasterizer.Reset(4, 4);
+        rasterizer.AddLine(0.5f, 0.5f, 2.5f, 0.5f);
+        rasterizer.AddLine(2.5f, 0.5f, 2.5f, 2.5f);
+        rasterizer.AddLine(2.5f, 2.5f, 0.5f, 2.5f);
+        rasterizer.AddLine(0.5f, 2.5f, 0.5f, 0.5f);
+        rasterizer.Accumulate(alphas);
+
+        TTK_ASSERT(alphas.size() == 16);
+        TTK_ASSERT_M(alphas[0 * 4 + 0] == 64, ToStr("%d", alphas[0]));
+        TTK_ASSERT_M(alphas[1 * 4 + 0] == 128, ToStr("%d", alphas[4]));
+        TTK_ASSERT_M(alphas[0 * 4 + 1] == 128, ToStr("%d", alphas[1]));
+        TTK_ASSERT(alphas[1 * 4 + 1] == 255);
+        TTK_ASSERT(alphas[2 * 4 + 2] == 64);
+        TTK_ASSERT(alphas[3 * 4 + 3] == 0);
+        TTK_ASSERT(alphas[0 * 4 + 3] == 0);
+
+        // overlapping contours (non-zero winding)
+        rasterizer.Reset(4, 4);
+        for (int ix = 0; ix < 2; ++ix) {
+            rasterizer.AddLine(0, 0, 4, 0);
+            rasterizer.AddLine(4, 0, 4, 4);
+            rasterizer.AddLine(4, 4, 0, 4);
+            rasterizer.AddLine(0, 4, 0, 0);
+        }
+        rasterizer.Accumulate(alphas);
+        TTK_ASSERT(std::count(alphas.begin(), alphas.end(), 255) == 16);
+
+        // circle from control points only (implied on-curve points between them)
+        const float PI      = 3.14159265f;
+        const float radius  = 20.0f;
+
+        TOGL_TrueTypeContour circle;
+        for (int ix = 0; ix < 8; ++ix) {
+            const float angle = ix * PI / 4;
+            const float distance = radius / cosf(PI / 8);
+            circle.push_back({cosf(angle) * distance, sinf(angle) * distance, false});
+        }
+
+        rasterizer.Reset(48, 48);
+        rasterizer.AddContours({circle}, 1.0f, 24.0f, 24.0f);
+        rasterizer.Accumulate(alphas);
+
+        double area = 0;
+        for (uint8_t alpha : alphas) area += alpha / 255.0;
+
+        TTK_ASSERT_M(fabs(area - PI * radius * radius) < PI * radius * radius * 0.01, ToStr("%f", area));
+        TTK_ASSERT(alphas[24 * 48 + 24] == 255);
+        TTK_ASSERT(alphas[0] == 0 && alphas[47] == 0);
+    }
+}
+
+void TestTOGL_FontCache() {
+    const TOGL_FontInfo font_info("Courier New", 16, TOGL_FONT_SIZE_UNIT_ID_PIXELS, TOGL_FONT_STYLE_ID_NORMAL, TOGL_FONT_CHAR_SET_ID_ENGLISH);
+
+    // key
+    {
+        const TOGL_FontLoadOptions options;
+        const uint64_t key = TOGL_FontCache::MakeKey(font_info, options);
+
+        TTK_ASSERT(key == TOGL_FontCache::MakeKey(font_info, options));
+
+        TOGL_FontInfo other_font_info = font_info;
+        other_font_info.name = "Arial";
+        TTK_ASSERT(key != TOGL_FontCache::MakeKey(other_font_info, options));
+
+        other_font_info = font_info;
+        other_font_info.size = 17;
+        TTK_ASSERT(key != TOGL_FontCache::MakeKey(other_font_info, options));
+
+        other_font_info = font_info;
+        other_font_info.style = TOGL_FONT_STYLE_ID_BOLD;
+        TTK_ASSERT(key != TOGL_FontCache::MakeKey(other_font_info, options));
+
+        other_font_info = font_info;
+        const TOGL_UnicodeRange ranges[] = {{0x20, 0x7F}};
+        other_font_info.unicode_range_group = TOGL_UnicodeRangeGroup(ranges);
+        TTK_ASSERT(key != TOGL_FontCache::MakeKey(other_font_info, options));
+
+        other_font_info = font_info;
+        other_font_info.distance_between_lines = 1;
+        TTK_ASSERT(key != TOGL_FontCache::MakeKey(other_font_info, options));
+
+        TOGL_FontLoadOptions other_options;
+        other_options.format = TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8;
+        TTK_ASSERT(key != TOGL_FontCache::MakeKey(font_info, other_options));
+
+        // font file identity
+        const uint64_t file_key = TOGL_FontCache::MakeKey(font_info, options, 1000, 0x12345678);
+        TTK_ASSERT(file_key != key);
+        TTK_ASSERT(file_key == TOGL_FontCache::MakeKey(font_info, options, 1000, 0x12345678));
+        TTK_ASSERT(file_key != TOGL_FontCache::MakeKey(font_info, options, 1004, 0x12345678));
+        TTK_ASSERT(file_key != TOGL_FontCache::MakeKey(font_info, options, 1000, 0x12345679));
+        TTK_ASSERT(key == TOGL_FontCache::MakeKey(font_info, options, 0, 0));
+
+        TTK_ASSERT(TOGL_FontCache::MakeFileName(0x12AB) == "00000000000012AB.toglfc");
+    }
+
+    // encode, decode
+    {
+        TOGL_FontCache cache;
+        cache.key                   = TOGL_FontCache::MakeKey(font_info, {});
+        cache.font_height           = 16;
+        cache.font_ascent           = 13;
+        cache.font_descent          = 3;
+        cache.font_internal_leading = 1;
+        cache.format                = TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8;
+        cache.stats.glyph_count     = 2;
+        cache.stats.page_count      = 2;
+        cache.stats.page_width      = 8;
+        cache.stats.page_height     = 4;
+        cache.stats.used_area       = 20;
+        cache.stats.texture_size    = 64;
+        cache.stats.deduplicated_glyph_count = 1;
+
+        TOGL_GlyphData glyph_data = {};
+        glyph_data.width        = 7;
+        glyph_data.quad_x       = -1;
+        glyph_data.quad_y       = 2;
+        glyph_data.quad_width   = 5;
+        glyph_data.quad_height  = 4;
+        glyph_data.x1           = 0.125;
+        glyph_data.y1           = 0.25;
+        glyph_data.x2           = 0.75;
+        glyph_data.y2           = 1.0;
+
+        cache.glyphs.push_back({'a', 0, glyph_data});
+        glyph_data.width = 9;
+        cache.glyphs.push_back({0x0444, 1, glyph_data});
+
+        std::vector<uint8_t> page0(cache.GetPageSize()), page1(cache.GetPageSize());
+        for (size_t ix = 0; ix < page0.size(); ++ix) {
+            page0[ix] = uint8_t(ix);
+            page1[ix] = uint8_t(255 - ix);
+        }
+        cache.pages = {page0.data(), page1.data()};
+
+        TTK_ASSERT(cache.GetPageSize() == 32);
+
+        const std::vector<uint8_t> data = cache.Encode();
+
+        TOGL_FontCache decoded;
+        TTK_ASSERT(decoded.Decode(data.data(), data.size()));
+
+        TTK_ASSERT(decoded.key == cache.key);
+        TTK_ASSERT(decoded.font_height == 16 && decoded.font_ascent == 13 && decoded.font_descent == 3 && decoded.font_internal_leading == 1);
+        TTK_ASSERT(decoded.format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8);
+        TTK_ASSERT(decoded.stats.glyph_count == 2 && decoded.stats.page_count == 2);
+        TTK_ASSERT(decoded.stats.page_width == 8 && decoded.stats.page_height == 4);
+        TTK_ASSERT(decoded.stats.used_area == 20 && decoded.stats.texture_size == 64);
+        TTK_ASSERT(decoded.stats.deduplicated_glyph_count == 1);
+
+        TTK_ASSERT(decoded.glyphs.size() == 2);
+        TTK_ASSERT(decoded.glyphs[0].code == 'a' && decoded.glyphs[0].page_ix == 0 && decoded.glyphs[0].data.width == 7);
+        TTK_ASSERT(decoded.glyphs[1].code == 0x0444 && decoded.glyphs[1].page_ix == 1 && decoded.glyphs[1].data.width == 9);
+        TTK_ASSERT(decoded.glyphs[1].data.quad_x == -1 && decoded.glyphs[1].data.quad_y == 2);
+        TTK_ASSERT(decoded.glyphs[1].data.quad_width == 5 && decoded.glyphs[1].data.quad_height == 4);
+        TTK_ASSERT(decoded.glyphs[1].data.x1 == 0.125 && decoded.glyphs[1].data.y2 == 1.0);
+        TTK_ASSERT(decoded.glyphs[1].data.tex_obj == 0);
+
+        // pages point to decoded data
+        TTK_ASSERT(decoded.pages.size() == 2);
+        TTK_ASSERT(decoded.pages[0] >= data.data() && decoded.pages[1] + decoded.GetPageSize() <= data.data() + data.size());
+        TTK_ASSERT(memcmp(decoded.pages[0], page0.data(), page0.size()) == 0);
+        TTK_ASSERT(memcmp(decoded.pages[1], page1.data(), page1.size()) == 0);
+
+        // truncated
+        for (size_t size = 0; size < data.size(); size += 7) {
+            TTK_ASSERT_M(!decoded.Decode(data.data(), size), ToStr("%d", int(size)));
+        }
+        TTK_ASSERT(!decoded.Decode(data.data(), data.size() - 1));
+        TTK_ASSERT(!decoded.Decode(NULL, 0));
+
+        // wrong signature
+        std::vector<uint8_t> corrupted = data;
+        corrupted[0] = 'X';
+        TTK_ASSERT(!decoded.Decode(corrupted.data(), corrupted.size()));
+
+        // wrong version
+        corrupted = data;
+        corrupted[8] += 1;
+        TTK_ASSERT(!decoded.Decode(corrupted.data(), corrupted.size()));
+    }
+}
+
+void TestTOGL_GlyphTable() {
+    auto MakeGlyphData = [](uint16_t width) {
+        TOGL_GlyphData glyph_data = {};
+        glyph_data.width = width;
+        return glyph_data;
+    };
+
+    // empty
+    {
+        TOGL_GlyphTable table;
+        TTK_ASSERT(table.GetCount() == 0);
+        TTK_ASSERT(table.Has('a') == false);
+        TTK_ASSERT(table.Get('a').width == 0);
+        TTK_ASSERT(table.GetCodes().empty());
+    }
+    // set, has, get
+    {
+        TOGL_GlyphTable table;
+        table.Set('a', MakeGlyphData(10));
+        table.Set('b', MakeGlyphData(11));
+        table.Set(0x0444, MakeGlyphData(12));
+        table.Set(0xFFFD, MakeGlyphData(13));
+        table.Set(0x110000, MakeGlyphData(14)); // out of range, ignored
+
+        TTK_ASSERT(table.GetCount() == 4);
+        TTK_ASSERT(table.Has('a') && table.Has('b') && table.Has(0x0444) && table.Has(0xFFFD));
+        TTK_ASSERT(!table.Has('c') && !table.Has(0x0445) && !table.Has(0x10000) && !table.Has(0x110000));
+
+        TTK_ASSERT(table.Get('a').width == 10);
+        TTK_ASSERT(table.Get('b').width == 11);
+        TTK_ASSERT(table.Get(0x0444).width == 12);
+        TTK_ASSERT(table.Get(0xFFFD).width == 13);
+
+        table.Set('a', MakeGlyphData(20));
+        TTK_ASSERT(table.GetCount() == 4);
+        TTK_ASSERT(table.Get('a').width == 20);
+
+        TTK_ASSERT(table.GetCodes() == std::vector<uint32_t>({'a', 'b', 0x0444, 0xFFFD}));
+
+        table.Clear();
+        TTK_ASSERT(table.GetCount() == 0);
+        TTK_ASSERT(!table.Has('a'));
+    }
+    // fallback
+    {
+        TOGL_GlyphTable table;
+        table.Set('a', MakeGlyphData(10));
+        table.Set(TOGL_UNICODE_WHITE_SQUARE, MakeGlyphData(30));
+        table.Set(TOGL_UNICODE_REPLACEMENT_CHARACTER, MakeGlyphData(40));
+
+        table.ResolveFallback({TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER}, MakeGlyphData(50));
+
+        TTK_ASSERT(table.Get('a').width == 10);
+        TTK_ASSERT(table.Get('b').width == 30);         // missing in allocated page
+        TTK_ASSERT(table.Get(0x0444).width == 30);      // missing in not allocated page
+        TTK_ASSERT(table.Get(0x1F600).width == 30);     // missing in not allocated plane
+        TTK_ASSERT(table.Get(0x110000).width == 30);    // out of range
+        TTK_ASSERT(table.Has('b') == false);
+
+        // page allocated after resolving
+        table.Set(0x0555, MakeGlyphData(60));
+        TTK_ASSERT(table.Get(0x0555).width == 60);
+        TTK_ASSERT(table.Get(0x0556).width == 30);
+
+        // plane allocated after resolving
+        table.Set(0x20000, MakeGlyphData(70));
+        TTK_ASSERT(table.Get(0x20000).width == 70);
+        TTK_ASSERT(table.Get(0x20001).width == 30);
+        TTK_ASSERT(table.Get(0x2FF00).width == 30);
+    }
+    // supplementary planes
+    {
+        TOGL_GlyphTable table;
+        table.Set('a', MakeGlyphData(10));
+        table.Set(0x10000, MakeGlyphData(11));
+        table.Set(0x1F600, MakeGlyphData(12));
+        table.Set(0x1F6FF, MakeGlyphData(13));
+        table.Set(0x10FFFF, MakeGlyphData(14));
+
+        TTK_ASSERT(table.GetCount() == 5);
+        TTK_ASSERT(table.Has(0x10000) && table.Has(0x1F600) && table.Has(0x1F6FF) && table.Has(0x10FFFF));
+        TTK_ASSERT(!table.Has(0x1F601) && !table.Has(0x1F500) && !table.Has(0x2F600) && !table.Has(0xF600));
+
+        TTK_ASSERT(table.Get('a').width == 10);
+        TTK_ASSERT(table.Get(0x10000).width == 11);
+        TTK_ASSERT(table.Get(0x1F600).width == 12);
+        TTK_ASSERT(table.Get(0x1F6FF).width == 13);
+        TTK_ASSERT(table.Get(0x10FFFF).width == 14);
+        TTK_ASSERT(table.Get(0xF600).width == 0);   // the same low bits in basic multilingual plane
+
+        TTK_ASSERT(table.GetCodes() == std::vector<uint32_t>({'a', 0x10000, 0x1F600, 0x1F6FF, 0x10FFFF}));
+
+        table.Clear();
+        TTK_ASSERT(table.GetCount() == 0);
+        TTK_ASSERT(!table.Has(0x1F600));
+        TTK_ASSERT(table.GetCodes().empty());
+    }
+    {
+        TOGL_GlyphTable table;
+        table.Set('a', MakeGlyphData(10));
+        table.Set(TOGL_UNICODE_REPLACEMENT_CHARACTER, MakeGlyphData(40));
+
+        table.ResolveFallback({TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER}, MakeGlyphData(50));
+        TTK_ASSERT(table.Get('b').width == 40);
+    }
+    {
+        TOGL_GlyphTable table;
+        table.Set('a', MakeGlyphData(10));
+
+        table.ResolveFallback({TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER}, MakeGlyphData(50));
+        TTK_ASSERT(table.Get('b').width == 50);
+        TTK_ASSERT(table.Get(0x0444).width == 50);
+    }
+
+    // font index
+    {
+        TOGL_GlyphTable table;
+        table.Set('a', MakeGlyphData(10));
+        table.Set(0x1F600, MakeGlyphData(11));
+        table.ResolveFallback({}, MakeGlyphData(50));
+
+        uint32_t resolve_count = 0;
+        auto Resolve = [&resolve_count](uint32_t code) {
+            resolve_count += 1;
+            return uint8_t((code == 'b') ? 2 : (code == 0x4E00) ? 1 : 0);
+        };
+
+        // glyphs of table aren't resolved
+        TTK_ASSERT(table.ToFontIx('a', Resolve) == 0);
+        TTK_ASSERT(table.ToFontIx(0x1F600, Resolve) == 0);
+        TTK_ASSERT(resolve_count == 0);
+
+        // missing glyphs are resolved once
+        TTK_ASSERT(table.ToFontIx('b', Resolve) == 2);
+        TTK_ASSERT(table.ToFontIx(0x4E00, Resolve) == 1);
+        TTK_ASSERT(table.ToFontIx(0x10FFFF, Resolve) == 0);
+        TTK_ASSERT(resolve_count == 3);
+
+        TTK_ASSERT(table.ToFontIx('b', Resolve) == 2);
+        TTK_ASSERT(table.ToFontIx(0x4E00, Resolve) == 1);
+        TTK_ASSERT(table.ToFontIx(0x10FFFF, Resolve) == 0);
+        TTK_ASSERT(resolve_count == 3);
+
+        // out of range
+        TTK_ASSERT(table.ToFontIx(0x110000, Resolve) == 0);
+        TTK_ASSERT(resolve_count == 3);
+
+        // resolution doesn't add glyphs, and pages allocated by it are filled with fallback glyph
+        TTK_ASSERT(table.GetCount() == 2);
+        TTK_ASSERT(!table.Has(0x4E00));
+        TTK_ASSERT(table.Get(0x4E00).width == 50 && table.Get(0x4E01).width == 50);
+        TTK_ASSERT(table.GetCodes() == std::vector<uint32_t>({'a', 0x1F600}));
+
+        // glyph added later belongs to table
+        table.Set('b', MakeGlyphData(12));
+        TTK_ASSERT(table.ToFontIx('b', Resolve) == 0);
+        TTK_ASSERT(resolve_count == 3);
+
+        table.ResetFontIxs();
+        TTK_ASSERT(table.ToFontIx('a', Resolve) == 0);
+        TTK_ASSERT(table.ToFontIx(0x4E00, Resolve) == 1);
+        TTK_ASSERT(resolve_count == 4);
+
+        // resolved index is limited
+        TTK_ASSERT(table.ToFontIx('c', [](uint32_t) { return uint8_t(TOGL_GlyphTable::UNRESOLVED_FONT_IX); }) == TOGL_GlyphTable::MAX_FONT_IX);
+
+        table.Clear();
+        TTK_ASSERT(table.ToFontIx(0x4E00, Resolve) == 1);
+        TTK_ASSERT(resolve_count == 5);
+    }
+}
+
+void TestTOGL_MetricsFont() {
+    const std::vector<uint8_t>  data = MakeTestTrueTypeFont();
+    const TOGL_FontInfo         font_info("", 100, TOGL_FONT_SIZE_UNIT_ID_PIXELS, TOGL_FONT_STYLE_ID_NORMAL, TOGL_FONT_CHAR_SET_ID_ENGLISH, 2, 3);
+
+    // from memory
+    {
+        TOGL_MetricsFont font;
+        TTK_ASSERT(!font.IsLoaded());
+
+        font.Load(data.data(), data.size(), font_info);
+        TTK_ASSERT_M(font.IsOk(), font.GetErrMsg());
+        TTK_ASSERT(font.IsLoaded());
+
+        TTK_ASSERT(font.GetHeight() == 100);
+        TTK_ASSERT(font.GetAscent() == 80);
+        TTK_ASSERT(font.GetDescent() == 20);
+        TTK_ASSERT(font.GetDistanceBetweenGlyphs() == 2);
+        TTK_ASSERT(font.GetDistanceBetweenLines() == 3);
+
+        TTK_ASSERT(font.GetGlyphSize('A').width == 100 && font.GetGlyphSize('A').height == 100);
+        TTK_ASSERT(font.GetGlyphSize(' ').width == 25);
+
+        // not in font
+        TTK_ASSERT(font.GetGlyphSize('D').width == 100);
+
+        TTK_ASSERT(font.GetGlyphCountInWidth(L"AAA", 0) == 0);
+        TTK_ASSERT(font.GetGlyphCountInWidth(L"AAA", 100) == 1);
+        TTK_ASSERT(font.GetGlyphCountInWidth(L"AAA", 250) == 2);
+
+        font.Unload();
+        TTK_ASSERT(!font.IsLoaded());
+        TTK_ASSERT(font.GetGlyphSize('A').width == 0);
+    }
+
+    // from file
+    {
+        const std::string file_name = "metrics_font_test.ttf";
+
+        FILE* file = fopen(file_name.c_str(), "wb");
+        TTK_ASSERT(file);
+        if (file) {
+            fwrite(data.data(), 1, data.size(), file);
+            fclose(file);
+        }
+
+        TOGL_MetricsFont font;
+        font.Load(file_name, font_info);
+        TTK_ASSERT_M(font.IsOk(), font.GetErrMsg());
+        TTK_ASSERT(font.GetHeight() == 100);
+        TTK_ASSERT(font.GetGlyphSize('B').width == 100);
+
+        remove(file_name.c_str());
+
+        font.Load("not_existing_font_file.ttf", font_info);
+        TTK_ASSERT(!font.IsOk());
+        TTK_ASSERT(!font.IsLoaded());
+    }
+}
+
+void TestTOGL_UnicodeRangeSet() {
+    auto IsEqual = [](const TOGL_UnicodeRangeSet& set, const std::vector<TOGL_UnicodeRange>& expected) {
+        const std::vector<TOGL_UnicodeRange>& ranges = set.ToRanges();
+
+        if (ranges.size() != expected.size()) return false;
+        for (size_t ix = 0; ix < ranges.size(); ++ix) {
+            if (ranges[ix].from != expected[ix].from || ranges[ix].to != expected[ix].to) return false;
+        }
+        return true;
+    };
+
+    // add
+    {
+        TOGL_UnicodeRangeSet set;
+        TTK_ASSERT(set.IsEmpty());
+        TTK_ASSERT(set.GetCodeCount() == 0);
+        TTK_ASSERT(!set.Contains(0));
+
+        set.Add({0x20, 0x7E});
+        set.Add({0x400, 0x4FF});
+        set.Add({0x100, 0x17F});            // between
+        set.Add({0x10, 0x1F});              // adjacent to first
+        set.Add({0x180, 0x180});            // adjacent to third
+        set.Add({0x50, 0x120});             // overlaps first and third
+        set.Add({5, 4});                    // ignored
+        TTK_ASSERT(IsEqual(set, {{0x10, 0x180}, {0x400, 0x4FF}}));
+        TTK_ASSERT(set.GetCodeCount() == 0x171 + 0x100);
+
+        set.Add({0, 0xFFFFFFFF});
+        TTK_ASSERT(IsEqual(set, {{0, 0xFFFFFFFF}}));
+        TTK_ASSERT(set.GetCodeCount() == 0x100000000ull);
+
+        set.Clear();
+        TTK_ASSERT(set.IsEmpty());
+    }
+    // constructor, contains
+    {
+        const TOGL_UnicodeRangeSet set({{0x400, 0x4FF}, {0x20, 0x7E}, {0x7F, 0x7F}, {0x1F600, 0x1F64F}});
+        TTK_ASSERT(IsEqual(set, {{0x20, 0x7F}, {0x400, 0x4FF}, {0x1F600, 0x1F64F}}));
+
+        TTK_ASSERT(!set.Contains(0x1F));
+        TTK_ASSERT(set.Contains(0x20));
+        TTK_ASSERT(set.Contains(0x7F));
+        TTK_ASSERT(!set.Contains(0x80));
+        TTK_ASSERT(set.Contains(0x4FF));
+        TTK_ASSERT(set.Contains(0x1F600));
+        TTK_ASSERT(!set.Contains(0x1F650));
+        TTK_ASSERT(!set.Contains(0x10FFFF));
+    }
+    // remove
+    {
+        TOGL_UnicodeRangeSet set({{0x0000, 0xFFFF}, {0x10000, 0x10010}});
+        TTK_ASSERT(IsEqual(set, {{0x0000, 0x10010}}));
+
+        set.Remove(0xFFFF);
+        TTK_ASSERT(IsEqual(set, {{0x0000, 0xFFFE}, {0x10000, 0x10010}}));
+
+        set.Remove({0x0000, 0x001F});
+        set.Remove({0x10005, 0x20000});
+        set.Remove({0x30000, 0x40000});     // not in set
+        TTK_ASSERT(IsEqual(set, {{0x0020, 0xFFFE}, {0x10000, 0x10004}}));
+
+        set.Remove({0x0000, 0x10FFFF});
+        TTK_ASSERT(set.IsEmpty());
+    }
+    // intersect
+    {
+        TOGL_UnicodeRangeSet set(std::vector<TOGL_UnicodeRange>{{0x0000, 0xFFFF}});
+        set.Intersect(TOGL_UnicodeRangeSet({{0x20, 0x7E}, {0xA0, 0x17F}, {0x25A1, 0x25A1}, {0x1F600, 0x1F64F}}));
+        TTK_ASSERT(IsEqual(set, {{0x20, 0x7E}, {0xA0, 0x17F}, {0x25A1, 0x25A1}}));
+
+        set.Intersect(TOGL_UnicodeRangeSet({{0x0, 0x40}, {0x60, 0xB0}, {0x100, 0x2000}}));
+        TTK_ASSERT(IsEqual(set, {{0x20, 0x40}, {0x60, 0x7E}, {0xA0, 0xB0}, {0x100, 0x17F}}));
+
+        set.Intersect(TOGL_UnicodeRangeSet());
+        TTK_ASSERT(set.IsEmpty());
+    }
+}
+
+void TestTOGL_CodePointRecord() {
+    TOGL_CodePointRecord record;
+
+    TTK_ASSERT(record.GetCount() == 0);
+    TTK_ASSERT(record.GetRanges().empty());
+
+    record.Add('a');
+    record.Add('b');
+    record.Add('c');
+    record.Add('b');                // already recorded
+    record.Add('x');
+    record.Add(0x00FF);             // adjacent to next page
+    record.Add(0x0100);
+    record.Add(0x1F600);
+    record.Add(0x110000);           // out of range
+
+    TTK_ASSERT(record.GetCount() == 7);
+    TTK_ASSERT(record.Contains('a'));
+    TTK_ASSERT(record.Contains(0x1F600));
+    TTK_ASSERT(!record.Contains('d'));
+    TTK_ASSERT(!record.Contains(0x110000));
+
+    const std::vector<TOGL_UnicodeRange> ranges = record.GetRanges();
+    TTK_ASSERT(ranges.size() == 4);
+    if (ranges.size() == 4) {
+        TTK_ASSERT(ranges[0].from == 'a'        && ranges[0].to == 'c');
+        TTK_ASSERT(ranges[1].from == 'x'        && ranges[1].to == 'x');
+        TTK_ASSERT(ranges[2].from == 0x00FF     && ranges[2].to == 0x0100);
+        TTK_ASSERT(ranges[3].from == 0x1F600    && ranges[3].to == 0x1F600);
+    }
+
+    // encode, decode
+    {
+        const std::vector<uint8_t> data = record.Encode();
+        TTK_ASSERT(data.size() == 16 + 3 * (4 + 32));     // only used pages are saved
+
+        TOGL_CodePointRecord decoded;
+        TTK_ASSERT(decoded.Decode(data.data(), data.size()));
+        TTK_ASSERT(decoded.GetCount() == record.GetCount());
+        TTK_ASSERT(decoded.GetRanges().size() == ranges.size());
+        TTK_ASSERT(decoded.Contains(0x0100) && decoded.Contains(0x1F600));
+
+        TTK_ASSERT(!decoded.Decode(data.data(), data.size() - 1));
+        TTK_ASSERT(decoded.GetCount() == 0);
+
+        std::vector<uint8_t> corrupted = data;
+        corrupted[0] = 'X';
+        TTK_ASSERT(!decoded.Decode(corrupted.data(), corrupted.size()));
+
+        corrupted = data;
+        corrupted[16] = 0xFF;       // page index out of range
+        corrupted[17] = 0xFF;
+        TTK_ASSERT(!decoded.Decode(corrupted.data(), corrupted.size()));
+        TTK_ASSERT(decoded.GetCount() == 0);
+
+        TTK_ASSERT(!decoded.Decode(nullptr, 0));
+    }
+
+    // merge
+    {
+        TOGL_CodePointRecord other;
+        other.Add('d');
+        other.Add('a');
+        other.Add(record);
+        TTK_ASSERT(other.GetCount() == 8);
+        TTK_ASSERT(other.GetRanges().size() == 4);
+    }
+
+    // save, load
+    {
+        const std::string file_name = "code_point_record_test.bin";
+
+        TTK_ASSERT(record.Save(file_name));
+
+        TOGL_CodePointRecord loaded;
+        TTK_ASSERT(loaded.Load(file_name));
+        TTK_ASSERT(loaded.GetCount() == record.GetCount());
+
+        TOGL_UnicodeRangeGroup group;
+        TTK_ASSERT(TOGL_LoadUnicodeRangeGroup(file_name, group, false));
+        TTK_ASSERT(group.GetCharSet() == TOGL_FONT_CHAR_SET_ID_CUSTOM);
+        TTK_ASSERT(group.ToRanges().size() == 4);
+
+        TTK_ASSERT(TOGL_LoadUnicodeRangeGroup(file_name, group));
+        TTK_ASSERT(group.ToRanges().size() == 6);
+
+        remove(file_name.c_str());
+
+        TTK_ASSERT(!loaded.Load("not_existing_record.bin"));
+        TTK_ASSERT(loaded.GetCount() == 0);
+        TTK_ASSERT(!TOGL_LoadUnicodeRangeGroup("not_existing_record.bin", group));
+    }
+}
+
+void TestTOGL_DistanceField() {
+    // empty glyph
+    {
+        const TOGL_GlyphBitmap field = TOGL_MakeDistanceField(TOGL_GlyphBitmap(), 4);
+        TTK_ASSERT(field.width == 0 && field.height == 0 && field.alphas.empty());
+    }
+
+    // filled square 4x4
+    {
+        TOGL_GlyphBitmap bitmap;
+        bitmap.x        = 1;
+        bitmap.y        = 2;
+        bitmap.width    = 4;
+        bitmap.height   = 4;
+        bitmap.alphas.assign(16, 255);
+
+        const TOGL_GlyphBitmap field = TOGL_MakeDistanceField(bitmap, 3);
+
+        TTK_ASSERT(field.x == -2 && field.y == -1);
+        TTK_ASSERT(field.width == 10 && field.height == 10);
+        TTK_ASSERT(field.alphas.size() == 100);
+
+        auto At = [&field](int x, int y) -> int { return field.alphas[y * field.width + x]; };
+
+        // row through middle of square: outside (0..2), inside (3..6), outside (7..9)
+        TTK_ASSERT_M(At(2, 4) == 106, ToStr("%d", At(2, 4)));   // 0.5 pixel outside of edge
+        TTK_ASSERT_M(At(3, 4) == 149, ToStr("%d", At(3, 4)));   // 0.5 pixel inside of edge
+        TTK_ASSERT_M(At(0, 4) == 21, ToStr("%d", At(0, 4)));    // 2.5 pixels outside of edge
+        TTK_ASSERT(At(4, 4) > At(3, 4));
+
+        // symmetric
+        for (int y = 0; y < 10; ++y) {
+            for (int x = 0; x < 10; ++x) {
+                TTK_ASSERT(At(x, y) == At(9 - x, y));
+                TTK_ASSERT(At(x, y) == At(x, 9 - y));
+                TTK_ASSERT(At(x, y) == At(y, x));
+            }
+        }
+
+        // edge is at threshold
+        for (int y = 3; y <= 6; ++y) {
+            for (int x = 0; x < 10; ++x) {
+                TTK_ASSERT((At(x, y) >= 128) == (x >= 3 && x <= 6));
+            }
+        }
+
+        // corner is the furthest from glyph (sqrt(2.5^2 + 2.5^2) > spread)
+        TTK_ASSERT(At(0, 0) == 0);
+    }
+
+    // coverage threshold and spread saturation
+    {
+        TOGL_GlyphBitmap bitmap;
+        bitmap.width    = 16;
+        bitmap.height   = 1;
+        bitmap.alphas.assign(16, 0);
+        for (size_t ix = 0; ix < 8; ++ix) bitmap.alphas[ix] = 128;
+
+        const TOGL_GlyphBitmap field = TOGL_MakeDistanceField(bitmap, 2);
+        const uint8_t* row = field.alphas.data() + 2 * field.width;
+
+        TTK_ASSERT(row[2 + 7] >= 128 && row[2 + 8] < 128);
+        TTK_ASSERT(row[2 + 15] == 0);
+        TTK_ASSERT_M(row[0] == 32, ToStr("%d", row[0]));  // 1.5 pixel outside of edge
+    }
+}
+
+#endif // PORTABLETEST_H_
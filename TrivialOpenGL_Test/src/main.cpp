@@ -1,12 +1,16 @@
 #include <stdio.h>
 #include <string>
 #include <set>
+#include <map>
+#include <chrono>
 
 #include <TrivialTestKit.h>
 #include <ToStr.h>
 
 #include "TrivialOpenGL.h"
 
+#include "PortableTest.h"
+
 //--------------------------------------------------------------------------
 
 template <unsigned N>
@@ -504,6 +508,39 @@ void TestTOGL_ToUTF8() {
     }
 }
 
+void TestTOGL_ToUTF32() {
+    auto ToText = [](std::initializer_list<uint16_t> codes) {
+        std::wstring text;
+        for (const uint16_t code : codes) text += wchar_t(code);
+        return text;
+    };
+
+    // empty text
+    TTK_ASSERT(TOGL_ToUTF32(L"") == U"");
+
+    // unicode characters, surrogate pair is one code point
+    TTK_ASSERT(TOGL_ToUTF32(L"Some text\u0444\U0002F820.") == U"Some text\u0444\U0002F820.");
+    TTK_ASSERT(TOGL_ToUTF32(ToText({0xD83D, 0xDE00})) == std::u32string(1, 0x1F600));
+    TTK_ASSERT(TOGL_ToUTF32(ToText({0xDBFF, 0xDFFF})) == std::u32string(1, 0x10FFFF));
+
+    // unpaired surrogates are replaced by U+FFFD
+    TTK_ASSERT(TOGL_ToUTF32(ToText({0xDC00, 'e', 'x', 't'})) == U"\uFFFDext");
+    TTK_ASSERT(TOGL_ToUTF32(ToText({'t', 'e', 'x', 0xD800})) == U"tex\uFFFD");
+    TTK_ASSERT(TOGL_ToUTF32(ToText({0xD800, 0xD800, 0xDC00})) == U"\uFFFD\U00010000");
+
+    // single character
+    {
+        const std::wstring text = ToText({'a', 0xD83D, 0xDE00, 'b'});
+        TTK_ASSERT(TOGL_GetUTF16_CharLength(text, 0) == 1);
+        TTK_ASSERT(TOGL_GetUTF16_CharLength(text, 1) == 2);
+        TTK_ASSERT(TOGL_GetUTF16_CharLength(text, 3) == 1);
+        TTK_ASSERT(TOGL_DecodeUTF16_Char(text, 0) == 'a');
+        TTK_ASSERT(TOGL_DecodeUTF16_Char(text, 1) == 0x1F600);
+        TTK_ASSERT(TOGL_DecodeUTF16_Char(text, 2) == 0xFFFD);   // second half of pair
+        TTK_ASSERT(TOGL_DecodeUTF16_Char(text, 3) == 'b');
+    }
+}
+
 void TestTOGL_Log() {
     TTK_ASSERT(CreateDirectoryA(".\\log", 0) || GetLastError() == ERROR_ALREADY_EXISTS);
     TTK_ASSERT(CreateDirectoryA(".\\log\\test", 0) || GetLastError() == ERROR_ALREADY_EXISTS);
@@ -629,6 +666,1842 @@ void TestTOGL_Color() {
     }
 }
 
+void TestTOGL_AtlasPacker() {
+    struct Rect {
+        TOGL_PointU16 pos;
+        TOGL_SizeU16  size;
+    };
+
+    auto IsOverlap = [](const Rect& a, const Rect& b) {
+        return a.pos.x < b.pos.x + b.size.width && b.pos.x < a.pos.x + a.size.width &&
+               a.pos.y < b.pos.y + b.size.height && b.pos.y < a.pos.y + a.size.height;
+    };
+
+    // Glyph-like boxes, sorted from highest to lowest (as in TOGL_FontDataGenerator).
+    std::vector<TOGL_SizeU16> sizes;
+    for (uint32_t ix = 0; ix < 500; ++ix) {
+        sizes.push_back(TOGL_SizeU16(uint16_t(3 + (ix * 7) % 14), uint16_t(2 + (ix * 13) % 17)));
+    }
+    std::stable_sort(sizes.begin(), sizes.end(), [](const TOGL_SizeU16& l, const TOGL_SizeU16& r) { return l.height > r.height; });
+
+    // Packs into pages, returns number of pages.
+    auto Pack = [&](TOGL_FontAtlasPackerId packer_id, uint16_t page_size) -> uint32_t {
+        TOGL_AtlasPacker packer(packer_id, page_size, page_size);
+        uint32_t page_count = 1;
+        std::vector<Rect> rects;
+        uint64_t used_area = 0;
+
+        for (const auto& size : sizes) {
+            Rect rect = {{}, size};
+
+            if (!packer.Insert(size.width, size.height, rect.pos)) {
+                TTK_ASSERT(packer.GetUsedArea() == used_area);
+
+                packer.Reset(packer_id, page_size, page_size);
+                rects.clear();
+                used_area = 0;
+                page_count += 1;
+
+                TTK_ASSERT(packer.Insert(size.width, size.height, rect.pos));
+            }
+
+            TTK_ASSERT(rect.pos.x + rect.size.width <= page_size);
+            TTK_ASSERT(rect.pos.y + rect.size.height <= page_size);
+
+            for (const auto& other : rects) {
+                TTK_ASSERT(!IsOverlap(rect, other));
+            }
+            rects.push_back(rect);
+            used_area += uint64_t(size.width) * size.height;
+        }
+        return page_count;
+    };
+
+    const uint32_t row_page_count       = Pack(TOGL_FONT_ATLAS_PACKER_ID_ROWS, 64);
+    const uint32_t skyline_page_count   = Pack(TOGL_FONT_ATLAS_PACKER_ID_SKYLINE, 64);
+
+    TTK_ASSERT_M(skyline_page_count <= row_page_count, ToStr("skyline=%u rows=%u", skyline_page_count, row_page_count));
+
+    // too big
+    {
+        TOGL_AtlasPacker packer(TOGL_FONT_ATLAS_PACKER_ID_SKYLINE, 16, 16);
+        TOGL_PointU16 pos;
+        TTK_ASSERT(!packer.Insert(17, 1, pos));
+        TTK_ASSERT(!packer.Insert(1, 17, pos));
+        TTK_ASSERT(packer.Insert(16, 16, pos));
+        TTK_ASSERT(pos.x == 0 && pos.y == 0);
+        TTK_ASSERT(!packer.Insert(1, 1, pos));
+    }
+    // bottom-left placement
+    {
+        TOGL_AtlasPacker packer(TOGL_FONT_ATLAS_PACKER_ID_SKYLINE, 16, 16);
+        TOGL_PointU16 pos;
+        TTK_ASSERT(packer.Insert(8, 4, pos) && pos.x == 0 && pos.y == 0);
+        TTK_ASSERT(packer.Insert(8, 2, pos) && pos.x == 8 && pos.y == 0);
+        TTK_ASSERT(packer.Insert(8, 2, pos) && pos.x == 8 && pos.y == 2);
+        TTK_ASSERT(packer.Insert(16, 1, pos) && pos.x == 0 && pos.y == 4);
+        TTK_ASSERT(packer.GetUsedArea() == 32 + 16 + 16 + 16);
+    }
+    // stats
+    {
+        TOGL_FontStats stats;
+        TTK_ASSERT(stats.GetFillRatio() == 0);
+        stats.page_count    = 2;
+        stats.page_width    = 16;
+        stats.page_height   = 16;
+        stats.used_area     = 128;
+        TTK_ASSERT(stats.GetFillRatio() == 0.25);
+
+        TTK_ASSERT(stats.GetDedupeRatio() == 0);
+        stats.glyph_count               = 8;
+        stats.deduplicated_glyph_count  = 2;
+        TTK_ASSERT(stats.GetDedupeRatio() == 0.25);
+    }
+}
+
+void TestTOGL_FontRegistry() {
+    // handle
+    {
+        TTK_ASSERT(TOGL_FontHandle().IsNone());
+        TTK_ASSERT(!TOGL_FontHandle(0x10001).IsNone());
+        TTK_ASSERT(TOGL_FontHandle(0x10001) == TOGL_FontHandle(0x10001));
+        TTK_ASSERT(TOGL_FontHandle(0x10001) != TOGL_FontHandle(0x00001));
+    }
+
+    // not loaded font
+    {
+        TOGL_FontRegistry registry;
+
+        TTK_ASSERT(registry.IsOk());
+        TTK_ASSERT(registry.GetFontCount() == 0);
+        TTK_ASSERT(registry.GetPageCount() == 0);
+
+        TTK_ASSERT(!registry.IsLoaded(TOGL_FontHandle()));
+        TTK_ASSERT(!registry.IsLoaded(TOGL_FontHandle(1)));
+        TTK_ASSERT(!registry.ToFont(TOGL_FontHandle(1)).IsLoaded());
+        TTK_ASSERT(&registry.ToFont(TOGL_FontHandle()) == &registry.ToFont(TOGL_FontHandle(2)));
+
+        registry.Unload(TOGL_FontHandle(1));
+        TTK_ASSERT(registry.GetFontCount() == 0);
+    }
+
+    // atlas compatibility
+    {
+        TOGL_FontAtlas atlas;
+        TOGL_FontLoadOptions options;
+
+        TTK_ASSERT(!atlas.IsInitialized());
+        TTK_ASSERT(!atlas.IsCompatible(options));
+
+        atlas.Reset(options.packer, options.format, options.is_sdf, 512, 256);
+
+        TTK_ASSERT(atlas.IsInitialized());
+        TTK_ASSERT(atlas.GetPageCount() == 0);
+        TTK_ASSERT(atlas.GetPageTextureSize() == 512 * 256 * 4);
+        TTK_ASSERT(atlas.IsCompatible(options));
+
+        options.page_width = 512;
+        TTK_ASSERT(atlas.IsCompatible(options));
+
+        options.page_height = 512;
+        TTK_ASSERT(!atlas.IsCompatible(options));
+
+        options.page_height = 0;
+        options.is_sdf = true;
+        TTK_ASSERT(!atlas.IsCompatible(options));
+
+        options.is_sdf = false;
+        options.format = TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8;
+        TTK_ASSERT(!atlas.IsCompatible(options));
+
+        // too big glyph doesn't create page
+        TOGL_PointU16   pos;
+        uint32_t        page_ix = 0;
+        TTK_ASSERT(!atlas.Insert(513, 10, pos, page_ix));
+        TTK_ASSERT(atlas.GetPageCount() == 0);
+    }
+
+    // distance field without spread fails before generating
+    {
+        TOGL_FontLoadOptions options;
+        options.is_sdf      = true;
+        options.sdf_spread  = 0;
+
+        const TOGL_FontInfo font_info("Courier New", 16, TOGL_FONT_SIZE_UNIT_ID_PIXELS, TOGL_FONT_STYLE_ID_NORMAL, TOGL_FONT_CHAR_SET_ID_ENGLISH);
+
+        TOGL_Font font;
+        font.Load(font_info, options);
+        TTK_ASSERT(!font.IsOk());
+        TTK_ASSERT(!font.IsLoaded());
+
+        font.LoadAsync(font_info, options);
+        TTK_ASSERT(!font.IsOk());
+        TTK_ASSERT(!font.IsLoadingAsync());
+        TTK_ASSERT(!font.UpdateLoading());
+
+        TOGL_FontRegistry registry;
+        const TOGL_FontHandle handle = registry.LoadAsync(font_info, options);
+        TTK_ASSERT(!registry.IsOk());
+        TTK_ASSERT(handle.IsNone());
+        TTK_ASSERT(registry.GetFontCount() == 0);
+    }
+}
+
+// Synthetic glyph source. Bitmap size and pixels depend on code point. 
+class TestGlyphSource : public TOGL_GlyphSource {
+public:
+    TestGlyphSource(bool is_clonable, std::shared_ptr<std::atomic<uint32_t>> clone_count) : m_is_clonable(is_clonable), m_clone_count(clone_count) {}
+
+    bool GetGlyphBitmap(uint32_t code, TOGL_GlyphBitmap& bitmap) override {
+        if (code == 'X') return false;
+
+        bitmap.x        = int16_t(code % 3);
+        bitmap.y        = -int16_t(code % 2);
+        bitmap.width    = uint16_t(code % 7);
+        bitmap.height   = uint16_t(code % 5);
+        bitmap.alphas.assign(size_t(bitmap.width) * bitmap.height, uint8_t(code));
+        return true;
+    }
+
+    uint16_t GetGlyphWidth(uint32_t code) override {
+        return uint16_t(code % 11);
+    }
+
+    std::shared_ptr<TOGL_GlyphSource> Clone() const override {
+        if (!m_is_clonable) return nullptr;
+
+        *m_clone_count += 1;
+        return std::make_shared<TestGlyphSource>(m_is_clonable, m_clone_count);
+    }
+
+private:
+    bool                                    m_is_clonable;
+    std::shared_ptr<std::atomic<uint32_t>>  m_clone_count;
+};
+
+void TestTOGL_RasterizeGlyphs() {
+    const std::vector<TOGL_UnicodeRange> ranges = {{'A', 'Z'}, {0x400, 0x4FF}, {'0', '9'}};
+
+    auto IsEqual = [](const TOGL_RasterizedGlyph& glyph, uint32_t code) {
+        if (code == 'X') {
+            return glyph.code == code && glyph.width == code % 11 && glyph.bitmap.width == 0 && glyph.bitmap.height == 0 && glyph.bitmap.alphas.empty();
+        }
+        return glyph.code == code 
+            && glyph.width == code % 11 
+            && glyph.bitmap.x == int16_t(code % 3) 
+            && glyph.bitmap.y == -int16_t(code % 2) 
+            && glyph.bitmap.width == code % 7 
+            && glyph.bitmap.height == code % 5 
+            && glyph.bitmap.alphas == std::vector<uint8_t>(size_t(code % 7) * (code % 5), uint8_t(code));
+    };
+
+    for (const bool is_clonable : {false, true}) {
+        for (const uint32_t thread_count : {0u, 1u, 2u, 3u, 8u, 100u}) {
+            std::shared_ptr<std::atomic<uint32_t>> clone_count = std::make_shared<std::atomic<uint32_t>>(0);
+            TestGlyphSource source(is_clonable, clone_count);
+
+            const std::vector<TOGL_RasterizedGlyph> glyphs = TOGL_RasterizeGlyphs(source, ranges, thread_count);
+
+            TTK_ASSERT(glyphs.size() == 26 + 256 + 10);
+
+            size_t ix = 0;
+            for (const TOGL_UnicodeRange& range : ranges) {
+                for (uint32_t code = range.from; code <= range.to; ++code, ++ix) {
+                    TTK_ASSERT_M(IsEqual(glyphs[ix], code), ToStr("%u %u", thread_count, code));
+                }
+            }
+
+            // Additional threads are limited by number of glyph batches.
+            if (!is_clonable || thread_count == 1) {
+                TTK_ASSERT(*clone_count == 0);
+            } else if (thread_count != 0) {
+                TTK_ASSERT_M(*clone_count == ((thread_count < 10) ? thread_count : 10) - 1, ToStr("%u", uint32_t(*clone_count)));
+            }
+        }
+    }
+
+    // no glyphs
+    {
+        std::shared_ptr<std::atomic<uint32_t>> clone_count = std::make_shared<std::atomic<uint32_t>>(0);
+        TestGlyphSource source(true, clone_count);
+
+        TTK_ASSERT(TOGL_RasterizeGlyphs(source, {}, 4).empty());
+        TTK_ASSERT(*clone_count == 0);
+    }
+
+    // distance field
+    {
+        std::shared_ptr<std::atomic<uint32_t>> clone_count = std::make_shared<std::atomic<uint32_t>>(0);
+        TestGlyphSource source(true, clone_count);
+
+        const std::vector<TOGL_RasterizedGlyph> glyphs = TOGL_RasterizeGlyphs(source, {{0x400, 0x4FF}}, 4, 3);
+
+        TTK_ASSERT(glyphs.size() == 256);
+        for (const TOGL_RasterizedGlyph& glyph : glyphs) {
+            TOGL_GlyphBitmap bitmap;
+            source.GetGlyphBitmap(glyph.code, bitmap);
+
+            const TOGL_GlyphBitmap field = TOGL_MakeDistanceField(bitmap, 3);
+
+            TTK_ASSERT(glyph.bitmap.x == field.x && glyph.bitmap.y == field.y);
+            TTK_ASSERT(glyph.bitmap.width == field.width && glyph.bitmap.height == field.height);
+            TTK_ASSERT(glyph.bitmap.alphas == field.alphas);
+        }
+    }
+}
+
+void TestTOGL_GlyphCache() {
+    auto Contains = [](const std::vector<uint32_t>& values, uint32_t value) {
+        return std::find(values.begin(), values.end(), value) != values.end();
+    };
+
+    // disabled
+    {
+        TOGL_GlyphCache         cache;
+        TOGL_GlyphCacheChanges  changes;
+
+        TTK_ASSERT(!cache.IsEnabled());
+        TTK_ASSERT(!cache.Insert('a', 8, 8, false, changes));
+        TTK_ASSERT(cache.GetGlyphCount() == 0);
+    }
+    // hit, miss, place
+    {
+        TOGL_GlyphCache         cache;
+        TOGL_GlyphCacheChanges  changes;
+        cache.Reset(TOGL_FONT_ATLAS_PACKER_ID_SKYLINE, 32, 32, 1);
+
+        TTK_ASSERT(cache.IsEnabled());
+        TTK_ASSERT(cache.Insert('a', 16, 16, false, changes));
+        TTK_ASSERT(cache.Insert(' ', 0, 0, false, changes));      // without visible pixels
+        TTK_ASSERT(!cache.Insert('b', 33, 16, false, changes));   // bigger than page
+        TTK_ASSERT(changes.IsEmpty());
+
+        TTK_ASSERT(cache.Touch('a'));
+        TTK_ASSERT(cache.Touch(' '));
+        TTK_ASSERT(!cache.Touch('b'));
+
+        TTK_ASSERT(cache.ToCounters().hit_count == 2);
+        TTK_ASSERT(cache.ToCounters().miss_count == 1);
+        TTK_ASSERT(cache.ToCounters().eviction_count == 0);
+
+        TOGL_PointU16   pos;
+        uint32_t        page_ix = 0;
+        TTK_ASSERT(cache.GetPlace('a', pos, page_ix) && pos.x == 0 && pos.y == 0 && page_ix == 0);
+        TTK_ASSERT(!cache.GetPlace(' ', pos, page_ix));
+        TTK_ASSERT(cache.GetGlyphCount() == 2);
+        TTK_ASSERT(cache.GetPageCount() == 1);
+    }
+    // least recently used glyph is evicted
+    {
+        TOGL_GlyphCache         cache;
+        TOGL_GlyphCacheChanges  changes;
+        cache.Reset(TOGL_FONT_ATLAS_PACKER_ID_SKYLINE, 32, 32, 1);
+
+        for (uint32_t code = 1; code <= 4; ++code) TTK_ASSERT(cache.Insert(code, 16, 16, false, changes));
+        TTK_ASSERT(changes.IsEmpty());
+
+        TOGL_PointU16   pos_2;
+        uint32_t        page_ix_2 = 0;
+        TTK_ASSERT(cache.GetPlace(2, pos_2, page_ix_2));
+
+        cache.NextFrame();
+        TTK_ASSERT(cache.Touch(1) && cache.Touch(3) && cache.Touch(4));
+
+        // Place of evicted glyph is reused, without repacking.
+        TTK_ASSERT(cache.Insert(5, 16, 16, false, changes));
+        TTK_ASSERT(changes.evicted_codes == std::vector<uint32_t>({2}));
+        TTK_ASSERT(changes.repacked_page_ixs.empty());
+        TTK_ASSERT(changes.relocated_codes.empty());
+        TTK_ASSERT(changes.reused_places.size() == 1);
+        TTK_ASSERT(changes.reused_places[0].page_ix == 0 && changes.reused_places[0].pos.x == pos_2.x && changes.reused_places[0].pos.y == pos_2.y);
+        TTK_ASSERT(changes.reused_places[0].width == 16 && changes.reused_places[0].height == 16);
+        TTK_ASSERT(!cache.Has(2) && cache.Has(5));
+        TTK_ASSERT(cache.ToCounters().eviction_count == 1);
+        TTK_ASSERT(cache.ToCounters().relocation_count == 0);
+        TTK_ASSERT(cache.ToCounters().reuse_count == 1);
+        TTK_ASSERT(cache.GetFragmentation(0) == 0);
+        TTK_ASSERT(cache.GetPageCount() == 1);
+
+        TOGL_PointU16   pos;
+        uint32_t        page_ix = 0;
+        TTK_ASSERT(cache.GetPlace(5, pos, page_ix) && pos.x == pos_2.x && pos.y == pos_2.y && page_ix == 0);
+
+        // All glyphs are used in current frame.
+        changes.Clear();
+        TTK_ASSERT(!cache.Insert(6, 16, 16, false, changes));
+        TTK_ASSERT(changes.IsEmpty());
+
+        // Pinned glyph is never evicted.
+        cache.NextFrame();
+        cache.Reset(TOGL_FONT_ATLAS_PACKER_ID_SKYLINE, 32, 32, 1);
+        TTK_ASSERT(cache.Insert(1, 32, 16, true, changes));
+        TTK_ASSERT(cache.Insert(2, 32, 16, false, changes));
+        cache.NextFrame();
+
+        TTK_ASSERT(cache.Insert(3, 32, 16, false, changes));
+        TTK_ASSERT(changes.evicted_codes == std::vector<uint32_t>({2}));
+        TTK_ASSERT(cache.Has(1) && cache.Has(3));
+
+        cache.NextFrame();
+        changes.Clear();
+        TTK_ASSERT(cache.Insert(4, 32, 16, false, changes));
+        TTK_ASSERT(changes.evicted_codes == std::vector<uint32_t>({3}));
+        TTK_ASSERT(cache.Has(1));
+    }
+    // compaction
+    {
+        TOGL_GlyphCache         cache;
+        TOGL_GlyphCacheChanges  changes;
+        cache.Reset(TOGL_FONT_ATLAS_PACKER_ID_SKYLINE, 32, 32, 2);
+
+        for (uint32_t code = 10; code <= 13; ++code) TTK_ASSERT(cache.Insert(code, 16, 16, false, changes)); // page 0
+        for (uint32_t code = 1; code <= 4; ++code) TTK_ASSERT(cache.Insert(code, 16, 16, false, changes));   // page 1
+        TTK_ASSERT(cache.GetPageCount() == 2);
+
+        cache.NextFrame();
+        for (uint32_t code : {2, 3, 4, 12, 13}) TTK_ASSERT(cache.Touch(code));
+
+        // Evicted glyph from page 1 doesn't free enough space, so page 0 is repacked.
+        TTK_ASSERT(cache.Insert(20, 32, 16, false, changes));
+        TTK_ASSERT(changes.evicted_codes == std::vector<uint32_t>({1, 10, 11}));
+        TTK_ASSERT(changes.repacked_page_ixs == std::vector<uint32_t>({0}));
+        TTK_ASSERT(Contains(changes.relocated_codes, 12) && Contains(changes.relocated_codes, 13));
+
+        TOGL_PointU16   pos;
+        uint32_t        page_ix = 0;
+        TTK_ASSERT(cache.GetPlace(20, pos, page_ix) && page_ix == 0);
+
+        TTK_ASSERT(cache.GetFragmentation(0) == 0);
+        TTK_ASSERT(cache.GetFragmentation(1) == 0.25);
+
+        changes.Clear();
+        TTK_ASSERT(!cache.CompactPage(changes, 0.5));
+        TTK_ASSERT(cache.CompactPage(changes, 0.25));
+        TTK_ASSERT(changes.repacked_page_ixs == std::vector<uint32_t>({1}));
+        TTK_ASSERT(changes.relocated_codes.size() == 3);
+        TTK_ASSERT(cache.GetFragmentation(1) == 0);
+        TTK_ASSERT(cache.ToCounters().compaction_count == 2);
+
+        changes.Clear();
+        TTK_ASSERT(!cache.CompactPage(changes, 0.25));
+        TTK_ASSERT(changes.IsEmpty());
+    }
+    // more glyphs are evicted before repacking, so next insertions don't repack
+    {
+        TOGL_GlyphCache         cache;
+        TOGL_GlyphCacheChanges  changes;
+        cache.Reset(TOGL_FONT_ATLAS_PACKER_ID_SKYLINE, 32, 32, 1);
+
+        for (uint32_t code = 1; code <= 16; ++code) TTK_ASSERT(cache.Insert(code, 8, 8, false, changes));
+        TTK_ASSERT(changes.IsEmpty());
+
+        cache.NextFrame();
+
+        TTK_ASSERT(cache.Insert(20, 16, 8, false, changes));
+        TTK_ASSERT(changes.evicted_codes == std::vector<uint32_t>({1, 2, 3, 4}));
+        TTK_ASSERT(changes.repacked_page_ixs == std::vector<uint32_t>({0}));
+        TTK_ASSERT(changes.relocated_codes.size() == 12);
+        TTK_ASSERT(changes.reused_places.empty());
+
+        changes.Clear();
+        TTK_ASSERT(cache.Insert(21, 16, 8, false, changes));
+        TTK_ASSERT(changes.IsEmpty());
+        TTK_ASSERT(cache.ToCounters().compaction_count == 1);
+        TTK_ASSERT(cache.GetGlyphCount() == 14);
+    }
+}
+
+void TestTOGL_MetricsFontLayout() {
+    const std::vector<uint8_t>  data = MakeTestTrueTypeFont();
+    const TOGL_FontInfo         font_info("", 100, TOGL_FONT_SIZE_UNIT_ID_PIXELS, TOGL_FONT_STYLE_ID_NORMAL, TOGL_FONT_CHAR_SET_ID_ENGLISH, 2, 3);
+
+    TOGL_MetricsFont font;
+    font.Load(data.data(), data.size(), font_info);
+    TTK_ASSERT_M(font.IsOk(), font.GetErrMsg());
+
+    const TOGL_FontMetrics& metrics = font;
+
+    TOGL_TextDrawer text_drawer;
+    TTK_ASSERT(text_drawer.GetTextSize(metrics, "A A").width == 100 + 2 + 25 + 2 + 100);
+    TTK_ASSERT(text_drawer.GetTextSize(metrics, "A A").height == 100);
+
+    TOGL_TextAdjuster text_adjuster;
+    text_adjuster.SetLineWrapWidth(150);
+
+    const TOGL_FineText adjusted_text = text_adjuster.AdjustText(metrics, TOGL_FineText(L"AA A"));
+    TTK_ASSERT(text_drawer.GetTextSize(metrics, adjusted_text).height > 100);
+}
+
+void TestTOGL_FindDuplicateGlyphs() {
+    auto MakeGlyph = [](uint32_t code, int16_t x, uint16_t width, uint16_t height, uint8_t alpha) {
+        TOGL_RasterizedGlyph glyph;
+        glyph.code          = code;
+        glyph.width         = width + 2;
+        glyph.bitmap.x      = x;
+        glyph.bitmap.width  = width;
+        glyph.bitmap.height = height;
+        glyph.bitmap.alphas.assign(size_t(width) * height, alpha);
+        glyph.bitmap_hash   = TOGL_HashGlyphBitmap(glyph.bitmap);
+        return glyph;
+    };
+
+    // hash
+    {
+        const TOGL_RasterizedGlyph a = MakeGlyph('a', 0, 5, 7, 200);
+
+        TTK_ASSERT(TOGL_HashGlyphBitmap(a.bitmap) == MakeGlyph('b', 3, 5, 7, 200).bitmap_hash);    // position isn't hashed
+        TTK_ASSERT(TOGL_HashGlyphBitmap(a.bitmap) != MakeGlyph('c', 0, 7, 5, 200).bitmap_hash);
+        TTK_ASSERT(TOGL_HashGlyphBitmap(a.bitmap) != MakeGlyph('d', 0, 5, 7, 201).bitmap_hash);
+
+        TOGL_RasterizedGlyph e = a;
+        e.bitmap.alphas.back() = 0;
+        TTK_ASSERT(TOGL_HashGlyphBitmap(a.bitmap) != TOGL_HashGlyphBitmap(e.bitmap));
+    }
+
+    // find
+    {
+        std::vector<TOGL_RasterizedGlyph> glyphs;
+        glyphs.push_back(MakeGlyph(' ',     0, 0, 0, 0));       // 0, without visible pixels
+        glyphs.push_back(MakeGlyph(0x00A0,  0, 0, 0, 0));       // 1, without visible pixels
+        glyphs.push_back(MakeGlyph('A',     1, 6, 8, 255));     // 2
+        glyphs.push_back(MakeGlyph('B',     1, 6, 8, 128));     // 3
+        glyphs.push_back(MakeGlyph(0x0391,  2, 6, 8, 255));     // 4, Greek Alpha looks like 'A'
+        glyphs.push_back(MakeGlyph(0x0410,  1, 6, 8, 255));     // 5, Cyrillic A looks like 'A'
+        glyphs.push_back(MakeGlyph(0x0412,  1, 6, 8, 128));     // 6, Cyrillic Ve looks like 'B'
+        glyphs.push_back(MakeGlyph('C',     1, 8, 6, 255));     // 7, other size
+
+        // the same hash, but different content
+        glyphs.push_back(MakeGlyph('D',     1, 6, 8, 64));      // 8
+        glyphs.back().bitmap_hash = glyphs[2].bitmap_hash;
+
+        const std::vector<uint32_t> original_ixs = TOGL_FindDuplicateGlyphs(glyphs);
+
+        const std::vector<uint32_t> expected = {0, 1, 2, 3, 2, 2, 3, 7, 8};
+        TTK_ASSERT(original_ixs == expected);
+    }
+
+    TTK_ASSERT(TOGL_FindDuplicateGlyphs({}).empty());
+}
+
+void TestTOGL_BMFont() {
+    const std::string text = 
+        "info face=\"Some Font\" size=-32 bold=0 italic=0 charset=\"\" unicode=1 stretchH=100 smooth=1 aa=1 padding=0,0,0,0 spacing=1,1\r\n"
+        "common lineHeight=32 base=26 scaleW=64 scaleH=32 pages=2 packed=0 alphaChnl=0 redChnl=4 greenChnl=4 blueChnl=4\r\n"
+        "page id=0 file=\"font_0.tga\"\r\n"
+        "page id=1 file=\"font_1.tga\"\r\n"
+        "chars count=3\r\n"
+        "char id=32   x=0  y=0  width=0  height=0  xoffset=0  yoffset=0  xadvance=8  page=0 chnl=15\r\n"
+        "char id=65   x=10 y=4  width=16 height=20 xoffset=-1 yoffset=6  xadvance=17 page=0 chnl=15\r\n"
+        "char id=1092 x=0  y=12 width=8  height=10 xoffset=1  yoffset=10 xadvance=10 page=1 chnl=15\r\n"
+        "kernings count=1\r\n"
+        "kerning first=65 second=65 amount=-1\r\n";
+
+    auto CheckFont = [](const TOGL_BMFont& font) {
+        TTK_ASSERT(font.face == "Some Font");
+        TTK_ASSERT(font.size == -32);
+        TTK_ASSERT(font.line_height == 32);
+        TTK_ASSERT(font.base == 26);
+        TTK_ASSERT(font.page_width == 64);
+        TTK_ASSERT(font.page_height == 32);
+        TTK_ASSERT(font.alpha_channel == 0);
+        TTK_ASSERT(font.page_file_names.size() == 2);
+        if (font.page_file_names.size() == 2) {
+            TTK_ASSERT(font.page_file_names[0] == "font_0.tga");
+            TTK_ASSERT(font.page_file_names[1] == "font_1.tga");
+        }
+        TTK_ASSERT(font.chars.size() == 3);
+        if (font.chars.size() == 3) {
+            const TOGL_BMFont::Char& c = font.chars[1];
+            TTK_ASSERT(c.code == 'A' && c.x == 10 && c.y == 4 && c.width == 16 && c.height == 20);
+            TTK_ASSERT(c.x_offset == -1 && c.y_offset == 6 && c.x_advance == 17 && c.page_ix == 0);
+            TTK_ASSERT(font.chars[2].code == 0x0444 && font.chars[2].page_ix == 1);
+        }
+    };
+
+    // text format
+    {
+        TOGL_BMFont font;
+        TTK_ASSERT(font.Decode((const uint8_t*)text.data(), text.size()));
+        CheckFont(font);
+
+        // glyph data
+        if (font.chars.size() == 3) {
+            const TOGL_GlyphData glyph_data = font.MakeGlyphData(font.chars[1]);
+            TTK_ASSERT(glyph_data.width == 17);
+            TTK_ASSERT(glyph_data.quad_x == -1);
+            TTK_ASSERT(glyph_data.quad_y == 32 - 6 - 20);
+            TTK_ASSERT(glyph_data.quad_width == 16 && glyph_data.quad_height == 20);
+            TTK_ASSERT(glyph_data.x1 == 10 / 64.0 && glyph_data.x2 == 26 / 64.0);
+            TTK_ASSERT(glyph_data.y1 == 8 / 32.0 && glyph_data.y2 == 28 / 32.0);
+        }
+
+        std::string packed = text;
+        packed.replace(packed.find("packed=0"), 8, "packed=1");
+        TTK_ASSERT(!font.Decode((const uint8_t*)packed.data(), packed.size()));
+        TTK_ASSERT(font.chars.empty());
+
+        std::string broken = text;
+        broken.replace(broken.find("x=10"), 4, "x=1a");
+        TTK_ASSERT(!font.Decode((const uint8_t*)broken.data(), broken.size()));
+
+        // page size out of range
+        for (const char* page_width : {"scaleW=0 ", "scaleW=-64 ", "scaleW=65536 "}) {
+            std::string wrong_size = text;
+            wrong_size.replace(wrong_size.find("scaleW=64 "), 10, page_width);
+            TTK_ASSERT(!font.Decode((const uint8_t*)wrong_size.data(), wrong_size.size()));
+        }
+
+        // page index of char is 8 bit
+        std::string too_many_pages = text;
+        too_many_pages.replace(too_many_pages.find("pages=2"), 7, "pages=257");
+        TTK_ASSERT(!font.Decode((const uint8_t*)too_many_pages.data(), too_many_pages.size()));
+
+        std::string negative_pages = text;
+        negative_pages.replace(negative_pages.find("pages=2"), 7, "pages=-1");
+        TTK_ASSERT(!font.Decode((const uint8_t*)negative_pages.data(), negative_pages.size()));
+
+        // glyph image exceeding page
+        for (const char* rect : {"x=50 y=4  width=16", "x=10 y=14 width=16"}) {
+            std::string exceeding = text;
+            exceeding.replace(exceeding.find("x=10 y=4  width=16"), 18, rect);
+            TTK_ASSERT(font.Decode((const uint8_t*)exceeding.data(), exceeding.size()));
+            TTK_ASSERT(font.chars.size() == 2);
+            if (font.chars.size() == 2) TTK_ASSERT(font.chars[0].code == ' ' && font.chars[1].code == 0x0444);
+        }
+
+        std::string max_pages = text;
+        max_pages.replace(max_pages.find("pages=2"), 7, "pages=256");
+        TTK_ASSERT(font.Decode((const uint8_t*)max_pages.data(), max_pages.size()));
+        TTK_ASSERT(font.page_file_names.size() == TOGL_BMFont::MAX_PAGE_COUNT);
+
+        const std::string not_font = "Some text.";
+        TTK_ASSERT(!font.Decode((const uint8_t*)not_font.data(), not_font.size()));
+        TTK_ASSERT(!font.Decode(nullptr, 0));
+    }
+
+    // binary format
+    {
+        std::vector<uint8_t> data = {'B', 'M', 'F', 3};
+
+        auto PutU8  = [&data](uint8_t value) { data.push_back(value); };
+        auto PutU16 = [&data](uint16_t value) { data.push_back(uint8_t(value)); data.push_back(uint8_t(value >> 8)); };
+        auto PutU32 = [&data](uint32_t value) { for (int ix = 0; ix < 4; ++ix) data.push_back(uint8_t(value >> (ix * 8))); };
+        auto PutStr = [&data](const std::string& str) { data.insert(data.end(), str.begin(), str.end()); data.push_back(0); };
+
+        PutU8(1); PutU32(14 + 10);
+        PutU16(uint16_t(-32)); PutU8(0); PutU8(0); PutU16(100); PutU8(1); PutU32(0); PutU8(1); PutU8(1); PutU8(0);
+        PutStr("Some Font");
+
+        PutU8(2); PutU32(15);
+        PutU16(32); PutU16(26); PutU16(64); PutU16(32); PutU16(2); PutU8(0); PutU8(0); PutU8(4); PutU8(4); PutU8(4);
+
+        PutU8(3); PutU32(2 * 11);
+        PutStr("font_0.tga");
+        PutStr("font_1.tga");
+
+        PutU8(4); PutU32(3 * 20);
+        PutU32(32);     PutU16(0);  PutU16(0);  PutU16(0);  PutU16(0);  PutU16(0);              PutU16(0);  PutU16(8);  PutU8(0); PutU8(15);
+        PutU32(65);     PutU16(10); PutU16(4);  PutU16(16); PutU16(20); PutU16(uint16_t(-1));   PutU16(6);  PutU16(17); PutU8(0); PutU8(15);
+        PutU32(1092);   PutU16(0);  PutU16(12); PutU16(8);  PutU16(10); PutU16(1);              PutU16(10); PutU16(10); PutU8(1); PutU8(15);
+
+        PutU8(5); PutU32(10);
+        PutU32(65); PutU32(65); PutU16(uint16_t(-1));
+
+        TOGL_BMFont font;
+        TTK_ASSERT(font.Decode(data.data(), data.size()));
+        CheckFont(font);
+
+        TTK_ASSERT(!font.Decode(data.data(), data.size() - 1));
+
+        std::vector<uint8_t> other_version = data;
+        other_version[3] = 2;
+        TTK_ASSERT(!font.Decode(other_version.data(), other_version.size()));
+
+        // 'pages' field of 'common' block (offset: header 4 + info block 5 + 24 + common block header 5 + 8)
+        std::vector<uint8_t> too_many_pages = data;
+        too_many_pages[46] = uint8_t(257);
+        too_many_pages[47] = uint8_t(257 >> 8);
+        TTK_ASSERT(!font.Decode(too_many_pages.data(), too_many_pages.size()));
+
+        // 'width' field of 'common' block
+        std::vector<uint8_t> zero_width = data;
+        zero_width[42] = 0;
+        zero_width[43] = 0;
+        TTK_ASSERT(!font.Decode(zero_width.data(), zero_width.size()));
+    }
+
+    // page image
+    {
+        TOGL_BMFont font;
+        font.page_width     = 3;
+        font.page_height    = 2;
+
+        auto MakeHeader = [](uint8_t image_type, uint8_t pixel_size, uint16_t width, uint16_t height, bool is_top_first) {
+            std::vector<uint8_t> header(18, 0);
+            header[2]   = image_type;
+            header[12]  = uint8_t(width);
+            header[14]  = uint8_t(height);
+            header[16]  = pixel_size;
+            header[17]  = is_top_first ? 0x20 : 0;
+            return header;
+        };
+
+        uint8_t alphas[6] = {};
+
+        // uncompressed grayscale, first row is top row
+        std::vector<uint8_t> gray = MakeHeader(3, 8, 3, 2, true);
+        gray.insert(gray.end(), {1, 2, 3, 4, 5, 6});
+        TTK_ASSERT(font.DecodePage(gray.data(), gray.size(), alphas));
+        TTK_ASSERT(alphas[0] == 4 && alphas[2] == 6 && alphas[3] == 1 && alphas[5] == 3);
+
+        TTK_ASSERT(!font.DecodePage(gray.data(), gray.size() - 1, alphas));
+
+        std::vector<uint8_t> other_size = MakeHeader(3, 8, 2, 3, true);
+        other_size.insert(other_size.end(), {1, 2, 3, 4, 5, 6});
+        TTK_ASSERT(!font.DecodePage(other_size.data(), other_size.size(), alphas));
+
+        // RLE 32 bit (BGRA), first row is bottom row, coverage in alpha channel
+        std::vector<uint8_t> rle = MakeHeader(10, 32, 3, 2, false);
+        rle.insert(rle.end(), {0x80 | 2, 255, 255, 255, 10});                         // run of 3 pixels
+        rle.insert(rle.end(), {2, 255, 255, 255, 20, 255, 255, 255, 30, 9, 9, 9, 40});  // 3 raw pixels
+        TTK_ASSERT(font.DecodePage(rle.data(), rle.size(), alphas));
+        TTK_ASSERT(alphas[0] == 10 && alphas[2] == 10 && alphas[3] == 20 && alphas[5] == 40);
+
+        // coverage in red channel
+        font.alpha_channel = 4;
+        TTK_ASSERT(font.DecodePage(rle.data(), rle.size(), alphas));
+        TTK_ASSERT(alphas[0] == 255 && alphas[5] == 9);
+
+        TTK_ASSERT(!font.DecodePage(rle.data(), rle.size() - 1, alphas));
+
+        std::vector<uint8_t> color_mapped = MakeHeader(1, 8, 3, 2, false);
+        color_mapped.insert(color_mapped.end(), {1, 2, 3, 4, 5, 6});
+        TTK_ASSERT(!font.DecodePage(color_mapped.data(), color_mapped.size(), alphas));
+    }
+}
+
+// Metrics font, which glyphs in bold style are wider.
+class TestTOGL_StyledMetricsFont : public TOGL_MetricsFont {
+public:
+    TOGL_SizeU GetGlyphSize(uint32_t code, TOGL_FontStyleId style) const override {
+        TOGL_SizeU size = TOGL_MetricsFont::GetGlyphSize(code);
+        if (style == TOGL_FONT_STYLE_ID_BOLD && size.width) size.width += 10;
+        return size;
+    }
+};
+
+void TestTOGL_TextStyle() {
+    // element
+    {
+        TOGL_FineTextElementContainer container(TOGL_FONT_STYLE_ID_BOLD);
+        TTK_ASSERT(container.GetTypeId() == TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE);
+        TTK_ASSERT(container.GetTextStyle() == TOGL_FONT_STYLE_ID_BOLD);
+
+        const TOGL_FineTextElementContainer copy = container;
+        TTK_ASSERT(copy.GetTextStyle() == TOGL_FONT_STYLE_ID_BOLD);
+
+        container.SetTextStyle(TOGL_FONT_STYLE_ID_ITALIC);
+        TTK_ASSERT(container.GetTextStyle() == TOGL_FONT_STYLE_ID_ITALIC);
+        TTK_ASSERT(copy.GetTextStyle() == TOGL_FONT_STYLE_ID_BOLD);
+
+        container.SetText(L"A");
+        TTK_ASSERT(container.GetTypeId() == TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT);
+        TTK_ASSERT(container.GetTextStyle() == TOGL_FONT_STYLE_ID_NORMAL);
+
+        TOGL_FineText fine_text;
+        fine_text.Append(TOGL_FONT_STYLE_ID_BOLD);
+        fine_text.Append(L"A");
+        TTK_ASSERT(fine_text.ToElementContainers().size() == 2);
+        TTK_ASSERT(fine_text.ToElementContainers()[0].GetTextStyle() == TOGL_FONT_STYLE_ID_BOLD);
+    }
+
+    // metrics
+    {
+        const std::vector<uint8_t>  data = MakeTestTrueTypeFont();
+        const TOGL_FontInfo         font_info("", 100, TOGL_FONT_SIZE_UNIT_ID_PIXELS, TOGL_FONT_STYLE_ID_NORMAL, TOGL_FONT_CHAR_SET_ID_ENGLISH, 2, 3);
+
+        TestTOGL_StyledMetricsFont font;
+        font.Load(data.data(), data.size(), font_info);
+        TTK_ASSERT_M(font.IsOk(), font.GetErrMsg());
+
+        const TOGL_FontMetrics& metrics = font;
+        TTK_ASSERT(metrics.GetGlyphSize('A').width == 100);
+        TTK_ASSERT(metrics.GetGlyphSize('A', TOGL_FONT_STYLE_ID_BOLD).width == 110);
+        TTK_ASSERT(metrics.GetGlyphCountInWidth(L"AAA", 220, TOGL_FONT_STYLE_ID_NORMAL) == 2);
+        TTK_ASSERT(metrics.GetGlyphCountInWidth(L"AAA", 220, TOGL_FONT_STYLE_ID_BOLD) == 1);
+
+        TOGL_TextDrawer text_drawer;
+
+        TOGL_FineText fine_text;
+        fine_text.Append(L"A");
+        fine_text.Append(TOGL_FONT_STYLE_ID_BOLD);
+        fine_text.Append(L"A");
+        fine_text.Append(TOGL_FONT_STYLE_ID_NORMAL);
+        fine_text.Append(L"A");
+        TTK_ASSERT(text_drawer.GetTextSize(metrics, fine_text).width == 100 + 2 + 110 + 2 + 100);
+
+        // bold run does not fit in line, where normal would
+        TOGL_TextAdjuster text_adjuster;
+        text_adjuster.SetLineWrapWidth(210);
+
+        const TOGL_FineText normal_text = text_adjuster.AdjustText(metrics, TOGL_FineText(L"AA"));
+        TTK_ASSERT(text_drawer.GetTextSize(metrics, normal_text).height == 100);
+
+        const TOGL_FineText bold_text = text_adjuster.AdjustText(metrics, TOGL_FineText(TOGL_FONT_STYLE_ID_BOLD, L"AA"));
+        TTK_ASSERT(text_drawer.GetTextSize(metrics, bold_text).height > 100);
+
+        // plain metrics font ignores style
+        TOGL_MetricsFont plain_font;
+        plain_font.Load(data.data(), data.size(), font_info);
+        const TOGL_FontMetrics& plain_metrics = plain_font;
+        TTK_ASSERT(plain_metrics.GetGlyphSize('A', TOGL_FONT_STYLE_ID_BOLD).width == 100);
+        TTK_ASSERT(text_drawer.GetTextSize(plain_metrics, fine_text).width == 100 + 2 + 100 + 2 + 100);
+    }
+}
+
+void TestTOGL_GlyphBatch() {
+    // Fonts are only keys of groups here.
+    TOGL_Font font1;
+    TOGL_Font font2;
+
+    TOGL_GlyphBatch batch;
+    TTK_ASSERT(batch.IsEmpty());
+    TTK_ASSERT(batch.GetGroupCount() == 0);
+
+    batch.SetColor({255, 0, 0, 255});
+    batch.AddQuad(&font1, 1, 0, 0, 10, 20, 0.0f, 0.0f, 0.5f, 0.5f, 0);
+    batch.AddQuad(&font1, 2, 10, 0, 20, 20, 0.5f, 0.5f, 1.0f, 1.0f, 0);
+    batch.SetColor({0, 255, 0, 255});
+    batch.AddQuad(&font1, 1, 20, 0, 30, 20, 0.0f, 0.0f, 0.5f, 0.5f, 0);
+    batch.AddQuad(&font2, 1, 30, 0, 40, 20, 0.0f, 0.0f, 0.5f, 0.5f, 0);
+
+    TTK_ASSERT(!batch.IsEmpty());
+    TTK_ASSERT(batch.GetQuadCount() == 4);
+    TTK_ASSERT(batch.GetGroupCount() == 3);
+
+    const std::vector<TOGL_GlyphBatch::Group>& groups = batch.ToGroups();
+    TTK_ASSERT(groups.size() == 3);
+    TTK_ASSERT(groups[0].font == &font1 && groups[0].tex_obj == 1 && groups[0].vertices.size() == 8);
+    TTK_ASSERT(groups[1].font == &font1 && groups[1].tex_obj == 2 && groups[1].vertices.size() == 4);
+    TTK_ASSERT(groups[2].font == &font2 && groups[2].tex_obj == 1 && groups[2].vertices.size() == 4);
+
+    // corners of quad, counter-clockwise from (x1, y1)
+    const TOGL_GlyphBatch::Vertex* vertices = groups[1].vertices.data();
+    TTK_ASSERT(vertices[0].x == 10 && vertices[0].y == 0  && vertices[0].tex_x == 0.5f && vertices[0].tex_y == 0.5f);
+    TTK_ASSERT(vertices[1].x == 20 && vertices[1].y == 0  && vertices[1].tex_x == 1.0f && vertices[1].tex_y == 0.5f);
+    TTK_ASSERT(vertices[2].x == 20 && vertices[2].y == 20 && vertices[2].tex_x == 1.0f && vertices[2].tex_y == 1.0f);
+    TTK_ASSERT(vertices[3].x == 10 && vertices[3].y == 20 && vertices[3].tex_x == 0.5f && vertices[3].tex_y == 1.0f);
+
+    TTK_ASSERT(groups[0].vertices[0].color.r == 255 && groups[0].vertices[0].color.g == 0);
+    TTK_ASSERT(groups[0].vertices[4].color.r == 0 && groups[0].vertices[4].color.g == 255);
+
+    // groups are kept for next frame
+    batch.Clear();
+    TTK_ASSERT(batch.IsEmpty());
+    TTK_ASSERT(batch.GetGroupCount() == 0);
+    TTK_ASSERT(batch.ToGroups().size() == 3);
+
+    batch.AddQuad(&font2, 1, 0, 0, 10, 20, 0.0f, 0.0f, 0.5f, 0.5f, 0);
+    TTK_ASSERT(batch.GetGroupCount() == 1);
+    TTK_ASSERT(batch.ToGroups().size() == 3);
+
+    // unused groups are removed
+    batch.Clear();
+    TTK_ASSERT(batch.ToGroups().size() == 1);
+    TTK_ASSERT(batch.ToGroups()[0].font == &font2);
+
+    // pending glyphs aren't quads
+    batch.SetColor({0, 0, 255, 255});
+    batch.AddPendingGlyph(&font1, &font2, 10, 20, 'a', TOGL_ORIGIN_ID_LEFT_TOP, 2);
+    TTK_ASSERT(batch.IsEmpty());
+    TTK_ASSERT(batch.GetGroupCount() == 0);
+    TTK_ASSERT(batch.ToPendingGlyphs().size() == 1);
+    if (batch.ToPendingGlyphs().size() == 1) {
+        const TOGL_GlyphBatch::PendingGlyph& pending_glyph = batch.ToPendingGlyphs()[0];
+        TTK_ASSERT(pending_glyph.font == &font1 && pending_glyph.owner == &font2);
+        TTK_ASSERT(pending_glyph.x == 10 && pending_glyph.y == 20 && pending_glyph.code == 'a');
+        TTK_ASSERT(pending_glyph.origin_id == TOGL_ORIGIN_ID_LEFT_TOP && pending_glyph.scale == 2);
+        TTK_ASSERT(pending_glyph.color.b == 255);
+    }
+
+    TTK_ASSERT(batch.TakePendingGlyphs().size() == 1);
+    TTK_ASSERT(batch.ToPendingGlyphs().empty());
+
+    batch.AddPendingGlyph(&font1, &font1, 0, 0, 'b', TOGL_ORIGIN_ID_LEFT_BOTTOM, 1);
+    batch.Clear();
+    TTK_ASSERT(batch.ToPendingGlyphs().empty());
+}
+
+void TestTOGL_StaticText() {
+    // font revision
+    {
+        TOGL_Font font;
+        TOGL_Font fallback_font;
+
+        uint64_t revision = font.GetRevision();
+
+        font.Unload();
+        TTK_ASSERT(font.GetRevision() != revision);
+        revision = font.GetRevision();
+
+        font.SetFallbackFonts({&fallback_font});
+        TTK_ASSERT(font.GetRevision() != revision);
+        revision = font.GetRevision();
+
+        // font from fallback chain
+        fallback_font.Unload();
+        TTK_ASSERT(font.GetRevision() != revision);
+        revision = font.GetRevision();
+
+        TTK_ASSERT(font.GetRevision() == revision);
+    }
+
+    // rebuild only when inputs change (font isn't loaded, so nothing is uploaded)
+    {
+        TOGL_Font font;
+
+        TOGL_StaticText static_text;
+        TTK_ASSERT(static_text.IsBuildNeeded());
+        TTK_ASSERT(static_text.ToFont() == nullptr);
+
+        static_text.SetFont(font);
+        static_text.SetText("Some text.");
+        static_text.Build();
+        TTK_ASSERT(!static_text.IsBuildNeeded());
+        TTK_ASSERT(static_text.GetBuildCount() == 1);
+        TTK_ASSERT(static_text.GetDrawCallCount() == 0);
+        TTK_ASSERT(static_text.GetSize().width == 0);
+
+        static_text.Build();
+        TTK_ASSERT(static_text.GetBuildCount() == 1);
+
+        // the same values
+        static_text.SetFont(font);
+        static_text.SetColor({255, 255, 255, 255});
+        static_text.SetOrigin(TOGL_ORIGIN_ID_LEFT_BOTTOM);
+        static_text.SetLineWrapWidth(0);
+        static_text.SetNumberOfSpacesInTab(4);
+        TTK_ASSERT(!static_text.IsBuildNeeded());
+
+        static_text.SetColor({255, 0, 0, 255});
+        TTK_ASSERT(static_text.IsBuildNeeded());
+        static_text.Build();
+
+        static_text.SetOrigin(TOGL_ORIGIN_ID_LEFT_TOP);
+        TTK_ASSERT(static_text.IsBuildNeeded());
+        static_text.Build();
+
+        static_text.SetLineWrapWidth(100);
+        TTK_ASSERT(static_text.IsBuildNeeded());
+        static_text.Build();
+
+        static_text.SetText("Other text.");
+        TTK_ASSERT(static_text.IsBuildNeeded());
+        static_text.Build();
+        TTK_ASSERT(static_text.GetBuildCount() == 5);
+
+        // font has been reloaded
+        font.Unload();
+        TTK_ASSERT(static_text.IsBuildNeeded());
+        static_text.Build();
+        TTK_ASSERT(!static_text.IsBuildNeeded());
+
+        static_text.Release();
+        TTK_ASSERT(static_text.IsBuildNeeded());
+    }
+}
+
+void TestTOGL_GlyphInstance() {
+    static_assert(sizeof(TOGL_GlyphBatch::Instance) == 16, "Instance should have 16 bytes.");
+
+    TOGL_Font font;
+
+    TOGL_GlyphBatch batch;
+    TTK_ASSERT(!batch.IsInstanced());
+
+    batch.SetInstanced(true);
+    TTK_ASSERT(batch.IsInstanced());
+
+    batch.SetColor({255, 0, 0, 255});
+    TTK_ASSERT(batch.AddInstance(&font, 1, 10.4, -20.6, 64, 128.2, 12, 20, 3, false));
+    TTK_ASSERT(batch.AddInstance(&font, 1, 0, 0, 0, 0, TOGL_GlyphBatch::MAX_INSTANCE_SIZE, TOGL_GlyphBatch::MAX_INSTANCE_SIZE, TOGL_GlyphBatch::MAX_INSTANCE_LAYER, true));
+
+    TTK_ASSERT(batch.GetQuadCount() == 2);
+    TTK_ASSERT(batch.GetGroupCount() == 1);
+
+    const std::vector<TOGL_GlyphBatch::Group>& groups = batch.ToGroups();
+    TTK_ASSERT(groups.size() == 1);
+    TTK_ASSERT(groups[0].vertices.empty() && groups[0].instances.size() == 2);
+
+    // position is rounded to whole pixels
+    const TOGL_GlyphBatch::Instance& instance = groups[0].instances[0];
+    TTK_ASSERT(instance.x == 10 && instance.y == -21);
+    TTK_ASSERT(instance.tex_x == 64 && instance.tex_y == 128);
+    TTK_ASSERT((instance.size_layer & 0xFFF) == 12);
+    TTK_ASSERT(((instance.size_layer >> 12) & 0xFFF) == 20);
+    TTK_ASSERT(((instance.size_layer >> 24) & 0x7F) == 3);
+    TTK_ASSERT((instance.size_layer >> 31) == 0);
+    TTK_ASSERT(instance.color.r == 255 && instance.color.g == 0);
+
+    TTK_ASSERT(groups[0].instances[1].size_layer == 0xFFFFFFFF);
+
+    // values, which don't fit, are rejected
+    TTK_ASSERT(!batch.AddInstance(&font, 1, 40000, 0, 0, 0, 12, 20, 0, false));
+    TTK_ASSERT(!batch.AddInstance(&font, 1, 0, 0, -1, 0, 12, 20, 0, false));
+    TTK_ASSERT(!batch.AddInstance(&font, 1, 0, 0, 0, 0, TOGL_GlyphBatch::MAX_INSTANCE_SIZE + 1, 20, 0, false));
+    TTK_ASSERT(!batch.AddInstance(&font, 1, 0, 0, 0, 0, 12, 20, TOGL_GlyphBatch::MAX_INSTANCE_LAYER + 1, false));
+    TTK_ASSERT(batch.GetQuadCount() == 2);
+
+    // quads and instances of the same group are rendered by separate draw calls
+    batch.AddQuad(&font, 1, 0, 0, 10, 20, 0.0f, 0.0f, 0.5f, 0.5f, 0);
+    TTK_ASSERT(batch.GetQuadCount() == 3);
+    TTK_ASSERT(batch.GetGroupCount() == 2);
+    TTK_ASSERT(batch.ToGroups().size() == 1);
+
+    batch.Clear();
+    TTK_ASSERT(batch.IsEmpty() && batch.GetGroupCount() == 0);
+    TTK_ASSERT(batch.ToGroups().size() == 1 && batch.ToGroups()[0].instances.empty());
+    TTK_ASSERT(batch.IsInstanced());
+}
+
+void TestTOGL_GlyphRunCache() {
+    TOGL_Font font;
+
+    auto MakeRun = [&font](uint32_t quad_count, int end_x) {
+        TOGL_GlyphRunCache::Run run;
+        for (uint32_t ix = 0; ix < quad_count; ++ix) {
+            run.batch.AddQuad(&font, 1, float(ix * 10), 0, float(ix * 10 + 10), 20, 0.0f, 0.0f, 0.5f, 0.5f, 0);
+        }
+        run.end_pos     = {end_x, 0};
+        run.glyph_count = quad_count;
+        return run;
+    };
+
+    const std::vector<uint32_t> key1 = {1, 2, 3};
+    const std::vector<uint32_t> key2 = {1, 2, 4};
+    const std::vector<uint32_t> key3 = {5};
+    const std::vector<uint32_t> key4 = {1, 2, 5};
+    const std::vector<uint32_t> key5 = {1, 2, 6};
+
+    // find
+    {
+        TOGL_GlyphRunCache cache;
+        TTK_ASSERT(cache.GetMaxUnusedFrameCount() == TOGL_GlyphRunCache::DEFAULT_MAX_UNUSED_FRAME_COUNT);
+        TTK_ASSERT(cache.GetMemoryBudget() == TOGL_GlyphRunCache::DEFAULT_MEMORY_BUDGET);
+        TTK_ASSERT(cache.Find(key1) == nullptr);
+
+        TTK_ASSERT(cache.Add(key1, MakeRun(3, 30)));
+        TTK_ASSERT(cache.GetRunCount() == 1);
+        TTK_ASSERT(cache.GetMemorySize() > 0);
+
+        const TOGL_GlyphRunCache::Run* run = cache.Find(key1);
+        TTK_ASSERT(run != nullptr);
+        TTK_ASSERT(run->batch.GetQuadCount() == 3);
+        TTK_ASSERT(run->end_pos.x == 30 && run->end_pos.y == 0);
+        TTK_ASSERT(run->glyph_count == 3);
+
+        TTK_ASSERT(cache.Find(key2) == nullptr);
+
+        // replaced by run with the same key
+        TTK_ASSERT(cache.Add(key1, MakeRun(1, 10)));
+        TTK_ASSERT(cache.GetRunCount() == 1);
+        TTK_ASSERT(cache.Find(key1)->batch.GetQuadCount() == 1);
+
+        cache.Clear();
+        TTK_ASSERT(cache.GetRunCount() == 0 && cache.GetMemorySize() == 0);
+        TTK_ASSERT(cache.Find(key1) == nullptr);
+    }
+
+    // runs not used for more than max unused frame count are evicted
+    {
+        TOGL_GlyphRunCache cache;
+        cache.SetMaxUnusedFrameCount(2);
+
+        cache.Add(key1, MakeRun(1, 10));
+        cache.Add(key2, MakeRun(1, 10));
+
+        cache.NextFrame();
+        cache.NextFrame();
+        TTK_ASSERT(cache.GetRunCount() == 2);
+
+        TTK_ASSERT(cache.Find(key2) != nullptr);
+        cache.NextFrame();
+        TTK_ASSERT(cache.GetFrame() == 3);
+        TTK_ASSERT(cache.GetRunCount() == 1);
+        TTK_ASSERT(cache.GetEvictionCount() == 1);
+        TTK_ASSERT(cache.Find(key1) == nullptr);
+        TTK_ASSERT(cache.Find(key2) != nullptr);
+    }
+
+    // least recently used runs are evicted when memory budget is exceeded
+    {
+        TOGL_GlyphRunCache cache;
+
+        cache.Add(key1, MakeRun(4, 40));
+        const size_t run_size = cache.GetMemorySize();
+        cache.Clear();
+
+        cache.SetMemoryBudget(run_size * 4);
+
+        cache.Add(key1, MakeRun(4, 40));
+        cache.NextFrame();
+        cache.Add(key2, MakeRun(4, 40));
+        cache.NextFrame();
+        cache.Add(key4, MakeRun(4, 40));
+        cache.NextFrame();
+        cache.Add(key5, MakeRun(4, 40));
+        cache.NextFrame();
+        TTK_ASSERT(cache.GetRunCount() == 4);
+        TTK_ASSERT(cache.GetEvictionCount() == 0);
+        TTK_ASSERT(cache.Find(key1) != nullptr);
+
+        // evicted in batch, until a quarter of budget is free
+        cache.Add(key3, MakeRun(4, 40));
+        TTK_ASSERT(cache.GetRunCount() == 3);
+        TTK_ASSERT(cache.GetEvictionCount() == 2);
+        TTK_ASSERT(cache.GetMemorySize() <= cache.GetMemoryBudget() - cache.GetMemoryBudget() / 4);
+        TTK_ASSERT(cache.Find(key1) != nullptr);
+        TTK_ASSERT(cache.Find(key2) == nullptr);
+        TTK_ASSERT(cache.Find(key4) == nullptr);
+        TTK_ASSERT(cache.Find(key5) != nullptr);
+        TTK_ASSERT(cache.Find(key3) != nullptr);
+
+        // run bigger than budget isn't kept
+        cache.SetMemoryBudget(run_size / 2);
+        TTK_ASSERT(cache.GetRunCount() == 0);
+        TTK_ASSERT(!cache.Add(key1, MakeRun(4, 40)));
+        TTK_ASSERT(cache.Find(key1) == nullptr);
+    }
+}
+
+// Metrics font, which counts glyph lookups.
+class TestTOGL_CountingMetricsFont : public TOGL_MetricsFont {
+public:
+    mutable uint32_t lookup_count = 0;
+
+    TOGL_SizeU GetGlyphSize(uint32_t code, TOGL_FontStyleId style) const override {
+        lookup_count += 1;
+        return TOGL_MetricsFont::GetGlyphSize(code);
+    }
+};
+
+void TestTOGL_TextCulling() {
+    TOGL_TextDrawer text_drawer;
+    TTK_ASSERT(text_drawer.ToStats().culled_line_count == 0 && text_drawer.ToStats().culled_glyph_count == 0);
+
+    text_drawer.SetClipArea({10, 20, 300, 400});
+    const TOGL_AreaI clip_area = text_drawer.GetClipArea();
+    TTK_ASSERT(clip_area.x == 10 && clip_area.y == 20 && clip_area.width == 300 && clip_area.height == 400);
+
+    // not loaded font renders nothing, so nothing is culled
+    TOGL_Font font;
+    text_drawer.SetCulling(true);
+    text_drawer.SetClipArea({0, 0, 100, 100});
+    text_drawer.RenderText(font, "Some text.\nNext line.");
+    TTK_ASSERT(text_drawer.ToStats().glyph_count == 0);
+    TTK_ASSERT(text_drawer.ToStats().culled_line_count == 0 && text_drawer.ToStats().culled_glyph_count == 0);
+
+    // Glyph 'A' is 100 x 100, distance between glyphs is 2, distance between lines is 3.
+    const std::vector<uint8_t>  data = MakeTestTrueTypeFont();
+    const TOGL_FontInfo         font_info("", 100, TOGL_FONT_SIZE_UNIT_ID_PIXELS, TOGL_FONT_STYLE_ID_NORMAL, TOGL_FONT_CHAR_SET_ID_ENGLISH, 2, 3);
+
+    TestTOGL_CountingMetricsFont metrics_font;
+    metrics_font.Load(data.data(), data.size(), font_info);
+    TTK_ASSERT_M(metrics_font.IsOk(), metrics_font.GetErrMsg());
+
+    const TOGL_FineText three_lines(L"AAA\nAAA\nAAA");
+
+    // without culling
+    {
+        text_drawer.Reset();
+        text_drawer.SetOrigin(TOGL_ORIGIN_ID_LEFT_TOP);
+        text_drawer.SetClipArea({0, 0, 10, 10});
+
+        TTK_ASSERT(text_drawer.AdvanceText(metrics_font, three_lines) == 9);
+        TTK_ASSERT(text_drawer.GetPos().x == 3 * 102 && text_drawer.GetPos().y == 2 * 103);
+        TTK_ASSERT(text_drawer.ToStats().culled_line_count == 0 && text_drawer.ToStats().culled_glyph_count == 0);
+    }
+
+    // culled lines are skipped without glyph lookup, except last line, which is measured
+    {
+        text_drawer.Reset();
+        text_drawer.ResetStats();
+        text_drawer.SetOrigin(TOGL_ORIGIN_ID_LEFT_TOP);
+        text_drawer.SetCulling(true);
+        text_drawer.SetClipArea({0, 110, 500, 50});     // crosses only second line (from 103 to 203)
+
+        metrics_font.lookup_count = 0;
+        TTK_ASSERT(text_drawer.AdvanceText(metrics_font, three_lines) == 3);
+        TTK_ASSERT(metrics_font.lookup_count == 3 + 3);
+        TTK_ASSERT(text_drawer.GetPos().x == 3 * 102 && text_drawer.GetPos().y == 2 * 103);
+        TTK_ASSERT(text_drawer.ToStats().culled_line_count == 2);
+        TTK_ASSERT(text_drawer.ToStats().culled_glyph_count == 6);
+
+        // the same position after text as without culling, when all is culled
+        text_drawer.SetPos(0, 0);
+        text_drawer.ResetStats();
+        text_drawer.SetClipArea({0, 1000, 500, 50});
+
+        metrics_font.lookup_count = 0;
+        TTK_ASSERT(text_drawer.AdvanceText(metrics_font, three_lines) == 0);
+        TTK_ASSERT(metrics_font.lookup_count == 3);
+        TTK_ASSERT(text_drawer.GetPos().x == 3 * 102 && text_drawer.GetPos().y == 2 * 103);
+        TTK_ASSERT(text_drawer.ToStats().culled_line_count == 3);
+        TTK_ASSERT(text_drawer.ToStats().culled_glyph_count == 9);
+    }
+
+    // glyphs on left and right of clip area
+    {
+        text_drawer.Reset();
+        text_drawer.ResetStats();
+        text_drawer.SetOrigin(TOGL_ORIGIN_ID_LEFT_TOP);
+        text_drawer.SetCulling(true);
+        text_drawer.SetClipArea({150, 0, 100, 500});    // from 150 to 250
+
+        // Glyphs are at 0, 102, 204 and 306. First glyph ends before clip area. Last glyph starts after it.
+        metrics_font.lookup_count = 0;
+        TTK_ASSERT(text_drawer.AdvanceText(metrics_font, TOGL_FineText(L"AAAA\nAAAA")) == 4);
+        TTK_ASSERT(metrics_font.lookup_count == 3 + 4);
+        TTK_ASSERT(text_drawer.GetPos().x == 4 * 102 && text_drawer.GetPos().y == 103);
+        TTK_ASSERT(text_drawer.ToStats().culled_line_count == 0);
+        TTK_ASSERT(text_drawer.ToStats().culled_glyph_count == 4);
+    }
+
+    // bottom-left origin, lines go down
+    {
+        text_drawer.Reset();
+        text_drawer.ResetStats();
+        text_drawer.SetOrigin(TOGL_ORIGIN_ID_LEFT_BOTTOM);
+        text_drawer.SetCulling(true);
+        text_drawer.SetPos(0, 500);
+        text_drawer.SetClipArea({0, 0, 500, 450});      // below first line (from 500 to 600)
+
+        TTK_ASSERT(text_drawer.AdvanceText(metrics_font, three_lines) == 6);
+        TTK_ASSERT(text_drawer.GetPos().x == 3 * 102 && text_drawer.GetPos().y == 500 - 2 * 103);
+        TTK_ASSERT(text_drawer.ToStats().culled_line_count == 1);
+        TTK_ASSERT(text_drawer.ToStats().culled_glyph_count == 3);
+    }
+}
+
+// Hidden window with OpenGL rendering context, so fonts can be loaded without running application.
+class TestTOGL_GL_Context {
+public:
+    TestTOGL_GL_Context() {
+        m_window_handle = CreateWindowExW(0, L"STATIC", L"", WS_POPUP, 0, 0, 1, 1, NULL, NULL, GetModuleHandleW(NULL), NULL);
+        if (m_window_handle) m_device_context_handle = GetDC(m_window_handle);
+
+        if (m_device_context_handle) {
+            PIXELFORMATDESCRIPTOR pfd = {};
+            pfd.nSize           = sizeof(PIXELFORMATDESCRIPTOR);
+            pfd.nVersion        = 1;
+            pfd.dwFlags         = PFD_DRAW_TO_WINDOW | PFD_SUPPORT_OPENGL | PFD_DOUBLEBUFFER;
+            pfd.iPixelType      = PFD_TYPE_RGBA;
+            pfd.cColorBits      = 24;
+            pfd.cAlphaBits      = 8;
+            pfd.iLayerType      = PFD_MAIN_PLANE;
+
+            const int pfi = ChoosePixelFormat(m_device_context_handle, &pfd);
+            if (pfi && SetPixelFormat(m_device_context_handle, pfi, &pfd)) {
+                m_rendering_context_handle = wglCreateContext(m_device_context_handle);
+            }
+        }
+
+        m_is_ok = m_rendering_context_handle && wglMakeCurrent(m_device_context_handle, m_rendering_context_handle);
+    }
+
+    ~TestTOGL_GL_Context() {
+        if (m_rendering_context_handle) {
+            wglMakeCurrent(NULL, NULL);
+            wglDeleteContext(m_rendering_context_handle);
+        }
+        if (m_device_context_handle) ReleaseDC(m_window_handle, m_device_context_handle);
+        if (m_window_handle) DestroyWindow(m_window_handle);
+    }
+
+    bool IsOk() const {
+        return m_is_ok;
+    }
+
+private:
+    HWND    m_window_handle             = NULL;
+    HDC     m_device_context_handle     = NULL;
+    HGLRC   m_rendering_context_handle  = NULL;
+    bool    m_is_ok                     = false;
+};
+
+void TestTOGL_BatchText() {
+    TestTOGL_GL_Context context;
+    TTK_ASSERT(context.IsOk());
+    if (!context.IsOk()) return;
+
+    // Glyph 'A' is on page 0, glyph 0x0444 is on page 1.
+    const std::string file_name         = "batch_text_test.fnt";
+    const std::string page_file_names[] = {"batch_text_test_0.tga", "batch_text_test_1.tga"};
+    const std::string text = 
+        "info face=\"Some Font\" size=-32 bold=0 italic=0 charset=\"\" unicode=1 stretchH=100 smooth=1 aa=1 padding=0,0,0,0 spacing=1,1\r\n"
+        "common lineHeight=32 base=26 scaleW=64 scaleH=32 pages=2 packed=0 alphaChnl=0 redChnl=4 greenChnl=4 blueChnl=4\r\n"
+        "page id=0 file=\"batch_text_test_0.tga\"\r\n"
+        "page id=1 file=\"batch_text_test_1.tga\"\r\n"
+        "chars count=3\r\n"
+        "char id=32   x=0  y=0  width=0  height=0  xoffset=0  yoffset=0  xadvance=8  page=0 chnl=15\r\n"
+        "char id=65   x=10 y=4  width=16 height=20 xoffset=-1 yoffset=6  xadvance=17 page=0 chnl=15\r\n"
+        "char id=1092 x=0  y=12 width=8  height=10 xoffset=1  yoffset=10 xadvance=10 page=1 chnl=15\r\n";
+
+    TTK_ASSERT(TOGL_SaveToFile(file_name, (const uint8_t*)text.data(), text.size()));
+
+    // uncompressed 8 bit grayscale TGA, rows from top
+    for (const std::string& page_file_name : page_file_names) {
+        std::vector<uint8_t> page(18 + 64 * 32, 255);
+        std::fill(page.begin(), page.begin() + 18, 0);
+        page[2]     = 3;
+        page[12]    = 64;
+        page[14]    = 32;
+        page[16]    = 8;
+        page[17]    = 0x20;
+        TTK_ASSERT(TOGL_SaveToFile(page_file_name, page.data(), page.size()));
+    }
+
+    TOGL_Font font;
+    font.LoadBMFont(file_name);
+    TTK_ASSERT_M(font.IsOk(), font.GetErrMsg());
+
+    remove(file_name.c_str());
+    for (const std::string& page_file_name : page_file_names) remove(page_file_name.c_str());
+
+    if (!font.IsLoaded()) return;
+
+    const TOGL_FineText fine_text(L"A\u0444A");
+
+    TOGL_TextDrawer text_drawer;
+    text_drawer.SetOrigin(TOGL_ORIGIN_ID_LEFT_TOP);
+
+    // quads are grouped by atlas page
+    {
+        text_drawer.SetPos(100, 200);
+
+        TOGL_GlyphBatch batch;
+        text_drawer.BatchText(font, fine_text, batch);
+        TTK_ASSERT(batch.GetQuadCount() == 3);
+        TTK_ASSERT(batch.GetGroupCount() == 2);
+        TTK_ASSERT(text_drawer.GetPos().x == 100 + 17 + 10 + 17 && text_drawer.GetPos().y == 200);
+
+        const std::vector<TOGL_GlyphBatch::Group>& groups = batch.ToGroups();
+        TTK_ASSERT(groups.size() == 2);
+        if (groups.size() == 2) {
+            const std::vector<TOGL_GlyphBatch::Vertex>& page0_vertices = groups[0].vertices;
+            const std::vector<TOGL_GlyphBatch::Vertex>& page1_vertices = groups[1].vertices;
+
+            TTK_ASSERT(groups[0].font == &font && groups[1].font == &font);
+            TTK_ASSERT(groups[0].tex_obj != 0 && groups[1].tex_obj != 0 && groups[0].tex_obj != groups[1].tex_obj);
+            TTK_ASSERT(page0_vertices.size() == 8 && page1_vertices.size() == 4);
+
+            // Quad of 'A' has 16 x 20 pixels and is offset by (-1, 6) from pen position.
+            if (page0_vertices.size() == 8) {
+                TTK_ASSERT(page0_vertices[0].x == 99 && page0_vertices[0].y == 206);
+                TTK_ASSERT(page0_vertices[2].x == 115 && page0_vertices[2].y == 226);
+                TTK_ASSERT(page0_vertices[4].x == 99 + 27 && page0_vertices[4].y == 206);
+                TTK_ASSERT(page0_vertices[6].x == 115 + 27 && page0_vertices[6].y == 226);
+            }
+
+            // Quad of 0x0444 has 8 x 10 pixels and is offset by (1, 10) from pen position.
+            if (page1_vertices.size() == 4) {
+                TTK_ASSERT(page1_vertices[0].x == 118 && page1_vertices[0].y == 210);
+                TTK_ASSERT(page1_vertices[2].x == 126 && page1_vertices[2].y == 220);
+            }
+        }
+    }
+
+    // batched and not batched rendering lay out the same glyphs, but batched rendering needs only one draw call per atlas page
+    {
+        text_drawer.ResetStats();
+        text_drawer.SetPos(100, 200);
+        text_drawer.RenderText(font, fine_text);
+
+        const TOGL_PointI batched_end_pos = text_drawer.GetPos();
+        TTK_ASSERT(text_drawer.ToStats().glyph_count == 3);
+        TTK_ASSERT(text_drawer.ToStats().draw_call_count == 2);
+
+        text_drawer.SetBatching(false);
+        text_drawer.ResetStats();
+        text_drawer.SetPos(100, 200);
+        text_drawer.RenderText(font, fine_text);
+
+        TTK_ASSERT(text_drawer.ToStats().glyph_count == 3);
+        TTK_ASSERT(text_drawer.ToStats().draw_call_count == 3);
+        TTK_ASSERT(text_drawer.GetPos().x == batched_end_pos.x && text_drawer.GetPos().y == batched_end_pos.y);
+    }
+}
+
+void TestTOGL_FontLoadAsync() {
+    TestTOGL_GL_Context context;
+    TTK_ASSERT(context.IsOk());
+    if (!context.IsOk()) return;
+
+    // Glyphs are rasterized on CPU, into small pages, so atlas has many pages.
+    TOGL_FontLoadOptions options;
+    options.rasterizer  = TOGL_FONT_RASTERIZER_ID_TRUE_TYPE;
+    options.page_width  = 64;
+    options.page_height = 64;
+
+    const TOGL_FontInfo small_font_info("Courier New", 16, TOGL_FONT_SIZE_UNIT_ID_PIXELS, TOGL_FONT_STYLE_ID_NORMAL, TOGL_FONT_CHAR_SET_ID_ENGLISH);
+    const TOGL_FontInfo big_font_info("Courier New", 32, TOGL_FONT_SIZE_UNIT_ID_PIXELS, TOGL_FONT_STYLE_ID_NORMAL, TOGL_FONT_CHAR_SET_ID_ENGLISH);
+
+    // generator
+    {
+        TOGL_FontDataGenerator generator;
+        generator.BeginGenerate(big_font_info, options);
+        TTK_ASSERT_M(generator.IsOk(), generator.GetErrMsg());
+
+        // Nothing is uploaded until pages are composed by background thread. Then each call uploads one page, since time budget is already exceeded.
+        uint32_t    uploaded_page_count = 0;
+        bool        is_finished         = false;
+
+        while (generator.IsOk() && !is_finished) {
+            is_finished = generator.ContinueGenerate(0);
+
+            const uint32_t count = generator.GetUploadedPageCount();
+            if (count != 0) TTK_ASSERT(count == uploaded_page_count + 1);
+
+            uploaded_page_count = count;
+        }
+
+        const TOGL_FontData data = generator.EndGenerate();
+        TTK_ASSERT_M(generator.IsOk(), generator.GetErrMsg());
+        TTK_ASSERT(data.stats.page_count > 1);
+        TTK_ASSERT(uploaded_page_count == data.stats.page_count);
+        TTK_ASSERT(data.tex_objs.size() == data.stats.page_count);
+        TTK_ASSERT(data.stats.texture_size == uint64_t(64) * 64 * 4 * data.stats.page_count);
+
+        // Pages are uploaded through pixel buffer object (OpenGL 2.1), otherwise from client memory. Either way, page of glyph has its coverage.
+        const TOGL_GlyphData& glyph_data = data.glyphs.Get('A');
+        TTK_ASSERT(glyph_data.tex_obj != 0 && !glyph_data.is_pending);
+
+        std::vector<uint8_t> pixels(64 * 64 * 4);
+
+        glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);
+        glBindTexture(GL_TEXTURE_2D, glyph_data.tex_obj);
+        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glPopClientAttrib();
+
+        uint32_t covered_pixel_count = 0;
+        for (size_t ix = 0; ix < pixels.size(); ix += 4) {
+            if (pixels[ix + 3] != 0) covered_pixel_count += 1;
+        }
+        TTK_ASSERT(covered_pixel_count > 0);
+
+        glDeleteTextures(GLsizei(data.tex_objs.size()), data.tex_objs.data());
+    }
+
+    // font
+    {
+        TOGL_Font font;
+        font.Load(small_font_info, options);
+        TTK_ASSERT_M(font.IsOk(), font.GetErrMsg());
+
+        const uint32_t small_height = font.GetHeight();
+
+        font.LoadAsync(big_font_info, options);
+        TTK_ASSERT_M(font.IsOk(), font.GetErrMsg());
+        TTK_ASSERT(font.IsLoadingAsync());
+
+        TOGL_TextDrawer text_drawer;
+        uint32_t        update_count = 0;
+
+        while (font.IsLoadingAsync()) {
+            // Current font is rendered until new font replaces it.
+            TTK_ASSERT(font.IsLoaded());
+            TTK_ASSERT(font.GetHeight() == small_height);
+
+            text_drawer.ResetStats();
+            text_drawer.RenderText(font, "ABC");
+            TTK_ASSERT(text_drawer.ToStats().glyph_count == 3);
+
+            const bool is_replaced = font.UpdateLoading(0);
+            TTK_ASSERT(is_replaced == !font.IsLoadingAsync());
+
+            update_count += 1;
+        }
+
+        TTK_ASSERT_M(font.IsOk(), font.GetErrMsg());
+        TTK_ASSERT(font.IsLoaded());
+        TTK_ASSERT(font.GetHeight() > small_height);
+        TTK_ASSERT(font.ToStats().page_count > 1);
+        TTK_ASSERT(update_count >= font.ToStats().page_count);
+        TTK_ASSERT(font.ToStats().texture_size == uint64_t(64) * 64 * 4 * font.ToStats().page_count);
+        TTK_ASSERT(!font.UpdateLoading(0));
+
+        text_drawer.ResetStats();
+        text_drawer.RenderText(font, "ABC");
+        TTK_ASSERT(text_drawer.ToStats().glyph_count == 3);
+    }
+}
+
+void TestTOGL_TextureArrayFont() {
+    TestTOGL_GL_Context context;
+    TTK_ASSERT(context.IsOk());
+    if (!context.IsOk()) return;
+
+    // Glyphs are rasterized on CPU, into small pages, so atlas has many pages.
+    TOGL_FontLoadOptions options;
+    options.rasterizer          = TOGL_FONT_RASTERIZER_ID_TRUE_TYPE;
+    options.page_width          = 64;
+    options.page_height         = 64;
+    options.is_texture_array    = true;
+
+    const TOGL_FontInfo font_info("Courier New", 16, TOGL_FONT_SIZE_UNIT_ID_PIXELS, TOGL_FONT_STYLE_ID_NORMAL, TOGL_FONT_CHAR_SET_ID_ENGLISH);
+
+    std::string all_glyphs_text;
+    for (char c = '!'; c <= '~'; ++c) all_glyphs_text += c;
+
+    // generator, pages are layers of one texture
+    {
+        TOGL_FontDataGenerator generator;
+        const TOGL_FontData data = generator.Generate(font_info, options);
+        TTK_ASSERT_M(generator.IsOk(), generator.GetErrMsg());
+
+        TTK_ASSERT(data.options.is_texture_array);
+        TTK_ASSERT(data.tex_array_obj != 0);
+        TTK_ASSERT(data.tex_objs.empty());
+        TTK_ASSERT(data.stats.page_count > 1);
+
+        std::set<uint16_t> layers;
+
+        for (const uint32_t code : data.glyphs.GetCodes()) {
+            const TOGL_GlyphData& glyph_data = data.glyphs.Get(code);
+
+            if (glyph_data.quad_width != 0 && glyph_data.quad_height != 0) {
+                TTK_ASSERT(glyph_data.tex_obj == data.tex_array_obj);
+                TTK_ASSERT(glyph_data.layer < data.stats.page_count);
+                layers.insert(glyph_data.layer);
+            }
+        }
+        TTK_ASSERT(layers.size() == data.stats.page_count);
+
+        glDeleteTextures(1, &data.tex_array_obj);
+    }
+
+    // Glyphs from all pages are rendered with one texture binding, so batched text needs one draw call.
+    {
+        TOGL_Font font;
+        font.Load(font_info, options);
+        TTK_ASSERT_M(font.IsOk(), font.GetErrMsg());
+        TTK_ASSERT(font.ToLoadOptions().is_texture_array);
+        TTK_ASSERT(font.ToStats().page_count > 1);
+
+        TOGL_TextDrawer text_drawer;
+        text_drawer.RenderText(font, all_glyphs_text);
+        TTK_ASSERT(text_drawer.ToStats().glyph_count == all_glyphs_text.size());
+        TTK_ASSERT(text_drawer.ToStats().draw_call_count == 1);
+    }
+
+    // Lazy font doesn't create texture array program, so pages fall back to separate 2D textures.
+    {
+        TOGL_FontLoadOptions lazy_options = options;
+        lazy_options.is_lazy = true;
+
+        TOGL_Font font;
+        font.Load(font_info, lazy_options);
+        TTK_ASSERT_M(font.IsOk(), font.GetErrMsg());
+        TTK_ASSERT(!font.ToLoadOptions().is_texture_array);
+
+        TOGL_TextDrawer text_drawer;
+        text_drawer.RenderText(font, all_glyphs_text);
+        TTK_ASSERT(text_drawer.ToStats().glyph_count == all_glyphs_text.size());
+        TTK_ASSERT(font.ToStats().page_count > 1);
+        TTK_ASSERT(text_drawer.ToStats().draw_call_count == font.ToStats().page_count);
+    }
+}
+
+void TestTOGL_AlphaFont() {
+    TestTOGL_GL_Context context;
+    TTK_ASSERT(context.IsOk());
+    if (!context.IsOk()) return;
+
+    TOGL_FontLoadOptions options;
+    options.rasterizer  = TOGL_FONT_RASTERIZER_ID_TRUE_TYPE;
+    options.format      = TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8;
+    options.page_width  = 64;
+    options.page_height = 64;
+
+    const TOGL_FontInfo font_info("Courier New", 16, TOGL_FONT_SIZE_UNIT_ID_PIXELS, TOGL_FONT_STYLE_ID_NORMAL, TOGL_FONT_CHAR_SET_ID_ENGLISH);
+
+    // generator, one byte per texel
+    {
+        TOGL_FontDataGenerator generator;
+        const TOGL_FontData data = generator.Generate(font_info, options);
+        TTK_ASSERT_M(generator.IsOk(), generator.GetErrMsg());
+
+        TTK_ASSERT(data.stats.page_count > 0);
+        TTK_ASSERT(data.tex_objs.size() == data.stats.page_count);
+        TTK_ASSERT(data.stats.texture_size == uint64_t(64) * 64 * data.stats.page_count);
+
+        for (const GLuint tex_obj : data.tex_objs) {
+            GLint internal_format = 0;
+
+            glBindTexture(GL_TEXTURE_2D, tex_obj);
+            glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &internal_format);
+            TTK_ASSERT(internal_format == GL_ALPHA8);
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+
+        glDeleteTextures(GLsizei(data.tex_objs.size()), data.tex_objs.data());
+    }
+
+    // font
+    {
+        TOGL_Font font;
+        font.Load(font_info, options);
+        TTK_ASSERT_M(font.IsOk(), font.GetErrMsg());
+        TTK_ASSERT(font.ToStats().texture_size == uint64_t(64) * 64 * font.ToStats().page_count);
+
+        TOGL_TextDrawer text_drawer;
+        text_drawer.RenderText(font, "ABC");
+        TTK_ASSERT(text_drawer.ToStats().glyph_count == 3);
+
+        // Pages are saved as white pixels with alpha.
+        TTK_ASSERT(font.SaveAsBMP());
+
+        const std::string   file_name   = font.ToFontInfo().name + ".bmp";
+        const size_t        header_size = sizeof(BITMAPFILEHEADER) + sizeof(BITMAPV5HEADER);
+
+        TOGL_MappedFile file;
+        TTK_ASSERT(file.Open(file_name));
+        TTK_ASSERT(file.GetSize() == header_size + 64 * 64 * 4);
+
+        if (file.GetSize() == header_size + 64 * 64 * 4) {
+            const uint8_t* data = file.ToData();
+            TTK_ASSERT(data[0] == 'B' && data[1] == 'M');
+
+            // Channels are stored in order alpha, blue, green, red.
+            uint32_t covered_pixel_count    = 0;
+            bool     is_white               = true;
+
+            for (size_t ix = header_size; ix < file.GetSize(); ix += 4) {
+                if (data[ix] != 0) covered_pixel_count += 1;
+                if (data[ix + 1] != 255 || data[ix + 2] != 255 || data[ix + 3] != 255) is_white = false;
+            }
+            TTK_ASSERT(covered_pixel_count > 0);
+            TTK_ASSERT(is_white);
+        }
+        file.Close();
+
+        remove(file_name.c_str());
+        for (uint32_t ix = 1; ix < font.ToStats().page_count; ++ix) {
+            remove((font.ToFontInfo().name + " (" + std::to_string(ix + 1) + ").bmp").c_str());
+        }
+    }
+}
+
+//--------------------------------------------------------------------------
+
+// Compares glyph lookup in TOGL_GlyphTable against lookup in std::map (used previously by TOGL_FontData).
+// Also checks that lookup of basic multilingual plane doesn't slow down, when table contains supplementary planes,
+// and measures lookup through fallback chain (resolution table followed by glyph table of resolved font).
+void BenchmarkGlyphLookup() {
+    enum : uint32_t { LOOKUP_COUNT = 20000000 };
+
+    TOGL_GlyphTable                     table;
+    std::map<uint32_t, TOGL_GlyphData>  map;
+
+    for (const auto& range : TOGL_GetUnicodeRanges(TOGL_FONT_CHAR_SET_ID_ENGLISH)) {
+        for (uint32_t code = range.from; code <= range.to; ++code) {
+            TOGL_GlyphData glyph_data = {};
+            glyph_data.width = uint16_t(code % 16 + 1);
+
+            table.Set(code, glyph_data);
+            map[code] = glyph_data;
+        }
+    }
+    table.ResolveFallback({TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER}, {});
+
+    // Mostly ascii text with some missing glyphs.
+    std::vector<uint32_t> text;
+    for (uint32_t ix = 0; ix < 4096; ++ix) {
+        text.push_back((ix % 37 == 0) ? (0x0400 + ix % 64) : (0x20 + (ix * 7919) % 95));
+    }
+
+    auto Measure = [&](const char* name, auto find) {
+        uint64_t sum = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (uint32_t ix = 0; ix < LOOKUP_COUNT; ++ix) {
+            sum += find(text[ix % text.size()]).width;
+        }
+        const auto stop = std::chrono::steady_clock::now();
+
+        const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / LOOKUP_COUNT;
+        printf("%-12s %8.3f ns/lookup (checksum=%llu)\n", name, ns, (unsigned long long)sum);
+        return ns;
+    };
+
+    const double map_ns = Measure("std::map", [&map](uint32_t code) -> const TOGL_GlyphData& {
+        auto it = map.find(code);
+
+        if (it == map.end()) it = map.find(TOGL_UNICODE_WHITE_SQUARE);
+        if (it == map.end()) it = map.find(TOGL_UNICODE_REPLACEMENT_CHARACTER);
+        return it->second;
+    });
+
+    const double table_ns = Measure("GlyphTable", [&table](uint32_t code) -> const TOGL_GlyphData& {
+        return table.Get(code);
+    });
+
+    printf("speedup: %.2fx\n", map_ns / table_ns);
+
+    // Emoji and CJK Unified Ideographs Extension B.
+    TOGL_GlyphTable table_smp = table;
+    for (uint32_t code = 0x1F300; code <= 0x1F6FF; ++code)  table_smp.Set(code, table.Get('a'));
+    for (uint32_t code = 0x20000; code <= 0x20FFF; ++code)  table_smp.Set(code, table.Get('b'));
+
+    const double table_smp_ns = Measure("GlyphTable+SMP", [&table_smp](uint32_t code) -> const TOGL_GlyphData& {
+        return table_smp.Get(code);
+    });
+
+    printf("bmp lookup with supplementary planes: %.2fx\n", table_smp_ns / table_ns);
+
+    // Mostly ascii text with emoji.
+    for (uint32_t ix = 0; ix < text.size(); ++ix) {
+        if (ix % 5 == 0) text[ix] = 0x1F300 + (ix * 7919) % 0x400;
+    }
+
+    const double table_mixed_ns = Measure("GlyphTable+SMP (mixed text)", [&table_smp](uint32_t code) -> const TOGL_GlyphData& {
+        return table_smp.Get(code);
+    });
+
+    // Emoji are in second font of chain.
+    TOGL_GlyphTable table_emoji;
+    for (uint32_t code = 0x1F300; code <= 0x1F6FF; ++code) table_emoji.Set(code, table.Get('a'));
+
+    const TOGL_GlyphTable* chain[] = {&table, &table_emoji};
+
+    const double chain_ns = Measure("GlyphTable+chain (mixed text)", [&](uint32_t code) -> const TOGL_GlyphData& {
+        const uint8_t font_ix = table.ToFontIx(code, [&table_emoji](uint32_t code) {
+            return uint8_t(table_emoji.Has(code) ? 1 : 0);
+        });
+        return chain[font_ix]->Get(code);
+    });
+
+    printf("lookup through fallback chain: %.2fx\n", chain_ns / table_mixed_ns);
+    fflush(stdout);
+}
+
+// Measures speed of built-in TrueType rasterizer (glyphs per second) for few font sizes. 
+// Uses first found system font, or test font if there is none.
+// Loads system font, or test font if there is none.
+std::shared_ptr<TOGL_TrueTypeFont> LoadBenchmarkTrueTypeFont() {
+    const char* paths[] = {
+        "C:/Windows/Fonts/arial.ttf",
+        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
+        "/usr/share/fonts/TTF/DejaVuSans.ttf",
+    };
+
+    std::vector<uint8_t> data;
+    for (const char* path : paths) {
+        FILE* file = fopen(path, "rb");
+        if (file) {
+            uint8_t buffer[4096];
+            size_t  count;
+            while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) data.insert(data.end(), buffer, buffer + count);
+            fclose(file);
+
+            printf("font: %s\n", path);
+            break;
+        }
+    }
+    if (data.empty()) {
+        data = MakeTestTrueTypeFont();
+        printf("font: test font\n");
+    }
+
+    std::shared_ptr<TOGL_TrueTypeFont> font = std::make_shared<TOGL_TrueTypeFont>();
+    if (!font->Load(data.data(), data.size())) {
+        printf("error: %s\n", font->GetErrMsg().c_str());
+        return nullptr;
+    }
+    return font;
+}
+
+void BenchmarkTrueTypeRasterizer() {
+    std::shared_ptr<TOGL_TrueTypeFont> font = LoadBenchmarkTrueTypeFont();
+    if (!font) return;
+
+    std::vector<uint32_t> codes;
+    for (uint32_t code = 0x20; code <= 0xFFFF; ++code) {
+        if (font->HasGlyph(code)) codes.push_back(code);
+    }
+    if (codes.empty()) codes.push_back('A');
+
+    for (const uint32_t font_height : {12u, 24u, 48u, 96u}) {
+        TOGL_TrueTypeGlyphSource source(font, font_height);
+        TOGL_GlyphBitmap bitmap;
+
+        uint64_t    pixel_count = 0;
+        uint32_t    glyph_count = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        auto stop = start;
+
+        // At least one second, or all glyphs.
+        do {
+            for (const uint32_t code : codes) {
+                source.GetGlyphBitmap(code, bitmap);
+                pixel_count += bitmap.alphas.size();
+            }
+            glyph_count += uint32_t(codes.size());
+            stop = std::chrono::steady_clock::now();
+        } while (std::chrono::duration<double>(stop - start).count() < 1.0);
+
+        const double seconds = std::chrono::duration<double>(stop - start).count();
+        printf("height=%3u px  %10.0f glyphs/s  %8.2f Mpx/s\n", font_height, glyph_count / seconds, pixel_count / seconds / 1e6);
+    }
+    fflush(stdout);
+}
+
+// Measures CPU stage of atlas generation (TOGL_RasterizeGlyphs) for different number of threads.
+void BenchmarkGlyphRasterization() {
+    std::shared_ptr<TOGL_TrueTypeFont> font = LoadBenchmarkTrueTypeFont();
+    if (!font) return;
+
+    const std::vector<TOGL_UnicodeRange> ranges = {{0x0020, 0xFFFF}};
+
+    std::vector<uint32_t> thread_counts;
+    for (uint32_t thread_count = 1; thread_count < std::thread::hardware_concurrency(); thread_count *= 2) thread_counts.push_back(thread_count);
+    thread_counts.push_back(std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1);
+
+    printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+
+    for (const bool is_sdf : {false, true}) {
+        for (const uint32_t font_height : {16u, 48u}) {
+            double single_thread_rate = 0;
+
+            for (const uint32_t thread_count : thread_counts) {
+                TOGL_TrueTypeGlyphSource source(font, font_height);
+
+                uint64_t glyph_count = 0;
+
+                const auto start = std::chrono::steady_clock::now();
+                auto stop = start;
+
+                // At least one second.
+                do {
+                    glyph_count += TOGL_RasterizeGlyphs(source, ranges, thread_count, is_sdf ? 4 : 0).size();
+                    stop = std::chrono::steady_clock::now();
+                } while (std::chrono::duration<double>(stop - start).count() < 1.0);
+
+                const double seconds    = std::chrono::duration<double>(stop - start).count();
+                const double rate       = glyph_count / seconds;
+
+                if (thread_count == 1) single_thread_rate = rate;
+
+                printf("sdf=%d height=%2u px threads=%2u  %10.0f glyphs/s  x%.2f\n", is_sdf, font_height, thread_count, rate, rate / single_thread_rate);
+            }
+        }
+    }
+    fflush(stdout);
+}
+
 int main(int argc, char *argv[]) {
     std::set<std::string> flags;
 
@@ -698,6 +2571,18 @@ int main(int argc, char *argv[]) {
         TOGL_LogInfo("Some message 4.");
         return 0;
 
+    } else if (IsFlag("BENCHMARK_GLYPH_LOOKUP")) {
+        BenchmarkGlyphLookup();
+        return 0;
+
+    } else if (IsFlag("BENCHMARK_TRUE_TYPE_RASTERIZER")) {
+        BenchmarkTrueTypeRasterizer();
+        return 0;
+
+    } else if (IsFlag("BENCHMARK_GLYPH_RASTERIZATION")) {
+        BenchmarkGlyphRasterization();
+        return 0;
+
     } else {
         TTK_ADD_TEST(TestTOGL_Point, 0);
         TTK_ADD_TEST(TestTOGL_Size, 0);
@@ -705,9 +2590,34 @@ int main(int argc, char *argv[]) {
         TTK_ADD_TEST(TestTOGL_ASCII_ToUTF16, 0);
         TTK_ADD_TEST(TestTOGL_ToUTF16, 0);
         TTK_ADD_TEST(TestTOGL_ToUTF8, 0);
+        TTK_ADD_TEST(TestTOGL_ToUTF32, 0);
         TTK_ADD_TEST(TestTOGL_Log, 0);
         TTK_ADD_TEST(TestTOGL_Split, 0);
         TTK_ADD_TEST(TestTOGL_Color, 0);
+        TTK_ADD_TEST(TestTOGL_GlyphTable, 0);
+        TTK_ADD_TEST(TestTOGL_AtlasPacker, 0);
+        TTK_ADD_TEST(TestTOGL_FontCache, 0);
+        TTK_ADD_TEST(TestTOGL_TrueType, 0);
+        TTK_ADD_TEST(TestTOGL_DistanceField, 0);
+        TTK_ADD_TEST(TestTOGL_FontRegistry, 0);
+        TTK_ADD_TEST(TestTOGL_RasterizeGlyphs, 0);
+        TTK_ADD_TEST(TestTOGL_GlyphCache, 0);
+        TTK_ADD_TEST(TestTOGL_MetricsFont, 0);
+        TTK_ADD_TEST(TestTOGL_MetricsFontLayout, 0);
+        TTK_ADD_TEST(TestTOGL_UnicodeRangeSet, 0);
+        TTK_ADD_TEST(TestTOGL_FindDuplicateGlyphs, 0);
+        TTK_ADD_TEST(TestTOGL_CodePointRecord, 0);
+        TTK_ADD_TEST(TestTOGL_BMFont, 0);
+        TTK_ADD_TEST(TestTOGL_TextStyle, 0);
+        TTK_ADD_TEST(TestTOGL_GlyphBatch, 0);
+        TTK_ADD_TEST(TestTOGL_StaticText, 0);
+        TTK_ADD_TEST(TestTOGL_GlyphInstance, 0);
+        TTK_ADD_TEST(TestTOGL_GlyphRunCache, 0);
+        TTK_ADD_TEST(TestTOGL_TextCulling, 0);
+        TTK_ADD_TEST(TestTOGL_BatchText, 0);
+        TTK_ADD_TEST(TestTOGL_FontLoadAsync, 0);
+        TTK_ADD_TEST(TestTOGL_TextureArrayFont, 0);
+        TTK_ADD_TEST(TestTOGL_AlphaFont, 0);
         
         return !TTK_Run();
     }
@@ -0,0 +1,624 @@
+/**
+* @file TrivialOpenGL_Common.h
+* @author underwatergrasshopper
+*/
+
+#ifndef TRIVIALOPENGL_COMMON_H_
+#define TRIVIALOPENGL_COMMON_H_
+
+// Types and functions, which depend only on standard library (and on system file functions). Don't use OpenGL.
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN 
+#include <windows.h>
+#undef WIN32_LEAN_AND_MEAN 
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <string>
+#include <vector>
+#include <sstream>
+#include <iomanip>
+
+//==============================================================================
+// Declarations
+//==============================================================================
+
+// Disables copy ability of class.
+#define TOGL_NO_COPY(Class) \
+    Class(const Class&) = delete; \
+    Class& operator=(const Class&) = delete
+
+#define TOGL_CASE_STR(name) case name: return #name
+
+//------------------------------------------------------------------------------
+// TOGL_Point
+//------------------------------------------------------------------------------
+
+template <typename Type>
+struct TOGL_Point {
+    Type x;
+    Type y;
+
+    TOGL_Point() : x(Type()), y(Type()) {}
+
+    template<typename S_Type>
+    explicit TOGL_Point(const S_Type& s) : x(Type(s)), y(Type(s)) {}
+
+    template<typename X_Type, typename Y_Type>
+    TOGL_Point(const X_Type& x, const Y_Type& y) : x(Type(x)), y(Type(y)) {}
+
+    template <typename SizeType>
+    explicit TOGL_Point(const TOGL_Point<SizeType>& p) : x(Type(p.x)), y(Type(p.y)) {}
+
+    virtual ~TOGL_Point() {}
+};
+
+using TOGL_PointI16  = TOGL_Point<int16_t>;
+using TOGL_PointI    = TOGL_Point<int32_t>;
+using TOGL_PointI64  = TOGL_Point<int64_t>;
+
+using TOGL_PointU16  = TOGL_Point<uint16_t>;
+using TOGL_PointU    = TOGL_Point<uint32_t>;
+using TOGL_PointU64  = TOGL_Point<uint64_t>;
+
+using TOGL_PointF    = TOGL_Point<float>;
+using TOGL_PointD    = TOGL_Point<float>;
+
+template <typename Type>
+inline bool operator==(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
+    return l.x == r.x && l.y == r.y;
+}
+
+template <typename Type>
+inline bool operator!=(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
+    return l.x != r.x || l.y != r.y;
+}
+
+template <typename Type>
+inline bool operator>(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
+    return l.x > r.x && l.y > r.y;
+}
+
+template <typename Type>
+inline bool operator<(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
+    return l.x < r.x && l.y < r.y;
+}
+
+template <typename Type>
+inline bool operator>=(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
+    return l.x >= r.x && l.y >= r.y;
+}
+
+template <typename Type>
+inline bool operator<=(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
+    return l.x <= r.x && l.y <= r.y;
+}
+
+
+template <typename Type>
+inline TOGL_Point<Type> operator+(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
+    return {l.x + r.x, l.y + r.y};
+}
+
+template <typename Type>
+inline TOGL_Point<Type> operator-(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
+    return {l.x - r.x, l.y - r.y};
+}
+
+template <typename Type>
+inline TOGL_Point<Type> operator*(const TOGL_Point<Type>& l, const Type& r) {
+    return {l.x * r, l.y * r};
+}
+
+template <typename Type>
+inline TOGL_Point<Type> operator/(const TOGL_Point<Type>& l, const Type& r) {
+    return {l.x / r, l.y / r};
+}
+
+
+template <typename Type>
+inline TOGL_Point<Type>& operator+=(TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
+    l = l + r;
+    return l;
+}
+    
+template <typename Type>
+inline TOGL_Point<Type>& operator-=(TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
+    l = l - r;
+    return l;
+}
+    
+template <typename Type>
+inline TOGL_Point<Type>& operator*=(TOGL_Point<Type>& l, const Type& r) {
+    l = l * r;
+    return l;
+}
+    
+template <typename Type>
+inline TOGL_Point<Type>& operator/=(TOGL_Point<Type>& l, const Type& r) {
+    l = l / r;
+    return l;
+}
+
+//------------------------------------------------------------------------------
+// TOGL_Size
+//------------------------------------------------------------------------------
+
+template <typename Type>
+struct TOGL_Size {
+    Type width;
+    Type height;
+
+    TOGL_Size() : width(Type()), height(Type()) {}
+
+    template <typename S_Type>
+    explicit TOGL_Size(const S_Type& s) : width(Type(s)), height(Type(s)) {}
+
+    template <typename WidthType, typename HeightType>
+    TOGL_Size(const WidthType& width, const HeightType& height) : width(Type(width)), height(Type(height)) {}
+
+    template <typename SizeType>
+    explicit TOGL_Size(const TOGL_Size<SizeType>& s) : width(Type(s.width)), height(Type(s.height)) {}
+
+    virtual ~TOGL_Size() {}
+};
+
+using TOGL_SizeI16  = TOGL_Size<int16_t>;
+using TOGL_SizeI    = TOGL_Size<int32_t>;
+using TOGL_SizeI64  = TOGL_Size<int64_t>;
+
+using TOGL_SizeU16  = TOGL_Size<uint16_t>;
+using TOGL_SizeU    = TOGL_Size<uint32_t>;
+using TOGL_SizeU64  = TOGL_Size<uint64_t>;
+
+using TOGL_SizeF    = TOGL_Size<float>;
+using TOGL_SizeD    = TOGL_Size<float>;
+
+template <typename Type>
+inline bool operator==(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
+    return l.width == r.width && l.height == r.height;
+}
+
+template <typename Type>
+inline bool operator!=(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
+    return l.width != r.width || l.height != r.height;
+}
+
+template <typename Type>
+inline bool operator>(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
+    return l.width > r.width && l.height > r.height;
+}
+
+template <typename Type>
+inline bool operator<(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
+    return l.width < r.width && l.height < r.height;
+}
+
+template <typename Type>
+inline bool operator>=(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
+    return l.width >= r.width && l.height >= r.height;
+}
+
+template <typename Type>
+inline bool operator<=(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
+    return l.width <= r.width && l.height <= r.height;
+}
+
+
+template <typename Type>
+inline TOGL_Size<Type> operator+(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
+    return {l.width + r.width, l.height + r.height};
+}
+
+template <typename Type>
+inline TOGL_Size<Type> operator-(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
+    return {l.width - r.width, l.height - r.height};
+}
+
+template <typename Type>
+inline TOGL_Size<Type> operator*(const TOGL_Size<Type>& l, const Type& r) {
+    return {l.width * r, l.height * r};
+}
+
+template <typename Type>
+inline TOGL_Size<Type> operator/(const TOGL_Size<Type>& l, const Type& r) {
+    return {l.width / r, l.height / r};
+}
+
+
+template <typename Type>
+inline TOGL_Size<Type>& operator+=(TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
+    l = l + r;
+    return l;
+}
+
+template <typename Type>
+inline TOGL_Size<Type>& operator-=(TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
+    l = l - r;
+    return l;
+}
+
+template <typename Type>
+inline TOGL_Size<Type>& operator*=(TOGL_Size<Type>& l, const Type& r) {
+    l = l * r;
+    return l;
+}
+
+template <typename Type>
+inline TOGL_Size<Type>& operator/=(TOGL_Size<Type>& l, const Type& r) {
+    l = l / r;
+    return l;
+}
+
+//------------------------------------------------------------------------------
+// TOGL_Area
+//------------------------------------------------------------------------------
+
+template <typename PointType, typename SizeType = PointType>
+struct TOGL_Area {
+    PointType  x;
+    PointType  y;
+    SizeType   width;
+    SizeType   height;
+
+    TOGL_Area() : x(PointType()), y(PointType()), width(SizeType()), height(SizeType()) {}
+
+    TOGL_Area(const PointType& x, const PointType& y, const SizeType& width, const SizeType& height) : x(x), y(y), width(width), height(height) {}
+
+    template <typename PointType2, typename SizeType2 = PointType2>
+    explicit TOGL_Area(const TOGL_Area<PointType2, SizeType2>& area) : x(PointType(area.x)), y(PointType(area.y)), width(SizeType(area.width)), height(SizeType(area.height)) {}
+
+    TOGL_Area(const TOGL_Point<PointType>& pos, const TOGL_Size<SizeType>& size) : x(pos.x), y(pos.y), width(size.width), height(size.height) {}
+
+    explicit TOGL_Area(const TOGL_Point<PointType>& pos) : x(pos.x), y(pos.y), width(SizeType()), height(SizeType()) {}
+    explicit TOGL_Area(const TOGL_Size<SizeType>& size) : x(PointType()), y(PointType()), width(size.width), height(size.height) {}
+
+    void SetPos(const TOGL_Point<PointType>& pos) {  
+        x = pos.x;
+        y = pos.y;
+    }
+
+    void SetSize(const TOGL_Size<SizeType>& size) {  
+        width   = size.width;
+        height  = size.height;
+    }
+
+    TOGL_Point<PointType> GetPos() const { return TOGL_Point<PointType>(x, y); }
+    TOGL_Size<SizeType> GetSize() const { return TOGL_Size<SizeType>(width, height); }
+
+    bool IsIn(const TOGL_Point<PointType>& pos) const {
+        return TOGL_Point<PointType>(x, y) <= pos && pos < TOGL_Point<PointType>(x + width, y + height);
+    }
+
+    virtual ~TOGL_Area() {}
+};
+
+using TOGL_AreaI    = TOGL_Area<int32_t>;
+using TOGL_AreaI64  = TOGL_Area<int64_t>;
+
+using TOGL_AreaU    = TOGL_Area<uint32_t>;
+using TOGL_AreaU64  = TOGL_Area<uint64_t>;
+
+using TOGL_AreaF    = TOGL_Area<float>;
+using TOGL_AreaD    = TOGL_Area<float>;
+
+using TOGL_AreaIU   = TOGL_Area<int32_t, uint32_t>;
+using TOGL_AreaIU16 = TOGL_Area<int32_t, uint16_t>;
+
+template <typename PointType, typename SizeType = PointType>
+inline bool operator==(const TOGL_Area<PointType, SizeType>& l, const TOGL_Area<PointType, SizeType>& r) {
+    return l.x == r.x && l.y == r.y && l.width == r.width && l.height == r.height;
+}
+
+template <typename PointType, typename SizeType = PointType>
+inline bool operator!=(const TOGL_Area<PointType, SizeType>& l, const TOGL_Area<PointType, SizeType>& r) {
+    return l.x != r.x || l.y != r.y || l.width != r.width || l.height != r.height;
+}
+
+//------------------------------------------------------------------------------
+// TOGL_Color
+//------------------------------------------------------------------------------
+
+template <typename Type>
+struct TOGL_Color4 {
+    Type r;
+    Type g;
+    Type b;
+    Type a;
+
+    TOGL_Color4() : r(0), g(0), b(0), a(0) {}
+
+    template <typename TypeR, typename TypeG, typename TypeB, typename TypeA>
+    TOGL_Color4(const TypeR& r, const TypeG& g, const TypeB& b, const TypeA& a) : r(Type(r)), g(Type(g)), b(Type(b)), a(Type(a)) {}
+
+    Type* ToData() {
+        return (Type*)this;
+    }
+
+    const Type* ToData() const {
+        return (const Type*)this;
+    }
+};
+
+using TOGL_Color4U8 = TOGL_Color4<uint8_t>;
+
+//------------------------------------------------------------------------------
+// TOGL_Global
+//------------------------------------------------------------------------------
+
+// Makes global object of specified type in header-only library.
+template <typename Type>
+class TOGL_Global {
+public:
+    static Type& ToObject() { return sm_object; }
+private:
+    static Type sm_object;
+};
+
+template <typename Type>
+Type TOGL_Global<Type>::sm_object;
+
+//------------------------------------------------------------------------------
+// Conversion
+//------------------------------------------------------------------------------
+
+// Converts ascii string to utf-16 string.
+std::wstring TOGL_ASCII_ToUTF16(const std::string& text_ascii);
+
+// Converts utf-16 string to string of unicode code points (surrogate pairs are joined).
+// Unpaired surrogate is replaced by FFFD.
+std::u32string TOGL_ToUTF32(const std::wstring& text_utf16);
+
+// Returns number of utf-16 code units which starts character at index (1 or 2).
+uint32_t TOGL_GetUTF16_CharLength(const std::wstring& text_utf16, size_t index);
+
+// Decodes one character from utf-16 string at index.
+// Unpaired surrogate is decoded as FFFD.
+uint32_t TOGL_DecodeUTF16_Char(const std::wstring& text_utf16, size_t index);
+
+//------------------------------------------------------------------------------
+// File
+//------------------------------------------------------------------------------
+
+// Saves data to binary file. If file exists, then it's overwritten.
+// file_name        - Variable encoding format: UTF8.
+// Returns true if data was saved to file.
+bool TOGL_SaveToFile(const std::string& file_name, const uint8_t* data, size_t size);
+
+// Read-only file mapped to memory.
+class TOGL_MappedFile {
+public:
+    TOGL_MappedFile();
+    virtual ~TOGL_MappedFile();
+
+    // file_name    - Variable encoding format: UTF8.
+    // Returns true if file has been mapped.
+    bool Open(const std::string& file_name);
+    void Close();
+
+    bool IsOpen() const;
+
+    // Returns content of file or NULL if file isn't opened.
+    const uint8_t* ToData() const;
+    size_t GetSize() const;
+
+private:
+    TOGL_NO_COPY(TOGL_MappedFile);
+
+#ifdef _WIN32
+    HANDLE          m_file_handle;
+    HANDLE          m_mapping_handle;
+#else
+    int             m_file_descriptor;
+#endif
+    const uint8_t*  m_data;
+    size_t          m_size;
+};
+
+//------------------------------------------------------------------------------
+// String
+//------------------------------------------------------------------------------
+
+std::string TOGL_HexToStr(uint16_t value);
+std::vector<std::string> TOGL_Split(const std::string& text, char c);
+
+//==============================================================================
+// Definitions
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// Conversion
+//------------------------------------------------------------------------------
+
+inline std::wstring TOGL_ASCII_ToUTF16(const std::string& text_ascii) {
+    std::wstring text_utf16;
+    for (size_t index = 0; index < text_ascii.length(); ++index) text_utf16 += wchar_t(text_ascii[index]);
+    return text_utf16;
+}
+
+inline std::u32string TOGL_ToUTF32(const std::wstring& text_utf16) {
+    std::u32string text_utf32;
+    text_utf32.reserve(text_utf16.length());
+
+    for (size_t index = 0; index < text_utf16.length(); index += TOGL_GetUTF16_CharLength(text_utf16, index)) {
+        text_utf32 += char32_t(TOGL_DecodeUTF16_Char(text_utf16, index));
+    }
+    return text_utf32;
+}
+
+inline uint32_t TOGL_GetUTF16_CharLength(const std::wstring& text_utf16, size_t index) {
+    const uint32_t c = uint32_t(text_utf16[index]);
+    if (c >= 0xD800 && c <= 0xDBFF && (index + 1) < text_utf16.length()) {
+        const uint32_t next = uint32_t(text_utf16[index + 1]);
+        if (next >= 0xDC00 && next <= 0xDFFF) return 2;
+    }
+    return 1;
+}
+
+inline uint32_t TOGL_DecodeUTF16_Char(const std::wstring& text_utf16, size_t index) {
+    const uint32_t c = uint32_t(text_utf16[index]);
+    if (c < 0xD800 || c > 0xDFFF) return c;
+
+    if (TOGL_GetUTF16_CharLength(text_utf16, index) == 2) {
+        return 0x10000 + ((c - 0xD800) << 10) + (uint32_t(text_utf16[index + 1]) - 0xDC00);
+    }
+    return 0xFFFD;
+}
+
+//------------------------------------------------------------------------------
+// File
+//------------------------------------------------------------------------------
+
+#ifdef _WIN32
+
+// Converts utf-8 file name to utf-16, as required by wide versions of Windows file functions.
+inline std::wstring _TOGL_ToFileNameUTF16(const std::string& file_name) {
+    const int length = MultiByteToWideChar(CP_UTF8, 0, file_name.c_str(), -1, NULL, 0);
+    if (length <= 1) return L"";
+
+    std::wstring file_name_utf16(size_t(length - 1), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, file_name.c_str(), -1, &file_name_utf16[0], length);
+    return file_name_utf16;
+}
+
+#endif
+
+inline bool TOGL_SaveToFile(const std::string& file_name, const uint8_t* data, size_t size) {
+    FILE* file = NULL;
+#ifdef _WIN32
+    bool is_success = _wfopen_s(&file, _TOGL_ToFileNameUTF16(file_name).c_str(), L"wb") == 0 && file;
+#else
+    file = fopen(file_name.c_str(), "wb");
+    bool is_success = file != NULL;
+#endif
+
+    if (is_success) {
+        is_success = fwrite(data, 1, size, file) == size;
+        fclose(file);
+    }
+
+    return is_success;
+}
+
+inline TOGL_MappedFile::TOGL_MappedFile() {
+#ifdef _WIN32
+    m_file_handle       = INVALID_HANDLE_VALUE;
+    m_mapping_handle    = NULL;
+#else
+    m_file_descriptor   = -1;
+#endif
+    m_data              = NULL;
+    m_size              = 0;
+}
+
+inline TOGL_MappedFile::~TOGL_MappedFile() {
+    Close();
+}
+
+inline bool TOGL_MappedFile::Open(const std::string& file_name) {
+    Close();
+
+#ifdef _WIN32
+    m_file_handle = CreateFileW(_TOGL_ToFileNameUTF16(file_name).c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (m_file_handle != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER size = {};
+
+        if (GetFileSizeEx(m_file_handle, &size) && size.QuadPart > 0) {
+            m_mapping_handle = CreateFileMappingW(m_file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
+
+            if (m_mapping_handle != NULL) {
+                m_data = (const uint8_t*)MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0);
+                m_size = size_t(size.QuadPart);
+            }
+        }
+    }
+#else
+    m_file_descriptor = open(file_name.c_str(), O_RDONLY);
+
+    if (m_file_descriptor != -1) {
+        struct stat file_stat = {};
+
+        if (fstat(m_file_descriptor, &file_stat) == 0 && file_stat.st_size > 0) {
+            void* data = mmap(NULL, size_t(file_stat.st_size), PROT_READ, MAP_PRIVATE, m_file_descriptor, 0);
+
+            if (data != MAP_FAILED) {
+                m_data = (const uint8_t*)data;
+                m_size = size_t(file_stat.st_size);
+            }
+        }
+    }
+#endif
+
+    if (!m_data) Close();
+
+    return IsOpen();
+}
+
+inline void TOGL_MappedFile::Close() {
+#ifdef _WIN32
+    if (m_data)                                 UnmapViewOfFile(m_data);
+    if (m_mapping_handle != NULL)               CloseHandle(m_mapping_handle);
+    if (m_file_handle != INVALID_HANDLE_VALUE)  CloseHandle(m_file_handle);
+
+    m_file_handle       = INVALID_HANDLE_VALUE;
+    m_mapping_handle    = NULL;
+#else
+    if (m_data)                                 munmap((void*)m_data, m_size);
+    if (m_file_descriptor != -1)                close(m_file_descriptor);
+
+    m_file_descriptor   = -1;
+#endif
+    m_data              = NULL;
+    m_size              = 0;
+}
+
+inline bool TOGL_MappedFile::IsOpen() const {
+    return m_data != NULL;
+}
+
+inline const uint8_t* TOGL_MappedFile::ToData() const {
+    return m_data;
+}
+
+inline size_t TOGL_MappedFile::GetSize() const {
+    return m_size;
+}
+
+//------------------------------------------------------------------------------
+// String
+//------------------------------------------------------------------------------
+
+inline std::vector<std::string> TOGL_Split(const std::string& text, char c) {
+    std::string temp = text;
+    std::vector<std::string> list;
+
+    while (true) {
+        size_t pos = temp.find(c, 0);
+
+        if (pos == std::string::npos) {
+            list.push_back(temp);
+            break;
+        } else {
+            list.push_back(temp.substr(0, pos));
+            temp = temp.substr(pos + 1);
+        }
+    }
+    return list;
+}
+
+inline std::string TOGL_HexToStr(uint16_t value) {
+    std::stringstream stream;
+    stream << std::hex << std::setfill('0') << std::setw(4) << std::right << std::uppercase << value;
+    return stream.str();
+};
+
+#endif // TRIVIALOPENGL_COMMON_H_
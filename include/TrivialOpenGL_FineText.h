@@ -7,6 +7,7 @@
 #define TRIVIALOPENGL_FINETEXT_H_
 
 #include "TrivialOpenGL_Utility.h"
+#include "TrivialOpenGL_FontCore.h"
 
 //==============================================================================
 // Declarations
@@ -19,7 +20,8 @@
 enum TOGL_FineTextElementTypeId {
     TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT,
     TOGL_FINE_TEXT_ELEMENT_TYPE_ID_COLOR,
-    TOGL_FINE_TEXT_ELEMENT_TYPE_ID_HORIZONTAL_SPACER
+    TOGL_FINE_TEXT_ELEMENT_TYPE_ID_HORIZONTAL_SPACER,
+    TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE
 };
 
 class TOGL_FineTextElement {
@@ -36,22 +38,28 @@ class TOGL_Text : public TOGL_FineTextElement {
 public:
     TOGL_Text() {}
     // text - Encoding format: ascii or utf8
-    TOGL_Text(const std::string& text) : m_text(TOGL_ToUTF16(text)) {}
+    TOGL_Text(const std::string& text) : m_text(TOGL_ToUTF16(text)), m_code_points(TOGL_ToUTF32(m_text)) {}
     // text - Encoding format: utf16
-    TOGL_Text(const std::wstring& text) : m_text(text) {}
+    TOGL_Text(const std::wstring& text) : m_text(text), m_code_points(TOGL_ToUTF32(m_text)) {}
     // text - Encoding format: utf16
-    TOGL_Text(std::wstring&& text) : m_text(std::move(text)) {}
+    TOGL_Text(std::wstring&& text) : m_text(std::move(text)), m_code_points(TOGL_ToUTF32(m_text)) {}
 
 
     // text - Encoding format: utf16
     void SetText(const std::wstring& text) {
-        m_text = text;
+        m_text          = text;
+        m_code_points   = TOGL_ToUTF32(m_text);
     }
 
     std::wstring GetText() const {
         return m_text;
     }
 
+    // Returns text decoded to unicode code points (surrogate pairs are decoded once, when text is set).
+    const std::u32string& ToCodePoints() const {
+        return m_code_points;
+    }
+
     TOGL_FineTextElementTypeId GetTypeId() const override final {
         return TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT;
     }
@@ -60,7 +68,8 @@ public:
         return new TOGL_Text(*this);
     }
 private:
-    std::wstring m_text;
+    std::wstring    m_text;
+    std::u32string  m_code_points;
 };
 
 class TOGL_TextColor : public TOGL_FineTextElement {
@@ -113,6 +122,31 @@ private:
     uint32_t m_width; // in pixels
 };
 
+// Font style of text (see TOGL_Font::SetStyle). Font without style set renders all styles in its own style.
+class TOGL_TextStyle : public TOGL_FineTextElement {
+public:
+    TOGL_TextStyle() : m_style(TOGL_FONT_STYLE_ID_NORMAL) {}
+    TOGL_TextStyle(TOGL_FontStyleId style) : m_style(style) {}
+
+    void SetStyle(TOGL_FontStyleId style) {
+        m_style = style;
+    }
+
+    TOGL_FontStyleId GetStyle() const {
+        return m_style;
+    }
+
+    TOGL_FineTextElementTypeId GetTypeId() const override final {
+        return TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE;
+    }
+
+    TOGL_TextStyle* CopyNew() const override final {
+        return new TOGL_TextStyle(*this);
+    }
+private:
+    TOGL_FontStyleId m_style;
+};
+
 //------------------------------------------------------------------------------
 // TOGL_FineTextElementContainer
 //------------------------------------------------------------------------------
@@ -131,6 +165,8 @@ public:
     // horizontal_space_width - in pixels
     TOGL_FineTextElementContainer(uint32_t horizontal_space_width)  : m_element(new TOGL_TextHorizontalSpacer(horizontal_space_width)) {}
 
+    TOGL_FineTextElementContainer(TOGL_FontStyleId style)           : m_element(new TOGL_TextStyle(style)) {}
+
     TOGL_FineTextElementContainer(const TOGL_FineTextElementContainer& other);
     TOGL_FineTextElementContainer(TOGL_FineTextElementContainer&& other) noexcept;
 
@@ -145,6 +181,9 @@ public:
     // If contained element is not TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT, then empty text is returned.
     std::wstring GetText() const;
 
+    // If contained element is not TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT, then empty text is returned.
+    const std::u32string& ToCodePoints() const;
+
     // If contained element is not TOGL_FINE_TEXT_ELEMENT_TYPE_ID_COLOR, then is changed to it.
     void SetTextColor(const TOGL_Color4U8& text_color);
 
@@ -157,6 +196,12 @@ public:
     // If contained element is not TOGL_FINE_TEXT_ELEMENT_TYPE_ID_HORIZONTAL_SPACER, then 0 is returned.
     uint32_t GetTextHorizontalSpaceWidth() const;
 
+    // If contained element is not TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE, then is changed to it.
+    void SetTextStyle(TOGL_FontStyleId style);
+
+    // If contained element is not TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE, then TOGL_FONT_STYLE_ID_NORMAL is returned.
+    TOGL_FontStyleId GetTextStyle() const;
+
     bool IsTypeId(TOGL_FineTextElementTypeId type_id) const;
     TOGL_FineTextElementTypeId GetTypeId() const;
 
@@ -174,15 +219,19 @@ private:
         virtual ~DefRawElement() {}
 
         const std::wstring& ToText() const { return m_text; }
+        const std::u32string& ToCodePoints() const { return m_code_points; }
         const TOGL_Color4U8& ToTextColor() const { return m_text_color; }
         const uint32_t& ToTextHorizontalSpaceWidth() const { return m_text_horizontal_space_width; }
+        const TOGL_FontStyleId& ToTextStyle() const { return m_text_style; }
 
     private:
-        DefRawElement() : m_text_horizontal_space_width(0) {}
+        DefRawElement() : m_text_horizontal_space_width(0), m_text_style(TOGL_FONT_STYLE_ID_NORMAL) {}
 
-        std::wstring    m_text;
-        TOGL_Color4U8   m_text_color;
-        uint32_t        m_text_horizontal_space_width;
+        std::wstring        m_text;
+        std::u32string      m_code_points;
+        TOGL_Color4U8       m_text_color;
+        uint32_t            m_text_horizontal_space_width;
+        TOGL_FontStyleId    m_text_style;
     };
 
     static DefRawElement& ToDefRawElement();
@@ -219,6 +268,7 @@ public:
     //                                              std::wstring                  - interpreted as text, in utf16 encoding;
     //                                              TOGL_ Color3FU                - interpreted as text color;
     //                                              uint32_t                      - interpreted as horizontal space width in pixels;
+    //                                              TOGL_FontStyleId              - interpreted as text style;
     //                                              ElementContainer.
     template <typename Type, typename... Types>
     void Set(const Type& raw_element, const Types&... raw_elements);
@@ -236,6 +286,9 @@ public:
     // horizontal_space_width - in pixels
     void Append(uint32_t horizontal_space_width);
 
+    // Sets text style. Will be used for text newly added after this element.
+    void Append(TOGL_FontStyleId style);
+
     void Append(const ElementContainer& element_container);
 
     void Append(const std::vector<ElementContainer>& element_containers);
@@ -245,6 +298,7 @@ public:
     //                                              std::wstring                  - interpreted as text, in utf16 encoding;
     //                                              TOGL_ Color3FU                - interpreted as text color;
     //                                              uint32_t                      - interpreted as horizontal space width in pixels;
+    //                                              TOGL_FontStyleId              - interpreted as text style;
     //                                              ElementContainer.
     template <typename Type1, typename Type2, typename... Types>
     void Append(const Type1& raw_element1, const Type2& raw_element2, const Types&... raw_elements);
@@ -321,6 +375,13 @@ inline std::wstring TOGL_FineTextElementContainer::GetText() const {
     return static_cast<const TOGL_Text*>(m_element)->GetText();
 }
 
+inline const std::u32string& TOGL_FineTextElementContainer::ToCodePoints() const {
+    if (!IsTypeId(TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT)) {
+        return ToDefRawElement().ToCodePoints();
+    }
+    return static_cast<const TOGL_Text*>(m_element)->ToCodePoints();
+}
+
 
 inline void TOGL_FineTextElementContainer::SetTextColor(const TOGL_Color4U8& text_color) {
     MakeNewIfMismatch(TOGL_FINE_TEXT_ELEMENT_TYPE_ID_COLOR);
@@ -347,6 +408,19 @@ inline uint32_t TOGL_FineTextElementContainer::GetTextHorizontalSpaceWidth() con
     return static_cast<const TOGL_TextHorizontalSpacer*>(m_element)->GetWidth();
 }
 
+
+inline void TOGL_FineTextElementContainer::SetTextStyle(TOGL_FontStyleId style) {
+    MakeNewIfMismatch(TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE);
+    static_cast<TOGL_TextStyle*>(m_element)->SetStyle(style);
+}
+
+inline TOGL_FontStyleId TOGL_FineTextElementContainer::GetTextStyle() const {
+    if (!IsTypeId(TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE)) {
+        return ToDefRawElement().ToTextStyle();
+    }
+    return static_cast<const TOGL_TextStyle*>(m_element)->GetStyle();
+}
+
 inline bool TOGL_FineTextElementContainer::IsTypeId(TOGL_FineTextElementTypeId type_id) const {
     return m_element && m_element->GetTypeId() == type_id;
 }
@@ -376,6 +450,7 @@ inline TOGL_FineTextElement* TOGL_FineTextElementContainer::MakeNew(TOGL_FineTex
     case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT:               return new TOGL_Text();
     case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_HORIZONTAL_SPACER:  return new TOGL_TextHorizontalSpacer();
     case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_COLOR:              return new TOGL_TextColor();
+    case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE:              return new TOGL_TextStyle();
     }
     return nullptr;
 }
@@ -455,6 +530,10 @@ inline void TOGL_FineText::Append(uint32_t horizontal_space_width) {
     m_element_containers.push_back(ElementContainer(horizontal_space_width));
 }
 
+inline void TOGL_FineText::Append(TOGL_FontStyleId style) {
+    m_element_containers.push_back(ElementContainer(style));
+}
+
 inline void TOGL_FineText::Append(const ElementContainer& element) {
     m_element_containers.push_back(element);
 }
@@ -7,119 +7,420 @@
 #define TRIVIALOPENGL_FONT_H_
 
 #include "TrivialOpenGL_Window.h"
+#include "TrivialOpenGL_FontCore.h"
 
 //==========================================================================
 // Declarations
 //==========================================================================
 
-enum TOGL_FontSizeUnitId {
-    TOGL_FONT_SIZE_UNIT_ID_PIXELS,
-    TOGL_FONT_SIZE_UNIT_ID_POINTS,
-};
+//-----------------------------------------------------------------------------
+// TOGL_AtlasPacker
+//-----------------------------------------------------------------------------
 
-enum TOGL_FontStyleId {
-    TOGL_FONT_STYLE_ID_NORMAL,
-    TOGL_FONT_STYLE_ID_BOLD,
-};
-    
-// Ranges are from unicode space.
-// Font might not have all glyphs from this ranges.
-enum TOGL_FontCharSetId {
-    TOGL_FONT_CHAR_SET_ID_CUSTOM,
+// Finds places for rectangles in single atlas page.
+// Coordinates origin is in left-bottom corner of page.
+class TOGL_AtlasPacker {
+public:
+    TOGL_AtlasPacker();
+    TOGL_AtlasPacker(TOGL_FontAtlasPackerId packer_id, uint16_t width, uint16_t height);
+    virtual ~TOGL_AtlasPacker();
+
+    // Clears page.
+    void Reset(TOGL_FontAtlasPackerId packer_id, uint16_t width, uint16_t height);
+
+    // Finds place for rectangle and reserves it.
+    // pos          - Left-bottom corner of found place.
+    // Returns false if there is no space for rectangle in page.
+    bool Insert(uint16_t width, uint16_t height, TOGL_PointU16& pos);
+
+    uint16_t GetWidth() const;
+    uint16_t GetHeight() const;
+
+    // Returns sum of areas of inserted rectangles in pixels.
+    uint64_t GetUsedArea() const;
+
+private:
+    // Horizontal segment of skyline.
+    struct Segment {
+        uint16_t x;
+        uint16_t y;         // top of occupied space below segment
+        uint16_t width;
+    };
+
+    bool InsertToRow(uint16_t width, uint16_t height, TOGL_PointU16& pos);
+    bool InsertToSkyline(uint16_t width, uint16_t height, TOGL_PointU16& pos);
+
+    // Returns false if rectangle can not be placed at left end of segment.
+    bool FitToSkyline(size_t segment_ix, uint16_t width, uint16_t height, uint16_t& y) const;
+
+    TOGL_FontAtlasPackerId  m_packer_id;
+    uint16_t                m_width;
+    uint16_t                m_height;
+    uint64_t                m_used_area;
 
-    // Unicode Plane 0 - BMP - Basic Multilingual Plane 
-    TOGL_FONT_CHAR_SET_ID_RANGE_0000_FFFF,
+    // TOGL_FONT_ATLAS_PACKER_ID_ROWS
+    TOGL_PointU16           m_row_pos;
+    uint16_t                m_row_height;
 
-    TOGL_FONT_CHAR_SET_ID_ENGLISH,
+    // TOGL_FONT_ATLAS_PACKER_ID_SKYLINE
+    std::vector<Segment>    m_skyline;
 };
 
-enum {
-    // "WHITE SQUARE" 
-    // Represents missing glyph in unicode space.
-    TOGL_UNICODE_WHITE_SQUARE               = 0x25A1,
+//-----------------------------------------------------------------------------
+// TOGL_FontAtlas
+//-----------------------------------------------------------------------------
+
+// Set of atlas pages (separate GL_TEXTURE_2D textures) of the same size, filled on demand. 
+// Glyphs are packed into last page. New page is created when glyph doesn't fit.
+class TOGL_FontAtlas {
+public:
+    TOGL_FontAtlas();
+    virtual ~TOGL_FontAtlas();
+
+    // Deletes all pages.
+    void Reset(TOGL_FontAtlasPackerId packer_id, TOGL_FontAtlasFormatId format, bool is_sdf, uint16_t page_width, uint16_t page_height);
+    bool IsInitialized() const;
+
+    // Returns true if glyphs of font loaded with options can be placed in this atlas.
+    // Page size is compared only if it's set in options.
+    bool IsCompatible(const TOGL_FontLoadOptions& options) const;
+
+    // Finds place for rectangle in last page and reserves it. Appends new page if there is no space in last page.
+    // pos          - Left-bottom corner of found place.
+    // page_ix      - Index of page which contains found place.
+    // Returns false if rectangle is bigger than page.
+    bool Insert(uint16_t width, uint16_t height, TOGL_PointU16& pos, uint32_t& page_ix);
+
+    // Glyph cache only (see TOGL_GlyphCache). Appends transparent pages until atlas has page_count pages. 
+    // Places in these pages are found by glyph cache instead of Insert.
+    void ReservePages(uint32_t page_count);
+
+    // Makes whole page transparent.
+    void ClearPage(uint32_t page_ix);
+
+    // Makes rectangle of page transparent.
+    // pos          - Left-bottom corner of rectangle.
+    void ClearArea(uint32_t page_ix, const TOGL_PointU16& pos, uint16_t width, uint16_t height);
+
+    GLuint GetTexObj(uint32_t page_ix) const;
+    const std::vector<GLuint>& ToTexObjs() const;
+
+    uint32_t GetPageCount() const;
+    uint16_t GetPageWidth() const;
+    uint16_t GetPageHeight() const;
+    TOGL_FontAtlasFormatId GetFormat() const;
+
+    // Returns size of single page in bytes.
+    uint64_t GetPageTextureSize() const;
+
+private:
+    TOGL_NO_COPY(TOGL_FontAtlas);
+
+    void AddPage();
+    void DeletePages();
 
-    // "REPLACEMENT CHARACTER"
-    // Represent out of range character code from unicode space.
-    TOGL_UNICODE_REPLACEMENT_CHARACTER      = 0xFFFD,
+    bool                    m_is_initialized;
+    TOGL_FontAtlasPackerId  m_packer_id;
+    TOGL_FontAtlasFormatId  m_format;
+    bool                    m_is_sdf;
+    TOGL_AtlasPacker        m_packer;
+    std::vector<GLuint>     m_tex_objs;
 };
 
 //-----------------------------------------------------------------------------
-// TOGL_UnicodeRange
+// TOGL_GlyphCache
 //-----------------------------------------------------------------------------
 
-struct TOGL_UnicodeRange {
-    uint32_t from;
-    uint32_t to;
-        
-    TOGL_UnicodeRange() : from(0), to(0) {}
-    TOGL_UnicodeRange(uint32_t code) : from(code), to(code) {}
-    TOGL_UnicodeRange(uint32_t from, uint32_t to) : from(from), to(to) {}
+struct TOGL_GlyphCacheCounters {
+    uint64_t    hit_count;          // number of touches of glyphs, which are in cache
+    uint64_t    miss_count;         // number of touches of glyphs, which are not in cache
+    uint64_t    eviction_count;     // number of glyphs removed from cache
+    uint64_t    relocation_count;   // number of glyphs moved to new place by repacking of page
+    uint64_t    compaction_count;   // number of repacked pages
+    uint64_t    reuse_count;        // number of glyphs placed in place of evicted glyph, without repacking of page
+
+    TOGL_GlyphCacheCounters();
+};
+
+// Changes made by TOGL_GlyphCache, which must be reflected in atlas textures.
+struct TOGL_GlyphCacheChanges {
+    // Place of evicted glyph, which is reused by inserted glyph.
+    struct ReusedPlace {
+        uint32_t        page_ix;
+        TOGL_PointU16   pos;            // left-bottom corner
+        uint16_t        width;
+        uint16_t        height;
+    };
+
+    std::vector<uint32_t>       evicted_codes;          // glyphs removed from cache
+    std::vector<uint32_t>       repacked_page_ixs;      // pages, which must be cleared before relocated glyphs are placed again
+    std::vector<uint32_t>       relocated_codes;        // glyphs moved to new place (see TOGL_GlyphCache::GetPlace)
+    std::vector<ReusedPlace>    reused_places;          // places, which must be cleared before inserted glyph is placed there
+
+    void Clear();
+    bool IsEmpty() const;
 };
 
-std::vector<TOGL_UnicodeRange> TOGL_GetUnicodeRanges(TOGL_FontCharSetId char_set);
+// Places glyph boxes in limited number of atlas pages and tracks which glyphs are used in each frame. Doesn't use OpenGL.
+// When pages are full, then least recently used glyphs are evicted. Place of evicted glyph is reused by glyph, which fits in it.
+// Otherwise, area of evicted glyph is reclaimed when its page is repacked (all glyphs, which are left in page, are placed again from scratch).
+// Before page is repacked, more glyphs are evicted from it, until a quarter of page is free, so that one repacking serves many next insertions.
+class TOGL_GlyphCache {
+public:
+    TOGL_GlyphCache();
+    virtual ~TOGL_GlyphCache();
+
+    // Removes all glyphs, pages and clears counters.
+    // page_budget      - Maximal number of pages. If 0, then cache is disabled.
+    void Reset(TOGL_FontAtlasPackerId packer_id, uint16_t page_width, uint16_t page_height, uint32_t page_budget);
+    bool IsEnabled() const;
+
+    // Starts next frame. Glyphs, which are not touched since then, can be evicted.
+    void NextFrame();
+    uint64_t GetFrame() const;
+
+    // Marks glyph as used in current frame. 
+    // Returns true if glyph is in cache (hit), otherwise false (miss).
+    bool Touch(uint32_t code);
+    bool Has(uint32_t code) const;
+
+    // Places glyph box in cache. Glyph is marked as used in current frame. Box with zero area is only marked as present.
+    // Evicts least recently used glyphs (except pinned and used in current frame), if there is no space left in any page. 
+    // Glyph is placed in place of evicted glyph if it fits there, otherwise page of evicted glyphs is repacked.
+    // width, height    - Size of glyph box in pixels (with padding).
+    // is_pinned        - If true, then glyph is never evicted (it still might be relocated).
+    // changes          - Evicted, relocated glyphs and reused places are appended.
+    // Returns false if box is bigger than page, or if there is no space for box even after eviction.
+    bool Insert(uint32_t code, uint16_t width, uint16_t height, bool is_pinned, TOGL_GlyphCacheChanges& changes);
+
+    // pos              - Left-bottom corner of glyph box.
+    // Returns false if glyph is not in cache or glyph box has zero area.
+    bool GetPlace(uint32_t code, TOGL_PointU16& pos, uint32_t& page_ix) const;
+
+    // Repacks page with the biggest area of evicted glyphs, if this area is at least min_fragmentation of page area.
+    // Can be called once per frame to spread compaction over time.
+    // Returns true if page has been repacked.
+    bool CompactPage(TOGL_GlyphCacheChanges& changes, double min_fragmentation = 0.25);
+
+    // Returns ratio of area of evicted glyphs, which is not reclaimed yet, to page area (from 0 to 1).
+    double GetFragmentation(uint32_t page_ix) const;
+
+    uint32_t GetPageCount() const;
+    uint32_t GetPageBudget() const;
+    uint32_t GetGlyphCount() const;
+
+    const TOGL_GlyphCacheCounters& ToCounters() const;
+
+private:
+    enum : uint32_t { NO_PAGE_IX = 0xFFFFFFFF };
+
+    struct Entry {
+        uint32_t        page_ix;        // NO_PAGE_IX for box with zero area
+        TOGL_PointU16   pos;
+        uint16_t        width;
+        uint16_t        height;
+        uint16_t        place_width;    // width of place reserved in page (bigger than width if place of evicted glyph is reused)
+        uint16_t        place_height;   // height of place reserved in page (bigger than height if place of evicted glyph is reused)
+        uint64_t        last_frame;
+        bool            is_pinned;
+    };
+
+    // Place of evicted glyph, not reclaimed yet.
+    struct FreePlace {
+        TOGL_PointU16   pos;
+        uint16_t        width;
+        uint16_t        height;
+    };
+
+    struct Page {
+        TOGL_AtlasPacker        packer;
+        uint64_t                evicted_area;   // in pixels, not reclaimed yet
+        std::vector<FreePlace>  free_places;
+    };
+
+    // Places box in first page with enough space, or in new page if budget allows.
+    bool InsertToPages(Entry& entry);
+
+    // Places box in the smallest place of evicted glyph, which fits it.
+    bool InsertToFreePlaces(Entry& entry, TOGL_GlyphCacheChanges& changes);
+
+    void Evict(uint32_t code, TOGL_GlyphCacheChanges& changes);
+    void RepackPage(uint32_t page_ix, TOGL_GlyphCacheChanges& changes);
+
+    TOGL_FontAtlasPackerId                  m_packer_id;
+    uint16_t                                m_page_width;
+    uint16_t                                m_page_height;
+    uint32_t                                m_page_budget;
+    uint64_t                                m_frame;
+
+    std::unordered_map<uint32_t, Entry>     m_entries;
+    std::vector<Page>                       m_pages;
+    TOGL_GlyphCacheCounters                 m_counters;
+};
 
 //-----------------------------------------------------------------------------
-// TOGL_UnicodeRangeGroup
+// TOGL_WinGlyphSource
 //-----------------------------------------------------------------------------
 
-class TOGL_UnicodeRangeGroup {
+// Rasterizes glyphs by GetGlyphOutlineW. Glyphs look the same as glyphs created by wglUseFontBitmapsW.
+// Code points from supplementary planes are mapped to glyph indices by character map of font (GDI functions accept only UTF-16 code units).
+class TOGL_WinGlyphSource : public TOGL_GlyphSource {
 public:
-    TOGL_UnicodeRangeGroup()                                                    : m_char_set(TOGL_FONT_CHAR_SET_ID_CUSTOM) {}
-    TOGL_UnicodeRangeGroup(TOGL_FontCharSetId char_set)                         : m_char_set(char_set),  m_ranges(TOGL_GetUnicodeRanges(char_set)) {}
-    template <uint32_t NUMBER>
-    explicit TOGL_UnicodeRangeGroup(const TOGL_UnicodeRange (&ranges)[NUMBER])  : m_char_set(TOGL_FONT_CHAR_SET_ID_CUSTOM), m_ranges(ranges, ranges + NUMBER) {}
+    // font_handle      - Takes ownership of font.
+    // font_descent     - In pixels.
+    TOGL_WinGlyphSource(HFONT font_handle, uint32_t font_descent);
+    virtual ~TOGL_WinGlyphSource();
 
-    virtual ~TOGL_UnicodeRangeGroup() {}
+    bool GetGlyphBitmap(uint32_t code, TOGL_GlyphBitmap& bitmap) override;
+    uint16_t GetGlyphWidth(uint32_t code) override;
 
-    TOGL_FontCharSetId GetCharSet() const;
-    std::vector<TOGL_UnicodeRange> GetRanges() const;
-    const std::vector<TOGL_UnicodeRange>& ToRanges() const;
+    // Copy has own font object created from the same font description, and own device context.
+    std::shared_ptr<TOGL_GlyphSource> Clone() const override;
 
 private:
-    TOGL_FontCharSetId              m_char_set;
-    std::vector<TOGL_UnicodeRange>  m_ranges;
+    TOGL_NO_COPY(TOGL_WinGlyphSource);
+
+    enum { WIDTH_BLOCK_SIZE = 256 };
+
+    // Returns glyph index of code point from supplementary plane or 0 if font doesn't have glyph for it.
+    uint32_t ToSupplementaryGlyphIndex(uint32_t code);
+
+    HDC                     m_device_context_handle;
+    HFONT                   m_font_handle;
+    HFONT                   m_old_font_handle;
+    uint32_t                m_font_descent;
+
+    std::vector<uint8_t>    m_buffer;
 
+    // Widths of one block of code points are retrieved at once.
+    uint32_t                m_width_block_from;
+    std::vector<INT>        m_width_block;
+
+    // Loaded at first request for code point from supplementary plane.
+    bool                    m_is_char_map_requested;
+    TOGL_TrueTypeFont       m_char_map_font;
 };
 
 //-----------------------------------------------------------------------------
-// TOGL_FontInfo
+// TOGL_RasterizeGlyphs
 //-----------------------------------------------------------------------------
 
-struct TOGL_FontInfo {
-    std::string             name;                   // encoding format: UTF8
-    uint32_t                size;
-    TOGL_FontSizeUnitId     size_unit;
-    TOGL_FontStyleId        style;
-    TOGL_UnicodeRangeGroup  unicode_range_group;
-    uint32_t                distance_between_glyphs;
-    uint32_t                distance_between_lines;
+// Glyph rasterized on CPU by TOGL_RasterizeGlyphs.
+struct TOGL_RasterizedGlyph {
+    uint32_t            code;
+    uint16_t            width;      // width of glyph cell (advance) in pixels
+
+    // If glyph can't be rasterized, then it's stored without visible pixels.
+    TOGL_GlyphBitmap    bitmap;
+    uint64_t            bitmap_hash;    // see TOGL_HashGlyphBitmap
 
-    TOGL_FontInfo();
-    TOGL_FontInfo(
-        const std::string& name, 
-        uint32_t size, 
-        TOGL_FontSizeUnitId size_unit, 
-        TOGL_FontStyleId style, 
-        const TOGL_UnicodeRangeGroup& unicode_range_group,
-        uint32_t distance_between_glyphs = 0,
-        uint32_t distance_between_lines = 0);
+    TOGL_RasterizedGlyph();
 };
 
+// Rasterizes all glyphs from ranges to coverage buffers. Glyphs are returned in the same order as code points in ranges.
+// Glyphs are taken in small batches by pool of threads. Each additional thread uses own copy of glyph source (see TOGL_GlyphSource::Clone). 
+// If glyph source can't be copied, then all glyphs are rasterized by calling thread.
+// thread_count     - Number of threads including calling thread. If 0, then number of hardware threads is used.
+// sdf_spread       - If not 0, then each glyph is converted to distance field with this spread (see TOGL_MakeDistanceField).
+std::vector<TOGL_RasterizedGlyph> TOGL_RasterizeGlyphs(TOGL_GlyphSource& glyph_source, const std::vector<TOGL_UnicodeRange>& ranges, uint32_t thread_count = 0, uint16_t sdf_spread = 0);
+
+// Returns for each glyph index of first glyph with identical bitmap size and coverage (own index if there is no such glyph before it).
+// Such glyphs can share one place in atlas. Glyphs without visible pixels always refer to themselves.
+std::vector<uint32_t> TOGL_FindDuplicateGlyphs(const std::vector<TOGL_RasterizedGlyph>& glyphs);
+
 //-----------------------------------------------------------------------------
-// TOGL_GlyphData
+// TOGL_FontGL
 //-----------------------------------------------------------------------------
 
-struct TOGL_GlyphData {
-    uint16_t    width;      // in pixels
-    GLuint      tex_obj;    // opengl texture object (name)
+// OpenGL functions (above version 1.1) used by font. 
+// Functions are loaded by Load, when OpenGL Rendering Context is current.
+class TOGL_FontGL {
+public:
+    enum : GLenum {
+        // Added prefix TOGL_ to standard OpenGL constants.
+        TOGL_GL_TEXTURE_2D_ARRAY            = 0x8C1A,
+        TOGL_GL_MAX_ARRAY_TEXTURE_LAYERS    = 0x88FF,
+        TOGL_GL_FRAGMENT_SHADER             = 0x8B30,
+        TOGL_GL_VERTEX_SHADER               = 0x8B31,
+        TOGL_GL_COMPILE_STATUS              = 0x8B81,
+        TOGL_GL_LINK_STATUS                 = 0x8B82,
+        TOGL_GL_INFO_LOG_LENGTH             = 0x8B84,
+        TOGL_GL_CURRENT_PROGRAM             = 0x8B8D,
+        TOGL_GL_PIXEL_UNPACK_BUFFER         = 0x88EC,
+        TOGL_GL_STREAM_DRAW                 = 0x88E0,
+        TOGL_GL_WRITE_ONLY                  = 0x88B9,
+        TOGL_GL_ARRAY_BUFFER                = 0x8892,
+        TOGL_GL_STATIC_DRAW                 = 0x88E4,
+        TOGL_GL_ARRAY_BUFFER_BINDING        = 0x8894,
+    };
+
+    TOGL_FontGL();
+    virtual ~TOGL_FontGL();
+
+    // Returns true if all functions have been loaded.
+    bool Load();
+    bool IsLoaded() const;
+
+    // Loads functions of instanced rendering (OpenGL 3.3), separately from Load(), so contexts without them can still use other functions.
+    // Returns true if all functions from Load() and all functions of instanced rendering have been loaded.
+    bool LoadInstancing();
+    bool IsInstancingLoaded() const;
+
+    // Returns version of OpenGL context current in calling thread or {0, 0} if it can't be retrieved. 
+    // Unlike TOGL_GetOpenGL_Version, it doesn't depend on window, so font can be used with context created outside of TOGL_Window.
+    static TOGL_GL_Version GetVersion();
+
+    // Compiles and links shader program.
+    // Returns program object or 0 if program can not be created. Then err_msg contains compilation or linking log.
+    GLuint CreateProgram(const std::string& vertex_shader_source, const std::string& fragment_shader_source, std::string& err_msg);
+
+    void    (APIENTRY *togl_glTexImage3D)(GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLsizei depth, GLint border, GLenum format, GLenum type, const void* pixels);
+    void    (APIENTRY *togl_glTexSubImage3D)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLsizei width, GLsizei height, GLsizei depth, GLenum format, GLenum type, const void* pixels);
+    void    (APIENTRY *togl_glCopyTexSubImage3D)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLint zoffset, GLint x, GLint y, GLsizei width, GLsizei height);
+
+    GLuint  (APIENTRY *togl_glCreateShader)(GLenum type);
+    void    (APIENTRY *togl_glShaderSource)(GLuint shader, GLsizei count, const char* const* string, const GLint* length);
+    void    (APIENTRY *togl_glCompileShader)(GLuint shader);
+    void    (APIENTRY *togl_glGetShaderiv)(GLuint shader, GLenum pname, GLint* params);
+    void    (APIENTRY *togl_glGetShaderInfoLog)(GLuint shader, GLsizei max_length, GLsizei* length, char* info_log);
+    void    (APIENTRY *togl_glDeleteShader)(GLuint shader);
+    GLuint  (APIENTRY *togl_glCreateProgram)();
+    void    (APIENTRY *togl_glAttachShader)(GLuint program, GLuint shader);
+    void    (APIENTRY *togl_glLinkProgram)(GLuint program);
+    void    (APIENTRY *togl_glGetProgramiv)(GLuint program, GLenum pname, GLint* params);
+    void    (APIENTRY *togl_glGetProgramInfoLog)(GLuint program, GLsizei max_length, GLsizei* length, char* info_log);
+    void    (APIENTRY *togl_glDeleteProgram)(GLuint program);
+    void    (APIENTRY *togl_glUseProgram)(GLuint program);
+    GLint   (APIENTRY *togl_glGetUniformLocation)(GLuint program, const char* name);
+    void    (APIENTRY *togl_glUniform1i)(GLint location, GLint v0);
+
+    void    (APIENTRY *togl_glGenBuffers)(GLsizei n, GLuint* buffers);
+    void    (APIENTRY *togl_glDeleteBuffers)(GLsizei n, const GLuint* buffers);
+    void    (APIENTRY *togl_glBindBuffer)(GLenum target, GLuint buffer);
+    void    (APIENTRY *togl_glBufferData)(GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+    void*   (APIENTRY *togl_glMapBuffer)(GLenum target, GLenum access);
+    GLboolean (APIENTRY *togl_glUnmapBuffer)(GLenum target);
+
+    // Instanced rendering only (see LoadInstancing).
+    void    (APIENTRY *togl_glBufferSubData)(GLenum target, ptrdiff_t offset, ptrdiff_t size, const void* data);
+    void    (APIENTRY *togl_glVertexAttribPointer)(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride, const void* pointer);
+    void    (APIENTRY *togl_glVertexAttribIPointer)(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer);
+    void    (APIENTRY *togl_glEnableVertexAttribArray)(GLuint index);
+    void    (APIENTRY *togl_glDisableVertexAttribArray)(GLuint index);
+    void    (APIENTRY *togl_glVertexAttribDivisor)(GLuint index, GLuint divisor);
+    void    (APIENTRY *togl_glDrawArraysInstanced)(GLenum mode, GLint first, GLsizei count, GLsizei instance_count);
+    void    (APIENTRY *togl_glUniform1f)(GLint location, GLfloat v0);
+
+private:
+    template <typename Type>
+    void Load(Type& function, const std::string& function_name);
 
-    // texture coordinates
-    double      x1;
-    double      y1;
-    double      x2;
-    double      y2;
+    // Sets is_loaded to false, if function can not be loaded.
+    template <typename Type>
+    void Load(Type& function, const std::string& function_name, bool& is_loaded);
 
-    TOGL_GlyphData();
+    bool m_is_loaded;
+    bool m_is_instancing_loaded;
 };
 
 //-----------------------------------------------------------------------------
@@ -127,23 +428,106 @@ struct TOGL_GlyphData {
 //-----------------------------------------------------------------------------
 
 struct TOGL_FontData {
-    TOGL_FontInfo info;
+    TOGL_FontInfo           info;
+    TOGL_FontLoadOptions    options;
+    TOGL_FontStats          stats;
 
     uint32_t font_height;               // in pixels
     uint32_t font_ascent;               // in pixels
     uint32_t font_descent;              // in pixels
     uint32_t font_internal_leading;     // in pixels
 
-    std::map<uint32_t, TOGL_GlyphData> glyphs;     // indexed by character code from unicode space
+    TOGL_GlyphTable glyphs;             // indexed by character code from unicode space
 
     // Array of OpenGL Texture Object Identifiers (Texture Names).
-    // Pixel Format: RGBA (8 bits per channel).
+    // Pixel Format: RGBA (8 bits per channel) or ALPHA (8 bits), depending on options.format.
     // Orientation: First pixel refers to left-bottom corner of image.
     std::vector<GLuint> tex_objs;
 
+    // Texture array atlas only (options.is_texture_array). 
+    // OpenGL Texture Object of GL_TEXTURE_2D_ARRAY texture, which contains all pages as layers. Then tex_objs is empty.
+    GLuint              tex_array_obj;
+
+    // Lazy loading only. Rasterizes pending glyphs.
+    std::shared_ptr<TOGL_GlyphSource>   glyph_source;
+
+    // Lazy loading only. Atlas pages into which rasterized glyphs are packed. Might be shared with other fonts (see TOGL_FontLoadOptions::shared_atlas). 
+    // Then tex_objs is empty.
+    std::shared_ptr<TOGL_FontAtlas>     atlas;
+
+    // Lazy loading only. Enabled if TOGL_FontLoadOptions::glyph_cache_page_budget is not 0. Then places of glyphs in atlas are found by glyph cache.
+    TOGL_GlyphCache                     glyph_cache;
+
     TOGL_FontData();
 };
 
+//-----------------------------------------------------------------------------
+// TOGL_BMFont
+//-----------------------------------------------------------------------------
+
+// Font descriptor of AngelCode Bitmap Font Generator (BMFont), in text or binary format (version 3), and decoder of its page images.
+// Only blocks used by TOGL_Font are kept ('info', 'common', 'page' and 'char'). Kerning pairs are skipped.
+// Descriptor is parsed in single pass, without copying of data (only face name and page file names are copied).
+// Doesn't use OpenGL.
+class TOGL_BMFont {
+public:
+    enum {
+        MAX_PAGE_COUNT = 256,   // page index of char is 8 bit
+    };
+
+    struct Char {
+        uint32_t    code;
+
+        // Glyph image in page, relative to left-top corner of page, in pixels.
+        uint16_t    x;
+        uint16_t    y;
+        uint16_t    width;
+        uint16_t    height;
+
+        // Position of glyph image relative to cursor (x) and top of line (y), in pixels.
+        int16_t     x_offset;
+        int16_t     y_offset;
+        int16_t     x_advance;
+
+        uint8_t     page_ix;
+    };
+
+    std::string                 face;               // encoding format: UTF8
+    int16_t                     size;               // negative if size is height of glyph cell (instead of character height)
+
+    uint16_t                    line_height;        // in pixels
+    uint16_t                    base;               // distance from top of line to baseline, in pixels
+    uint16_t                    page_width;         // in pixels
+    uint16_t                    page_height;        // in pixels
+
+    // Content of alpha channel of 32 bit page images: 0 - glyph, 1 - outline, 2 - glyph and outline, 3 - zero, 4 - one.
+    uint8_t                     alpha_channel;
+
+    std::vector<std::string>    page_file_names;    // relative to directory of descriptor file, encoding format: UTF8
+    std::vector<Char>           chars;
+
+    TOGL_BMFont();
+
+    // Format is detected by signature ("BMF" for binary format). 
+    // Returns false if data is not valid descriptor (wrong signature, version, truncated, page size out of range, more than MAX_PAGE_COUNT pages, ...), 
+    // or if it describes font with glyphs packed in separate channels.
+    // Chars with glyph image exceeding page are skipped.
+    bool Decode(const uint8_t* data, size_t size);
+
+    // Returns glyph data of char (tex_obj isn't set). Texture coordinates refer to page with first pixel in left-bottom corner.
+    TOGL_GlyphData MakeGlyphData(const Char& c) const;
+
+    // Decodes page image in TGA format (uncompressed or RLE, 8 bit grayscale, 24 bit or 32 bit color) to glyph coverage.
+    // Coverage is taken from alpha channel of 32 bit image (if alpha_channel is 0, 1 or 2), otherwise from red channel (gray level for grayscale image).
+    // alphas       - page_width * page_height bytes, first pixel refers to left-bottom corner of page.
+    // Returns false if image is not supported, or its size isn't page_width x page_height.
+    bool DecodePage(const uint8_t* data, size_t size, uint8_t* alphas) const;
+
+private:
+    bool DecodeText(const char* text, size_t text_size);
+    bool DecodeBinary(const uint8_t* data, size_t data_size);
+};
+
 //-----------------------------------------------------------------------------
 // TOGL_FontDataGenerator
 //-----------------------------------------------------------------------------
@@ -156,7 +540,38 @@ public:
     // Returns generated font data.
     // If generating fails then returned font data is invalid, and IsOk() returns false.
     // Error message can be retrieved by GetErrMsg().
-    TOGL_FontData Generate(const TOGL_FontInfo& font_info);
+    TOGL_FontData Generate(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
+
+    // Starts asynchronous generation. Font metrics and glyph source are created by calling thread. 
+    // Glyphs are rasterized, packed and composed into atlas pages by background thread (always on CPU, see TOGL_RasterizeGlyphs).
+    // Lazy font and font from cache file are generated at once.
+    void BeginGenerate(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
+
+    // Continues asynchronous generation. Composed atlas pages are uploaded to textures until time budget (in seconds) runs out. At least one page is uploaded per call.
+    // Returns true if generation is finished. Then font data can be retrieved by EndGenerate().
+    bool ContinueGenerate(double time_budget);
+
+    // Returns generated font data. If generation isn't finished, then waits for background thread and uploads all remaining pages.
+    // If generating fails then returned font data is invalid, and IsOk() returns false.
+    TOGL_FontData EndGenerate();
+
+    // Stops asynchronous generation. Waits for background thread and deletes already uploaded pages.
+    void CancelGenerate();
+
+    // Asynchronous generation only. Returns number of atlas pages, which have been already uploaded to textures by ContinueGenerate.
+    uint32_t GetUploadedPageCount() const;
+
+    // Returns font data loaded from BMFont descriptor file (see TOGL_BMFont) and its page images, without generating glyphs.
+    // Pages are uploaded as they are (in format from options), so generating options (rasterizer, packer, page size, lazy loading, distance field, cache) are ignored.
+    // file_name    - Encoding format: UTF8.
+    TOGL_FontData GenerateFromBMFont(const std::string& file_name, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
+
+    // Lazy loading only. Rasterizes pending glyphs of font data, packs them into atlas and uploads them to atlas pages (textures).
+    // Glyphs, which are not pending, are skipped.
+    void GeneratePendingGlyphs(TOGL_FontData& data, const std::vector<uint32_t>& codes);
+
+    // Glyph cache only. Repacks at most one fragmented atlas page of font data (see TOGL_GlyphCache::CompactPage) and uploads relocated glyphs.
+    void CompactGlyphCache(TOGL_FontData& data);
 
     bool IsOk() const;
     std::string GetErrMsg() const;
@@ -216,20 +631,129 @@ private:
         std::string m_err_msg;
     };
 
+    // Placement of glyph in atlas.
+    struct GlyphLayout {
+        uint32_t                code;
+        const DisplayListSet*   display_list_set;
+
+        uint16_t                width;          // glyph cell width in pixels
+
+        // Glyph box (part of glyph cell which is stored in atlas) relative to left-bottom corner of glyph cell, in pixels.
+        int16_t                 box_x;
+        int16_t                 box_y;
+        uint16_t                box_width;
+        uint16_t                box_height;
+
+        uint32_t                page_ix;
+        TOGL_PointU16           pos;            // left-bottom corner of glyph box in atlas page
+
+        // If true, then glyph box has the same content as box of layout with original_ix, and shares place in atlas with it.
+        bool                    is_duplicate;
+        uint32_t                original_ix;
+    };
+
     void Initialize();
 
-    void GenerateFontTextures(uint16_t width, uint16_t height);
+    // Generates font metrics and glyph source. Depending on path, generates atlas, or starts composing atlas pages (m_is_staged).
+    void Start(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options, bool is_async);
+
+    // Sets glyph data of uploaded pages and saves cache file.
+    void Finish();
+
+    void GenerateFontTextures();
+
+    // Rasterizes glyphs by glyph source (m_data.glyph_source) on worker threads, packs them and composes atlas pages in memory (m_page_alphas). 
+    // Doesn't use OpenGL, so it can be run by background thread.
+    void ComposeAtlasPages(const std::vector<TOGL_UnicodeRange>& ranges);
+
+    // Uploads composed atlas pages until time budget (in seconds) runs out. Uses pixel buffer object if it's supported (OpenGL 2.1).
+    // Returns true if all pages have been uploaded.
+    bool UploadAtlasPages(double time_budget);
+
+    // Lazy loading only. Generates metrics of all glyphs and prepares atlas.
+    void GenerateGlyphMetrics(const std::vector<TOGL_UnicodeRange>& ranges);
+
+    // Creates glyph source (m_data.glyph_source) for font selected in window device context, depending on rasterizer from options.
+    // TrueType glyph source replaces font metrics.
+    void CreateGlyphSource(const TOGL_FontInfo& font_info);
+
+    // Places glyph boxes on atlas pages and fills atlas stats. Page size is chosen if it's not set in options.
+    // Returns number of atlas pages. If glyph doesn't fit in page, sets error and returns 0.
+    uint32_t PackGlyphs(std::vector<GlyphLayout>& layouts, TOGL_SizeU16& page_size);
+
+    TOGL_GlyphData MakeGlyphData(const GlyphLayout& layout, GLuint tex_obj, const TOGL_SizeU16& page_size) const;
+
+    // Returns glyph bitmap from glyph source of font data. Bitmap is converted to distance field for distance field atlas.
+    static bool RasterizeGlyph(TOGL_FontData& data, uint32_t code, TOGL_GlyphBitmap& bitmap);
+
+    // Uploads glyph bitmap to atlas page at pos and sets texture coordinates and quad of glyph data.
+    static void UploadGlyph(TOGL_FontData& data, const TOGL_GlyphBitmap& bitmap, const TOGL_PointU16& pos, uint32_t page_ix, TOGL_GlyphData& glyph_data, std::vector<uint8_t>& pixels);
+
+    // Glyph cache only. Makes evicted glyphs pending, clears repacked pages and uploads relocated glyphs again.
+    static void ApplyGlyphCacheChanges(TOGL_FontData& data, const TOGL_GlyphCacheChanges& changes);
+
+    static bool IsFallbackCode(uint32_t code);
+
+    // Returns space left around each glyph box in atlas page, depending on packer.
+    static uint16_t GetGlyphPadding(const TOGL_FontLoadOptions& options);
+
+    // Returns code points from set, which have glyphs in font selected in device context.
+    // Basic Multilingual Plane is checked by GetFontUnicodeRanges, supplementary planes by character map of font. 
+    // Code points, which can't be checked, are treated as covered.
+    static TOGL_UnicodeRangeSet GetCoveredCodes(HDC device_context_handle, const TOGL_UnicodeRangeSet& codes);
+
+    // Distance field is interpolated between texels. Coverage is sampled exactly, as glyphs are rendered in original size.
+    static GLint GetTextureFilter(const TOGL_FontLoadOptions& options);
+
+    // Converts glyph coverage to white pixels with coverage in alpha channel (GL_RGBA).
+    static void AlphasToPixels(const uint8_t* alphas, size_t count, std::vector<uint8_t>& pixels);
+    static void AlphasToPixels(const uint8_t* alphas, size_t count, uint8_t* pixels);
+
+    HFONT CreateWinFont(const TOGL_FontInfo& font_info) const;
+
+    // Returns key of cache file, which also depends on version of font file (its size and checksum of 'head' table).
+    uint64_t MakeCacheKey(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options) const;
+
+    // Returns true if texture array atlas with page_count pages can be created.
+    bool IsTextureArraySupported(uint32_t page_count);
+
+    // Returns true if font data has been loaded from cache file with matching key.
+    bool LoadFromCache(const std::string& file_name, uint64_t key);
+
+    // Uploads pages of cache to textures and sets font metrics and glyphs. Returns false if pages are too big for OpenGL.
+    bool LoadFromCache(const TOGL_FontCache& cache);
+
+    // Sets font metrics and stats from cache and creates textures (without content) for its pages. Pages of cache aren't used.
+    // Returns false if pages are too big for OpenGL. Then no texture is created.
+    bool CreatePageTextures(const TOGL_FontCache& cache);
+
+    // Uploads content of page (in format from options) to texture created by CreatePageTextures.
+    void UploadPage(uint32_t page_ix, const uint8_t* page);
+
+    // Sets glyph data of cache glyphs, which refer to textures created by CreatePageTextures.
+    void SetCacheGlyphs(const TOGL_FontCache& cache);
+
+    void DeleteTextures();
+    void SaveToCache(const std::string& file_name, uint64_t key);
+
+    // Returns glyph data, which is used when glyph and all fallback glyphs are missing. Such glyph is rendered as filled square.
+    TOGL_GlyphData MakeMissingGlyphData() const;
+
     void RenderGlyphToTexture(GLuint list_base, int x, int y, wchar_t c);
 
-    TOGL_SizeU16 GetCharSize(wchar_t c) const;
+    // Measures glyph box which will be placed in atlas, depending on used packer.
+    GlyphLayout MeasureGlyph(const DisplayListSet& display_list_set, uint32_t code) const;
 
-    void SetErrMsg(const std::string& err_msg);
+    // Returns the smallest atlas page size, which can fit glyphs of total area and each glyph with width and height not bigger than min_size, 
+    // or maximal supported page size.
+    TOGL_SizeU16 ChoosePageSize(uint64_t area, uint32_t min_size) const;
 
-    static uint32_t PointsToPixels(uint32_t points) {
-        return points * 4 / 3;
-    }
+    // Returns maximal atlas page size supported by OpenGL.
+    static uint32_t QueryMaxPageSize();
+
+    TOGL_SizeU16 GetCharSize(wchar_t c) const;
 
-    static uint32_t ToPixels(uint32_t size, TOGL_FontSizeUnitId size_unit);
+    void SetErrMsg(const std::string& err_msg);
 
     template <typename Type>
     void Load(Type& function, const std::string& function_name);
@@ -239,6 +763,26 @@ private:
 
     HDC                         m_device_context_handle;
     std::vector<DisplayListSet> m_display_list_sets;
+
+    TOGL_FontGL                 m_gl;
+
+    uint32_t                    m_max_page_size;
+
+    bool                        m_is_cache_used;
+    uint64_t                    m_cache_key;
+    std::string                 m_cache_file_name;
+
+    bool                        m_is_finished;
+
+    // Staged generation (rasterized on CPU). Pages are composed (maybe by background thread), then uploaded.
+    bool                        m_is_staged;
+    std::future<void>           m_composing;
+    std::vector<GlyphLayout>    m_layouts;
+    std::vector<uint8_t>        m_page_alphas;
+    uint32_t                    m_page_count;
+    TOGL_SizeU16                m_page_size;
+    uint32_t                    m_uploaded_page_count;
+    bool                        m_is_upload_started;
 };
 
 //-----------------------------------------------------------------------------
@@ -261,9 +805,21 @@ TOGL_Font& TOGL_ToGlobalFont();
 // If font has been loaded successfully, then TOGL_IsFontOk() should return true. Otherwise, font failed to load, and error message can be retrieved by TOGL_GetFontErrMsg().
 // Font size for loaded font might be smaller than requested font size (font_info.size, size) when size unit (font_info.size_unit, size_unit) is TOGL_FONT_SIZE_UNIT_ID_PIXELS.
 // To get loaded font size (in pixels) call TOGL_GetFontHeight().
-void TOGL_LoadFont(const TOGL_FontInfo& font_info);
+void TOGL_LoadFont(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
 void TOGL_LoadFont(const std::string& name, uint32_t size, TOGL_FontSizeUnitId size_unit, TOGL_FontStyleId style, const TOGL_UnicodeRangeGroup& unicode_range_group);
 
+// Unload current font if loaded. Loads font prebaked by AngelCode Bitmap Font Generator (see TOGL_Font::LoadBMFont).
+void TOGL_LoadBMFont(const std::string& file_name, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
+
+// Starts loading new font in background. Current font is rendered until new font replaces it (see TOGL_Font::LoadAsync).
+// TOGL_UpdateFontLoading() should be called once per frame, before rendering.
+void TOGL_LoadFontAsync(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
+
+// Uploads atlas pages of font loaded in background until time budget (in seconds) runs out.
+// Returns true if global font has been replaced by new font in this call.
+bool TOGL_UpdateFontLoading(double time_budget = 0.002);
+bool TOGL_IsFontLoadingAsync();
+
 void TOGL_UnloadFont();
 bool TOGL_IsFontLoaded();
 
@@ -281,15 +837,139 @@ uint32_t TOGL_GetInternalLeading();
 
 TOGL_FontInfo TOGL_GetFontInfo();
 
+TOGL_FontStats TOGL_GetFontStats();
+
 bool TOGL_IsFontOk();
 std::string TOGL_GetFontErrMsg();
 
+//-----------------------------------------------------------------------------
+// TOGL_GlyphBatch
+//-----------------------------------------------------------------------------
+
+// Glyph quads computed on CPU (see TOGL_Font::BatchGlyph), grouped by font and atlas page. 
+// Each group is rendered with one draw call (see TOGL_Font::RenderBatch), instead of one draw call per glyph.
+// Memory is kept in between frames, so batch should be reused.
+// Instanced batch (see SetInstanced) keeps one 16-byte instance per glyph instead of 4 vertices, 
+// which is expanded to quad by shader (OpenGL 3.3 or higher). Glyphs which don't fit into instance are kept as quads.
+class TOGL_GlyphBatch {
+public:
+    struct Vertex {
+        float           x;          // in pixels
+        float           y;          // in pixels
+        float           tex_x;
+        float           tex_y;
+        float           layer;      // texture array atlas only
+        TOGL_Color4U8   color;
+    };
+
+    enum : uint32_t {
+        MAX_INSTANCE_SIZE   = 0xFFF,
+        MAX_INSTANCE_LAYER  = 0x7F,
+    };
+
+    struct Instance {
+        int16_t         x;          // left-bottom corner of quad, in pixels
+        int16_t         y;          // left-bottom corner of quad, in pixels
+        uint16_t        tex_x;      // left-bottom corner of glyph in atlas page, in texels
+        uint16_t        tex_y;      // left-bottom corner of glyph in atlas page, in texels
+
+        // Bits 0-11: width, bits 12-23: height (both in texels, quad size is multiplied by font scale).
+        // Bits 24-30: layer (texture array atlas only). Bit 31: glyph image is upside down in atlas page.
+        uint32_t        size_layer;
+
+        TOGL_Color4U8   color;
+    };
+
+    // Quads of glyphs from one atlas page, which are rendered by one font.
+    struct Group {
+        TOGL_Font*              font;       // For glyphs of font in style (see TOGL_Font::SetStyle), it's font of style set.
+        GLuint                  tex_obj;    // 0 - replacements for missing glyphs (rendered without texture)
+        std::vector<Vertex>     vertices;   // 4 per quad
+        std::vector<Instance>   instances;  // 1 per quad, instanced batch only
+    };
+
+    // Range of group vertices in vertex buffer object, to which vertices of groups have been uploaded (see TOGL_StaticText).
+    struct BufferGroup {
+        TOGL_Font*              font;
+        GLuint                  tex_obj;
+        uint32_t                first;      // index of first vertex of group in buffer
+        uint32_t                count;      // number of vertices
+    };
+
+    // Glyph, which wasn't rasterized yet (lazy loading) when it was batched. It becomes quad when it's uploaded (see TOGL_Font::UpdateBatch).
+    struct PendingGlyph {
+        TOGL_Font*              font;       // font which has glyph
+        TOGL_Font*              owner;      // font which renders group of quad
+        double                  x;          // position of glyph cell, in pixels
+        double                  y;          // position of glyph cell, in pixels
+        uint32_t                code;
+        TOGL_OriginId           origin_id;  // origin of font, when glyph was batched
+        double                  scale;      // scale of font, when glyph was batched
+        TOGL_Color4U8           color;
+    };
+
+    TOGL_GlyphBatch();
+    virtual ~TOGL_GlyphBatch();
+
+    // Removes all quads and pending glyphs. Groups, which have been empty since previous call, are removed. Memory of other groups is kept.
+    void Clear();
+
+    // Sets color of quads added after this call.
+    void SetColor(const TOGL_Color4U8& color);
+    const TOGL_Color4U8& ToColor() const;
+
+    // x1, y1, x2, y2           - Corners of quad, in pixels.
+    // tex_x1, tex_y1, ...      - Texture coordinates of corners (x1, y1) and (x2, y2).
+    void AddQuad(TOGL_Font* font, GLuint tex_obj, float x1, float y1, float x2, float y2, float tex_x1, float tex_y1, float tex_x2, float tex_y2, float layer);
+
+    // If true, then TOGL_Font::BatchGlyph adds glyphs as instances, when font supports instanced rendering. False by default.
+    void SetInstanced(bool is_instanced);
+    bool IsInstanced() const;
+
+    // x, y                     - Left-bottom corner of quad, in pixels. Rounded to whole pixels.
+    // tex_x, tex_y             - Left-bottom corner of glyph in atlas page, in texels. 
+    // width, height            - Size of glyph, in texels.
+    // is_flipped               - Glyph image is upside down in atlas page (top of quad is at tex_y).
+    // Returns false if values don't fit into instance. Then glyph should be added by AddQuad.
+    bool AddInstance(TOGL_Font* font, GLuint tex_obj, double x, double y, double tex_x, double tex_y, uint32_t width, uint32_t height, uint32_t layer, bool is_flipped);
+
+    // Color of pending glyph is color of batch.
+    void AddPendingGlyph(TOGL_Font* font, TOGL_Font* owner, double x, double y, uint32_t code, TOGL_OriginId origin_id, double scale);
+
+    // Pending glyphs aren't rendered, until they are turned into quads by TOGL_Font::UpdateBatch.
+    const std::vector<PendingGlyph>& ToPendingGlyphs() const;
+    std::vector<PendingGlyph> TakePendingGlyphs();
+
+    // Returns true if batch has no quads. Pending glyphs aren't counted.
+    bool IsEmpty() const;
+
+    // Returns number of quads and instances.
+    uint32_t GetQuadCount() const;
+
+    // Returns number of groups which have quads, where group with both quads and instances is counted twice 
+    // (number of draw calls issued by TOGL_Font::RenderBatch).
+    uint32_t GetGroupCount() const;
+
+    const std::vector<Group>& ToGroups() const;
+
+private:
+    Group& ToGroup(TOGL_Font* font, GLuint tex_obj);
+
+    std::vector<Group>          m_groups;
+    std::vector<PendingGlyph>   m_pending_glyphs;
+    size_t                      m_last_group_ix;    // consecutive glyphs are mostly from the same group
+    uint32_t                    m_quad_count;
+    uint32_t                    m_group_count;
+    TOGL_Color4U8               m_color;
+    bool                        m_is_instanced;
+};
+
 
 //-----------------------------------------------------------------------------
 // TOGL_Font
 //-----------------------------------------------------------------------------
 
-class TOGL_Font {
+class TOGL_Font : public TOGL_FontMetrics {
 public:
     TOGL_Font();
     virtual ~TOGL_Font();
@@ -298,11 +978,32 @@ public:
     // If font has been loaded successfully, then IsOk() should return true. Otherwise, font failed to load, and error message can be retrieved by GetErrMsg().
     // Font size for loaded font might be different than requested font size (font_info.size, size) when size unit (font_info.size_unit, size_unit) is TOGL_FONT_SIZE_UNIT_ID_PIXELS.
     // To get loaded font size (in pixels) call GetHeight().
-    void Load(const TOGL_FontInfo& font_info);
+    void Load(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
     void Load(const std::string& name, uint32_t size, TOGL_FontSizeUnitId size_unit, TOGL_FontStyleId style, const TOGL_UnicodeRangeGroup& unicode_range_group);
 
+    // Unloads current font if loaded. Loads font prebaked by AngelCode Bitmap Font Generator from descriptor file (text or binary) and its page images (TGA). 
+    // Glyphs aren't generated, so loading is only reading of files and upload of pages (see TOGL_FontDataGenerator::GenerateFromBMFont).
+    // Only options.format and options.is_texture_array are used. 
+    // file_name    - Encoding format: UTF8.
+    void LoadBMFont(const std::string& file_name, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
+
+    // Starts loading new font in background (see TOGL_FontDataGenerator::BeginGenerate). Previous asynchronous loading is canceled.
+    // Until new font is loaded, current font (if loaded) is still rendered. Loading is continued by UpdateLoading(). 
+    // When new font is loaded, it replaces current font at once, the same way as by Load.
+    void LoadAsync(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
+
+    // Continues asynchronous loading. Uploads atlas pages until time budget (in seconds) runs out. 
+    // Should be called once per frame, before rendering.
+    // Returns true if current font has been replaced by new font in this call. Then IsOk() tells if new font has been loaded successfully.
+    bool UpdateLoading(double time_budget = 0.002);
+
+    // Returns true if asynchronous loading is in progress.
+    bool IsLoadingAsync() const;
+    void CancelLoading();
+
+    // Unloads font and cancels asynchronous loading.
     void Unload();
-    bool IsLoaded() const;
+    bool IsLoaded() const override;
 
     // Warning!!! Each section of code which starts with RenderBegin() MUST end with RenderEnd().
     void RenderBegin();
@@ -312,6 +1013,88 @@ public:
     // Can be used only in between RenderBegin() and RenderEnd().
     void RenderGlyph(uint32_t code);
 
+    // Adds quad of single glyph to batch. Nothing is rendered until RenderBatch is called. 
+    // Quad color is taken from batch (see TOGL_GlyphBatch::SetColor). Should be used outside of RenderBegin() and RenderEnd().
+    // Glyph, which isn't rasterized yet (lazy loading), is requested and kept in batch as pending glyph, without quad. 
+    // Pending glyphs of batch are uploaded together by UpdateBatch.
+    // x, y         - Position of glyph cell, in pixels.
+    void BatchGlyph(TOGL_GlyphBatch& batch, double x, double y, uint32_t code);
+
+    // Lazy loading only. Uploads glyphs requested by fonts of pending glyphs from batch (once per font) and adds quads of uploaded glyphs to batch. 
+    // Should be called once per frame, after all glyphs of frame have been batched and before batch is rendered.
+    // Glyphs, which stay pending (see TOGL_FontLoadOptions::glyph_cache_page_budget), are kept in batch.
+    static void UpdateBatch(TOGL_GlyphBatch& batch);
+
+    // Renders all quads from batch with one draw call per group (font and atlas page). Pending glyphs aren't rendered (see UpdateBatch).
+    // Each font from batch is rendered in its own section of RenderBegin() and RenderEnd(), so it can't be used in between them.
+    // Fonts from batch must be still loaded. Batch isn't cleared.
+    static void RenderBatch(const TOGL_GlyphBatch& batch);
+
+    // Renders groups, which vertices are taken from vertex buffer object bound to GL_ARRAY_BUFFER, with one draw call per group.
+    // Fonts are rendered the same way as by RenderBatch.
+    static void RenderBufferGroups(const std::vector<TOGL_GlyphBatch::BufferGroup>& groups);
+
+    // Lazy loading only (TOGL_FontLoadOptions::is_lazy). 
+    // Marks glyphs, which are not rasterized yet, to be rasterized by next UpdateGlyphs call.
+    // text         - Encoding format: UTF16 (surrogate pairs are decoded) or UTF32.
+    void RequestGlyph(uint32_t code);
+    void RequestGlyphs(const std::wstring& text);
+    void RequestGlyphs(const std::u32string& text);
+
+    // Lazy loading only. Rasterizes all requested glyphs and uploads them to atlas in one batch.
+    // Should be called once per frame, before rendering. Glyphs which weren't requested are rasterized by RenderGlyph, one by one.
+    void UpdateGlyphs();
+
+    // Glyph cache only (TOGL_FontLoadOptions::glyph_cache_page_budget). Starts next frame. Glyphs requested before this call become evictable.
+    // Repacks at most one fragmented atlas page, so compaction is spread over frames.
+    // Should be called once per frame, before text is requested or rendered.
+    void NextFrame();
+
+    // Glyph cache only. Returns numbers of hits, misses and evictions of glyphs requested by RequestGlyph(s).
+    const TOGL_GlyphCacheCounters& ToGlyphCacheCounters() const;
+
+    // Returns number, which changes each time when quads of glyphs, which have been already batched (see BatchGlyph), might be no longer valid.
+    // It happens when font (or any font from its fallback chain) is loaded or unloaded, when fallback chain is set, 
+    // or when glyph cache evicts or relocates glyphs.
+    uint64_t GetRevision() const;
+
+    // Returns number, which is unique for each load of each font in process (also for font loaded again at the same address).
+    uint64_t GetLoadId() const;
+
+    // Returns true if font has glyph for code point (rasterized or pending). Fallback fonts aren't checked.
+    bool HasGlyph(uint32_t code) const;
+
+    // Sets ordered chain of fonts, which render code points missing in this font (at most TOGL_GlyphTable::MAX_FONT_IX fonts).
+    // Code point is rendered and measured by first font from this font, fonts[0], fonts[1], ..., which has glyph for it (see HasGlyph).
+    // If none of them has, then fallback glyph of this font is used.
+    // Each code point is resolved on first use and font index is kept in glyph table entry, so next lookups don't search the chain.
+    // Fallback glyph is rendered with origin of this font, with baseline aligned to baseline of this font, and scaled by scale of its font.
+    // Fonts from chain must outlive this font or chain must be replaced. They are kept when this font is reloaded.
+    // Resolution is reset by this call, by reload of this font, and when revision of chain changes (see GetRevision), for example, when font from chain is reloaded.
+    // Requested glyphs of fonts from chain are rasterized by UpdateGlyphs of this font. NextFrame must be called for each of them separately.
+    void SetFallbackFonts(const std::vector<TOGL_Font*>& fonts);
+    const std::vector<TOGL_Font*>& ToFallbackFonts() const;
+
+    // Starts recording code points, which are rendered (RenderGlyph), requested (RequestGlyph) or measured (GetGlyphSize) by this font.
+    // Code points are added to current record, which is kept when font is reloaded. 
+    // Record can be saved to file (see TOGL_CodePointRecord::Save), and loaded as unicode ranges of font by next run (see TOGL_LoadUnicodeRangeGroup), 
+    // so only used glyphs are rasterized.
+    void StartRecording();
+    void StopRecording();
+    bool IsRecording() const;
+
+    const TOGL_CodePointRecord& ToCodePointRecord() const;
+    void ClearCodePointRecord();
+
+    // Style set only (TOGL_FontLoadOptions::is_style_set). Sets style of rendered, requested and measured glyphs. 
+    // Can be called in between RenderBegin() and RenderEnd(). Code points, which font in style doesn't have, are taken from font in style from font info.
+    // Font in style, which font doesn't have (see HasStyle), renders glyphs of font in style from font info.
+    void SetStyle(TOGL_FontStyleId style);
+    TOGL_FontStyleId GetStyle() const override;
+
+    // Returns true if glyphs of style can be rendered. Style from font info is always available.
+    bool HasStyle(TOGL_FontStyleId style) const;
+
     // Renders array of glyphs. 
     // Special characters (like '\n', '\t', ... and so on) are interpreted as "unrepresented characters".
     // Can be used only in between RenderBegin() and RenderEnd().
@@ -323,35 +1106,27 @@ public:
 
     TOGL_OriginId GetOrigin() const;
 
-    // Returns distance between rendered glyphs in pixels.
-    uint32_t GetDistanceBetweenGlyphs() const;
-
-    // Returns distance between rendered lines in pixels.
-    uint32_t GetDistanceBetweenLines() const;
-
-    // Returns glyph size (width and height, both in pixels).
-    TOGL_SizeU GetGlyphSize(uint32_t code) const;
-
-    // height = ascent + descent
+    // Sets scale of rendered glyphs. Font metrics (GetHeight, GetGlyphSize, ...) are scaled too, and rounded to pixels.
+    // Intended for distance field fonts (see TOGL_FontLoadOptions::is_sdf). Glyphs of other fonts are scaled without smoothing.
+    void SetScale(double scale);
+    double GetScale() const;
+
+    // Metrics are scaled (see SetScale).
+    uint32_t GetDistanceBetweenGlyphs() const override;
+    uint32_t GetDistanceBetweenLines() const override;
+    TOGL_SizeU GetGlyphSize(uint32_t code) const override;
+    TOGL_SizeU GetGlyphSize(uint32_t code, TOGL_FontStyleId style) const override;
+    uint32_t GetHeight() const override;
+    uint32_t GetDescent() const override;
+    uint32_t GetAscent() const override;
+    uint32_t GetInternalLeading() const override;
 
-    // Returns font height in pixels.
-    uint32_t GetHeight() const;
-    
-    // Returns font descent length in pixels.
-    uint32_t GetDescent() const;
-
-    // Returns font ascent length in pixels.
-    uint32_t GetAscent() const;
-    
-    // Returns font internal leading in pixels.
-    uint32_t GetInternalLeading() const;
+    const TOGL_FontInfo& ToFontInfo() const;
 
-    // text         - Each code point is interpreted as single printable glyph (even '\t' and 'n').
-    // width        - In pixels.
-    // Returns number of glyphs from text which will fit in width.
-    uint32_t GetGlyphCountInWidth(const std::wstring& text, uint32_t width) const;
+    const TOGL_FontLoadOptions& ToLoadOptions() const;
 
-    const TOGL_FontInfo& ToFontInfo() const;
+    // Returns statistics of font atlas (number of pages, fill ratio, ...).
+    const TOGL_FontStats& ToStats() const;
 
     bool IsOk() const;
     std::string GetErrMsg() const;
@@ -365,907 +1140,4992 @@ private:
 
     void Initialize();
 
+    // Logs unicode ranges and creates texture array program if it's needed. Sets options for font data generator (used_options).
+    // Returns false and sets error message if options are invalid. Then nothing is created.
+    bool PrepareLoad(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options, TOGL_FontLoadOptions& used_options, GLuint& program);
+
+    // Takes generated font data and finishes loading.
+    void CompleteLoad(const TOGL_FontData& data, const TOGL_FontDataGenerator& font_data_generator, GLuint program);
+
     void SetErrMsg(const std::string& err_msg);
 
-    const TOGL_GlyphData* FindGlyphData(uint32_t code) const;
+    // Returns next number from process-wide counter of font loads.
+    static uint64_t GenerateLoadId();
+
+    // Returns glyph for code point. For missing glyph returns fallback glyph.
+    const TOGL_GlyphData& ToGlyphData(uint32_t code) const;
+
+    // Returns index of font, which renders code point (0 - this font, n - m_fallback_fonts[n - 1]). Code point is resolved on first use.
+    uint8_t ToFontIx(uint32_t code) const;
+
+    // Glyph quad relative to glyph cell (in pixels), with texture coordinates y for vertices y1 and y2.
+    struct GlyphQuad {
+        const TOGL_GlyphData*   glyph_data;
+        double                  x1;
+        double                  y1;
+        double                  x2;
+        double                  y2;
+        double                  ty1;
+        double                  ty2;
+    };
+
+    // Returns false if glyph has empty quad or it's pending.
+    bool ToOwnGlyphQuad(uint32_t code, GlyphQuad& quad) const;
+
+    // Returns offset, which aligns baseline of font (fallback font or font in style) with baseline of this font.
+    double ToBaselineOffset(const TOGL_Font& font) const;
+
+    // Versions of RenderGlyph, BatchGlyph, RequestGlyph and UpdateGlyphs, which ignore fallback fonts.
+    // owner        - Font which renders group of quad (see TOGL_GlyphBatch::Group).
+    void RenderOwnGlyph(uint32_t code);
+    void BatchOwnGlyph(TOGL_GlyphBatch& batch, TOGL_Font& owner, double x, double y, uint32_t code);
+    void RequestOwnGlyph(uint32_t code);
+    void UpdateOwnGlyphs();
+
+    // Renders glyph of fallback font in place of glyph of this font.
+    void RenderFallbackGlyph(TOGL_Font& font, uint32_t code);
+
+    // Renders quads of group with one draw call. Can be used only in between RenderBegin() and RenderEnd().
+    // vertices     - Address of group vertices, or their offset (in bytes) in bound vertex buffer object.
+    void RenderBatchGroup(GLuint tex_obj, const uint8_t* vertices, uint32_t vertex_count);
+
+    // Calls render_group(ix) for each group of font, with groups of one font in one section of RenderBegin() and RenderEnd().
+    // get_font         - Returns font of group ix.
+    // is_group_empty   - Returns true if group ix has nothing to render.
+    template <typename GetFontT, typename IsGroupEmptyT, typename RenderGroupT>
+    static void RenderGroupsByFont(size_t group_count, GetFontT get_font, IsGroupEmptyT is_group_empty, RenderGroupT render_group);
+
+    // Renders instances of group with one instanced draw call. Can be used only in between RenderBegin() and RenderEnd().
+    void RenderInstancedGroup(const TOGL_GlyphBatch::Group& group);
+
+    // Creates program and instance buffer at first call after load. 
+    // Returns true if glyphs of this font can be rendered as instances (OpenGL 3.3 or higher).
+    bool PrepareInstancing();
+
+    // Glyph cache only. Returns number of glyphs, which have been evicted or relocated.
+    uint64_t GetGlyphCacheChangeCount() const;
+
+    enum { STYLE_COUNT = TOGL_FONT_STYLE_ID_ITALIC + 1 };
+
+    // Style set only. Loads fonts in other styles than style from font info, into atlas of this font.
+    void LoadStyleFonts();
+
+    // Returns font in style, which renders code point, or nullptr if code point is rendered by this font.
+    TOGL_Font* ToStyleFont(uint32_t code, TOGL_FontStyleId style) const;
+
+    // Renders glyph of font in style in place of glyph of this font.
+    void RenderStyleGlyph(TOGL_Font& font, uint32_t code);
+
+    // Returns shader program for texture array atlas and/or distance field atlas, or 0 if it can't be created.
+    // is_instanced     - Program expands instances of TOGL_GlyphBatch into quads (OpenGL 3.3 or higher).
+    GLuint CreateProgram(bool is_texture_array, bool is_sdf, bool is_instanced = false);
+
+    // Returns length in pixels multiplied by scale.
+    uint32_t ToScaled(uint32_t length) const;
 
     TOGL_FontData           m_data;
     TOGL_OriginId           m_origin_id;
+    double                  m_scale;
     bool                    m_is_loaded;
     std::string             m_err_msg;
-};
 
-//==========================================================================
-// Definitions
-//==========================================================================
+    std::vector<uint32_t>   m_requested_codes;
 
-//-----------------------------------------------------------------------------
-// TOGL_UnicodeRange
-//-----------------------------------------------------------------------------
+    // Texture array atlas only.
+    TOGL_FontGL             m_gl;
+    GLuint                  m_program;
+    GLint                   m_prev_program;
 
-inline std::vector<TOGL_UnicodeRange> TOGL_GetUnicodeRanges(TOGL_FontCharSetId char_set) {
-    switch (char_set) {
-    case TOGL_FONT_CHAR_SET_ID_CUSTOM:
-        return {};
+    // Texture bound by RenderGlyph, in between RenderBegin() and RenderEnd().
+    GLuint                  m_bound_tex_obj;
 
-    case TOGL_FONT_CHAR_SET_ID_RANGE_0000_FFFF:
-        return {
-            {0x0000, 0xFFFF}
-        };
+    // Instanced rendering only (see PrepareInstancing).
+    bool                    m_is_instancing_prepared;
+    GLuint                  m_instanced_program;
+    GLint                   m_instanced_scale_location;
+    GLuint                  m_instance_buffer;
 
-    case TOGL_FONT_CHAR_SET_ID_ENGLISH:
-        return {
-            {0x0020, 0x007E},
-            {TOGL_UNICODE_WHITE_SQUARE},
-            {TOGL_UNICODE_REPLACEMENT_CHARACTER}
-        };
+    // Asynchronous loading only. Font which replaces current font.
+    std::unique_ptr<TOGL_FontDataGenerator> m_pending_generator;
+    GLuint                                  m_pending_program;
 
-    } // switch
+    std::vector<TOGL_Font*>                 m_fallback_fonts;
+    mutable uint64_t                        m_resolution_revision;  // revision of chain (see GetRevision), for which font indices in glyph table are resolved
 
-    return {};
-}
+    bool                                    m_is_recording;
+    mutable TOGL_CodePointRecord            m_code_point_record;    // also filled by const functions
+
+    uint64_t                                m_revision;
+    uint64_t                                m_load_id;
+
+    // Style set only. Fonts indexed by style. Font in style from font info is null (this font renders it).
+    TOGL_FontStyleId                        m_style;
+    std::unique_ptr<TOGL_Font>              m_style_fonts[STYLE_COUNT];
+};
 
 //-----------------------------------------------------------------------------
-// TOGL_UnicodeRangeGroup
+// TOGL_FontHandle
 //-----------------------------------------------------------------------------
 
-inline TOGL_FontCharSetId TOGL_UnicodeRangeGroup::GetCharSet() const {
-    return m_char_set;
-}
+// Identifies font loaded by TOGL_FontRegistry. Default constructed handle doesn't refer to any font.
+struct TOGL_FontHandle {
+    uint32_t id;
 
-inline std::vector<TOGL_UnicodeRange> TOGL_UnicodeRangeGroup::GetRanges() const {
-    return m_ranges;
-}
+    TOGL_FontHandle();
+    explicit TOGL_FontHandle(uint32_t id);
 
-inline const std::vector<TOGL_UnicodeRange>& TOGL_UnicodeRangeGroup::ToRanges() const {
-    return m_ranges;
-}
+    bool IsNone() const;
+
+    bool operator==(const TOGL_FontHandle& other) const;
+    bool operator!=(const TOGL_FontHandle& other) const;
+};
 
 //-----------------------------------------------------------------------------
-// TOGL_FontInfo
+// Global Font Registry
 //-----------------------------------------------------------------------------
 
-inline TOGL_FontInfo::TOGL_FontInfo() {
-    name                = "";
-    size                = 0;
-    size_unit           = TOGL_FONT_SIZE_UNIT_ID_PIXELS;
-    style               = TOGL_FONT_STYLE_ID_NORMAL;
-    unicode_range_group = TOGL_FONT_CHAR_SET_ID_ENGLISH;
-}
-        
-inline TOGL_FontInfo::TOGL_FontInfo(
-        const std::string& name, 
-        uint32_t size, TOGL_FontSizeUnitId size_unit, 
-        TOGL_FontStyleId style, 
-        const TOGL_UnicodeRangeGroup& unicode_range_group,
-        uint32_t distance_between_glyphs,
-        uint32_t distance_between_lines) {
-    this->name                      = name;
-    this->size                      = size;    
-    this->size_unit                 = size_unit;
-    this->style                     = style;    
-    this->unicode_range_group       = unicode_range_group;
-    this->distance_between_glyphs   = distance_between_glyphs;
-    this->distance_between_lines    = distance_between_lines;
-}
+class TOGL_FontRegistry;
+TOGL_FontRegistry& TOGL_ToGlobalFontRegistry();
 
 //-----------------------------------------------------------------------------
-// TOGL_GlyphData
+// TOGL_FontRegistry
 //-----------------------------------------------------------------------------
 
-inline TOGL_GlyphData::TOGL_GlyphData() {
-    width       = 0;
-    tex_obj     = 0;
-                
-    x1          = 0;
-    y1          = 0;
-    x2          = 0;
-    y2          = 0;
-}
+// Keeps many fonts loaded at once. Each font is accessed by handle, so switching between fonts costs only a table lookup.
+// Fonts are loaded lazily (see TOGL_FontLoadOptions::is_lazy), and glyphs of fonts with compatible options are packed into the same atlas pages.
+class TOGL_FontRegistry {
+public:
+    enum { DEFAULT_PAGE_SIZE = 1024 };
 
-//-----------------------------------------------------------------------------
-// TOGL_FontData
-//-----------------------------------------------------------------------------
+    TOGL_FontRegistry();
+    virtual ~TOGL_FontRegistry();
 
-inline TOGL_FontData::TOGL_FontData() {
-    info                    = {};
+    // Loads font and returns handle to it. If the same font has been already loaded with the same options, then returns handle to that font.
+    // Font is unloaded when Unload has been called as many times as Load returned its handle.
+    // If atlas page size isn't set in options, then DEFAULT_PAGE_SIZE is used, so fonts of different sizes can share pages.
+    // If font fails to load, then returns none handle, and error message can be retrieved by GetErrMsg().
+    TOGL_FontHandle Load(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
+    TOGL_FontHandle Load(const std::string& name, uint32_t size, TOGL_FontSizeUnitId size_unit, TOGL_FontStyleId style, const TOGL_UnicodeRangeGroup& unicode_range_group);
 
-    font_height             = 0;           
-    font_ascent             = 0;           
-    font_descent            = 0;          
-    font_internal_leading   = 0; 
-}
+    // Starts loading font in background and returns pending handle at once (see TOGL_Font::LoadAsync). 
+    // Options are adjusted the same way as by Load, so font shares atlas pages with other fonts. Until font is loaded, it renders nothing.
+    // Loading is continued by Update(). If loading fails at once, then returns none handle, and error message can be retrieved by GetErrMsg().
+    TOGL_FontHandle LoadAsync(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
+
+    // Starts loading other font in background for handle. Current font of handle is rendered until new font replaces it.
+    void ReloadAsync(TOGL_FontHandle handle, const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options = TOGL_FontLoadOptions());
+
+    // Continues loading of all fonts loaded in background. Uploads atlas pages until time budget (in seconds) runs out.
+    // Should be called once per frame, before rendering. If any font fails to load, then error message can be retrieved by GetErrMsg().
+    void Update(double time_budget = 0.002);
+
+    // Returns true if font of handle is being loaded in background.
+    bool IsPending(TOGL_FontHandle handle) const;
+
+    void Unload(TOGL_FontHandle handle);
+    void UnloadAll();
+
+    // Returns true if handle refers to font which can be rendered.
+    bool IsLoaded(TOGL_FontHandle handle) const;
+
+    // Returns font referred by handle. For not loaded font returns empty font (not loaded), which renders nothing.
+    TOGL_Font& ToFont(TOGL_FontHandle handle);
+    const TOGL_Font& ToFont(TOGL_FontHandle handle) const;
+
+    // Returns number of loaded fonts.
+    uint32_t GetFontCount() const;
+
+    // Returns number of atlas pages shared by all loaded fonts.
+    uint32_t GetPageCount() const;
+
+    bool IsOk() const;
+    std::string GetErrMsg() const;
+
+private:
+    TOGL_NO_COPY(TOGL_FontRegistry);
+
+    struct Slot {
+        std::unique_ptr<TOGL_Font>  font;           // null when slot is free
+        uint64_t                    key;
+        uint32_t                    ref_count;
+        uint16_t                    generation;     // incremented when slot is reused, so old handles don't refer to new font
+    };
+
+    // Returns index of slot referred by handle, or -1 if handle doesn't refer to loaded font.
+    int64_t FindSlot(TOGL_FontHandle handle) const;
+
+    // Returns handle of font in new slot. Returns none handle if there is no free slot.
+    TOGL_FontHandle AddSlot(std::unique_ptr<TOGL_Font> font, uint64_t key);
+
+    // Returns options with which font is loaded into registry: lazy loading, separate textures and DEFAULT_PAGE_SIZE if page size isn't set.
+    static TOGL_FontLoadOptions MakeRegistryOptions(const TOGL_FontLoadOptions& options);
+
+    // Sets shared atlas of options to atlas compatible with them, or to new atlas if there isn't any. 
+    // Options with own shared atlas or with glyph cache (which needs own atlas) are left unchanged.
+    void AssignSharedAtlas(TOGL_FontLoadOptions& registry_options);
+
+    // Deletes atlases not used by any font.
+    void ReleaseUnusedAtlases();
+
+    std::vector<Slot>                               m_slots;
+    std::vector<std::shared_ptr<TOGL_FontAtlas>>    m_atlases;
+    TOGL_Font                                       m_empty_font;
+    std::string                                     m_err_msg;
+};
+
+//==========================================================================
+// Definitions
+//==========================================================================
 
 //-----------------------------------------------------------------------------
-// TOGL_FontDataGenerator
+// TOGL_AtlasPacker
 //-----------------------------------------------------------------------------
 
-inline TOGL_FontDataGenerator::TOGL_FontDataGenerator() {
-    Initialize();
+inline TOGL_AtlasPacker::TOGL_AtlasPacker() {
+    Reset(TOGL_FONT_ATLAS_PACKER_ID_SKYLINE, 0, 0);
 }
 
-inline TOGL_FontDataGenerator::~TOGL_FontDataGenerator() {
+inline TOGL_AtlasPacker::TOGL_AtlasPacker(TOGL_FontAtlasPackerId packer_id, uint16_t width, uint16_t height) {
+    Reset(packer_id, width, height);
+}
+
+inline TOGL_AtlasPacker::~TOGL_AtlasPacker() {
 
 }
 
-inline TOGL_FontData TOGL_FontDataGenerator::Generate(const TOGL_FontInfo& font_info) {
-    m_err_msg           = "";
-    m_data.info         = font_info;
+inline void TOGL_AtlasPacker::Reset(TOGL_FontAtlasPackerId packer_id, uint16_t width, uint16_t height) {
+    m_packer_id     = packer_id;
+    m_width         = width;
+    m_height        = height;
+    m_used_area     = 0;
 
-    _TOGL_WindowInnerAccessor& window_inner_accessor = TOGL_ToWindow();
-    HWND window_handle = window_inner_accessor.ToHWND();
+    m_row_pos       = {0, 0};
+    m_row_height    = 0;
 
-    m_device_context_handle = GetDC(window_handle);
-    
-    UINT old_text_align = SetTextAlign(m_device_context_handle, TA_LEFT | TA_TOP | TA_NOUPDATECP);
-    if (old_text_align == GDI_ERROR) {
-        SetErrMsg("Can set window device context text aling.");
+    m_skyline.clear();
+    m_skyline.push_back({0, 0, width});
+}
 
-    } else {
-        int old_map_mode = SetMapMode(m_device_context_handle, MM_TEXT);
-        if (old_map_mode == 0) {
-            SetErrMsg("Can set window device context map mode.");
+inline bool TOGL_AtlasPacker::Insert(uint16_t width, uint16_t height, TOGL_PointU16& pos) {
+    const bool is_inserted = (m_packer_id == TOGL_FONT_ATLAS_PACKER_ID_ROWS) ? InsertToRow(width, height, pos) : InsertToSkyline(width, height, pos);
+    if (is_inserted) {
+        m_used_area += uint64_t(width) * height;
+    }
+    return is_inserted;
+}
 
-        } else {
-            const uint32_t requested_font_height = ToPixels(font_info.size, font_info.size_unit);
-
-            HFONT font_handle = CreateFontW(
-                    requested_font_height,                    
-                    0, 0, 0,                            
-                    (font_info.style == TOGL_FONT_STYLE_ID_BOLD) ? FW_BOLD : FW_NORMAL,
-                    FALSE, FALSE, FALSE,
-                    ANSI_CHARSET, // For W version of this function, should create a font bitmap with all having glyphs for unicode range from 0000 to FFFF.
-                    OUT_TT_PRECIS,
-                    CLIP_DEFAULT_PRECIS,
-                    ANTIALIASED_QUALITY,
-                    FF_DONTCARE | DEFAULT_PITCH,
-                    TOGL_ToUTF16(font_info.name).c_str());  
+inline uint16_t TOGL_AtlasPacker::GetWidth() const {
+    return m_width;
+}
 
-            if (font_handle == NULL) {
-                SetErrMsg("Can not create font source.");
-            } else {
-                HFONT old_font_handle = (HFONT)SelectObject(m_device_context_handle, font_handle); 
+inline uint16_t TOGL_AtlasPacker::GetHeight() const {
+    return m_height;
+}
 
-                // --- Gets Font Metrics --- //
-                TEXTMETRICW metric;
-                GetTextMetricsW(m_device_context_handle, &metric);
-                m_data.font_height              = metric.tmHeight;
-                m_data.font_ascent              = metric.tmAscent;
-                m_data.font_descent             = metric.tmDescent;
-                m_data.font_internal_leading    = metric.tmInternalLeading;
+inline uint64_t TOGL_AtlasPacker::GetUsedArea() const {
+    return m_used_area;
+}
 
-                // debug section
-                //togl_print_i32(m_data.font_height);
-                //togl_print_i32(m_data.font_ascent);
-                //togl_print_i32(m_data.font_descent);
-                //togl_print_i32(m_data.font_internal_leading);
+inline bool TOGL_AtlasPacker::InsertToRow(uint16_t width, uint16_t height, TOGL_PointU16& pos) {
+    if (width > m_width) return false;
 
-                // Note: Requested font size (requested_font_height) might be different from created font size (m_data.font_height).
+    if (uint32_t(m_row_pos.x) + width > m_width) {
+        m_row_pos.x     = 0;
+        m_row_pos.y     += m_row_height;
+        m_row_height    = 0;
+    }
 
-                auto GetUnicodeRangesOfCurrentWinFont = [](HDC device_context_handle) {
-                    std::vector<TOGL_UnicodeRange> unicode_ranges;
+    if (uint32_t(m_row_pos.y) + height > m_height) return false;
 
-                    DWORD buffer_size = GetFontUnicodeRanges(device_context_handle, NULL);
-                    BYTE* buffer = new BYTE[buffer_size];
+    pos = m_row_pos;
 
-                    GLYPHSET* glyphset = (GLYPHSET*)buffer;
-                    GetFontUnicodeRanges(device_context_handle, glyphset);
-                    // debug
-                    //togl_print_i32(glyphset->cbThis);
-                    //togl_print_i32(glyphset->flAccel);
-                    //togl_print_i32(glyphset->cGlyphsSupported);
-                    //togl_print_i32(glyphset->cRanges);
+    m_row_pos.x     += width;
+    if (height > m_row_height) m_row_height = height;
+    return true;
+}
 
-                    for (uint32_t ix = 0; ix < glyphset->cRanges; ++ix) {
-                        const uint32_t from = glyphset->ranges[ix].wcLow;
-                        const uint32_t to   = from + glyphset->ranges[ix].cGlyphs - 1;
+inline bool TOGL_AtlasPacker::InsertToSkyline(uint16_t width, uint16_t height, TOGL_PointU16& pos) {
+    // Bottom-left rule: chooses place with lowest top edge, then with narrowest segment below.
+    size_t      best_ix     = m_skyline.size();
+    uint32_t    best_top    = UINT32_MAX;
+    uint16_t    best_width  = UINT16_MAX;
+    uint16_t    best_y      = 0;
+
+    for (size_t ix = 0; ix < m_skyline.size(); ++ix) {
+        uint16_t y = 0;
+        if (FitToSkyline(ix, width, height, y)) {
+            const uint32_t top = uint32_t(y) + height;
+            if (top < best_top || (top == best_top && m_skyline[ix].width < best_width)) {
+                best_ix     = ix;
+                best_top    = top;
+                best_width  = m_skyline[ix].width;
+                best_y      = y;
+            }
+        }
+    }
 
-                        unicode_ranges.push_back({from, to});
-                    }
+    if (best_ix == m_skyline.size()) return false;
 
-                    delete[] buffer;
+    pos = {m_skyline[best_ix].x, best_y};
 
-                    return unicode_ranges;
-                };
+    // Cuts off segments covered by inserted rectangle.
+    const uint16_t right = pos.x + width;
 
-                // debug
-                //for (const auto& range : GetUnicodeRangesOfCurrentWinFont(m_device_context_handle)) {
-                //    LogDebug(std::string() + "[" + HexToStr(range.from) + ".." + HexToStr(range.to) + "]");
-                //}
+    m_skyline.insert(m_skyline.begin() + best_ix, {pos.x, uint16_t(best_y + height), width});
 
-                // --- Generates Display Lists and Intermediary Font Bitmaps --- //
+    size_t ix = best_ix + 1;
+    while (ix < m_skyline.size() && m_skyline[ix].x < right) {
+        Segment& segment = m_skyline[ix];
 
-                std::vector<TOGL_UnicodeRange> ranges;
-                for (TOGL_UnicodeRange range : m_data.info.unicode_range_group.ToRanges()) {
-                    if (range.from > 0xFFFF || range.to > 0xFFFF) {
-                            SetErrMsg("Unicode code point is out of supported range. Supported unicode code point range is from 0000 to (including) FFFF. ");
-                            break;
-                    }
+        if (segment.x + segment.width <= right) {
+            m_skyline.erase(m_skyline.begin() + ix);
+        } else {
+            segment.width   -= right - segment.x;
+            segment.x       = right;
+            break;
+        }
+    }
 
-                    auto PushRangeWithoutCodePoint = [](uint32_t code_point, const TOGL_UnicodeRange& range, std::vector<TOGL_UnicodeRange>& ranges) {
-                        auto IsIn = [](uint32_t code, const TOGL_UnicodeRange& range) -> bool {
-                            return range.from <= code && code <= range.to;
-                        };
-
-                        if (IsIn(code_point, range)) {
-                            if (range.from != code_point) {
-                                ranges.push_back({range.from, code_point - 1});
-                            }
-                            if (range.to != code_point) {
-                                ranges.push_back({code_point + 1, range.to});
-                            }
-                        } else {
-                            ranges.push_back(range);
-                        }
-                    };
+    // Merges neighbouring segments with the same height.
+    for (ix = 1; ix < m_skyline.size();) {
+        if (m_skyline[ix - 1].y == m_skyline[ix].y) {
+            m_skyline[ix - 1].width += m_skyline[ix].width;
+            m_skyline.erase(m_skyline.begin() + ix);
+        } else {
+            ++ix;
+        }
+    }
 
-                    // Function wglUseFontBitmapsW have problem with generating font bitmap when FFFF code point is present in range.
-                    // Workaround: Remove this code point from range, since it's a non-character code point. 
-                    PushRangeWithoutCodePoint(0xFFFF, range, ranges);
-                }
+    return true;
+}
 
-                if (IsOk()) {
-                    glPushAttrib(GL_ALL_ATTRIB_BITS);
+inline bool TOGL_AtlasPacker::FitToSkyline(size_t segment_ix, uint16_t width, uint16_t height, uint16_t& y) const {
+    const uint32_t left = m_skyline[segment_ix].x;
+    if (left + width > m_width) return false;
 
-                    for (const auto& range : ranges) {
-                        //LogDebug(std::string() + "[" + HexToStr(range.from) + ".." + HexToStr(range.to) + "]"); // debug
+    uint32_t top        = 0;
+    uint32_t width_left = width;
 
-                        DisplayListSet display_list_set(range.from, range.to);
+    for (size_t ix = segment_ix; width_left > 0 && ix < m_skyline.size(); ++ix) {
+        if (m_skyline[ix].y > top) top = m_skyline[ix].y;
+        if (top + height > m_height) return false;
 
-                        display_list_set.first  = display_list_set.unicode_range.from;
-                        display_list_set.range  = GLsizei(display_list_set.unicode_range.to - display_list_set.unicode_range.from + 1);
-                        display_list_set.base   = glGenLists(display_list_set.range);
+        width_left -= (m_skyline[ix].width < width_left) ? m_skyline[ix].width : width_left;
+    }
 
-                        if (display_list_set.base == 0) {
-                            SetErrMsg(std::string() + "Can not generate display list for unicode range [" + TOGL_HexToStr(display_list_set.unicode_range.from) + ".." + TOGL_HexToStr(display_list_set.unicode_range.to) + "].");
-                            break;
-                        }
+    y = uint16_t(top);
+    return true;
+}
 
-                        bool is_success = wglUseFontBitmapsW(m_device_context_handle, display_list_set.first, display_list_set.range, display_list_set.base);
+//-----------------------------------------------------------------------------
+// TOGL_FontAtlas
+//-----------------------------------------------------------------------------
 
-                        // Workaround for strange behavior. For POPUP window first call of wglUseFontBitmapsA fail with GetError() = 0.
-                        // Second call, right after first, seams to succeed.
-                        if (!is_success) is_success = wglUseFontBitmapsW(m_device_context_handle, display_list_set.first, display_list_set.range, display_list_set.base);
+inline TOGL_FontAtlas::TOGL_FontAtlas() {
+    m_is_initialized    = false;
+    m_packer_id         = TOGL_FONT_ATLAS_PACKER_ID_SKYLINE;
+    m_format            = TOGL_FONT_ATLAS_FORMAT_ID_RGBA8;
+    m_is_sdf            = false;
+}
 
-                        if (!is_success) {
-                            SetErrMsg("Error: Can not create intermediary font bitmap for unicode range [" + TOGL_HexToStr(display_list_set.unicode_range.from) + ".." + TOGL_HexToStr(display_list_set.unicode_range.to) + "].");
-                            break;
-                        }
+inline TOGL_FontAtlas::~TOGL_FontAtlas() {
+    DeletePages();
+}
 
-                        m_display_list_sets.push_back(display_list_set);
-                    }
+inline void TOGL_FontAtlas::Reset(TOGL_FontAtlasPackerId packer_id, TOGL_FontAtlasFormatId format, bool is_sdf, uint16_t page_width, uint16_t page_height) {
+    DeletePages();
 
-                    // --- Generate Font Textures --- //
+    m_is_initialized    = true;
+    m_packer_id         = packer_id;
+    m_format            = format;
+    m_is_sdf            = is_sdf;
 
-                    if (IsOk()) {
-                        GenerateFontTextures(1024, 1024);
-                    }
+    m_packer.Reset(packer_id, page_width, page_height);
+}
 
-                    // --- Destroys Display Lists and Clears Ranges --- //
+inline bool TOGL_FontAtlas::IsInitialized() const {
+    return m_is_initialized;
+}
 
-                    for (auto& display_list_set : m_display_list_sets) {
-                        glDeleteLists(display_list_set.base, display_list_set.range);
-                    }
-                    m_display_list_sets.clear();
+inline bool TOGL_FontAtlas::IsCompatible(const TOGL_FontLoadOptions& options) const {
+    return m_is_initialized
+        && options.packer == m_packer_id
+        && options.format == m_format
+        && options.is_sdf == m_is_sdf
+        && (options.page_width == 0 || options.page_width == m_packer.GetWidth())
+        && (options.page_height == 0 || options.page_height == m_packer.GetHeight());
+}
 
-                    glPopAttrib();
-                }
-                SelectObject(m_device_context_handle, old_font_handle);
-                DeleteObject(font_handle);
-            }
-            SetMapMode(m_device_context_handle, old_map_mode);
-        }
-        SetTextAlign(m_device_context_handle, old_text_align);
-    } 
+inline bool TOGL_FontAtlas::Insert(uint16_t width, uint16_t height, TOGL_PointU16& pos, uint32_t& page_ix) {
+    if (width > m_packer.GetWidth() || height > m_packer.GetHeight()) return false;
 
-    ReleaseDC(window_handle, m_device_context_handle);
-    m_device_context_handle = NULL;
+    if (m_tex_objs.empty() || !m_packer.Insert(width, height, pos)) {
+        m_packer.Reset(m_packer_id, m_packer.GetWidth(), m_packer.GetHeight());
+        AddPage();
 
-    TOGL_FontData data = m_data;
-    m_data = {};
+        if (!m_packer.Insert(width, height, pos)) return false;
+    }
 
-    return IsOk() ? data : TOGL_FontData();
+    page_ix = uint32_t(m_tex_objs.size() - 1);
+    return true;
 }
 
-inline bool TOGL_FontDataGenerator::IsOk() const {
-    return m_err_msg.empty();
+inline GLuint TOGL_FontAtlas::GetTexObj(uint32_t page_ix) const {
+    return (page_ix < m_tex_objs.size()) ? m_tex_objs[page_ix] : 0;
 }
 
-inline std::string TOGL_FontDataGenerator::GetErrMsg() const {
-    return m_err_msg;
+inline const std::vector<GLuint>& TOGL_FontAtlas::ToTexObjs() const {
+    return m_tex_objs;
 }
 
-//-----------------------------------------------------------------------------
+inline uint32_t TOGL_FontAtlas::GetPageCount() const {
+    return uint32_t(m_tex_objs.size());
+}
 
-inline TOGL_FontDataGenerator::DisplayListSet::DisplayListSet() {
-    first      = 0;
-    range      = 0;
-    base       = 0; 
+inline uint16_t TOGL_FontAtlas::GetPageWidth() const {
+    return m_packer.GetWidth();
 }
 
-inline TOGL_FontDataGenerator::DisplayListSet::DisplayListSet(uint32_t code) {
-    unicode_range = TOGL_UnicodeRange(code);
+inline uint16_t TOGL_FontAtlas::GetPageHeight() const {
+    return m_packer.GetHeight();
+}
 
-    first      = 0;
-    range      = 0;
-    base       = 0; 
+inline TOGL_FontAtlasFormatId TOGL_FontAtlas::GetFormat() const {
+    return m_format;
 }
 
-inline TOGL_FontDataGenerator::DisplayListSet::DisplayListSet(uint32_t from, uint32_t to) {
-    unicode_range = TOGL_UnicodeRange(from, to);
+inline uint64_t TOGL_FontAtlas::GetPageTextureSize() const {
+    const uint32_t pixel_size = (m_format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8) ? 1 : 4; // in bytes
 
-    first      = 0;
-    range      = 0;
-    base       = 0; 
+    return uint64_t(m_packer.GetWidth()) * m_packer.GetHeight() * pixel_size;
 }
 
-//-----------------------------------------------------------------------------
+inline void TOGL_FontAtlas::AddPage() {
+    const uint16_t  width       = m_packer.GetWidth();
+    const uint16_t  height      = m_packer.GetHeight();
+    const bool      is_alpha    = m_format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8;
 
-inline TOGL_FontDataGenerator::FrameBuffer::FrameBuffer(uint16_t width, uint16_t height) {
-    Load(m_glGenFramebuffersEXT, "glGenFramebuffersEXT");
-    Load(m_glDeleteFramebuffersEXT, "glDeleteFramebuffersEXT");
-    Load(m_glBindFramebufferEXT, "glBindFramebufferEXT");
-    Load(m_glFramebufferTexture2DEXT, "glFramebufferTexture2DEXT");
-    Load(m_glCheckFramebufferStatusEXT, "glCheckFramebufferStatusEXT");
-                    
-    m_width     = width;
-    m_height    = height;
+    // New page is transparent.
+    const std::vector<uint8_t> pixels(size_t(GetPageTextureSize()), 0);
 
-    if (IsOk()) {
-        GLint max_viewport_size[2] = {};
-        glGetIntegerv(GL_MAX_VIEWPORT_DIMS, max_viewport_size);
-        GLint max_texture_size = 0;
-        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+    // Distance field is interpolated between texels. Coverage is sampled exactly.
+    const GLint filter = m_is_sdf ? GL_LINEAR : GL_NEAREST;
 
-        if (width > max_viewport_size[0] || width > max_texture_size || height > max_viewport_size[1] || height > max_texture_size) {
-            AddErrMsg(std::string() + "Value of width or/and height are to big. ("
-                "max_viewport_width=" + std::to_string(max_viewport_size[0]) + 
-                ", max_viewport_height=" + std::to_string(max_viewport_size[1]) + 
-                ", max_texture_width=" + std::to_string(max_texture_size) + 
-                ", max_texture_height=" + std::to_string(max_texture_size) + 
-                ")"
-            );
-        }
-    }
+    glPushAttrib(GL_TEXTURE_BIT);
 
-    m_fbo       = 0;
-    m_prev_fbo  = 0;
+    GLuint tex_obj = 0;
+    glGenTextures(1, &tex_obj);
+    glBindTexture(GL_TEXTURE_2D, tex_obj);
 
-    if (IsOk()) {
-        m_glGenFramebuffersEXT(1, &m_fbo);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexImage2D(GL_TEXTURE_2D, 0, is_alpha ? GL_ALPHA8 : GL_RGBA8, width, height, 0, is_alpha ? GL_ALPHA : GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 
-        glGetIntegerv(TOGL_GL_FRAMEBUFFER_BINDING, (GLint*)&m_prev_fbo);
-        m_glBindFramebufferEXT(TOGL_GL_FRAMEBUFFER_EXT, m_fbo);
-    }
+    glPopAttrib();
 
-    glPushAttrib(GL_ENABLE_BIT);
-    glPushAttrib(GL_TEXTURE_BIT);
+    m_tex_objs.push_back(tex_obj);
 }
 
-inline TOGL_FontDataGenerator::FrameBuffer::~FrameBuffer() {
-    if (IsOk()) m_glFramebufferTexture2DEXT(TOGL_GL_FRAMEBUFFER_EXT, TOGL_GL_COLOR_ATTACHMENT0_EXT, GL_TEXTURE_2D, 0, 0);
+inline void TOGL_FontAtlas::DeletePages() {
+    for (auto& tex_obj : m_tex_objs) {
+        glDeleteTextures(1, &tex_obj);
+    }
+    m_tex_objs.clear();
+}
 
-    glPopAttrib();
-    glPopAttrib();
+inline void TOGL_FontAtlas::ReservePages(uint32_t page_count) {
+    while (m_tex_objs.size() < page_count) AddPage();
+}
 
-    if (IsOk()) {
-        m_glBindFramebufferEXT(TOGL_GL_FRAMEBUFFER_EXT, m_prev_fbo);
-        m_glDeleteFramebuffersEXT(1, &m_fbo);
-    }
+inline void TOGL_FontAtlas::ClearPage(uint32_t page_ix) {
+    ClearArea(page_ix, {0, 0}, m_packer.GetWidth(), m_packer.GetHeight());
 }
 
-inline GLuint TOGL_FontDataGenerator::FrameBuffer::GenAndBindTex() {
-    GLuint tex_obj = 0;
+inline void TOGL_FontAtlas::ClearArea(uint32_t page_ix, const TOGL_PointU16& pos, uint16_t width, uint16_t height) {
+    if (page_ix < m_tex_objs.size() && width > 0 && height > 0) {
+        const bool is_alpha = m_format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8;
 
-    if (IsOk()) {
-        glGenTextures(1, &tex_obj);
-        glBindTexture(GL_TEXTURE_2D, tex_obj);
-        glDisable(GL_TEXTURE_2D);
+        const std::vector<uint8_t> pixels(size_t(width) * height * (is_alpha ? 1 : 4), 0);
 
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glPushAttrib(GL_TEXTURE_BIT);
+        glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-        m_glFramebufferTexture2DEXT(TOGL_GL_FRAMEBUFFER_EXT, TOGL_GL_COLOR_ATTACHMENT0_EXT, GL_TEXTURE_2D, tex_obj, 0);
-                    
-        if (m_glCheckFramebufferStatusEXT(TOGL_GL_FRAMEBUFFER_EXT) != TOGL_GL_FRAMEBUFFER_COMPLETE_EXT) {
-            AddErrMsg("Frame buffer is not complete.");
+        glBindTexture(GL_TEXTURE_2D, m_tex_objs[page_ix]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, width, height, is_alpha ? GL_ALPHA : GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 
-            m_glFramebufferTexture2DEXT(TOGL_GL_FRAMEBUFFER_EXT, TOGL_GL_COLOR_ATTACHMENT0_EXT, GL_TEXTURE_2D, 0, 0);
-            glDeleteTextures(1, &tex_obj);
-            tex_obj = 0;
-        } 
+        glPopClientAttrib();
+        glPopAttrib();
     }
+}
 
-    return tex_obj;
+//-----------------------------------------------------------------------------
+// TOGL_GlyphCache
+//-----------------------------------------------------------------------------
+
+inline TOGL_GlyphCacheCounters::TOGL_GlyphCacheCounters() {
+    hit_count           = 0;
+    miss_count          = 0;
+    eviction_count      = 0;
+    relocation_count    = 0;
+    compaction_count    = 0;
+    reuse_count         = 0;
 }
 
-inline void TOGL_FontDataGenerator::FrameBuffer::AddErrMsg(const std::string& err_msg) {
-    if (!m_err_msg.empty()) m_err_msg += "\n";
-    m_err_msg += err_msg;
+inline void TOGL_GlyphCacheChanges::Clear() {
+    evicted_codes.clear();
+    repacked_page_ixs.clear();
+    relocated_codes.clear();
+    reused_places.clear();
 }
 
-template <typename Type>
-inline void TOGL_FontDataGenerator::FrameBuffer::Load(Type& function, const std::string& function_name) {
-    function = (Type)wglGetProcAddress(function_name.c_str());
-    if (!function) {
-        AddErrMsg(std::string() + "Can not load function: \"" + function_name + "\".");
-    }
+inline bool TOGL_GlyphCacheChanges::IsEmpty() const {
+    return evicted_codes.empty() && repacked_page_ixs.empty() && relocated_codes.empty() && reused_places.empty();
 }
 
-//-----------------------------------------------------------------------------
+inline TOGL_GlyphCache::TOGL_GlyphCache() {
+    Reset(TOGL_FONT_ATLAS_PACKER_ID_SKYLINE, 0, 0, 0);
+}
 
-inline void TOGL_FontDataGenerator::Initialize() {
-    m_device_context_handle = NULL;
+inline TOGL_GlyphCache::~TOGL_GlyphCache() {
 
-    m_data = {};
 }
 
-inline void TOGL_FontDataGenerator::GenerateFontTextures(uint16_t width, uint16_t height) {
-    FrameBuffer frame_buffer(width, height);
-    GLuint tex_obj = frame_buffer.GenAndBindTex();
+inline void TOGL_GlyphCache::Reset(TOGL_FontAtlasPackerId packer_id, uint16_t page_width, uint16_t page_height, uint32_t page_budget) {
+    m_packer_id     = packer_id;
+    m_page_width    = page_width;
+    m_page_height   = page_height;
+    m_page_budget   = page_budget;
+    m_frame         = 0;
 
-    if (frame_buffer.IsOk()) {
-        m_data.tex_objs.push_back(tex_obj);
+    m_entries.clear();
+    m_pages.clear();
+    m_counters      = {};
+}
 
-        glPushAttrib(GL_VIEWPORT_BIT);
-        glViewport(0, 0, width, height);
+inline bool TOGL_GlyphCache::IsEnabled() const {
+    return m_page_budget != 0;
+}
 
-        glPushAttrib(GL_MATRIX_MODE);
-        glMatrixMode(GL_PROJECTION);
-        glPushMatrix();
-        glLoadIdentity();
-        glOrtho(0, width, 0, height, 1, -1);
-        glMatrixMode(GL_MODELVIEW);
-        glPushMatrix();
-        glLoadIdentity();
+inline void TOGL_GlyphCache::NextFrame() {
+    m_frame += 1;
+}
 
-        glPushAttrib(GL_COLOR_BUFFER_BIT);
-        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+inline uint64_t TOGL_GlyphCache::GetFrame() const {
+    return m_frame;
+}
 
-        glClear(GL_COLOR_BUFFER_BIT);
+inline bool TOGL_GlyphCache::Touch(uint32_t code) {
+    auto it = m_entries.find(code);
+    if (it == m_entries.end()) {
+        m_counters.miss_count += 1;
+        return false;
+    }
+    it->second.last_frame = m_frame;
+    m_counters.hit_count += 1;
+    return true;
+}
 
-        int y = int(height) - int(m_data.font_height);
-        TOGL_PointI pos = {0, y};
- 
-        for (const DisplayListSet& display_list_set : m_display_list_sets) {
-            if (!frame_buffer.IsOk()) {
+inline bool TOGL_GlyphCache::Has(uint32_t code) const {
+    return m_entries.find(code) != m_entries.end();
+}
+
+inline bool TOGL_GlyphCache::Insert(uint32_t code, uint16_t width, uint16_t height, bool is_pinned, TOGL_GlyphCacheChanges& changes) {
+    if (!IsEnabled()) return false;
+
+    if (Has(code)) Evict(code, changes);
+
+    Entry entry = {};
+    entry.page_ix       = NO_PAGE_IX;
+    entry.width         = width;
+    entry.height        = height;
+    entry.place_width   = width;
+    entry.place_height  = height;
+    entry.last_frame    = m_frame;
+    entry.is_pinned     = is_pinned;
+
+    if (width == 0 || height == 0) {
+        m_entries[code] = entry;
+        return true;
+    }
+    if (width > m_page_width || height > m_page_height) return false;
+
+    if (!InsertToPages(entry) && !InsertToFreePlaces(entry, changes)) {
+        // Least recently used glyphs are evicted until glyph fits in place of evicted glyph, 
+        // or until one of pages might have enough of free space after repacking.
+        std::vector<std::pair<uint64_t, uint32_t>> candidates; // last frame, code
+
+        for (const auto& it : m_entries) {
+            const Entry& candidate = it.second;
+            if (candidate.page_ix != NO_PAGE_IX && !candidate.is_pinned && candidate.last_frame < m_frame) {
+                candidates.push_back({candidate.last_frame, it.first});
+            }
+        }
+        std::sort(candidates.begin(), candidates.end());
+
+        const uint64_t area         = uint64_t(width) * height;
+        const uint64_t reserve_area = std::max(area, uint64_t(m_page_width) * m_page_height / 4);
+
+        bool is_inserted = false;
+        for (size_t ix = 0; ix < candidates.size(); ++ix) {
+            auto it = m_entries.find(candidates[ix].second);
+            if (it == m_entries.end()) continue; // already evicted by repacking
+
+            const uint32_t page_ix = it->second.page_ix;
+
+            Evict(candidates[ix].second, changes);
+
+            if (InsertToFreePlaces(entry, changes)) {
+                is_inserted = true;
                 break;
             }
-            for (uint32_t code = display_list_set.unicode_range.from; code <= display_list_set.unicode_range.to; ++code) {
 
-                const TOGL_SizeU16 size = GetCharSize((wchar_t)code);
+            if (m_pages[page_ix].evicted_area >= area) {
+                // Repacking re-uploads all glyphs left in page, so it's done rarely. Next insertions use space reserved now.
+                for (size_t next_ix = ix + 1; next_ix < candidates.size() && m_pages[page_ix].evicted_area < reserve_area; ++next_ix) {
+                    auto next_it = m_entries.find(candidates[next_ix].second);
+                    if (next_it != m_entries.end() && next_it->second.page_ix == page_ix) Evict(candidates[next_ix].second, changes);
+                }
 
-                if ((pos.x + size.width) >= width) {
-                    pos.x = 0;
+                RepackPage(page_ix, changes);
 
-                    if ((pos.y - m_data.font_height) <= 0) {
-                        // run out of space in texture, generate next texture
-                        tex_obj = frame_buffer.GenAndBindTex();
+                if (m_pages[page_ix].packer.Insert(width, height, entry.pos)) {
+                    entry.page_ix   = page_ix;
+                    is_inserted     = true;
+                    break;
+                }
+            }
+        }
 
-                        if (!frame_buffer.IsOk()) {
-                            break;
-                        }
-                        glClear(GL_COLOR_BUFFER_BIT);
+        // Evicted area might be spread over many pages.
+        for (uint32_t page_ix = 0; !is_inserted && page_ix < m_pages.size(); ++page_ix) {
+            if (m_pages[page_ix].evicted_area > 0) {
+                RepackPage(page_ix, changes);
+
+                if (m_pages[page_ix].packer.Insert(width, height, entry.pos)) {
+                    entry.page_ix   = page_ix;
+                    is_inserted     = true;
+                }
+            }
+        }
+
+        if (!is_inserted) return false;
+    }
+
+    m_entries[code] = entry;
+    return true;
+}
+
+inline bool TOGL_GlyphCache::GetPlace(uint32_t code, TOGL_PointU16& pos, uint32_t& page_ix) const {
+    auto it = m_entries.find(code);
+    if (it == m_entries.end() || it->second.page_ix == NO_PAGE_IX) return false;
+
+    pos     = it->second.pos;
+    page_ix = it->second.page_ix;
+    return true;
+}
+
+inline bool TOGL_GlyphCache::CompactPage(TOGL_GlyphCacheChanges& changes, double min_fragmentation) {
+    uint32_t    chosen_page_ix      = NO_PAGE_IX;
+    double      chosen_fragmentation = 0;
+
+    for (uint32_t page_ix = 0; page_ix < m_pages.size(); ++page_ix) {
+        const double fragmentation = GetFragmentation(page_ix);
+
+        if (m_pages[page_ix].evicted_area > 0 && fragmentation >= min_fragmentation && fragmentation > chosen_fragmentation) {
+            chosen_page_ix          = page_ix;
+            chosen_fragmentation    = fragmentation;
+        }
+    }
+
+    if (chosen_page_ix == NO_PAGE_IX) return false;
+
+    RepackPage(chosen_page_ix, changes);
+    return true;
+}
+
+inline double TOGL_GlyphCache::GetFragmentation(uint32_t page_ix) const {
+    const uint64_t page_area = uint64_t(m_page_width) * m_page_height;
+
+    return (page_ix < m_pages.size() && page_area > 0) ? (double(m_pages[page_ix].evicted_area) / page_area) : 0;
+}
+
+inline uint32_t TOGL_GlyphCache::GetPageCount() const {
+    return uint32_t(m_pages.size());
+}
+
+inline uint32_t TOGL_GlyphCache::GetPageBudget() const {
+    return m_page_budget;
+}
+
+inline uint32_t TOGL_GlyphCache::GetGlyphCount() const {
+    return uint32_t(m_entries.size());
+}
+
+inline const TOGL_GlyphCacheCounters& TOGL_GlyphCache::ToCounters() const {
+    return m_counters;
+}
+
+inline bool TOGL_GlyphCache::InsertToPages(Entry& entry) {
+    for (uint32_t page_ix = 0; page_ix < m_pages.size(); ++page_ix) {
+        if (m_pages[page_ix].packer.Insert(entry.width, entry.height, entry.pos)) {
+            entry.page_ix = page_ix;
+            return true;
+        }
+    }
+
+    if (m_pages.size() < m_page_budget) {
+        Page page = {};
+        page.packer.Reset(m_packer_id, m_page_width, m_page_height);
+        m_pages.push_back(page);
+
+        if (m_pages.back().packer.Insert(entry.width, entry.height, entry.pos)) {
+            entry.page_ix = uint32_t(m_pages.size() - 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+inline bool TOGL_GlyphCache::InsertToFreePlaces(Entry& entry, TOGL_GlyphCacheChanges& changes) {
+    uint32_t    chosen_page_ix  = NO_PAGE_IX;
+    size_t      chosen_ix       = 0;
+    uint64_t    chosen_area     = 0;
+
+    for (uint32_t page_ix = 0; page_ix < m_pages.size(); ++page_ix) {
+        const std::vector<FreePlace>& free_places = m_pages[page_ix].free_places;
+
+        for (size_t ix = 0; ix < free_places.size(); ++ix) {
+            const FreePlace&    place   = free_places[ix];
+            const uint64_t      area    = uint64_t(place.width) * place.height;
+
+            if (place.width >= entry.width && place.height >= entry.height && (chosen_page_ix == NO_PAGE_IX || area < chosen_area)) {
+                chosen_page_ix  = page_ix;
+                chosen_ix       = ix;
+                chosen_area     = area;
+            }
+        }
+    }
+
+    if (chosen_page_ix == NO_PAGE_IX) return false;
+
+    Page&           page    = m_pages[chosen_page_ix];
+    const FreePlace place   = page.free_places[chosen_ix];
+
+    page.free_places[chosen_ix] = page.free_places.back();
+    page.free_places.pop_back();
+    page.evicted_area -= chosen_area;
+
+    entry.page_ix       = chosen_page_ix;
+    entry.pos           = place.pos;
+    entry.place_width   = place.width;
+    entry.place_height  = place.height;
+
+    changes.reused_places.push_back({chosen_page_ix, place.pos, place.width, place.height});
+    m_counters.reuse_count += 1;
+    return true;
+}
+
+inline void TOGL_GlyphCache::Evict(uint32_t code, TOGL_GlyphCacheChanges& changes) {
+    auto it = m_entries.find(code);
+    if (it != m_entries.end()) {
+        const Entry& entry = it->second;
+
+        if (entry.page_ix != NO_PAGE_IX) {
+            Page& page = m_pages[entry.page_ix];
+
+            page.evicted_area += uint64_t(entry.place_width) * entry.place_height;
+            page.free_places.push_back({entry.pos, entry.place_width, entry.place_height});
+        }
+        m_entries.erase(it);
+
+        changes.evicted_codes.push_back(code);
+        m_counters.eviction_count += 1;
+    }
+}
+
+inline void TOGL_GlyphCache::RepackPage(uint32_t page_ix, TOGL_GlyphCacheChanges& changes) {
+    std::vector<uint32_t> codes;
+    for (const auto& it : m_entries) {
+        if (it.second.page_ix == page_ix) codes.push_back(it.first);
+    }
+
+    // Tall boxes first, to pack page tightly. Code is compared to keep order independent of hash map.
+    std::sort(codes.begin(), codes.end(), [this](uint32_t a, uint32_t b) {
+        const Entry& entry_a = m_entries[a];
+        const Entry& entry_b = m_entries[b];
+
+        if (entry_a.height != entry_b.height) return entry_a.height > entry_b.height;
+        if (entry_a.width != entry_b.width) return entry_a.width > entry_b.width;
+        return a < b;
+    });
+
+    Page& page = m_pages[page_ix];
+    page.packer.Reset(m_packer_id, m_page_width, m_page_height);
+    page.evicted_area = 0;
+    page.free_places.clear();
+
+    changes.repacked_page_ixs.push_back(page_ix);
+    m_counters.compaction_count += 1;
+
+    for (const uint32_t code : codes) {
+        Entry& entry = m_entries[code];
+
+        if (page.packer.Insert(entry.width, entry.height, entry.pos)) {
+            entry.place_width   = entry.width;
+            entry.place_height  = entry.height;
+
+            changes.relocated_codes.push_back(code);
+            m_counters.relocation_count += 1;
+        } else {
+            // Might happen only when packing order differs from original one.
+            Evict(code, changes);
+        }
+    }
+    // Boxes, which didn't fit, don't occupy any area of repacked page.
+    page.evicted_area = 0;
+    page.free_places.clear();
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_WinGlyphSource
+//-----------------------------------------------------------------------------
+
+// Returns table of font selected in device context or empty vector if font doesn't have this table.
+inline std::vector<uint8_t> _TOGL_GetWinFontTable(HDC device_context_handle, uint32_t tag) {
+    // GetFontData takes tag with reversed byte order.
+    const DWORD win_tag = ((tag & 0xFF) << 24) | ((tag & 0xFF00) << 8) | ((tag >> 8) & 0xFF00) | (tag >> 24);
+
+    const DWORD size = GetFontData(device_context_handle, win_tag, 0, NULL, 0);
+    if (size == GDI_ERROR || size == 0) return {};
+
+    std::vector<uint8_t> table(size);
+    if (GetFontData(device_context_handle, win_tag, 0, table.data(), size) != size) return {};
+
+    return table;
+}
+
+inline TOGL_WinGlyphSource::TOGL_WinGlyphSource(HFONT font_handle, uint32_t font_descent) {
+    m_font_handle           = font_handle;
+    m_font_descent          = font_descent;
+
+    m_device_context_handle = CreateCompatibleDC(NULL);
+    m_old_font_handle       = (HFONT)SelectObject(m_device_context_handle, m_font_handle);
+
+    m_width_block_from      = 0;
+
+    m_is_char_map_requested = false;
+}
+
+inline TOGL_WinGlyphSource::~TOGL_WinGlyphSource() {
+    SelectObject(m_device_context_handle, m_old_font_handle);
+    DeleteObject(m_font_handle);
+    DeleteDC(m_device_context_handle);
+}
+
+inline bool TOGL_WinGlyphSource::GetGlyphBitmap(uint32_t code, TOGL_GlyphBitmap& bitmap) {
+    bitmap = {};
+
+    GLYPHMETRICS    metrics     = {};
+    const MAT2      identity    = {{0, 1}, {0, 0}, {0, 0}, {0, 1}};
+
+    // The same format is used by wglUseFontBitmapsW.
+    UINT character  = (UINT)code;
+    UINT format     = GGO_BITMAP;
+
+    if (code > 0xFFFF) {
+        character = (UINT)ToSupplementaryGlyphIndex(code);
+        if (character == 0) return false;
+
+        format |= GGO_GLYPH_INDEX;
+    }
+
+    const DWORD size = GetGlyphOutlineW(m_device_context_handle, character, format, &metrics, 0, NULL, &identity);
+    if (size == GDI_ERROR) return false;
+
+    // Glyph without visible pixels (for example: space).
+    if (size == 0) return true;
+
+    m_buffer.resize(size);
+    if (GetGlyphOutlineW(m_device_context_handle, character, format, &metrics, size, m_buffer.data(), &identity) == GDI_ERROR) return false;
 
-                        m_data.tex_objs.push_back(tex_obj);
+    bitmap.x        = int16_t(metrics.gmptGlyphOrigin.x);
+    bitmap.y        = int16_t(int(m_font_descent) + metrics.gmptGlyphOrigin.y - int(metrics.gmBlackBoxY));
+    bitmap.width    = uint16_t(metrics.gmBlackBoxX);
+    bitmap.height   = uint16_t(metrics.gmBlackBoxY);
 
-                        //printf("T%d [%04X]\n", (int)m_data.tex_objs.size() - 1, code); // debug
+    bitmap.alphas.resize(size_t(bitmap.width) * bitmap.height);
+
+    // Source: one bit per pixel, rows from top to bottom, each row aligned to 4 bytes.
+    const size_t row_size = ((size_t(bitmap.width) + 31) / 32) * 4;
+
+    for (uint32_t row_ix = 0; row_ix < bitmap.height; ++row_ix) {
+        const uint8_t*  src = m_buffer.data() + row_size * (bitmap.height - 1 - row_ix);
+        uint8_t*        dst = bitmap.alphas.data() + size_t(bitmap.width) * row_ix;
+
+        for (uint32_t ix = 0; ix < bitmap.width; ++ix) {
+            dst[ix] = (src[ix / 8] & (0x80 >> (ix % 8))) ? 255 : 0;
+        }
+    }
+
+    return true;
+}
+
+inline std::shared_ptr<TOGL_GlyphSource> TOGL_WinGlyphSource::Clone() const {
+    LOGFONTW font_description = {};
+    if (GetObjectW(m_font_handle, sizeof(font_description), &font_description) == 0) return nullptr;
+
+    HFONT font_handle = CreateFontIndirectW(&font_description);
+    if (font_handle == NULL) return nullptr;
+
+    return std::make_shared<TOGL_WinGlyphSource>(font_handle, m_font_descent);
+}
+
+inline uint16_t TOGL_WinGlyphSource::GetGlyphWidth(uint32_t code) {
+    if (code > 0xFFFF) {
+        const uint32_t glyph_index = ToSupplementaryGlyphIndex(code);
+
+        INT width = 0;
+        if (glyph_index == 0 || !GetCharWidthI(m_device_context_handle, (UINT)glyph_index, 1, NULL, &width)) return 0;
+        return uint16_t(width);
+    }
+
+    const uint32_t from = code - code % WIDTH_BLOCK_SIZE;
+
+    if (m_width_block.empty() || m_width_block_from != from) {
+        m_width_block.assign(WIDTH_BLOCK_SIZE, 0);
+        m_width_block_from = from;
+
+        if (!GetCharWidth32W(m_device_context_handle, from, from + WIDTH_BLOCK_SIZE - 1, m_width_block.data())) {
+            m_width_block.clear();
+            return 0;
+        }
+    }
+    return uint16_t(m_width_block[code - from]);
+}
+
+inline uint32_t TOGL_WinGlyphSource::ToSupplementaryGlyphIndex(uint32_t code) {
+    if (!m_is_char_map_requested) {
+        m_is_char_map_requested = true;
+
+        const HDC device_context_handle = m_device_context_handle;
+
+        m_char_map_font.Load([device_context_handle](uint32_t tag) {
+            return _TOGL_GetWinFontTable(device_context_handle, tag);
+        });
+    }
+    return m_char_map_font.IsLoaded() ? m_char_map_font.GetGlyphIndex(code) : 0;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_RasterizeGlyphs
+//-----------------------------------------------------------------------------
+
+inline TOGL_RasterizedGlyph::TOGL_RasterizedGlyph() {
+    code        = 0;
+    width       = 0;
+    bitmap_hash = 0;
+}
+
+inline std::vector<TOGL_RasterizedGlyph> TOGL_RasterizeGlyphs(TOGL_GlyphSource& glyph_source, const std::vector<TOGL_UnicodeRange>& ranges, uint32_t thread_count, uint16_t sdf_spread) {
+    // Glyphs differ in complexity, so small batches keep threads busy until the end.
+    enum { BATCH_SIZE = 32 };
+
+    std::vector<TOGL_RasterizedGlyph> glyphs;
+
+    for (const TOGL_UnicodeRange& range : ranges) {
+        for (uint32_t code = range.from; code <= range.to; ++code) {
+            glyphs.push_back({});
+            glyphs.back().code = code;
+        }
+    }
+
+    const uint32_t batch_count = uint32_t((glyphs.size() + BATCH_SIZE - 1) / BATCH_SIZE);
+
+    if (thread_count == 0) thread_count = std::thread::hardware_concurrency();
+    if (thread_count > batch_count) thread_count = batch_count;
+
+    std::atomic<uint32_t> next_batch_ix(0);
+
+    auto RasterizeBatches = [&glyphs, &next_batch_ix, batch_count, sdf_spread](TOGL_GlyphSource& source) {
+        for (uint32_t batch_ix = next_batch_ix++; batch_ix < batch_count; batch_ix = next_batch_ix++) {
+            const size_t from   = size_t(batch_ix) * BATCH_SIZE;
+            const size_t to     = (from + BATCH_SIZE < glyphs.size()) ? (from + BATCH_SIZE) : glyphs.size();
+
+            for (size_t ix = from; ix < to; ++ix) {
+                TOGL_RasterizedGlyph& glyph = glyphs[ix];
+
+                glyph.width = source.GetGlyphWidth(glyph.code);
+
+                if (!source.GetGlyphBitmap(glyph.code, glyph.bitmap)) {
+                    glyph.bitmap = {};
+                } else if (sdf_spread != 0) {
+                    glyph.bitmap = TOGL_MakeDistanceField(glyph.bitmap, sdf_spread);
+                }
+
+                // Hashed by worker threads, so finding duplicates later costs only comparisons.
+                glyph.bitmap_hash = TOGL_HashGlyphBitmap(glyph.bitmap);
+            }
+        }
+    };
+
+    std::vector<std::shared_ptr<TOGL_GlyphSource>> sources;
+
+    for (uint32_t ix = 1; ix < thread_count; ++ix) {
+        std::shared_ptr<TOGL_GlyphSource> source = glyph_source.Clone();
+        if (!source) break;
+
+        sources.push_back(source);
+    }
+
+    std::vector<std::thread> threads;
+
+    for (const auto& source : sources) {
+        threads.push_back(std::thread(RasterizeBatches, std::ref(*source)));
+    }
+
+    RasterizeBatches(glyph_source);
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    return glyphs;
+}
+
+inline std::vector<uint32_t> TOGL_FindDuplicateGlyphs(const std::vector<TOGL_RasterizedGlyph>& glyphs) {
+    std::vector<uint32_t> original_ixs(glyphs.size());
+
+    // Hash of bitmap to indices of first glyphs with such hash (more than one only when bitmaps differ).
+    std::unordered_map<uint64_t, std::vector<uint32_t>> originals;
+
+    for (uint32_t ix = 0; ix < glyphs.size(); ++ix) {
+        const TOGL_GlyphBitmap& bitmap = glyphs[ix].bitmap;
+
+        original_ixs[ix] = ix;
+
+        if (bitmap.width != 0 && bitmap.height != 0) {
+            std::vector<uint32_t>& candidate_ixs = originals[glyphs[ix].bitmap_hash];
+
+            for (const uint32_t candidate_ix : candidate_ixs) {
+                const TOGL_GlyphBitmap& candidate = glyphs[candidate_ix].bitmap;
+
+                if (candidate.width == bitmap.width && candidate.height == bitmap.height && candidate.alphas == bitmap.alphas) {
+                    original_ixs[ix] = candidate_ix;
+                    break;
+                }
+            }
+
+            if (original_ixs[ix] == ix) candidate_ixs.push_back(ix);
+        }
+    }
+
+    return original_ixs;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_FontGL
+//-----------------------------------------------------------------------------
+
+inline TOGL_FontGL::TOGL_FontGL() {
+    m_is_loaded             = false;
+    m_is_instancing_loaded  = false;
+}
+
+inline TOGL_FontGL::~TOGL_FontGL() {
+
+}
+
+inline bool TOGL_FontGL::Load() {
+    if (!m_is_loaded) {
+        m_is_loaded = true;
+
+        Load(togl_glTexImage3D,             "glTexImage3D");
+        Load(togl_glTexSubImage3D,          "glTexSubImage3D");
+        Load(togl_glCopyTexSubImage3D,      "glCopyTexSubImage3D");
+
+        Load(togl_glCreateShader,           "glCreateShader");
+        Load(togl_glShaderSource,           "glShaderSource");
+        Load(togl_glCompileShader,          "glCompileShader");
+        Load(togl_glGetShaderiv,            "glGetShaderiv");
+        Load(togl_glGetShaderInfoLog,       "glGetShaderInfoLog");
+        Load(togl_glDeleteShader,           "glDeleteShader");
+        Load(togl_glCreateProgram,          "glCreateProgram");
+        Load(togl_glAttachShader,           "glAttachShader");
+        Load(togl_glLinkProgram,            "glLinkProgram");
+        Load(togl_glGetProgramiv,           "glGetProgramiv");
+        Load(togl_glGetProgramInfoLog,      "glGetProgramInfoLog");
+        Load(togl_glDeleteProgram,          "glDeleteProgram");
+        Load(togl_glUseProgram,             "glUseProgram");
+        Load(togl_glGetUniformLocation,     "glGetUniformLocation");
+        Load(togl_glUniform1i,              "glUniform1i");
+
+        Load(togl_glGenBuffers,             "glGenBuffers");
+        Load(togl_glDeleteBuffers,          "glDeleteBuffers");
+        Load(togl_glBindBuffer,             "glBindBuffer");
+        Load(togl_glBufferData,             "glBufferData");
+        Load(togl_glMapBuffer,              "glMapBuffer");
+        Load(togl_glUnmapBuffer,            "glUnmapBuffer");
+    }
+    return IsLoaded();
+}
+
+inline bool TOGL_FontGL::IsLoaded() const {
+    return m_is_loaded;
+}
+
+inline bool TOGL_FontGL::LoadInstancing() {
+    if (!m_is_instancing_loaded && Load()) {
+        m_is_instancing_loaded = true;
+
+        Load(togl_glBufferSubData,              "glBufferSubData",              m_is_instancing_loaded);
+        Load(togl_glVertexAttribPointer,        "glVertexAttribPointer",        m_is_instancing_loaded);
+        Load(togl_glVertexAttribIPointer,       "glVertexAttribIPointer",       m_is_instancing_loaded);
+        Load(togl_glEnableVertexAttribArray,    "glEnableVertexAttribArray",    m_is_instancing_loaded);
+        Load(togl_glDisableVertexAttribArray,   "glDisableVertexAttribArray",   m_is_instancing_loaded);
+        Load(togl_glVertexAttribDivisor,        "glVertexAttribDivisor",        m_is_instancing_loaded);
+        Load(togl_glDrawArraysInstanced,        "glDrawArraysInstanced",        m_is_instancing_loaded);
+        Load(togl_glUniform1f,                  "glUniform1f",                  m_is_instancing_loaded);
+    }
+    return IsInstancingLoaded();
+}
+
+inline bool TOGL_FontGL::IsInstancingLoaded() const {
+    return m_is_instancing_loaded;
+}
+
+inline TOGL_GL_Version TOGL_FontGL::GetVersion() {
+    TOGL_GL_Version version = {};
+
+    const char* text = (const char*)glGetString(GL_VERSION);
+    if (!text || sscanf_s(text, "%d.%d", &version.major, &version.minor) != 2) return {};
+
+    return version;
+}
+
+inline GLuint TOGL_FontGL::CreateProgram(const std::string& vertex_shader_source, const std::string& fragment_shader_source, std::string& err_msg) {
+    err_msg = "";
+
+    auto CreateShader = [&](GLenum type, const std::string& source) -> GLuint {
+        const char* text = source.c_str();
+
+        GLuint shader = togl_glCreateShader(type);
+        togl_glShaderSource(shader, 1, &text, NULL);
+        togl_glCompileShader(shader);
+
+        GLint status = GL_FALSE;
+        togl_glGetShaderiv(shader, TOGL_GL_COMPILE_STATUS, &status);
+
+        if (status != GL_TRUE) {
+            GLint length = 0;
+            togl_glGetShaderiv(shader, TOGL_GL_INFO_LOG_LENGTH, &length);
+
+            std::string log(length > 0 ? length : 1, '\0');
+            togl_glGetShaderInfoLog(shader, GLsizei(log.size()), NULL, &log[0]);
+            err_msg += std::string() + "Can not compile " + ((type == TOGL_GL_VERTEX_SHADER) ? "vertex" : "fragment") + " shader: " + log.c_str();
+
+            togl_glDeleteShader(shader);
+            shader = 0;
+        }
+        return shader;
+    };
+
+    GLuint program = 0;
+
+    if (m_is_loaded) {
+        const GLuint vertex_shader      = CreateShader(TOGL_GL_VERTEX_SHADER, vertex_shader_source);
+        const GLuint fragment_shader    = CreateShader(TOGL_GL_FRAGMENT_SHADER, fragment_shader_source);
+
+        if (vertex_shader && fragment_shader) {
+            program = togl_glCreateProgram();
+            togl_glAttachShader(program, vertex_shader);
+            togl_glAttachShader(program, fragment_shader);
+            togl_glLinkProgram(program);
+
+            GLint status = GL_FALSE;
+            togl_glGetProgramiv(program, TOGL_GL_LINK_STATUS, &status);
+
+            if (status != GL_TRUE) {
+                GLint length = 0;
+                togl_glGetProgramiv(program, TOGL_GL_INFO_LOG_LENGTH, &length);
+
+                std::string log(length > 0 ? length : 1, '\0');
+                togl_glGetProgramInfoLog(program, GLsizei(log.size()), NULL, &log[0]);
+                err_msg += std::string() + "Can not link shader program: " + log.c_str();
+
+                togl_glDeleteProgram(program);
+                program = 0;
+            }
+        }
+
+        if (vertex_shader)      togl_glDeleteShader(vertex_shader);
+        if (fragment_shader)    togl_glDeleteShader(fragment_shader);
+    } else {
+        err_msg = "OpenGL functions are not loaded.";
+    }
+
+    return program;
+}
+
+template <typename Type>
+inline void TOGL_FontGL::Load(Type& function, const std::string& function_name) {
+    Load(function, function_name, m_is_loaded);
+}
+
+template <typename Type>
+inline void TOGL_FontGL::Load(Type& function, const std::string& function_name, bool& is_loaded) {
+    function = (Type)wglGetProcAddress(function_name.c_str());
+    if (!function) is_loaded = false;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_FontData
+//-----------------------------------------------------------------------------
+
+inline TOGL_FontData::TOGL_FontData() {
+    info                    = {};
+
+    font_height             = 0;           
+    font_ascent             = 0;           
+    font_descent            = 0;          
+    font_internal_leading   = 0; 
+
+    tex_array_obj           = 0;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_BMFont
+//-----------------------------------------------------------------------------
+
+// Converts position in atlas page (in texels) to texture coordinate.
+inline double _TOGL_ToTexSpace(int pos, uint16_t size) {
+    return pos / double(size);
+}
+
+inline TOGL_BMFont::TOGL_BMFont() {
+    size            = 0;
+
+    line_height     = 0;
+    base            = 0;
+    page_width      = 0;
+    page_height     = 0;
+
+    alpha_channel   = 0;
+}
+
+inline bool TOGL_BMFont::Decode(const uint8_t* data, size_t size) {
+    *this = {};
+
+    if (!data) return false;
+
+    const bool is_decoded = (size >= 3 && memcmp(data, "BMF", 3) == 0) ? DecodeBinary(data, size) : DecodeText((const char*)data, size);
+
+    if (!is_decoded || line_height == 0 || page_width == 0 || page_height == 0 || page_file_names.size() > MAX_PAGE_COUNT) {
+        *this = {};
+        return false;
+    }
+
+    // Texture coordinates of such char would sample outside of its page.
+    chars.erase(std::remove_if(chars.begin(), chars.end(), [this](const Char& c) {
+        return uint32_t(c.x) + c.width > page_width || uint32_t(c.y) + c.height > page_height;
+    }), chars.end());
+
+    return true;
+}
+
+inline TOGL_GlyphData TOGL_BMFont::MakeGlyphData(const Char& c) const {
+    TOGL_GlyphData glyph_data = {};
+
+    // Glyph cell is line_height high, with baseline at base from its top.
+    glyph_data.width        = (c.x_advance > 0) ? uint16_t(c.x_advance) : 0;
+    glyph_data.quad_x       = c.x_offset;
+    glyph_data.quad_y       = int16_t(int(line_height) - c.y_offset - c.height);
+    glyph_data.quad_width   = c.width;
+    glyph_data.quad_height  = c.height;
+
+    // Page is stored with first pixel in left-bottom corner, while char position is relative to left-top corner.
+    glyph_data.x1 = _TOGL_ToTexSpace(c.x, page_width);
+    glyph_data.y1 = _TOGL_ToTexSpace(int(page_height) - c.y - c.height, page_height);
+    glyph_data.x2 = _TOGL_ToTexSpace(c.x + c.width, page_width);
+    glyph_data.y2 = _TOGL_ToTexSpace(int(page_height) - c.y, page_height);
+
+    return glyph_data;
+}
+
+// TGA header (all values little endian):
+//  id length           u8
+//  color map type      u8
+//  image type          u8      (2 - color, 3 - grayscale, 10 - RLE color, 11 - RLE grayscale)
+//  color map           u16 first entry, u16 entry count, u8 entry size (in bits)
+//  image origin        u16 x, u16 y
+//  image size          u16 width, u16 height
+//  pixel size          u8      (in bits)
+//  descriptor          u8      (bit 5 set - first row is top row)
+
+inline bool TOGL_BMFont::DecodePage(const uint8_t* data, size_t size, uint8_t* alphas) const {
+    enum { HEADER_SIZE = 18 };
+
+    if (!data || !alphas || size < HEADER_SIZE) return false;
+
+    auto GetU16 = [data](size_t pos) -> uint16_t {
+        return uint16_t(data[pos] | (data[pos + 1] << 8));
+    };
+
+    const uint8_t   id_length       = data[0];
+    const uint8_t   color_map_type  = data[1];
+    const uint8_t   image_type      = data[2];
+    const uint16_t  map_length      = GetU16(5);
+    const uint8_t   map_entry_size  = data[7];
+    const uint16_t  width           = GetU16(12);
+    const uint16_t  height          = GetU16(14);
+    const uint8_t   pixel_size      = data[16] / 8;
+    const bool      is_top_first    = (data[17] & 0x20) != 0;
+
+    const bool is_rle       = image_type == 10 || image_type == 11;
+    const bool is_grayscale = image_type == 3 || image_type == 11;
+
+    if (color_map_type > 1 || (image_type != 2 && image_type != 3 && image_type != 10 && image_type != 11)) return false;
+    if (is_grayscale ? (pixel_size != 1) : (pixel_size != 3 && pixel_size != 4)) return false;
+    if (width != page_width || height != page_height) return false;
+
+    // Byte of pixel (BGRA order), from which coverage is taken.
+    const uint8_t channel_ix = (pixel_size == 4 && alpha_channel <= 2) ? 3 : (is_grayscale ? 0 : 2);
+
+    size_t pos = HEADER_SIZE + id_length + (color_map_type ? size_t(map_length) * ((map_entry_size + 7) / 8) : 0);
+
+    const size_t pixel_count = size_t(width) * height;
+
+    // Pixels are decoded in order of file, then rows are placed from the bottom.
+    auto Put = [&](size_t ix, uint8_t alpha) {
+        const size_t row = ix / width;
+        const size_t column = ix % width;
+
+        alphas[(is_top_first ? (height - 1 - row) : row) * width + column] = alpha;
+    };
+
+    if (is_rle) {
+        size_t ix = 0;
+
+        while (ix < pixel_count) {
+            if (pos >= size) return false;
+
+            const uint8_t   packet_header   = data[pos++];
+            const size_t    count           = size_t(packet_header & 0x7F) + 1;
+
+            if (count > pixel_count - ix) return false;
+
+            if (packet_header & 0x80) {
+                // Run of one pixel.
+                if (size - pos < pixel_size) return false;
+
+                const uint8_t alpha = data[pos + channel_ix];
+                pos += pixel_size;
+
+                for (size_t run_ix = 0; run_ix < count; ++run_ix) Put(ix++, alpha);
+            } else {
+                if ((size - pos) / pixel_size < count) return false;
+
+                for (size_t raw_ix = 0; raw_ix < count; ++raw_ix) {
+                    Put(ix++, data[pos + channel_ix]);
+                    pos += pixel_size;
+                }
+            }
+        }
+    } else {
+        if (pos > size || (size - pos) / pixel_size < pixel_count) return false;
+
+        for (size_t ix = 0; ix < pixel_count; ++ix) {
+            Put(ix, data[pos + channel_ix]);
+            pos += pixel_size;
+        }
+    }
+
+    return true;
+}
+
+// Text format: one tag per line, followed by key=value pairs separated by spaces. String values are quoted.
+//  info face="Arial" size=32 ...
+//  common lineHeight=32 base=26 scaleW=256 scaleH=256 pages=1 packed=0 alphaChnl=0 ...
+//  page id=0 file="arial_0.tga"
+//  char id=65 x=0 y=0 width=18 height=20 xoffset=0 yoffset=6 xadvance=19 page=0 chnl=15
+
+inline bool TOGL_BMFont::DecodeText(const char* text, size_t text_size) {
+    const char* const end = text + text_size;
+    const char* it = text;
+
+    auto IsSpace = [](char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+    };
+
+    auto IsEqual = [](const char* begin, const char* str_end, const char* str) {
+        const size_t length = strlen(str);
+        return size_t(str_end - begin) == length && memcmp(begin, str, length) == 0;
+    };
+
+    auto ToInt = [](const char* begin, const char* str_end, bool& is_valid) -> int32_t {
+        const bool is_negative = begin < str_end && *begin == '-';
+        if (is_negative) ++begin;
+
+        int64_t value = 0;
+        is_valid = begin < str_end;
+
+        for (; begin < str_end && is_valid; ++begin) {
+            is_valid = *begin >= '0' && *begin <= '9';
+            value = value * 10 + (*begin - '0');
+            if (value > INT32_MAX) is_valid = false;
+        }
+        return int32_t(is_negative ? -value : value);
+    };
+
+    bool        is_ok           = true;
+    bool        is_common_read  = false;
+    uint32_t    page_count      = 0;
+
+    while (it < end && is_ok) {
+        const char* line_end = (const char*)memchr(it, '\n', end - it);
+        if (!line_end) line_end = end;
+
+        while (it < line_end && IsSpace(*it)) ++it;
+
+        const char* tag = it;
+        while (it < line_end && !IsSpace(*it)) ++it;
+        const char* tag_end = it;
+
+        const bool is_info      = IsEqual(tag, tag_end, "info");
+        const bool is_common    = IsEqual(tag, tag_end, "common");
+        const bool is_page      = IsEqual(tag, tag_end, "page");
+        const bool is_char      = IsEqual(tag, tag_end, "char");
+
+        Char        c           = {};
+        int32_t     page_id     = -1;
+        const char* file        = nullptr;
+        const char* file_end    = nullptr;
+
+        // Other tags (like 'chars', 'kernings', 'kerning') are skipped.
+        while ((is_info || is_common || is_page || is_char) && it < line_end && is_ok) {
+            while (it < line_end && IsSpace(*it)) ++it;
+            if (it == line_end) break;
+
+            const char* key = it;
+            while (it < line_end && *it != '=' && !IsSpace(*it)) ++it;
+            const char* key_end = it;
+
+            if (it == line_end || *it != '=') continue;
+            ++it;
+
+            const char* value = it;
+            const char* value_end = it;
+
+            if (it < line_end && *it == '"') {
+                value = ++it;
+                while (it < line_end && *it != '"') ++it;
+                value_end = it;
+                if (it < line_end) ++it;
+            } else {
+                while (it < line_end && !IsSpace(*it)) ++it;
+                value_end = it;
+            }
+
+            // Lists of numbers (like padding=1,1,1,1) aren't used.
+            bool is_valid = true;
+
+            auto Int = [&]() -> int32_t {
+                const int32_t number = ToInt(value, value_end, is_valid);
+                is_ok = is_ok && is_valid;
+                return number;
+            };
+
+            auto Size = [&]() -> uint16_t {
+                const int32_t number = Int();
+                is_ok = is_ok && number > 0 && number <= UINT16_MAX;
+                return uint16_t(number);
+            };
+
+            if (is_info) {
+                if      (IsEqual(key, key_end, "face"))         face.assign(value, value_end);
+                else if (IsEqual(key, key_end, "size"))         size = int16_t(Int());
+            } else if (is_common) {
+                if      (IsEqual(key, key_end, "lineHeight"))   line_height = uint16_t(Int());
+                else if (IsEqual(key, key_end, "base"))         base = uint16_t(Int());
+                else if (IsEqual(key, key_end, "scaleW"))       page_width = Size();
+                else if (IsEqual(key, key_end, "scaleH"))       page_height = Size();
+                else if (IsEqual(key, key_end, "pages"))        page_count = uint32_t(Int());
+                else if (IsEqual(key, key_end, "alphaChnl"))    alpha_channel = uint8_t(Int());
+                else if (IsEqual(key, key_end, "packed"))       is_ok = is_ok && Int() == 0;
+            } else if (is_page) {
+                if      (IsEqual(key, key_end, "id"))           page_id = Int();
+                else if (IsEqual(key, key_end, "file"))         { file = value; file_end = value_end; }
+            } else if (is_char) {
+                if      (IsEqual(key, key_end, "id"))           c.code = uint32_t(Int());
+                else if (IsEqual(key, key_end, "x"))            c.x = uint16_t(Int());
+                else if (IsEqual(key, key_end, "y"))            c.y = uint16_t(Int());
+                else if (IsEqual(key, key_end, "width"))        c.width = uint16_t(Int());
+                else if (IsEqual(key, key_end, "height"))       c.height = uint16_t(Int());
+                else if (IsEqual(key, key_end, "xoffset"))      c.x_offset = int16_t(Int());
+                else if (IsEqual(key, key_end, "yoffset"))      c.y_offset = int16_t(Int());
+                else if (IsEqual(key, key_end, "xadvance"))     c.x_advance = int16_t(Int());
+                else if (IsEqual(key, key_end, "page"))         c.page_ix = uint8_t(Int());
+            }
+        }
+
+        if (is_common) {
+            is_common_read = true;
+            is_ok = is_ok && page_count <= MAX_PAGE_COUNT;
+            if (is_ok) page_file_names.resize(page_count);
+        } else if (is_page) {
+            is_ok = is_ok && file && page_id >= 0 && uint32_t(page_id) < page_file_names.size();
+            if (is_ok) page_file_names[page_id].assign(file, file_end);
+        } else if (is_char) {
+            is_ok = is_ok && is_common_read && c.code <= 0x10FFFF;
+            if (is_ok) chars.push_back(c);
+        }
+
+        it = line_end + (line_end < end ? 1 : 0);
+    }
+
+    return is_ok && is_common_read;
+}
+
+// Binary format (all values little endian):
+//  signature           char[3] "BMF"
+//  version             u8      3
+//  blocks              u8 type, u32 size, size bytes of block
+//      1 info          i16 size, u8 flags, u8 char set, u16 stretch, u8 aa, u8 padding[4], u8 spacing[2], u8 outline, face (null-terminated)
+//      2 common        u16 line height, u16 base, u16 width, u16 height, u16 pages, u8 flags (bit 7 - packed), u8 alpha, u8 red, u8 green, u8 blue
+//      3 pages         file names (null-terminated, one after another)
+//      4 chars         u32 id, u16 x, u16 y, u16 width, u16 height, i16 xoffset, i16 yoffset, i16 xadvance, u8 page, u8 channel (20 bytes each)
+//      5 kerning pairs
+
+inline bool TOGL_BMFont::DecodeBinary(const uint8_t* data, size_t data_size) {
+    enum {
+        VERSION             = 3,
+        BLOCK_HEADER_SIZE   = 5,
+        INFO_FACE_POS       = 14,
+        COMMON_SIZE         = 15,
+        CHAR_SIZE           = 20,
+    };
+
+    if (data_size < 4 || data[3] != VERSION) return false;
+
+    auto GetU16 = [](const uint8_t* bytes) -> uint16_t {
+        return uint16_t(bytes[0] | (bytes[1] << 8));
+    };
+
+    auto GetU32 = [](const uint8_t* bytes) -> uint32_t {
+        return uint32_t(bytes[0]) | (uint32_t(bytes[1]) << 8) | (uint32_t(bytes[2]) << 16) | (uint32_t(bytes[3]) << 24);
+    };
+
+    bool        is_common_read  = false;
+    uint32_t    page_count      = 0;
+    size_t      pos             = 4;
+
+    while (pos < data_size) {
+        if (data_size - pos < BLOCK_HEADER_SIZE) return false;
+
+        const uint8_t   type        = data[pos];
+        const size_t    block_size  = GetU32(data + pos + 1);
+
+        pos += BLOCK_HEADER_SIZE;
+        if (data_size - pos < block_size) return false;
+
+        const uint8_t* block = data + pos;
+
+        switch (type) {
+        case 1:
+            if (block_size < INFO_FACE_POS) return false;
+            size = int16_t(GetU16(block));
+            face.assign((const char*)block + INFO_FACE_POS, strnlen((const char*)block + INFO_FACE_POS, block_size - INFO_FACE_POS));
+            break;
+        case 2:
+            if (block_size < COMMON_SIZE) return false;
+            line_height     = GetU16(block);
+            base            = GetU16(block + 2);
+            page_width      = GetU16(block + 4);
+            page_height     = GetU16(block + 6);
+            page_count      = GetU16(block + 8);
+            alpha_channel   = block[11];
+            if ((block[10] & 0x80) || page_count > MAX_PAGE_COUNT) return false;
+            is_common_read  = true;
+            break;
+        case 3:
+            // All names have the same length.
+            for (size_t name_pos = 0; name_pos < block_size; ) {
+                const size_t length = strnlen((const char*)block + name_pos, block_size - name_pos);
+                page_file_names.push_back(std::string((const char*)block + name_pos, length));
+                name_pos += length + 1;
+            }
+            break;
+        case 4:
+            chars.reserve(block_size / CHAR_SIZE);
+            for (size_t char_pos = 0; char_pos + CHAR_SIZE <= block_size; char_pos += CHAR_SIZE) {
+                const uint8_t* bytes = block + char_pos;
+
+                Char c = {};
+                c.code          = GetU32(bytes);
+                c.x             = GetU16(bytes + 4);
+                c.y             = GetU16(bytes + 6);
+                c.width         = GetU16(bytes + 8);
+                c.height        = GetU16(bytes + 10);
+                c.x_offset      = int16_t(GetU16(bytes + 12));
+                c.y_offset      = int16_t(GetU16(bytes + 14));
+                c.x_advance     = int16_t(GetU16(bytes + 16));
+                c.page_ix       = bytes[18];
+
+                if (c.code > 0x10FFFF) return false;
+                chars.push_back(c);
+            }
+            break;
+        default:
+            break;
+        }
+
+        pos += block_size;
+    }
+
+    return is_common_read && page_file_names.size() == page_count;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_FontDataGenerator
+//-----------------------------------------------------------------------------
+
+inline TOGL_FontDataGenerator::TOGL_FontDataGenerator() {
+    Initialize();
+}
+
+inline TOGL_FontDataGenerator::~TOGL_FontDataGenerator() {
+
+}
+
+inline TOGL_FontData TOGL_FontDataGenerator::Generate(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options) {
+    Start(font_info, options, false);
+    return EndGenerate();
+}
+
+inline void TOGL_FontDataGenerator::BeginGenerate(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options) {
+    Start(font_info, options, true);
+}
+
+inline bool TOGL_FontDataGenerator::ContinueGenerate(double time_budget) {
+    if (m_is_finished) return true;
+
+    if (m_composing.valid()) {
+        if (m_composing.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+        m_composing.get();
+    }
+
+    if (IsOk() && !UploadAtlasPages(time_budget)) return false;
+
+    Finish();
+    return true;
+}
+
+inline TOGL_FontData TOGL_FontDataGenerator::EndGenerate() {
+    if (m_composing.valid()) m_composing.wait();
+
+    while (!ContinueGenerate(1e9)) {}
+
+    TOGL_FontData data = m_data;
+    Initialize();
+
+    return IsOk() ? data : TOGL_FontData();
+}
+
+inline void TOGL_FontDataGenerator::CancelGenerate() {
+    if (m_composing.valid()) m_composing.wait();
+
+    DeleteTextures();
+    Initialize();
+}
+
+inline uint32_t TOGL_FontDataGenerator::GetUploadedPageCount() const {
+    return m_uploaded_page_count;
+}
+
+inline TOGL_FontData TOGL_FontDataGenerator::GenerateFromBMFont(const std::string& file_name, const TOGL_FontLoadOptions& options) {
+    Initialize();
+
+    m_err_msg                       = "";
+    m_data.options                  = TOGL_FontLoadOptions();
+    m_data.options.format           = options.format;
+    m_data.options.is_texture_array = options.is_texture_array;
+
+    TOGL_MappedFile file;
+    TOGL_BMFont     bmfont;
+
+    if (!file.Open(file_name)) {
+        SetErrMsg("Can not open BMFont file \"" + file_name + "\".");
+    } else if (!bmfont.Decode(file.ToData(), file.GetSize())) {
+        SetErrMsg("Can not read BMFont file \"" + file_name + "\".");
+    } else {
+        // Page file names are relative to directory of descriptor file.
+        const size_t        separator_pos   = file_name.find_last_of("/\\");
+        const std::string   dir             = (separator_pos != std::string::npos) ? file_name.substr(0, separator_pos + 1) : "";
+
+        TOGL_FontCache cache;
+
+        cache.font_height           = bmfont.line_height;
+        cache.font_ascent           = bmfont.base;
+        cache.font_descent          = (bmfont.line_height > bmfont.base) ? (bmfont.line_height - bmfont.base) : 0;
+        cache.font_internal_leading = 0;
+        cache.format                = m_data.options.format;
+
+        cache.stats.page_count      = uint32_t(bmfont.page_file_names.size());
+        cache.stats.page_width      = bmfont.page_width;
+        cache.stats.page_height     = bmfont.page_height;
+        cache.stats.texture_size    = uint64_t(cache.GetPageSize()) * cache.stats.page_count;
+
+        // Pages are decoded and uploaded one by one, so only one page is held in memory.
+        if (!CreatePageTextures(cache)) {
+            SetErrMsg("BMFont pages are too big for OpenGL.");
+        } else {
+            const size_t            page_area = size_t(bmfont.page_width) * bmfont.page_height;
+            std::vector<uint8_t>    alphas(page_area);
+            std::vector<uint8_t>    pixels((cache.format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8) ? 0 : cache.GetPageSize());
+
+            for (uint32_t ix = 0; ix < cache.stats.page_count && IsOk(); ++ix) {
+                const std::string   page_file_name  = dir + bmfont.page_file_names[ix];
+                TOGL_MappedFile     page_file;
+
+                if (!page_file.Open(page_file_name)) {
+                    SetErrMsg("Can not open BMFont page file \"" + page_file_name + "\".");
+                } else if (!bmfont.DecodePage(page_file.ToData(), page_file.GetSize(), alphas.data())) {
+                    SetErrMsg("Can not read BMFont page file \"" + page_file_name + "\".");
+                } else if (cache.format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8) {
+                    UploadPage(ix, alphas.data());
+                } else {
+                    AlphasToPixels(alphas.data(), page_area, pixels.data());
+                    UploadPage(ix, pixels.data());
+                }
+            }
+
+            if (!IsOk()) DeleteTextures();
+        }
+
+        if (IsOk()) {
+            TOGL_UnicodeRangeSet codes;
+
+            cache.glyphs.reserve(bmfont.chars.size());
+            for (const TOGL_BMFont::Char& c : bmfont.chars) {
+                if (c.page_ix < cache.stats.page_count) {
+                    cache.glyphs.push_back({c.code, c.page_ix, bmfont.MakeGlyphData(c)});
+                    cache.stats.used_area += uint64_t(c.width) * c.height;
+
+                    codes.Add({c.code, c.code});
+                }
+            }
+            cache.stats.glyph_count = uint32_t(cache.glyphs.size());
+
+            m_data.info.name                = bmfont.face;
+            m_data.info.size                = (bmfont.size < 0) ? uint32_t(-bmfont.size) : uint32_t(bmfont.size);
+            m_data.info.size_unit           = TOGL_FONT_SIZE_UNIT_ID_PIXELS;
+            m_data.info.unicode_range_group = TOGL_UnicodeRangeGroup(codes.ToRanges());
+
+            SetCacheGlyphs(cache);
+        }
+    }
+
+    m_is_finished = true;
+
+    return EndGenerate();
+}
+
+inline void TOGL_FontDataGenerator::Start(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options, bool is_async) {
+    Initialize();
+
+    m_err_msg           = "";
+    m_data.info         = font_info;
+    m_data.options      = options;
+
+    if (options.glyph_cache_page_budget != 0) m_data.options.is_lazy = true;
+
+    m_is_cache_used     = !options.cache_dir.empty() && !m_data.options.is_lazy;
+    m_cache_key         = m_is_cache_used ? MakeCacheKey(font_info, options) : TOGL_FontCache::MakeKey(font_info, options);
+
+    if (m_is_cache_used) {
+        m_cache_file_name = options.cache_dir;
+        if (m_cache_file_name[m_cache_file_name.length() - 1] != '/' && m_cache_file_name[m_cache_file_name.length() - 1] != '\\') {
+            m_cache_file_name += "/";
+        }
+        m_cache_file_name += TOGL_FontCache::MakeFileName(m_cache_key);
+
+        if (LoadFromCache(m_cache_file_name, m_cache_key)) {
+            if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
+                TOGL_LogDebug("Font has been loaded from cache file \"" + m_cache_file_name + "\".");
+            }
+
+            m_is_cache_used = false;
+            m_is_finished   = true;
+            return;
+        }
+        m_data = {};
+        m_data.info         = font_info;
+        m_data.options      = options;
+    }
+
+    m_max_page_size = QueryMaxPageSize();
+
+    _TOGL_WindowInnerAccessor& window_inner_accessor = TOGL_ToWindow();
+    HWND window_handle = window_inner_accessor.ToHWND();
+
+    m_device_context_handle = GetDC(window_handle);
+    
+    UINT old_text_align = SetTextAlign(m_device_context_handle, TA_LEFT | TA_TOP | TA_NOUPDATECP);
+    if (old_text_align == GDI_ERROR) {
+        SetErrMsg("Can set window device context text aling.");
+
+    } else {
+        int old_map_mode = SetMapMode(m_device_context_handle, MM_TEXT);
+        if (old_map_mode == 0) {
+            SetErrMsg("Can set window device context map mode.");
+
+        } else {
+            HFONT font_handle = CreateWinFont(font_info);
+
+            if (font_handle == NULL) {
+                SetErrMsg("Can not create font source.");
+            } else {
+                HFONT old_font_handle = (HFONT)SelectObject(m_device_context_handle, font_handle); 
+
+                // --- Gets Font Metrics --- //
+                TEXTMETRICW metric;
+                GetTextMetricsW(m_device_context_handle, &metric);
+                m_data.font_height              = metric.tmHeight;
+                m_data.font_ascent              = metric.tmAscent;
+                m_data.font_descent             = metric.tmDescent;
+                m_data.font_internal_leading    = metric.tmInternalLeading;
+
+                // debug section
+                //togl_print_i32(m_data.font_height);
+                //togl_print_i32(m_data.font_ascent);
+                //togl_print_i32(m_data.font_descent);
+                //togl_print_i32(m_data.font_internal_leading);
+
+                // Note: Requested font size (requested_font_height) might be different from created font size (m_data.font_height).
+
+                // --- Generates Display Lists and Intermediary Font Bitmaps --- //
+
+                TOGL_UnicodeRangeSet requested_codes;
+                for (TOGL_UnicodeRange range : m_data.info.unicode_range_group.ToRanges()) {
+                    if (range.from > 0x10FFFF || range.to > 0x10FFFF) {
+                            SetErrMsg("Unicode code point is out of supported range. Supported unicode code point range is from 0000 to (including) 10FFFF. ");
+                            break;
+                    }
+                    requested_codes.Add(range);
+                }
+
+                // Function wglUseFontBitmapsW have problem with generating font bitmap when FFFF code point is present in range.
+                // Workaround: Remove this code point from range, since it's a non-character code point. 
+                requested_codes.Remove(0xFFFF);
+
+                // Only code points, which font has glyphs for, get place in atlas. Others are resolved to one shared fallback glyph.
+                // Requested fallback code points are kept, so fallback glyph is rendered by font even if font doesn't have them.
+                TOGL_UnicodeRangeSet codes = GetCoveredCodes(m_device_context_handle, requested_codes);
+
+                for (const uint32_t code : {TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER}) {
+                    if (requested_codes.Contains(code)) codes.Add(code);
+                }
+
+                if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
+                    TOGL_LogDebug("Font coverage: requested=" + std::to_string(requested_codes.GetCodeCount()) + ", covered=" + std::to_string(codes.GetCodeCount()) + " code points.");
+                }
+
+                const std::vector<TOGL_UnicodeRange>& ranges = codes.ToRanges();
+                const bool is_supplementary = !ranges.empty() && ranges.back().to > 0xFFFF;
+
+                // Function wglUseFontBitmapsW accepts only code points from Basic Multilingual Plane, 
+                // so supplementary planes are always rasterized by glyph source.
+                // Glyphs from display lists are rendered to RGBA frame buffer, so single channel atlas is also composed from glyph source.
+                const bool is_alpha = options.format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8;
+
+                if (IsOk() && (is_supplementary || is_async || is_alpha || m_data.options.is_lazy || options.is_sdf || options.rasterizer == TOGL_FONT_RASTERIZER_ID_TRUE_TYPE || options.thread_count != 1)) {
+                    glPushAttrib(GL_ALL_ATTRIB_BITS);
+
+                    CreateGlyphSource(font_info);
+
+                    if (IsOk() && m_data.options.is_lazy) {
+                        GenerateGlyphMetrics(ranges);
+
+                    } else if (IsOk()) {
+                        m_is_staged = true;
+
+                        if (is_async) {
+                            // Until pages are composed, generator members (except of composing) are used only by background thread.
+                            m_composing = std::async(std::launch::async, &TOGL_FontDataGenerator::ComposeAtlasPages, this, ranges);
+                        } else {
+                            ComposeAtlasPages(ranges);
+                        }
+                    }
+
+                    glPopAttrib();
+
+                } else if (IsOk()) {
+                    glPushAttrib(GL_ALL_ATTRIB_BITS);
+
+                    for (const auto& range : ranges) {
+                        //LogDebug(std::string() + "[" + HexToStr(range.from) + ".." + HexToStr(range.to) + "]"); // debug
+
+                        DisplayListSet display_list_set(range.from, range.to);
+
+                        display_list_set.first  = display_list_set.unicode_range.from;
+                        display_list_set.range  = GLsizei(display_list_set.unicode_range.to - display_list_set.unicode_range.from + 1);
+                        display_list_set.base   = glGenLists(display_list_set.range);
+
+                        if (display_list_set.base == 0) {
+                            SetErrMsg(std::string() + "Can not generate display list for unicode range [" + TOGL_HexToStr(display_list_set.unicode_range.from) + ".." + TOGL_HexToStr(display_list_set.unicode_range.to) + "].");
+                            break;
+                        }
+
+                        bool is_success = wglUseFontBitmapsW(m_device_context_handle, display_list_set.first, display_list_set.range, display_list_set.base);
+
+                        // Workaround for strange behavior. For POPUP window first call of wglUseFontBitmapsA fail with GetError() = 0.
+                        // Second call, right after first, seams to succeed.
+                        if (!is_success) is_success = wglUseFontBitmapsW(m_device_context_handle, display_list_set.first, display_list_set.range, display_list_set.base);
+
+                        if (!is_success) {
+                            SetErrMsg("Error: Can not create intermediary font bitmap for unicode range [" + TOGL_HexToStr(display_list_set.unicode_range.from) + ".." + TOGL_HexToStr(display_list_set.unicode_range.to) + "].");
+                            break;
+                        }
+
+                        m_display_list_sets.push_back(display_list_set);
+                    }
+
+                    // --- Generate Font Textures --- //
+
+                    if (IsOk()) {
+                        GenerateFontTextures();
+                    }
+
+                    m_data.glyphs.ResolveFallback({TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER}, MakeMissingGlyphData());
+
+                    // --- Destroys Display Lists and Clears Ranges --- //
+
+                    for (auto& display_list_set : m_display_list_sets) {
+                        glDeleteLists(display_list_set.base, display_list_set.range);
+                    }
+                    m_display_list_sets.clear();
+
+                    glPopAttrib();
+                }
+                SelectObject(m_device_context_handle, old_font_handle);
+                DeleteObject(font_handle);
+            }
+            SetMapMode(m_device_context_handle, old_map_mode);
+        }
+        SetTextAlign(m_device_context_handle, old_text_align);
+    } 
+
+    ReleaseDC(window_handle, m_device_context_handle);
+    m_device_context_handle = NULL;
+
+    if (!m_is_staged || !IsOk()) Finish();
+}
+
+inline void TOGL_FontDataGenerator::Finish() {
+    if (m_is_staged && IsOk()) {
+        const bool is_texture_array = m_data.tex_array_obj != 0;
+
+        for (const GlyphLayout& layout : m_layouts) {
+            const GLuint tex_obj = is_texture_array ? m_data.tex_array_obj : m_data.tex_objs[layout.page_ix];
+
+            m_data.glyphs.Set(layout.code, MakeGlyphData(layout, tex_obj, m_page_size));
+        }
+
+        // All glyphs are in atlas, glyph source is needed only by lazy loading.
+        m_data.glyph_source = nullptr;
+
+        m_data.glyphs.ResolveFallback({TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER}, MakeMissingGlyphData());
+    }
+
+    m_is_staged = false;
+    m_layouts.clear();
+    m_page_alphas.clear();
+
+    if (IsOk() && m_is_cache_used) {
+        SaveToCache(m_cache_file_name, m_cache_key);
+    }
+
+    m_is_finished = true;
+}
+
+inline bool TOGL_FontDataGenerator::IsOk() const {
+    return m_err_msg.empty();
+}
+
+inline std::string TOGL_FontDataGenerator::GetErrMsg() const {
+    return m_err_msg;
+}
+
+//-----------------------------------------------------------------------------
+
+inline TOGL_FontDataGenerator::DisplayListSet::DisplayListSet() {
+    first      = 0;
+    range      = 0;
+    base       = 0; 
+}
+
+inline TOGL_FontDataGenerator::DisplayListSet::DisplayListSet(uint32_t code) {
+    unicode_range = TOGL_UnicodeRange(code);
+
+    first      = 0;
+    range      = 0;
+    base       = 0; 
+}
+
+inline TOGL_FontDataGenerator::DisplayListSet::DisplayListSet(uint32_t from, uint32_t to) {
+    unicode_range = TOGL_UnicodeRange(from, to);
+
+    first      = 0;
+    range      = 0;
+    base       = 0; 
+}
+
+//-----------------------------------------------------------------------------
+
+inline TOGL_FontDataGenerator::FrameBuffer::FrameBuffer(uint16_t width, uint16_t height) {
+    Load(m_glGenFramebuffersEXT, "glGenFramebuffersEXT");
+    Load(m_glDeleteFramebuffersEXT, "glDeleteFramebuffersEXT");
+    Load(m_glBindFramebufferEXT, "glBindFramebufferEXT");
+    Load(m_glFramebufferTexture2DEXT, "glFramebufferTexture2DEXT");
+    Load(m_glCheckFramebufferStatusEXT, "glCheckFramebufferStatusEXT");
+                    
+    m_width     = width;
+    m_height    = height;
+
+    if (IsOk()) {
+        GLint max_viewport_size[2] = {};
+        glGetIntegerv(GL_MAX_VIEWPORT_DIMS, max_viewport_size);
+        GLint max_texture_size = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+
+        if (width > max_viewport_size[0] || width > max_texture_size || height > max_viewport_size[1] || height > max_texture_size) {
+            AddErrMsg(std::string() + "Value of width or/and height are to big. ("
+                "max_viewport_width=" + std::to_string(max_viewport_size[0]) + 
+                ", max_viewport_height=" + std::to_string(max_viewport_size[1]) + 
+                ", max_texture_width=" + std::to_string(max_texture_size) + 
+                ", max_texture_height=" + std::to_string(max_texture_size) + 
+                ")"
+            );
+        }
+    }
+
+    m_fbo       = 0;
+    m_prev_fbo  = 0;
+
+    if (IsOk()) {
+        m_glGenFramebuffersEXT(1, &m_fbo);
+
+        glGetIntegerv(TOGL_GL_FRAMEBUFFER_BINDING, (GLint*)&m_prev_fbo);
+        m_glBindFramebufferEXT(TOGL_GL_FRAMEBUFFER_EXT, m_fbo);
+    }
+
+    glPushAttrib(GL_ENABLE_BIT);
+    glPushAttrib(GL_TEXTURE_BIT);
+}
+
+inline TOGL_FontDataGenerator::FrameBuffer::~FrameBuffer() {
+    if (IsOk()) m_glFramebufferTexture2DEXT(TOGL_GL_FRAMEBUFFER_EXT, TOGL_GL_COLOR_ATTACHMENT0_EXT, GL_TEXTURE_2D, 0, 0);
+
+    glPopAttrib();
+    glPopAttrib();
+
+    if (IsOk()) {
+        m_glBindFramebufferEXT(TOGL_GL_FRAMEBUFFER_EXT, m_prev_fbo);
+        m_glDeleteFramebuffersEXT(1, &m_fbo);
+    }
+}
+
+inline GLuint TOGL_FontDataGenerator::FrameBuffer::GenAndBindTex() {
+    GLuint tex_obj = 0;
+
+    if (IsOk()) {
+        glGenTextures(1, &tex_obj);
+        glBindTexture(GL_TEXTURE_2D, tex_obj);
+        glDisable(GL_TEXTURE_2D);
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, m_width, m_height, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+
+        m_glFramebufferTexture2DEXT(TOGL_GL_FRAMEBUFFER_EXT, TOGL_GL_COLOR_ATTACHMENT0_EXT, GL_TEXTURE_2D, tex_obj, 0);
+                    
+        if (m_glCheckFramebufferStatusEXT(TOGL_GL_FRAMEBUFFER_EXT) != TOGL_GL_FRAMEBUFFER_COMPLETE_EXT) {
+            AddErrMsg("Frame buffer is not complete.");
+
+            m_glFramebufferTexture2DEXT(TOGL_GL_FRAMEBUFFER_EXT, TOGL_GL_COLOR_ATTACHMENT0_EXT, GL_TEXTURE_2D, 0, 0);
+            glDeleteTextures(1, &tex_obj);
+            tex_obj = 0;
+        } 
+    }
+
+    return tex_obj;
+}
+
+inline void TOGL_FontDataGenerator::FrameBuffer::AddErrMsg(const std::string& err_msg) {
+    if (!m_err_msg.empty()) m_err_msg += "\n";
+    m_err_msg += err_msg;
+}
+
+template <typename Type>
+inline void TOGL_FontDataGenerator::FrameBuffer::Load(Type& function, const std::string& function_name) {
+    function = (Type)wglGetProcAddress(function_name.c_str());
+    if (!function) {
+        AddErrMsg(std::string() + "Can not load function: \"" + function_name + "\".");
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+inline void TOGL_FontDataGenerator::Initialize() {
+    m_device_context_handle = NULL;
+
+    m_data                  = {};
+
+    m_max_page_size         = 0;
+
+    m_is_cache_used         = false;
+    m_cache_key             = 0;
+    m_cache_file_name       = "";
+
+    m_is_finished           = false;
+
+    m_is_staged             = false;
+    m_composing             = std::future<void>();
+    m_layouts.clear();
+    m_page_alphas.clear();
+    m_page_count            = 0;
+    m_page_size             = {};
+    m_uploaded_page_count   = 0;
+    m_is_upload_started     = false;
+}
+
+inline void TOGL_FontDataGenerator::GenerateFontTextures() {
+    const TOGL_FontLoadOptions& options = m_data.options;
+
+    // --- Measures Glyphs --- //
+
+    std::vector<GlyphLayout> layouts;
+
+    for (const DisplayListSet& display_list_set : m_display_list_sets) {
+        for (uint32_t code = display_list_set.unicode_range.from; code <= display_list_set.unicode_range.to; ++code) {
+            layouts.push_back(MeasureGlyph(display_list_set, code));
+        }
+    }
+
+    // --- Packs Glyphs --- //
+
+    TOGL_SizeU16 page_size;
+    const uint32_t page_count = PackGlyphs(layouts, page_size);
+
+    if (!IsOk()) return;
+
+    // --- Renders Glyphs to Atlas Pages --- //
+
+    std::vector<std::vector<const GlyphLayout*>> pages(page_count);
+    for (const GlyphLayout& layout : layouts) {
+        pages[layout.page_ix].push_back(&layout);
+    }
+
+    const uint16_t width    = page_size.width;
+    const uint16_t height   = page_size.height;
+
+    FrameBuffer frame_buffer(width, height);
+
+    if (frame_buffer.IsOk()) {
+        glPushAttrib(GL_VIEWPORT_BIT);
+        glViewport(0, 0, width, height);
+
+        glPushAttrib(GL_MATRIX_MODE);
+        glMatrixMode(GL_PROJECTION);
+        glPushMatrix();
+        glLoadIdentity();
+        glOrtho(0, width, 0, height, 1, -1);
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glLoadIdentity();
+
+        glPushAttrib(GL_COLOR_BUFFER_BIT);
+        glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+
+        const bool      is_texture_array    = options.is_texture_array && IsTextureArraySupported(page_count);
+        const uint64_t  page_texture_size   = uint64_t(width) * height * 4;
+
+        if (is_texture_array) {
+            glGenTextures(1, &m_data.tex_array_obj);
+            glBindTexture(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, m_data.tex_array_obj);
+
+            glTexParameteri(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+            m_gl.togl_glTexImage3D(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8, width, height, page_count, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        } else {
+            m_data.options.is_texture_array = false;
+        }
+
+        for (uint32_t page_ix = 0; page_ix < page_count; ++page_ix) {
+            const auto& page = pages[page_ix];
+
+            GLuint tex_obj = frame_buffer.GenAndBindTex();
+
+            if (!frame_buffer.IsOk()) {
+                break;
+            }
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            for (const GlyphLayout* layout : page) {
+                if (layout->box_width != 0 && layout->box_height != 0) {
+                    // Glyph bitmap is drawn from baseline of glyph cell.
+                    RenderGlyphToTexture(
+                        layout->display_list_set->base, 
+                        int(layout->pos.x) - layout->box_x, 
+                        int(layout->pos.y) - layout->box_y + int(m_data.font_descent), 
+                        (wchar_t)(layout->code - layout->display_list_set->first) // corrects character code to match glyph index in display list
+                    );
+                }
+            }
+
+            if (is_texture_array) {
+                // Copies page from frame buffer to layer.
+                glBindTexture(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, m_data.tex_array_obj);
+                m_gl.togl_glCopyTexSubImage3D(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, 0, 0, 0, page_ix, 0, 0, width, height);
+
+                glDeleteTextures(1, &tex_obj);
+                tex_obj = m_data.tex_array_obj;
+            } else {
+                m_data.tex_objs.push_back(tex_obj);
+            }
+
+            m_data.stats.texture_size += page_texture_size;
+
+            for (const GlyphLayout* layout : page) {
+                m_data.glyphs.Set(layout->code, MakeGlyphData(*layout, tex_obj, page_size));
+            }
+        }
+
+        glMatrixMode(GL_PROJECTION);
+        glPopMatrix();
+        glMatrixMode(GL_MODELVIEW);
+        glPopMatrix();
+                    
+        glPopAttrib();
+        glPopAttrib();
+        glPopAttrib();
+    }
+
+    if (!frame_buffer.IsOk()) {
+        SetErrMsg(frame_buffer.GetErrMsg());
+    }
+}
+
+inline void TOGL_FontDataGenerator::ComposeAtlasPages(const std::vector<TOGL_UnicodeRange>& ranges) {
+    const TOGL_FontLoadOptions& options = m_data.options;
+
+    // --- Rasterizes Glyphs --- //
+
+    const std::vector<TOGL_RasterizedGlyph> glyphs = TOGL_RasterizeGlyphs(*m_data.glyph_source, ranges, options.thread_count, options.is_sdf ? options.sdf_spread : 0);
+
+    m_layouts.clear();
+    m_layouts.reserve(glyphs.size());
+
+    for (const TOGL_RasterizedGlyph& glyph : glyphs) {
+        GlyphLayout layout = {};
+
+        layout.code         = glyph.code;
+        layout.width        = glyph.width;
+        layout.box_x        = glyph.bitmap.x;
+        layout.box_y        = glyph.bitmap.y;
+        layout.box_width    = glyph.bitmap.width;
+        layout.box_height   = glyph.bitmap.height;
+
+        m_layouts.push_back(layout);
+    }
+
+    // --- Deduplicates Glyphs --- //
+
+    // Identical bitmaps (blanks, control characters, look-alike letters) share one place in atlas. 
+    // Each glyph keeps its own position in glyph cell and width.
+    const std::vector<uint32_t> original_ixs = TOGL_FindDuplicateGlyphs(glyphs);
+
+    for (size_t ix = 0; ix < m_layouts.size(); ++ix) {
+        if (original_ixs[ix] != ix) {
+            m_layouts[ix].is_duplicate  = true;
+            m_layouts[ix].original_ix   = original_ixs[ix];
+        }
+    }
+
+    // --- Packs Glyphs --- //
+
+    m_page_count = PackGlyphs(m_layouts, m_page_size);
+
+    if (!IsOk()) return;
+
+    // --- Composes Atlas Pages --- //
+
+    const uint16_t  width       = m_page_size.width;
+    const size_t    page_area   = size_t(width) * m_page_size.height;
+
+    m_page_alphas.assign(page_area * m_page_count, 0);
+
+    for (size_t ix = 0; ix < m_layouts.size(); ++ix) {
+        const GlyphLayout&      layout = m_layouts[ix];
+        const TOGL_GlyphBitmap& bitmap = glyphs[ix].bitmap;
+
+        if (layout.is_duplicate) continue;
+
+        for (uint32_t row_ix = 0; row_ix < bitmap.height; ++row_ix) {
+            const uint8_t*  src = bitmap.alphas.data() + size_t(bitmap.width) * row_ix;
+            uint8_t*        dst = m_page_alphas.data() + page_area * layout.page_ix + size_t(width) * (layout.pos.y + row_ix) + layout.pos.x;
+
+            std::copy(src, src + bitmap.width, dst);
+        }
+    }
+}
+
+inline bool TOGL_FontDataGenerator::UploadAtlasPages(double time_budget) {
+    const auto start = std::chrono::steady_clock::now();
+
+    const TOGL_FontLoadOptions& options = m_data.options;
+
+    const uint16_t  width               = m_page_size.width;
+    const uint16_t  height              = m_page_size.height;
+    const size_t    page_area           = size_t(width) * height;
+    const bool      is_alpha            = options.format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8;
+    const uint64_t  page_texture_size   = uint64_t(page_area) * (is_alpha ? 1 : 4);
+
+    glPushAttrib(GL_TEXTURE_BIT);
+    glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (!m_is_upload_started) {
+        m_is_upload_started = true;
+
+        if (options.is_texture_array && IsTextureArraySupported(m_page_count)) {
+            glGenTextures(1, &m_data.tex_array_obj);
+            glBindTexture(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, m_data.tex_array_obj);
+
+            glTexParameteri(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GetTextureFilter(options));
+            glTexParameteri(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GetTextureFilter(options));
+            m_gl.togl_glTexImage3D(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, 0, is_alpha ? GL_ALPHA8 : GL_RGBA8, width, height, m_page_count, 0, is_alpha ? GL_ALPHA : GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        } else {
+            m_data.options.is_texture_array = false;
+        }
+    }
+
+    const bool is_texture_array = m_data.tex_array_obj != 0;
+
+    // Driver copies pixels from pixel buffer object to texture asynchronously, so texture upload returns sooner.
+    const TOGL_GL_Version   version = TOGL_FontGL::GetVersion();
+    const bool              is_pbo  = (version.major > 2 || (version.major == 2 && version.minor >= 1)) && m_gl.Load();
+
+    GLuint pbo = 0;
+    if (is_pbo) {
+        m_gl.togl_glGenBuffers(1, &pbo);
+        m_gl.togl_glBindBuffer(TOGL_FontGL::TOGL_GL_PIXEL_UNPACK_BUFFER, pbo);
+    }
+
+    std::vector<uint8_t> pixels;
+
+    while (m_uploaded_page_count < m_page_count) {
+        const uint32_t  page_ix     = m_uploaded_page_count;
+        const uint8_t*  page_alphas = m_page_alphas.data() + page_area * page_ix;
+
+        const void* data = NULL;
+
+        if (pbo != 0) {
+            // Previous content of buffer is orphaned, so mapping doesn't wait for previous upload.
+            m_gl.togl_glBufferData(TOGL_FontGL::TOGL_GL_PIXEL_UNPACK_BUFFER, ptrdiff_t(page_texture_size), NULL, TOGL_FontGL::TOGL_GL_STREAM_DRAW);
+
+            uint8_t* buffer = (uint8_t*)m_gl.togl_glMapBuffer(TOGL_FontGL::TOGL_GL_PIXEL_UNPACK_BUFFER, TOGL_FontGL::TOGL_GL_WRITE_ONLY);
+
+            if (buffer) {
+                if (is_alpha) {
+                    std::copy(page_alphas, page_alphas + page_area, buffer);
+                } else {
+                    AlphasToPixels(page_alphas, page_area, buffer);
+                }
+            }
+
+            if (!buffer || !m_gl.togl_glUnmapBuffer(TOGL_FontGL::TOGL_GL_PIXEL_UNPACK_BUFFER)) {
+                // Buffer can't be used, pixels are uploaded from client memory.
+                m_gl.togl_glBindBuffer(TOGL_FontGL::TOGL_GL_PIXEL_UNPACK_BUFFER, 0);
+                m_gl.togl_glDeleteBuffers(1, &pbo);
+                pbo = 0;
+            }
+        }
+
+        if (pbo == 0) {
+            if (!is_alpha) AlphasToPixels(page_alphas, page_area, pixels);
+
+            data = is_alpha ? (const void*)page_alphas : (const void*)pixels.data();
+        }
+
+        if (is_texture_array) {
+            glBindTexture(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, m_data.tex_array_obj);
+            m_gl.togl_glTexSubImage3D(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, 0, 0, 0, page_ix, width, height, 1, is_alpha ? GL_ALPHA : GL_RGBA, GL_UNSIGNED_BYTE, data);
+        } else {
+            GLuint tex_obj = 0;
+            glGenTextures(1, &tex_obj);
+            glBindTexture(GL_TEXTURE_2D, tex_obj);
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GetTextureFilter(options));
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GetTextureFilter(options));
+            glTexImage2D(GL_TEXTURE_2D, 0, is_alpha ? GL_ALPHA8 : GL_RGBA8, width, height, 0, is_alpha ? GL_ALPHA : GL_RGBA, GL_UNSIGNED_BYTE, data);
+
+            m_data.tex_objs.push_back(tex_obj);
+        }
+
+        m_data.stats.texture_size += page_texture_size;
+        m_uploaded_page_count += 1;
+
+        if (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() >= time_budget) break;
+    }
+
+    if (pbo != 0) {
+        m_gl.togl_glBindBuffer(TOGL_FontGL::TOGL_GL_PIXEL_UNPACK_BUFFER, 0);
+        m_gl.togl_glDeleteBuffers(1, &pbo);
+    }
+
+    glPopClientAttrib();
+    glPopAttrib();
+
+    return m_uploaded_page_count == m_page_count;
+}
+
+inline void TOGL_FontDataGenerator::GenerateGlyphMetrics(const std::vector<TOGL_UnicodeRange>& ranges) {
+    for (const TOGL_UnicodeRange& range : ranges) {
+        for (uint32_t code = range.from; code <= range.to; ++code) {
+            TOGL_GlyphData glyph_data = {};
+
+            glyph_data.width        = m_data.glyph_source->GetGlyphWidth(code);
+            glyph_data.is_pending   = true;
+
+            m_data.glyphs.Set(code, glyph_data);
+        }
+    }
+
+    // Number of pages is unknown, so pages are separate textures.
+    m_data.options.is_texture_array = false;
+
+    if (m_data.options.glyph_cache_page_budget != 0 && m_data.options.shared_atlas) {
+        SetErrMsg("Glyph cache can't be used with shared atlas.");
+        return;
+    }
+
+    m_data.atlas = m_data.options.shared_atlas ? m_data.options.shared_atlas : std::make_shared<TOGL_FontAtlas>();
+
+    if (!m_data.atlas->IsInitialized()) {
+        // Page fits about 256 glyphs, only a small part of big character set is expected to be used.
+        TOGL_SizeU16 page_size = ChoosePageSize(uint64_t(m_data.font_height) * m_data.font_height * 256, m_data.font_height * 2);
+
+        if (m_data.options.page_width != 0)  page_size.width   = m_data.options.page_width;
+        if (m_data.options.page_height != 0) page_size.height  = m_data.options.page_height;
+
+        m_data.atlas->Reset(m_data.options.packer, m_data.options.format, m_data.options.is_sdf, page_size.width, page_size.height);
+    } else if (!m_data.atlas->IsCompatible(m_data.options)) {
+        SetErrMsg("Shared atlas is not compatible with font load options.");
+        return;
+    }
+
+    m_data.stats.page_width     = m_data.atlas->GetPageWidth();
+    m_data.stats.page_height    = m_data.atlas->GetPageHeight();
+
+    m_data.glyph_cache.Reset(m_data.options.packer, m_data.atlas->GetPageWidth(), m_data.atlas->GetPageHeight(), m_data.options.glyph_cache_page_budget);
+
+    // Fallback glyphs are copied to missing glyphs, so they can't be pending.
+    GeneratePendingGlyphs(m_data, {TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER});
+
+    m_data.glyphs.ResolveFallback({TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER}, MakeMissingGlyphData());
+}
+
+inline void TOGL_FontDataGenerator::GeneratePendingGlyphs(TOGL_FontData& data, const std::vector<uint32_t>& codes) {
+    if (!data.glyph_source || !data.atlas) return;
+
+    const uint16_t padding = GetGlyphPadding(data.options);
+
+    const bool is_glyph_cache = data.glyph_cache.IsEnabled();
+
+    TOGL_GlyphBitmap        bitmap;
+    std::vector<uint8_t>    pixels;
+    TOGL_GlyphCacheChanges  changes;
+
+    for (const uint32_t code : codes) {
+        if (!data.glyphs.Has(code) || !data.glyphs.Get(code).is_pending) continue;
+
+        TOGL_GlyphData glyph_data = data.glyphs.Get(code);
+        glyph_data.is_pending = false;
+
+        if (RasterizeGlyph(data, code, bitmap) && bitmap.width != 0 && bitmap.height != 0) {
+            const uint16_t width    = bitmap.width + padding;
+            const uint16_t height   = bitmap.height + padding;
+
+            TOGL_FontAtlas& atlas       = *data.atlas;
+            const uint16_t  page_width  = atlas.GetPageWidth();
+            const uint16_t  page_height = atlas.GetPageHeight();
+
+            TOGL_PointU16   pos;
+            uint32_t        page_ix     = 0;
+            bool            is_inserted = false;
+
+            if (is_glyph_cache) {
+                changes.Clear();
+                is_inserted = data.glyph_cache.Insert(code, width, height, IsFallbackCode(code), changes) && data.glyph_cache.GetPlace(code, pos, page_ix);
+
+                ApplyGlyphCacheChanges(data, changes);
+
+                if (!is_inserted) {
+                    // All pages are filled with glyphs used in current frame. Glyph stays pending, so it's requested again in next frame.
+                    if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
+                        TOGL_LogDebug("Glyph [" + TOGL_HexToStr(code) + "] doesn't fit in glyph cache (" + std::to_string(data.glyph_cache.GetPageBudget()) + " pages).");
+                    }
+                    continue;
+                }
+            } else {
+                is_inserted = atlas.Insert(width, height, pos, page_ix);
+
+                if (!is_inserted) {
+                    SetErrMsg("Glyph [" + TOGL_HexToStr(code) + "] doesn't fit in atlas page (" + std::to_string(page_width) + "x" + std::to_string(page_height) + ").");
+                }
+            }
+
+            if (is_inserted) {
+                UploadGlyph(data, bitmap, pos, page_ix, glyph_data, pixels);
+
+                // Pages of shared atlas are counted for each font which uses them.
+                data.stats.page_count   = atlas.GetPageCount();
+                data.stats.texture_size = atlas.GetPageCount() * atlas.GetPageTextureSize();
+                data.stats.used_area    += uint64_t(bitmap.width) * bitmap.height;
+            }
+
+        } else if (is_glyph_cache) {
+            // Glyph without visible pixels is kept in cache, so it isn't counted as miss.
+            changes.Clear();
+            data.glyph_cache.Insert(code, 0, 0, false, changes);
+        }
+
+        data.stats.glyph_count += 1;
+        data.glyphs.Set(code, glyph_data);
+    }
+}
+
+inline void TOGL_FontDataGenerator::CompactGlyphCache(TOGL_FontData& data) {
+    if (data.atlas && data.glyph_source && data.glyph_cache.IsEnabled()) {
+        TOGL_GlyphCacheChanges changes;
+
+        if (data.glyph_cache.CompactPage(changes)) {
+            ApplyGlyphCacheChanges(data, changes);
+        }
+    }
+}
+
+inline void TOGL_FontDataGenerator::UploadGlyph(TOGL_FontData& data, const TOGL_GlyphBitmap& bitmap, const TOGL_PointU16& pos, uint32_t page_ix, TOGL_GlyphData& glyph_data, std::vector<uint8_t>& pixels) {
+    const TOGL_FontAtlas&   atlas       = *data.atlas;
+    const uint16_t          page_width  = atlas.GetPageWidth();
+    const uint16_t          page_height = atlas.GetPageHeight();
+    const GLuint            tex_obj     = atlas.GetTexObj(page_ix);
+
+    glPushAttrib(GL_TEXTURE_BIT);
+    glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    glBindTexture(GL_TEXTURE_2D, tex_obj);
+
+    if (data.options.format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, bitmap.width, bitmap.height, GL_ALPHA, GL_UNSIGNED_BYTE, bitmap.alphas.data());
+    } else {
+        AlphasToPixels(bitmap.alphas.data(), bitmap.alphas.size(), pixels);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, bitmap.width, bitmap.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    }
+
+    glPopClientAttrib();
+    glPopAttrib();
+
+    glyph_data.tex_obj      = tex_obj;
+    glyph_data.layer        = uint16_t(page_ix);
+
+    glyph_data.quad_x       = bitmap.x;
+    glyph_data.quad_y       = bitmap.y;
+    glyph_data.quad_width   = bitmap.width;
+    glyph_data.quad_height  = bitmap.height;
+
+    glyph_data.x1 = _TOGL_ToTexSpace(pos.x, page_width);
+    glyph_data.y1 = _TOGL_ToTexSpace(pos.y, page_height);
+    glyph_data.x2 = _TOGL_ToTexSpace(pos.x + bitmap.width, page_width);
+    glyph_data.y2 = _TOGL_ToTexSpace(pos.y + bitmap.height, page_height);
+}
+
+inline void TOGL_FontDataGenerator::ApplyGlyphCacheChanges(TOGL_FontData& data, const TOGL_GlyphCacheChanges& changes) {
+    if (changes.IsEmpty()) return;
+
+    TOGL_FontAtlas& atlas = *data.atlas;
+
+    atlas.ReservePages(data.glyph_cache.GetPageCount());
+
+    bool is_fallback_changed = false;
+
+    for (const uint32_t code : changes.evicted_codes) {
+        if (data.glyph_cache.Has(code)) continue; // inserted again
+
+        TOGL_GlyphData glyph_data = data.glyphs.Get(code);
+
+        data.stats.used_area    -= uint64_t(glyph_data.quad_width) * glyph_data.quad_height;
+        data.stats.glyph_count  -= 1;
+
+        // Only width is valid for pending glyph.
+        const uint16_t width = glyph_data.width;
+        glyph_data              = {};
+        glyph_data.width        = width;
+        glyph_data.is_pending   = true;
+
+        data.glyphs.Set(code, glyph_data);
+
+        if (IsFallbackCode(code)) is_fallback_changed = true;
+    }
+
+    for (const uint32_t page_ix : changes.repacked_page_ixs) {
+        atlas.ClearPage(page_ix);
+    }
+
+    // Padding of glyph placed in reused place must be transparent.
+    for (const TOGL_GlyphCacheChanges::ReusedPlace& place : changes.reused_places) {
+        atlas.ClearArea(place.page_ix, place.pos, place.width, place.height);
+    }
+
+    // Glyph is rasterized again, since old place might already be cleared or overwritten.
+    TOGL_GlyphBitmap        bitmap;
+    std::vector<uint8_t>    pixels;
+
+    for (const uint32_t code : changes.relocated_codes) {
+        TOGL_PointU16   pos;
+        uint32_t        page_ix = 0;
+
+        if (data.glyph_cache.GetPlace(code, pos, page_ix) && RasterizeGlyph(data, code, bitmap)) {
+            TOGL_GlyphData glyph_data = data.glyphs.Get(code);
+            UploadGlyph(data, bitmap, pos, page_ix, glyph_data, pixels);
+            data.glyphs.Set(code, glyph_data);
+
+            if (IsFallbackCode(code)) is_fallback_changed = true;
+        }
+    }
+
+    // Missing glyphs refer to copy of fallback glyph.
+    if (is_fallback_changed) {
+        data.glyphs.ResolveFallback({TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER}, TOGL_MakeMissingGlyphData(data.font_height));
+    }
+
+    data.stats.page_count   = atlas.GetPageCount();
+    data.stats.texture_size = atlas.GetPageCount() * atlas.GetPageTextureSize();
+}
+
+inline bool TOGL_FontDataGenerator::IsFallbackCode(uint32_t code) {
+    return code == TOGL_UNICODE_WHITE_SQUARE || code == TOGL_UNICODE_REPLACEMENT_CHARACTER;
+}
+
+inline uint16_t TOGL_FontDataGenerator::GetGlyphPadding(const TOGL_FontLoadOptions& options) {
+    // Used as workaround for overlapping glyphs when they are drawn.
+    enum { ADDITIONAL_SAFE_SPACE = 1 };
+
+    return (options.packer == TOGL_FONT_ATLAS_PACKER_ID_ROWS) ? uint16_t(ADDITIONAL_SAFE_SPACE) : options.glyph_padding;
+}
+
+inline TOGL_UnicodeRangeSet TOGL_FontDataGenerator::GetCoveredCodes(HDC device_context_handle, const TOGL_UnicodeRangeSet& codes) {
+    TOGL_UnicodeRangeSet coverage;
+
+    // --- Basic Multilingual Plane --- //
+
+    const DWORD buffer_size = GetFontUnicodeRanges(device_context_handle, NULL);
+    bool        is_bmp_checked = false;
+
+    if (buffer_size >= sizeof(GLYPHSET)) {
+        std::vector<uint8_t> buffer(buffer_size);
+
+        GLYPHSET* glyphset = (GLYPHSET*)buffer.data();
+
+        if (GetFontUnicodeRanges(device_context_handle, glyphset) != 0) {
+            for (uint32_t ix = 0; ix < glyphset->cRanges; ++ix) {
+                const uint32_t from = glyphset->ranges[ix].wcLow;
+
+                if (glyphset->ranges[ix].cGlyphs != 0) {
+                    coverage.Add({from, from + glyphset->ranges[ix].cGlyphs - 1});
+                }
+            }
+            is_bmp_checked = true;
+        }
+    }
+    if (!is_bmp_checked) coverage.Add({0x0000, 0xFFFF});
+
+    // --- Supplementary Planes --- //
+
+    TOGL_UnicodeRangeSet supplementary_codes = codes;
+    supplementary_codes.Remove({0x0000, 0xFFFF});
+
+    if (!supplementary_codes.IsEmpty()) {
+        TOGL_TrueTypeFont font;
+
+        const bool is_loaded = font.Load([device_context_handle](uint32_t tag) {
+            return _TOGL_GetWinFontTable(device_context_handle, tag);
+        }, true);
+
+        if (is_loaded) {
+            for (const TOGL_UnicodeRange& range : supplementary_codes.ToRanges()) {
+                for (uint32_t code = range.from; code <= range.to && code <= 0x10FFFF; ++code) {
+                    if (font.HasGlyph(code)) coverage.Add(code);
+                }
+            }
+        } else {
+            coverage.Add(supplementary_codes);
+        }
+    }
+
+    TOGL_UnicodeRangeSet covered_codes = codes;
+    covered_codes.Intersect(coverage);
+
+    return covered_codes;
+}
+
+inline void TOGL_FontDataGenerator::CreateGlyphSource(const TOGL_FontInfo& font_info) {
+    if (m_data.options.rasterizer == TOGL_FONT_RASTERIZER_ID_TRUE_TYPE) {
+        const HDC device_context_handle = m_device_context_handle;
+
+        // Tables are taken from font selected in device context, so the same font file is used as by Windows (also for font collections).
+        std::shared_ptr<TOGL_TrueTypeFont> font = std::make_shared<TOGL_TrueTypeFont>();
+
+        font->Load([device_context_handle](uint32_t tag) {
+            return _TOGL_GetWinFontTable(device_context_handle, tag);
+        });
+
+        if (!font->IsOk()) {
+            SetErrMsg("Can not load TrueType font data. " + font->GetErrMsg());
+            return;
+        }
+
+        std::shared_ptr<TOGL_TrueTypeGlyphSource> glyph_source = std::make_shared<TOGL_TrueTypeGlyphSource>(font, m_data.font_height);
+
+        // Glyphs are placed in glyph cell by metrics of TrueType font, which might differ by rounding from metrics of Windows font.
+        m_data.font_ascent              = glyph_source->GetFontAscent();
+        m_data.font_descent             = glyph_source->GetFontDescent();
+        m_data.font_internal_leading    = glyph_source->GetFontInternalLeading();
+
+        m_data.glyph_source = glyph_source;
+    } else {
+        // Device context of window can't be hold by font, so glyph source has its own font object.
+        HFONT font_handle = CreateWinFont(font_info);
+        if (font_handle == NULL) {
+            SetErrMsg("Can not create font source.");
+            return;
+        }
+        m_data.glyph_source = std::make_shared<TOGL_WinGlyphSource>(font_handle, m_data.font_descent);
+    }
+}
+
+inline uint32_t TOGL_FontDataGenerator::PackGlyphs(std::vector<GlyphLayout>& layouts, TOGL_SizeU16& page_size) {
+    const TOGL_FontLoadOptions& options = m_data.options;
+
+    const uint16_t padding = GetGlyphPadding(options);
+
+    uint64_t area       = 0;
+    uint32_t min_size   = 0;
+
+    for (const GlyphLayout& layout : layouts) {
+        if (layout.box_width != 0 && layout.box_height != 0 && !layout.is_duplicate) {
+            area += uint64_t(layout.box_width + padding) * (layout.box_height + padding);
+
+            if (uint32_t(layout.box_width + padding) > min_size)  min_size = layout.box_width + padding;
+            if (uint32_t(layout.box_height + padding) > min_size) min_size = layout.box_height + padding;
+        }
+    }
+
+    page_size = ChoosePageSize(area, min_size);
+
+    if (options.page_width != 0)  page_size.width   = options.page_width;
+    if (options.page_height != 0) page_size.height  = options.page_height;
+
+    std::vector<size_t> order(layouts.size());
+    for (size_t ix = 0; ix < order.size(); ++ix) order[ix] = ix;
+
+    if (options.packer == TOGL_FONT_ATLAS_PACKER_ID_SKYLINE) {
+        // Skyline packer wastes least space, when glyphs are packed from highest to lowest.
+        std::stable_sort(order.begin(), order.end(), [&layouts](size_t l, size_t r) {
+            if (layouts[l].box_height != layouts[r].box_height) return layouts[l].box_height > layouts[r].box_height;
+            return layouts[l].box_width > layouts[r].box_width;
+        });
+    }
+
+    TOGL_AtlasPacker packer(options.packer, page_size.width, page_size.height);
+    uint32_t page_count = 1;
+
+    for (size_t ix : order) {
+        GlyphLayout& layout = layouts[ix];
+
+        if (layout.box_width == 0 || layout.box_height == 0) {
+            // Glyph without any visible pixel doesn't need space in atlas.
+            layout.page_ix = page_count - 1;
+            continue;
+        }
+
+        // Placed with its original below.
+        if (layout.is_duplicate) continue;
+
+        const uint16_t width    = layout.box_width + padding;
+        const uint16_t height   = layout.box_height + padding;
+
+        if (!packer.Insert(width, height, layout.pos)) {
+            packer.Reset(options.packer, page_size.width, page_size.height);
+            page_count += 1;
+
+            if (!packer.Insert(width, height, layout.pos)) {
+                SetErrMsg("Glyph [" + TOGL_HexToStr(layout.code) + "] doesn't fit in atlas page (" + std::to_string(page_size.width) + "x" + std::to_string(page_size.height) + ").");
+                return 0;
+            }
+        }
+
+        layout.page_ix = page_count - 1;
+
+        m_data.stats.used_area += uint64_t(layout.box_width) * layout.box_height;
+    }
+
+    m_data.stats.deduplicated_glyph_count = 0;
+
+    for (GlyphLayout& layout : layouts) {
+        if (layout.is_duplicate && layout.box_width != 0 && layout.box_height != 0) {
+            layout.page_ix  = layouts[layout.original_ix].page_ix;
+            layout.pos      = layouts[layout.original_ix].pos;
+
+            m_data.stats.deduplicated_glyph_count += 1;
+        }
+    }
+
+    m_data.stats.glyph_count    = uint32_t(layouts.size());
+    m_data.stats.page_count     = page_count;
+    m_data.stats.page_width     = page_size.width;
+    m_data.stats.page_height    = page_size.height;
+
+    return page_count;
+}
+
+inline TOGL_GlyphData TOGL_FontDataGenerator::MakeGlyphData(const GlyphLayout& layout, GLuint tex_obj, const TOGL_SizeU16& page_size) const {
+    TOGL_GlyphData glyph_data = {};
+
+    glyph_data.width        = layout.width;
+    glyph_data.tex_obj      = tex_obj;
+    glyph_data.layer        = uint16_t(layout.page_ix);
+
+    glyph_data.quad_x       = layout.box_x;
+    glyph_data.quad_y       = layout.box_y;
+    glyph_data.quad_width   = layout.box_width;
+    glyph_data.quad_height  = layout.box_height;
+
+    glyph_data.x1 = _TOGL_ToTexSpace(layout.pos.x, page_size.width);
+    glyph_data.y1 = _TOGL_ToTexSpace(layout.pos.y, page_size.height);
+    glyph_data.x2 = _TOGL_ToTexSpace(layout.pos.x + layout.box_width, page_size.width);
+    glyph_data.y2 = _TOGL_ToTexSpace(layout.pos.y + layout.box_height, page_size.height);
+
+    return glyph_data;
+}
+
+inline bool TOGL_FontDataGenerator::RasterizeGlyph(TOGL_FontData& data, uint32_t code, TOGL_GlyphBitmap& bitmap) {
+    if (!data.glyph_source->GetGlyphBitmap(code, bitmap)) return false;
+
+    if (data.options.is_sdf) {
+        bitmap = TOGL_MakeDistanceField(bitmap, data.options.sdf_spread);
+    }
+    return true;
+}
+
+inline GLint TOGL_FontDataGenerator::GetTextureFilter(const TOGL_FontLoadOptions& options) {
+    return options.is_sdf ? GL_LINEAR : GL_NEAREST;
+}
+
+inline void TOGL_FontDataGenerator::AlphasToPixels(const uint8_t* alphas, size_t count, std::vector<uint8_t>& pixels) {
+    pixels.resize(count * 4);
+    AlphasToPixels(alphas, count, pixels.data());
+}
+
+inline void TOGL_FontDataGenerator::AlphasToPixels(const uint8_t* alphas, size_t count, uint8_t* pixels) {
+    for (size_t ix = 0; ix < count; ++ix) {
+        pixels[ix * 4 + 0] = 255;
+        pixels[ix * 4 + 1] = 255;
+        pixels[ix * 4 + 2] = 255;
+        pixels[ix * 4 + 3] = alphas[ix];
+    }
+}
+
+inline HFONT TOGL_FontDataGenerator::CreateWinFont(const TOGL_FontInfo& font_info) const {
+    return CreateFontW(
+        TOGL_FontSizeToPixels(font_info.size, font_info.size_unit),                    
+        0, 0, 0,                            
+        (font_info.style == TOGL_FONT_STYLE_ID_BOLD) ? FW_BOLD : FW_NORMAL,
+        (font_info.style == TOGL_FONT_STYLE_ID_ITALIC) ? TRUE : FALSE, 
+        FALSE, FALSE,
+        ANSI_CHARSET, // For W version of this function, should create a font bitmap with all having glyphs for unicode range from 0000 to FFFF.
+        OUT_TT_PRECIS,
+        CLIP_DEFAULT_PRECIS,
+        ANTIALIASED_QUALITY,
+        FF_DONTCARE | DEFAULT_PITCH,
+        TOGL_ToUTF16(font_info.name).c_str());  
+}
+
+inline uint64_t TOGL_FontDataGenerator::MakeCacheKey(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options) const {
+    uint64_t font_data_size     = 0;
+    uint32_t font_head_checksum = 0;
+
+    HDC device_context_handle = CreateCompatibleDC(NULL);
+    if (device_context_handle != NULL) {
+        HFONT font_handle = CreateWinFont(font_info);
+        if (font_handle != NULL) {
+            HFONT old_font_handle = (HFONT)SelectObject(device_context_handle, font_handle);
+
+            const DWORD size = GetFontData(device_context_handle, 0, 0, NULL, 0);
+            if (size != GDI_ERROR) font_data_size = size;
+
+            const std::vector<uint8_t> head = _TOGL_GetWinFontTable(device_context_handle, TOGL_MakeTrueTypeTag('h', 'e', 'a', 'd'));
+            font_head_checksum = TOGL_ComputeTrueTypeTableChecksum(head.data(), head.size());
+
+            SelectObject(device_context_handle, old_font_handle);
+            DeleteObject(font_handle);
+        }
+        DeleteDC(device_context_handle);
+    }
+
+    return TOGL_FontCache::MakeKey(font_info, options, font_data_size, font_head_checksum);
+}
+
+inline bool TOGL_FontDataGenerator::IsTextureArraySupported(uint32_t page_count) {
+    if (TOGL_FontGL::GetVersion().major < 3 || !m_gl.Load()) return false;
+
+    GLint max_layer_count = 0;
+    glGetIntegerv(TOGL_FontGL::TOGL_GL_MAX_ARRAY_TEXTURE_LAYERS, &max_layer_count);
+
+    return page_count <= uint32_t(max_layer_count);
+}
+
+inline bool TOGL_FontDataGenerator::LoadFromCache(const std::string& file_name, uint64_t key) {
+    TOGL_MappedFile file;
+    TOGL_FontCache  cache;
+
+    if (!file.Open(file_name) || !cache.Decode(file.ToData(), file.GetSize()) || cache.key != key) {
+        return false;
+    }
+
+    return LoadFromCache(cache);
+}
+
+inline bool TOGL_FontDataGenerator::LoadFromCache(const TOGL_FontCache& cache) {
+    if (!CreatePageTextures(cache)) return false;
+
+    // Pages are uploaded straight from mapped file.
+    for (uint32_t ix = 0; ix < cache.pages.size(); ++ix) {
+        UploadPage(ix, cache.pages[ix]);
+    }
+
+    SetCacheGlyphs(cache);
+
+    return true;
+}
+
+inline bool TOGL_FontDataGenerator::CreatePageTextures(const TOGL_FontCache& cache) {
+    GLint max_texture_size = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+    if (cache.stats.page_width > max_texture_size || cache.stats.page_height > max_texture_size) {
+        return false;
+    }
+
+    m_data.font_height              = cache.font_height;
+    m_data.font_ascent              = cache.font_ascent;
+    m_data.font_descent             = cache.font_descent;
+    m_data.font_internal_leading    = cache.font_internal_leading;
+    m_data.stats                    = cache.stats;
+
+    const bool      is_alpha            = cache.format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8;
+    const GLint     internal_format     = is_alpha ? GL_ALPHA8 : GL_RGBA8;
+    const GLenum    format              = is_alpha ? GL_ALPHA : GL_RGBA;
+    const bool      is_texture_array    = m_data.options.is_texture_array && IsTextureArraySupported(cache.stats.page_count);
+
+    m_data.options.is_texture_array = is_texture_array;
+
+    glPushAttrib(GL_TEXTURE_BIT);
+
+    if (is_texture_array) {
+        glGenTextures(1, &m_data.tex_array_obj);
+        glBindTexture(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, m_data.tex_array_obj);
+
+        glTexParameteri(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GetTextureFilter(m_data.options));
+        glTexParameteri(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GetTextureFilter(m_data.options));
+        m_gl.togl_glTexImage3D(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, 0, internal_format, cache.stats.page_width, cache.stats.page_height, cache.stats.page_count, 0, format, GL_UNSIGNED_BYTE, NULL);
+    } else {
+        for (uint32_t ix = 0; ix < cache.stats.page_count; ++ix) {
+            GLuint tex_obj = 0;
+            glGenTextures(1, &tex_obj);
+            glBindTexture(GL_TEXTURE_2D, tex_obj);
+
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GetTextureFilter(m_data.options));
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GetTextureFilter(m_data.options));
+            glTexImage2D(GL_TEXTURE_2D, 0, internal_format, cache.stats.page_width, cache.stats.page_height, 0, format, GL_UNSIGNED_BYTE, NULL);
+
+            m_data.tex_objs.push_back(tex_obj);
+        }
+    }
+
+    glPopAttrib();
+
+    return true;
+}
+
+inline void TOGL_FontDataGenerator::UploadPage(uint32_t page_ix, const uint8_t* page) {
+    const uint16_t  width   = m_data.stats.page_width;
+    const uint16_t  height  = m_data.stats.page_height;
+    const GLenum    format  = (m_data.options.format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8) ? GL_ALPHA : GL_RGBA;
+
+    glPushAttrib(GL_TEXTURE_BIT);
+    glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (m_data.tex_array_obj != 0) {
+        glBindTexture(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, m_data.tex_array_obj);
+        m_gl.togl_glTexSubImage3D(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, 0, 0, 0, page_ix, width, height, 1, format, GL_UNSIGNED_BYTE, page);
+    } else if (page_ix < m_data.tex_objs.size()) {
+        glBindTexture(GL_TEXTURE_2D, m_data.tex_objs[page_ix]);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, format, GL_UNSIGNED_BYTE, page);
+    }
+
+    glPopClientAttrib();
+    glPopAttrib();
+}
+
+inline void TOGL_FontDataGenerator::SetCacheGlyphs(const TOGL_FontCache& cache) {
+    const bool is_texture_array = m_data.tex_array_obj != 0;
+
+    for (const TOGL_FontCache::Glyph& glyph : cache.glyphs) {
+        TOGL_GlyphData glyph_data = glyph.data;
+        glyph_data.tex_obj  = is_texture_array ? m_data.tex_array_obj : m_data.tex_objs[glyph.page_ix];
+        glyph_data.layer    = uint16_t(glyph.page_ix);
+
+        m_data.glyphs.Set(glyph.code, glyph_data);
+    }
+
+    m_data.glyphs.ResolveFallback({TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER}, MakeMissingGlyphData());
+}
+
+inline void TOGL_FontDataGenerator::DeleteTextures() {
+    for (auto& tex_obj : m_data.tex_objs) {
+        glDeleteTextures(1, &tex_obj);
+    }
+    m_data.tex_objs.clear();
+
+    if (m_data.tex_array_obj != 0) {
+        glDeleteTextures(1, &m_data.tex_array_obj);
+        m_data.tex_array_obj = 0;
+    }
+}
+
+inline void TOGL_FontDataGenerator::SaveToCache(const std::string& file_name, uint64_t key) {
+    TOGL_FontCache cache;
+
+    cache.key                       = key;
+    cache.font_height               = m_data.font_height;
+    cache.font_ascent               = m_data.font_ascent;
+    cache.font_descent              = m_data.font_descent;
+    cache.font_internal_leading     = m_data.font_internal_leading;
+    cache.format                    = m_data.options.format;
+    cache.stats                     = m_data.stats;
+
+    const GLenum format = (cache.format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8) ? GL_ALPHA : GL_RGBA;
+
+    std::vector<uint8_t> pixels(cache.GetPageSize() * cache.stats.page_count);
+
+    glPushAttrib(GL_TEXTURE_BIT);
+    glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    if (m_data.tex_array_obj != 0) {
+        // All layers at once.
+        glBindTexture(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, m_data.tex_array_obj);
+        glGetTexImage(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, 0, format, GL_UNSIGNED_BYTE, pixels.data());
+    } else {
+        for (uint32_t ix = 0; ix < m_data.tex_objs.size() && ix < cache.stats.page_count; ++ix) {
+            glBindTexture(GL_TEXTURE_2D, m_data.tex_objs[ix]);
+            glGetTexImage(GL_TEXTURE_2D, 0, format, GL_UNSIGNED_BYTE, pixels.data() + cache.GetPageSize() * ix);
+        }
+    }
+
+    glPopClientAttrib();
+    glPopAttrib();
+
+    for (uint32_t ix = 0; ix < cache.stats.page_count; ++ix) {
+        cache.pages.push_back(pixels.data() + cache.GetPageSize() * ix);
+    }
+
+    for (const uint32_t code : m_data.glyphs.GetCodes()) {
+        const TOGL_GlyphData& glyph_data = m_data.glyphs.Get(code);
+
+        if (glyph_data.tex_obj != 0) {
+            cache.glyphs.push_back({code, glyph_data.layer, glyph_data});
+        }
+    }
+
+    const std::vector<uint8_t> data = cache.Encode();
+
+    if (!TOGL_SaveToFile(file_name, data.data(), data.size())) {
+        if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
+            TOGL_LogDebug("Can not save font cache file \"" + file_name + "\".");
+        }
+    }
+}
+
+inline TOGL_GlyphData TOGL_FontDataGenerator::MakeMissingGlyphData() const {
+    return TOGL_MakeMissingGlyphData(m_data.font_height);
+}
+
+inline void TOGL_FontDataGenerator::RenderGlyphToTexture(GLuint list_base, int x, int y, wchar_t c) {
+    glPushAttrib(GL_ENABLE_BIT);
+    glPushAttrib(GL_COLOR_BUFFER_BIT);
+    glPushAttrib(GL_LIST_BIT);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  
+                
+    glColor4ub(255, 255, 255, 255);
+
+    // Raster position outside of viewport is invalid, and nothing would be drawn. 
+    // Valid raster position is moved to (x, y) by empty bitmap instead.
+    glRasterPos2i(0, 0);
+    glBitmap(0, 0, 0, 0, GLfloat(x), GLfloat(y), NULL);
+
+    glListBase(list_base);
+    glCallLists(1, GL_UNSIGNED_SHORT, &c);
+
+    glPopAttrib();
+    glPopAttrib();
+    glPopAttrib();
+}
+
+inline TOGL_FontDataGenerator::GlyphLayout TOGL_FontDataGenerator::MeasureGlyph(const DisplayListSet& display_list_set, uint32_t code) const {
+    GlyphLayout layout = {};
+
+    layout.code             = code;
+    layout.display_list_set = &display_list_set;
+    layout.width            = GetCharSize((wchar_t)code).width;
+
+    // Whole glyph cell.
+    layout.box_width        = layout.width;
+    layout.box_height       = uint16_t(m_data.font_height);
+
+    if (m_data.options.packer == TOGL_FONT_ATLAS_PACKER_ID_SKYLINE) {
+        // Ink box. The same metrics are used by wglUseFontBitmapsW to create glyph bitmap.
+        GLYPHMETRICS    metrics     = {};
+        const MAT2      identity    = {{0, 1}, {0, 0}, {0, 0}, {0, 1}};
+
+        if (GetGlyphOutlineW(m_device_context_handle, (UINT)code, GGO_METRICS, &metrics, 0, NULL, &identity) != GDI_ERROR) {
+            layout.box_x        = int16_t(metrics.gmptGlyphOrigin.x);
+            layout.box_y        = int16_t(int(m_data.font_descent) + metrics.gmptGlyphOrigin.y - int(metrics.gmBlackBoxY));
+            layout.box_width    = uint16_t(metrics.gmBlackBoxX);
+            layout.box_height   = uint16_t(metrics.gmBlackBoxY);
+        }
+    }
+
+    return layout;
+}
+
+inline TOGL_SizeU16 TOGL_FontDataGenerator::ChoosePageSize(uint64_t area, uint32_t min_size) const {
+    enum { 
+        MIN_PAGE_SIZE = 64, 
+        MAX_PAGE_SIZE = 4096,
+    };
+
+    uint32_t max_size = MAX_PAGE_SIZE;
+    if (m_max_page_size < max_size) max_size = m_max_page_size;
+
+    // Packers can't fill page completely, some space is left for waste.
+    area += area * 15 / 100;
+
+    uint32_t size = MIN_PAGE_SIZE;
+    while (size < max_size && (size < min_size || uint64_t(size) * size < area)) {
+        size *= 2;
+    }
+    if (size > max_size) size = max_size;
+
+    return TOGL_SizeU16(size, size);
+}
+
+inline uint32_t TOGL_FontDataGenerator::QueryMaxPageSize() {
+    GLint max_viewport_size[2] = {};
+    glGetIntegerv(GL_MAX_VIEWPORT_DIMS, max_viewport_size);
+    GLint max_texture_size = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &max_texture_size);
+
+    uint32_t max_size = uint32_t(max_texture_size);
+    if (uint32_t(max_viewport_size[0]) < max_size)  max_size = max_viewport_size[0];
+    if (uint32_t(max_viewport_size[1]) < max_size)  max_size = max_viewport_size[1];
+
+    return max_size;
+}
+
+inline TOGL_SizeU16 TOGL_FontDataGenerator::GetCharSize(wchar_t c) const {
+    SIZE size;
+    if (GetTextExtentPoint32W(m_device_context_handle, &c, 1, &size)) {
+        return TOGL_SizeU16(size.cx, size.cy);
+    }
+    return {};
+}
+
+inline void TOGL_FontDataGenerator::SetErrMsg(const std::string& err_msg) {
+    m_err_msg = err_msg;
+}
+
+template <typename Type>
+inline void TOGL_FontDataGenerator::Load(Type& function, const std::string& function_name) {
+    function = (Type)wglGetProcAddress(function_name.c_str());
+    if (!function) {
+        SetErrMsg(std::string() + "Can not load function: \"" + function_name + "\".");
+    }
+}
+
+//-----------------------------------------------------------------------------
+// Global Font
+//-----------------------------------------------------------------------------
+
+inline TOGL_Font& TOGL_ToGlobalFont() {
+    return TOGL_Global<TOGL_Font>::ToObject();
+}
+
+inline void TOGL_LoadFont(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options) {
+    TOGL_ToGlobalFont().Load(font_info, options);
+}
+
+inline void TOGL_LoadFontAsync(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options) {
+    TOGL_ToGlobalFont().LoadAsync(font_info, options);
+}
+
+inline bool TOGL_UpdateFontLoading(double time_budget) {
+    return TOGL_ToGlobalFont().UpdateLoading(time_budget);
+}
+
+inline bool TOGL_IsFontLoadingAsync() {
+    return TOGL_ToGlobalFont().IsLoadingAsync();
+}
+
+inline void TOGL_LoadFont(const std::string& name, uint32_t size, TOGL_FontSizeUnitId size_unit, TOGL_FontStyleId style, const TOGL_UnicodeRangeGroup& unicode_range_group) {
+    TOGL_ToGlobalFont().Load(name, size, size_unit, style, unicode_range_group);
+}
+
+inline void TOGL_LoadBMFont(const std::string& file_name, const TOGL_FontLoadOptions& options) {
+    TOGL_ToGlobalFont().LoadBMFont(file_name, options);
+}
+
+inline void TOGL_UnloadFont() {
+    TOGL_ToGlobalFont().Unload();
+}
+
+inline bool TOGL_IsFontLoaded() {
+    return TOGL_ToGlobalFont().IsLoaded();
+}
+
+inline uint32_t TOGL_GetFontHeight() {
+    return TOGL_ToGlobalFont().GetHeight();
+}
+
+inline uint32_t TOGL_GetFontAscent() {
+    return TOGL_ToGlobalFont().GetAscent();
+}
+
+inline uint32_t TOGL_GetFontDescent() {
+    return TOGL_ToGlobalFont().GetDescent();
+}
+
+inline uint32_t TOGL_GetInternalLeading() {
+    return TOGL_ToGlobalFont().GetInternalLeading();
+}
+
+inline TOGL_FontInfo TOGL_GetFontInfo() {
+    return TOGL_ToGlobalFont().ToFontInfo();
+}
+
+inline TOGL_FontStats TOGL_GetFontStats() {
+    return TOGL_ToGlobalFont().ToStats();
+}
+
+inline bool TOGL_IsFontOk() {
+    return TOGL_ToGlobalFont().IsOk();
+}
+
+inline std::string TOGL_GetFontErrMsg() {
+    return TOGL_ToGlobalFont().GetErrMsg();
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_GlyphBatch
+//-----------------------------------------------------------------------------
+
+inline TOGL_GlyphBatch::TOGL_GlyphBatch() {
+    m_last_group_ix = 0;
+    m_quad_count    = 0;
+    m_group_count   = 0;
+    m_color         = {255, 255, 255, 255};
+    m_is_instanced  = false;
+}
+
+inline TOGL_GlyphBatch::~TOGL_GlyphBatch() {
+
+}
+
+inline void TOGL_GlyphBatch::Clear() {
+    m_groups.erase(std::remove_if(m_groups.begin(), m_groups.end(), [](const Group& group) { 
+        return group.vertices.empty() && group.instances.empty(); 
+    }), m_groups.end());
+
+    for (Group& group : m_groups) {
+        group.vertices.clear();
+        group.instances.clear();
+    }
+    m_pending_glyphs.clear();
+
+    m_last_group_ix = 0;
+    m_quad_count    = 0;
+    m_group_count   = 0;
+}
+
+inline void TOGL_GlyphBatch::SetColor(const TOGL_Color4U8& color) {
+    m_color = color;
+}
+
+inline const TOGL_Color4U8& TOGL_GlyphBatch::ToColor() const {
+    return m_color;
+}
+
+inline void TOGL_GlyphBatch::AddQuad(TOGL_Font* font, GLuint tex_obj, float x1, float y1, float x2, float y2, float tex_x1, float tex_y1, float tex_x2, float tex_y2, float layer) {
+    std::vector<Vertex>& vertices = ToGroup(font, tex_obj).vertices;
+    if (vertices.empty()) ++m_group_count;
+
+    vertices.push_back({x1, y1, tex_x1, tex_y1, layer, m_color});
+    vertices.push_back({x2, y1, tex_x2, tex_y1, layer, m_color});
+    vertices.push_back({x2, y2, tex_x2, tex_y2, layer, m_color});
+    vertices.push_back({x1, y2, tex_x1, tex_y2, layer, m_color});
+
+    ++m_quad_count;
+}
+
+inline void TOGL_GlyphBatch::SetInstanced(bool is_instanced) {
+    m_is_instanced = is_instanced;
+}
+
+inline bool TOGL_GlyphBatch::IsInstanced() const {
+    return m_is_instanced;
+}
+
+inline bool TOGL_GlyphBatch::AddInstance(TOGL_Font* font, GLuint tex_obj, double x, double y, double tex_x, double tex_y, uint32_t width, uint32_t height, uint32_t layer, bool is_flipped) {
+    const double rounded_x      = floor(x + 0.5);
+    const double rounded_y      = floor(y + 0.5);
+    const double rounded_tex_x  = floor(tex_x + 0.5);
+    const double rounded_tex_y  = floor(tex_y + 0.5);
+
+    const bool is_fit = rounded_x >= INT16_MIN && rounded_x <= INT16_MAX 
+        && rounded_y >= INT16_MIN && rounded_y <= INT16_MAX
+        && rounded_tex_x >= 0 && rounded_tex_x <= UINT16_MAX
+        && rounded_tex_y >= 0 && rounded_tex_y <= UINT16_MAX
+        && width <= MAX_INSTANCE_SIZE && height <= MAX_INSTANCE_SIZE && layer <= MAX_INSTANCE_LAYER;
+
+    if (is_fit) {
+        std::vector<Instance>& instances = ToGroup(font, tex_obj).instances;
+        if (instances.empty()) ++m_group_count;
+
+        instances.push_back({
+            int16_t(rounded_x), 
+            int16_t(rounded_y), 
+            uint16_t(rounded_tex_x), 
+            uint16_t(rounded_tex_y), 
+            width | (height << 12) | (layer << 24) | (is_flipped ? (1u << 31) : 0u),
+            m_color
+        });
+
+        ++m_quad_count;
+    }
+    return is_fit;
+}
+
+inline void TOGL_GlyphBatch::AddPendingGlyph(TOGL_Font* font, TOGL_Font* owner, double x, double y, uint32_t code, TOGL_OriginId origin_id, double scale) {
+    m_pending_glyphs.push_back({font, owner, x, y, code, origin_id, scale, m_color});
+}
+
+inline const std::vector<TOGL_GlyphBatch::PendingGlyph>& TOGL_GlyphBatch::ToPendingGlyphs() const {
+    return m_pending_glyphs;
+}
+
+inline std::vector<TOGL_GlyphBatch::PendingGlyph> TOGL_GlyphBatch::TakePendingGlyphs() {
+    std::vector<PendingGlyph> pending_glyphs;
+    pending_glyphs.swap(m_pending_glyphs);
+    return pending_glyphs;
+}
+
+inline bool TOGL_GlyphBatch::IsEmpty() const {
+    return m_quad_count == 0;
+}
+
+inline uint32_t TOGL_GlyphBatch::GetQuadCount() const {
+    return m_quad_count;
+}
+
+inline uint32_t TOGL_GlyphBatch::GetGroupCount() const {
+    return m_group_count;
+}
+
+inline const std::vector<TOGL_GlyphBatch::Group>& TOGL_GlyphBatch::ToGroups() const {
+    return m_groups;
+}
+
+inline TOGL_GlyphBatch::Group& TOGL_GlyphBatch::ToGroup(TOGL_Font* font, GLuint tex_obj) {
+    if (m_last_group_ix >= m_groups.size() || m_groups[m_last_group_ix].font != font || m_groups[m_last_group_ix].tex_obj != tex_obj) {
+        m_last_group_ix = 0;
+        while (m_last_group_ix < m_groups.size() && (m_groups[m_last_group_ix].font != font || m_groups[m_last_group_ix].tex_obj != tex_obj)) {
+            ++m_last_group_ix;
+        }
+
+        if (m_last_group_ix == m_groups.size()) {
+            m_groups.push_back({font, tex_obj, {}, {}});
+        }
+    }
+    return m_groups[m_last_group_ix];
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_Font
+//-----------------------------------------------------------------------------
+
+inline TOGL_Font::TOGL_Font() {
+    m_is_recording  = false;
+    m_revision      = 0;
+
+    Initialize();
+}
+inline TOGL_Font::~TOGL_Font() {
+    Unload();
+}
+
+inline void TOGL_Font::Load(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options) {
+    Unload();
+
+    GLuint                  program         = 0;
+    TOGL_FontLoadOptions    used_options    = {};
+
+    if (!PrepareLoad(font_info, options, used_options, program)) return;
+
+    TOGL_FontDataGenerator font_data_generator;
+
+    if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
+        TOGL_LogDebug("Generating font textures...");
+    }
+
+    TOGL_FontData data = font_data_generator.Generate(font_info, used_options);
+    CompleteLoad(data, font_data_generator, program);
+}
+
+inline void TOGL_Font::LoadAsync(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options) {
+    CancelLoading();
+
+    TOGL_FontLoadOptions used_options = {};
+
+    if (!PrepareLoad(font_info, options, used_options, m_pending_program)) {
+        // Fails at once, the same way as failed loading (current font is unloaded).
+        const std::string err_msg = GetErrMsg();
+        Unload();
+        SetErrMsg(err_msg);
+        return;
+    }
+
+    if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
+        TOGL_LogDebug("Generating font textures in background...");
+    }
+
+    m_pending_generator.reset(new TOGL_FontDataGenerator());
+    m_pending_generator->BeginGenerate(font_info, used_options);
+}
+
+inline bool TOGL_Font::UpdateLoading(double time_budget) {
+    if (!m_pending_generator || !m_pending_generator->ContinueGenerate(time_budget)) return false;
+
+    std::unique_ptr<TOGL_FontDataGenerator> font_data_generator = std::move(m_pending_generator);
+    const GLuint                            program             = m_pending_program;
+
+    m_pending_program = 0;
+
+    TOGL_FontData data = font_data_generator->EndGenerate();
+
+    Unload();
+    CompleteLoad(data, *font_data_generator, program);
+
+    return true;
+}
+
+inline bool TOGL_Font::IsLoadingAsync() const {
+    return m_pending_generator != nullptr;
+}
+
+inline void TOGL_Font::CancelLoading() {
+    if (m_pending_generator) {
+        m_pending_generator->CancelGenerate();
+        m_pending_generator.reset();
+    }
+    if (m_pending_program != 0) {
+        m_gl.togl_glDeleteProgram(m_pending_program);
+        m_pending_program = 0;
+    }
+}
+
+inline bool TOGL_Font::PrepareLoad(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options, TOGL_FontLoadOptions& used_options, GLuint& program) {
+    program = 0;
+
+    if (options.is_sdf && options.sdf_spread == 0) {
+        SetErrMsg("Distance field font requires sdf_spread greater than 0.");
+        return false;
+    }
+
+    if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
+        TOGL_LogDebug("Font Unicode Ranges:");
+        for (const auto& range : font_info.unicode_range_group.ToRanges()) {
+            if (range.from == range.to) { 
+                TOGL_LogDebug(std::string() + "[" + TOGL_HexToStr(range.from) + "]");
+            } else {
+                TOGL_LogDebug(std::string() + "[" + TOGL_HexToStr(range.from) + ".." + TOGL_HexToStr(range.to) + "]");
+            }
+        }
+    }
+
+    used_options = options;
+
+    if (used_options.is_style_set) {
+        // Fonts in styles share atlas pages, which glyph cache would repack.
+        used_options.is_lazy                    = true;
+        used_options.glyph_cache_page_budget    = 0;
+    }
+
+    if (used_options.glyph_cache_page_budget != 0) used_options.is_lazy = true;
+
+    if (used_options.is_texture_array) {
+        // Texture array can't be sampled by fixed-function pipeline.
+        program = used_options.is_lazy ? 0 : CreateProgram(true, used_options.is_sdf);
+        if (program == 0) {
+            used_options.is_texture_array = false;
+        }
+    }
+
+    return true;
+}
+
+inline void TOGL_Font::CompleteLoad(const TOGL_FontData& data, const TOGL_FontDataGenerator& font_data_generator, GLuint program) {
+    m_program   = program;
+    m_data      = data;
+
+    if (m_data.tex_array_obj == 0 && m_program != 0) {
+        m_gl.togl_glDeleteProgram(m_program);
+        m_program = 0;
+    }
+
+    if (m_program == 0 && m_data.options.is_sdf) {
+        // Without shader, distance field is rendered with alpha test (edges without smoothing).
+        m_program = CreateProgram(false, true);
+    }
+
+    if (font_data_generator.IsOk()) {
+
+        if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
+            TOGL_LogDebug("Font textures has been generated.");
+
+            const TOGL_FontStats& stats = m_data.stats;
+            TOGL_LogDebug(std::string() + "Font Atlas: glyphs=" + std::to_string(stats.glyph_count) 
+                + ", pages=" + std::to_string(stats.page_count) 
+                + ", page_size=" + std::to_string(stats.page_width) + "x" + std::to_string(stats.page_height) 
+                + ", fill_ratio=" + std::to_string(stats.GetFillRatio())
+                + ", dedupe_ratio=" + std::to_string(stats.GetDedupeRatio())
+                + ", texture_size=" + std::to_string(stats.texture_size)
+                + ", texture_array=" + (m_data.tex_array_obj != 0 ? "yes" : "no")
+                + ", sdf=" + (m_data.options.is_sdf ? (m_program != 0 ? "shader" : "alpha_test") : "no"));
+        }
+
+        m_is_loaded = true;
+
+        if (m_data.options.is_style_set) LoadStyleFonts();
+    } else {
+        SetErrMsg(font_data_generator.GetErrMsg());
+    }
+} 
+
+inline void TOGL_Font::Load(const std::string& name, uint32_t size, TOGL_FontSizeUnitId size_unit, TOGL_FontStyleId style, const TOGL_UnicodeRangeGroup& unicode_range_group) {
+    Load(TOGL_FontInfo(name, size, size_unit, style, unicode_range_group));
+} 
+
+inline void TOGL_Font::LoadBMFont(const std::string& file_name, const TOGL_FontLoadOptions& options) {
+    Unload();
+
+    TOGL_FontLoadOptions bmfont_options = TOGL_FontLoadOptions();
+    bmfont_options.format           = options.format;
+    bmfont_options.is_texture_array = options.is_texture_array;
+
+    GLuint                  program         = 0;
+    TOGL_FontLoadOptions    used_options    = {};
+
+    if (!PrepareLoad(TOGL_FontInfo(), bmfont_options, used_options, program)) return;
+
+    TOGL_FontDataGenerator font_data_generator;
+
+    if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
+        TOGL_LogDebug("Loading font textures from BMFont file \"" + file_name + "\"...");
+    }
+
+    TOGL_FontData data = font_data_generator.GenerateFromBMFont(file_name, used_options);
+    CompleteLoad(data, font_data_generator, program);
+}
+
+inline void TOGL_Font::Unload() {
+    CancelLoading();
+
+    for (auto& tex_obj : m_data.tex_objs) {
+        glDeleteTextures(1, &tex_obj);
+    }
+    if (m_data.tex_array_obj != 0) {
+        glDeleteTextures(1, &m_data.tex_array_obj);
+    }
+    if (m_program != 0) {
+        m_gl.togl_glDeleteProgram(m_program);
+    }
+    if (m_instanced_program != 0) {
+        m_gl.togl_glDeleteProgram(m_instanced_program);
+        m_gl.togl_glDeleteBuffers(1, &m_instance_buffer);
+    }
+    Initialize();
+}
+
+inline bool TOGL_Font::IsLoaded() const {
+    return m_is_loaded;
+}
+
+inline void TOGL_Font::RenderBegin() {
+    glPushAttrib(GL_TEXTURE_BIT);
+    glPushAttrib(GL_ENABLE_BIT);
+    glPushAttrib(GL_COLOR_BUFFER_BIT);
+    glPushAttrib(GL_LIST_BIT);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  
+
+    // Glyph color is taken from current color. Glyph coverage is taken from texture alpha, 
+    // for both RGBA8 (white pixels) and ALPHA8 atlas formats.
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+    m_bound_tex_obj = 0;
+
+    if (m_program != 0) {
+        glGetIntegerv(TOGL_FontGL::TOGL_GL_CURRENT_PROGRAM, &m_prev_program);
+        m_gl.togl_glUseProgram(m_program);
+
+        if (m_data.tex_array_obj != 0) {
+            // All glyphs are in one texture, which is bound once.
+            glBindTexture(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, m_data.tex_array_obj);
+            m_bound_tex_obj = m_data.tex_array_obj;
+        }
+    } else if (m_data.options.is_sdf) {
+        // Glyph edge is at half of distance range. Alpha of current color lowers threshold, so text should be opaque.
+        glEnable(GL_ALPHA_TEST);
+        glAlphaFunc(GL_GEQUAL, 0.5f);
+    }
+}
+
+inline void TOGL_Font::RenderEnd() {
+    if (m_program != 0) {
+        m_gl.togl_glUseProgram(m_prev_program);
+    }
+
+    glPopAttrib();
+    glPopAttrib();
+    glPopAttrib();
+    glPopAttrib();
+}
+
+inline void TOGL_Font::RenderGlyph(uint32_t code) {
+    if (m_is_recording) m_code_point_record.Add(code);
+
+    if (m_is_loaded) {
+        TOGL_Font*      style_font  = ToStyleFont(code, m_style);
+        const uint8_t   font_ix     = style_font ? 0 : ToFontIx(code);
+
+        if (style_font) {
+            RenderStyleGlyph(*style_font, code);
+        } else if (font_ix != 0) {
+            RenderFallbackGlyph(*m_fallback_fonts[font_ix - 1], code);
+        } else {
+            RenderOwnGlyph(code);
+        }
+    }
+}
+
+inline bool TOGL_Font::ToOwnGlyphQuad(uint32_t code, GlyphQuad& quad) const {
+    const TOGL_GlyphData* glyph_data = &ToGlyphData(code);
+
+    if (!glyph_data->is_pending && glyph_data->quad_width != 0 && glyph_data->quad_height != 0) {
+        quad.glyph_data = glyph_data;
+
+        quad.x1 = glyph_data->quad_x * m_scale;
+        quad.x2 = (glyph_data->quad_x + glyph_data->quad_width) * m_scale;
+
+        quad.y1 = glyph_data->quad_y * m_scale;
+        quad.y2 = (glyph_data->quad_y + glyph_data->quad_height) * m_scale;
+
+        quad.ty1 = glyph_data->y1;
+        quad.ty2 = glyph_data->y2;
+
+        if (m_origin_id == TOGL_ORIGIN_ID_LEFT_TOP) {
+            quad.y1 = (int(m_data.font_height) - glyph_data->quad_y - glyph_data->quad_height) * m_scale;
+            quad.y2 = (int(m_data.font_height) - glyph_data->quad_y) * m_scale;
+
+            quad.ty1 = glyph_data->y2;
+            quad.ty2 = glyph_data->y1;
+        }
+        return true;
+    }
+    return false;
+}
+
+inline double TOGL_Font::ToBaselineOffset(const TOGL_Font& font) const {
+    // Both origins are at the same corner of glyph cell, so baselines differ by ascent (origin at top) or descent (origin at bottom).
+    return (m_origin_id == TOGL_ORIGIN_ID_LEFT_TOP) 
+        ? (double(GetAscent()) - double(font.GetAscent())) 
+        : (double(GetDescent()) - double(font.GetDescent()));
+}
+
+inline void TOGL_Font::RenderOwnGlyph(uint32_t code) {
+    GlyphQuad quad;
+
+    // Glyph, which wasn't requested, is uploaded alone.
+    if (m_is_loaded && ToGlyphData(code).is_pending) {
+        RequestOwnGlyph(code);
+        UpdateOwnGlyphs();
+    }
+
+    if (m_is_loaded && ToOwnGlyphQuad(code, quad)) {
+        const TOGL_GlyphData* glyph_data = quad.glyph_data;
+
+        const double x1     = quad.x1;
+        const double x2     = quad.x2;
+        const double y1     = quad.y1;
+        const double y2     = quad.y2;
+        const double ty1    = quad.ty1;
+        const double ty2    = quad.ty2;
+
+        if (glyph_data->tex_obj != 0) {
+            if (m_data.tex_array_obj != 0) {
+                const double layer = glyph_data->layer;
+
+                glBegin(GL_TRIANGLE_FAN);
+
+                glTexCoord3d(glyph_data->x1, ty1, layer);
+                glVertex2d(x1, y1);
+
+                glTexCoord3d(glyph_data->x2, ty1, layer);
+                glVertex2d(x2, y1);
+
+                glTexCoord3d(glyph_data->x2, ty2, layer);
+                glVertex2d(x2, y2);
+
+                glTexCoord3d(glyph_data->x1, ty2, layer);
+                glVertex2d(x1, y2);
+
+                glEnd();
+            } else {
+                // Consecutive glyphs from the same page don't rebind texture.
+                if (glyph_data->tex_obj != m_bound_tex_obj) {
+                    glBindTexture(GL_TEXTURE_2D, glyph_data->tex_obj);
+                    m_bound_tex_obj = glyph_data->tex_obj;
+                }
+                glEnable(GL_TEXTURE_2D);
+
+                glBegin(GL_TRIANGLE_FAN);
+
+                glTexCoord2d(glyph_data->x1, ty1);
+                glVertex2d(x1, y1);
+
+                glTexCoord2d(glyph_data->x2, ty1);
+                glVertex2d(x2, y1);
+
+                glTexCoord2d(glyph_data->x2, ty2);
+                glVertex2d(x2, y2);
+            
+                glTexCoord2d(glyph_data->x1, ty2);
+                glVertex2d(x1, y2);
+
+                glEnd();
+            }
+        } else {
+            // Renders replacement for missing glyph.
+            if (m_program != 0) m_gl.togl_glUseProgram(0);
+            glDisable(GL_TEXTURE_2D);
+
+            glBegin(GL_TRIANGLE_FAN);
+            glVertex2d(x1, y1);
+            glVertex2d(x2, y1);
+            glVertex2d(x2, y2);
+            glVertex2d(x1, y2);
+            glEnd();
+
+            if (m_program != 0) m_gl.togl_glUseProgram(m_program);
+        }
+    }
+} 
+
+inline void TOGL_Font::RenderFallbackGlyph(TOGL_Font& font, uint32_t code) {
+    const double offset_y = ToBaselineOffset(font);
+
+    const TOGL_OriginId old_origin_id = font.m_origin_id;
+    font.m_origin_id = m_origin_id;
+
+    glPushMatrix();
+    glTranslated(0, offset_y, 0);
+
+    font.RenderBegin();
+    font.RenderOwnGlyph(code);
+    font.RenderEnd();
+
+    glPopMatrix();
+
+    font.m_origin_id = old_origin_id;
+
+    // Fallback font has bound its own textures.
+    m_bound_tex_obj = 0;
+    if (m_program != 0 && m_data.tex_array_obj != 0) {
+        glBindTexture(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, m_data.tex_array_obj);
+        m_bound_tex_obj = m_data.tex_array_obj;
+    }
+}
+
+inline void TOGL_Font::LoadStyleFonts() {
+    for (uint32_t style = 0; style < STYLE_COUNT; ++style) {
+        if (style == uint32_t(m_data.info.style)) continue;
+
+        TOGL_FontInfo font_info = m_data.info;
+        font_info.style = TOGL_FontStyleId(style);
+
+        TOGL_FontLoadOptions options = m_data.options;
+        options.is_style_set = false;
+        options.shared_atlas = m_data.atlas;
+
+        std::unique_ptr<TOGL_Font> font(new TOGL_Font());
+        font->Load(font_info, options);
+
+        if (font->IsOk() && font->IsLoaded()) {
+            // Glyphs are rendered with program of this font (see RenderStyleGlyph).
+            if (font->m_program != 0) {
+                font->m_gl.togl_glDeleteProgram(font->m_program);
+                font->m_program = 0;
+            }
+            m_style_fonts[style] = std::move(font);
+        } else if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
+            TOGL_LogDebug("Font style " + std::to_string(style) + " isn't available. " + font->GetErrMsg());
+        }
+    }
+}
+
+inline TOGL_Font* TOGL_Font::ToStyleFont(uint32_t code, TOGL_FontStyleId style) const {
+    if (style == m_data.info.style || uint32_t(style) >= STYLE_COUNT) return nullptr;
+
+    TOGL_Font* font = m_style_fonts[style].get();
+    return (font && font->HasGlyph(code)) ? font : nullptr;
+}
+
+inline void TOGL_Font::RenderStyleGlyph(TOGL_Font& font, uint32_t code) {
+    // Font in style has the same atlas pages and is rendered with program of this font, so texture binding and program are kept.
+    font.m_origin_id        = m_origin_id;
+    font.m_scale            = m_scale;
+    font.m_program          = m_program;
+    font.m_bound_tex_obj    = m_bound_tex_obj;
+
+    const double offset_y = ToBaselineOffset(font);
+
+    if (offset_y != 0) {
+        glPushMatrix();
+        glTranslated(0, offset_y, 0);
+    }
+
+    font.RenderOwnGlyph(code);
+
+    if (offset_y != 0) glPopMatrix();
+
+    m_bound_tex_obj = font.m_bound_tex_obj;
+    font.m_program  = 0;
+}
+
+inline void TOGL_Font::BatchGlyph(TOGL_GlyphBatch& batch, double x, double y, uint32_t code) {
+    if (m_is_recording) m_code_point_record.Add(code);
+
+    if (m_is_loaded) {
+        TOGL_Font*      style_font  = ToStyleFont(code, m_style);
+        const uint8_t   font_ix     = style_font ? 0 : ToFontIx(code);
+
+        if (style_font) {
+            // Font in style has the same atlas pages and is rendered with program of this font, so its quads are in groups of this font.
+            style_font->m_origin_id = m_origin_id;
+            style_font->m_scale     = m_scale;
+
+            style_font->BatchOwnGlyph(batch, *this, x, y + ToBaselineOffset(*style_font), code);
+        } else if (font_ix != 0) {
+            TOGL_Font& font = *m_fallback_fonts[font_ix - 1];
+
+            const TOGL_OriginId old_origin_id = font.m_origin_id;
+            font.m_origin_id = m_origin_id;
+
+            font.BatchOwnGlyph(batch, font, x, y + ToBaselineOffset(font), code);
+
+            font.m_origin_id = old_origin_id;
+        } else {
+            BatchOwnGlyph(batch, *this, x, y, code);
+        }
+    }
+}
+
+inline void TOGL_Font::BatchOwnGlyph(TOGL_GlyphBatch& batch, TOGL_Font& owner, double x, double y, uint32_t code) {
+    GlyphQuad quad;
+
+    if (m_is_loaded && ToGlyphData(code).is_pending) {
+        RequestOwnGlyph(code);
+        batch.AddPendingGlyph(this, &owner, x, y, code, m_origin_id, m_scale);
+    } else if (m_is_loaded && ToOwnGlyphQuad(code, quad)) {
+        const TOGL_GlyphData& glyph_data = *quad.glyph_data;
+
+        if (batch.IsInstanced() && glyph_data.tex_obj != 0 && owner.PrepareInstancing()) {
+            // Glyph rectangle in atlas page has the same size in texels as quad in pixels (before scaling).
+            const double page_width     = glyph_data.quad_width / fabs(glyph_data.x2 - glyph_data.x1);
+            const double page_height    = glyph_data.quad_height / fabs(glyph_data.y2 - glyph_data.y1);
+
+            const bool is_added = batch.AddInstance(
+                &owner, 
+                glyph_data.tex_obj, 
+                x + quad.x1, y + quad.y1, 
+                std::min(glyph_data.x1, glyph_data.x2) * page_width, std::min(quad.ty1, quad.ty2) * page_height,
+                glyph_data.quad_width, glyph_data.quad_height,
+                uint32_t(glyph_data.layer),
+                quad.ty1 > quad.ty2
+            );
+            if (is_added) return;
+        }
+
+        batch.AddQuad(
+            &owner, 
+            glyph_data.tex_obj, 
+            float(x + quad.x1), float(y + quad.y1), float(x + quad.x2), float(y + quad.y2),
+            float(glyph_data.x1), float(quad.ty1), float(glyph_data.x2), float(quad.ty2),
+            float(glyph_data.layer)
+        );
+    }
+}
+
+inline void TOGL_Font::UpdateBatch(TOGL_GlyphBatch& batch) {
+    if (batch.ToPendingGlyphs().empty()) return;
+
+    const std::vector<TOGL_GlyphBatch::PendingGlyph> pending_glyphs = batch.TakePendingGlyphs();
+    const TOGL_Color4U8                             old_color       = batch.ToColor();
+
+    std::vector<TOGL_Font*> fonts;
+
+    for (const TOGL_GlyphBatch::PendingGlyph& pending_glyph : pending_glyphs) {
+        if (std::find(fonts.begin(), fonts.end(), pending_glyph.font) == fonts.end()) {
+            fonts.push_back(pending_glyph.font);
+            pending_glyph.font->UpdateOwnGlyphs();
+        }
+    }
+
+    for (const TOGL_GlyphBatch::PendingGlyph& pending_glyph : pending_glyphs) {
+        TOGL_Font& font = *pending_glyph.font;
+
+        const TOGL_OriginId old_origin_id   = font.m_origin_id;
+        const double        old_scale       = font.m_scale;
+
+        font.m_origin_id    = pending_glyph.origin_id;
+        font.m_scale        = pending_glyph.scale;
+
+        batch.SetColor(pending_glyph.color);
+        font.BatchOwnGlyph(batch, *pending_glyph.owner, pending_glyph.x, pending_glyph.y, pending_glyph.code);
+
+        font.m_origin_id    = old_origin_id;
+        font.m_scale        = old_scale;
+    }
+
+    batch.SetColor(old_color);
+}
+
+inline void TOGL_Font::RenderBatch(const TOGL_GlyphBatch& batch) {
+    const std::vector<TOGL_GlyphBatch::Group>& groups = batch.ToGroups();
+
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    RenderGroupsByFont(groups.size(), 
+        [&groups](size_t ix) { return groups[ix].font; },
+        [&groups](size_t ix) { return groups[ix].vertices.empty() && groups[ix].instances.empty(); },
+        [&groups](size_t ix) {
+            const TOGL_GlyphBatch::Group& group = groups[ix];
+
+            if (!group.vertices.empty()) {
+                group.font->RenderBatchGroup(group.tex_obj, (const uint8_t*)group.vertices.data(), uint32_t(group.vertices.size()));
+            }
+            if (!group.instances.empty()) {
+                group.font->RenderInstancedGroup(group);
+            }
+        }
+    );
+
+    glPopClientAttrib();
+}
+
+inline void TOGL_Font::RenderBufferGroups(const std::vector<TOGL_GlyphBatch::BufferGroup>& groups) {
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    RenderGroupsByFont(groups.size(), 
+        [&groups](size_t ix) { return groups[ix].font; },
+        [&groups](size_t ix) { return groups[ix].count == 0; },
+        [&groups](size_t ix) {
+            const TOGL_GlyphBatch::BufferGroup& group = groups[ix];
+
+            // Offset of group vertices in buffer, in bytes.
+            const uint8_t* vertices = (const uint8_t*)(size_t(group.first) * sizeof(TOGL_GlyphBatch::Vertex));
+
+            group.font->RenderBatchGroup(group.tex_obj, vertices, group.count);
+        }
+    );
+
+    glPopClientAttrib();
+}
+
+template <typename GetFontT, typename IsGroupEmptyT, typename RenderGroupT>
+inline void TOGL_Font::RenderGroupsByFont(size_t group_count, GetFontT get_font, IsGroupEmptyT is_group_empty, RenderGroupT render_group) {
+    for (size_t ix = 0; ix < group_count; ++ix) {
+        TOGL_Font* font = get_font(ix);
+
+        // Groups of font are rendered together, when first of them is found.
+        bool is_rendered    = false;
+        bool is_empty       = true;
+
+        for (size_t prev_ix = 0; prev_ix < ix && !is_rendered; ++prev_ix) {
+            is_rendered = get_font(prev_ix) == font;
+        }
+        for (size_t next_ix = ix; next_ix < group_count && is_empty; ++next_ix) {
+            is_empty = get_font(next_ix) != font || is_group_empty(next_ix);
+        }
+
+        if (!is_rendered && !is_empty) {
+            font->RenderBegin();
+            for (size_t next_ix = ix; next_ix < group_count; ++next_ix) {
+                if (get_font(next_ix) == font && !is_group_empty(next_ix)) render_group(next_ix);
+            }
+            font->RenderEnd();
+        }
+    }
+}
+
+inline void TOGL_Font::RenderBatchGroup(GLuint tex_obj, const uint8_t* vertices, uint32_t vertex_count) {
+    glVertexPointer(2, GL_FLOAT, sizeof(TOGL_GlyphBatch::Vertex), vertices + offsetof(TOGL_GlyphBatch::Vertex, x));
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(TOGL_GlyphBatch::Vertex), vertices + offsetof(TOGL_GlyphBatch::Vertex, color));
+
+    if (tex_obj != 0) {
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+
+        if (m_data.tex_array_obj != 0) {
+            // Texture array is bound by RenderBegin().
+            glTexCoordPointer(3, GL_FLOAT, sizeof(TOGL_GlyphBatch::Vertex), vertices + offsetof(TOGL_GlyphBatch::Vertex, tex_x));
+        } else {
+            if (tex_obj != m_bound_tex_obj) {
+                glBindTexture(GL_TEXTURE_2D, tex_obj);
+                m_bound_tex_obj = tex_obj;
+            }
+            glEnable(GL_TEXTURE_2D);
+
+            glTexCoordPointer(2, GL_FLOAT, sizeof(TOGL_GlyphBatch::Vertex), vertices + offsetof(TOGL_GlyphBatch::Vertex, tex_x));
+        }
+
+        glDrawArrays(GL_QUADS, 0, GLsizei(vertex_count));
+
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    } else {
+        // Renders replacements for missing glyphs.
+        if (m_program != 0) m_gl.togl_glUseProgram(0);
+        glDisable(GL_TEXTURE_2D);
+
+        glDrawArrays(GL_QUADS, 0, GLsizei(vertex_count));
+
+        if (m_program != 0) m_gl.togl_glUseProgram(m_program);
+    }
+}
+
+inline void TOGL_Font::RenderInstancedGroup(const TOGL_GlyphBatch::Group& group) {
+    using Instance = TOGL_GlyphBatch::Instance;
+
+    // Corners of quad in order of triangle strip, (x, y) per vertex, 4 bytes per vertex. Stored in front of instances.
+    static const uint8_t s_corners[sizeof(Instance)] = {
+        0, 0, 0, 0,
+        1, 0, 0, 0,
+        0, 1, 0, 0,
+        1, 1, 0, 0,
+    };
+    enum { ATTRIB_COUNT = 5 };
+
+    if (m_data.tex_array_obj == 0 && group.tex_obj != m_bound_tex_obj) {
+        glBindTexture(GL_TEXTURE_2D, group.tex_obj);
+        m_bound_tex_obj = group.tex_obj;
+    }
+
+    GLint prev_program = 0;
+    GLint prev_buffer = 0;
+    glGetIntegerv(TOGL_FontGL::TOGL_GL_CURRENT_PROGRAM, &prev_program);
+    glGetIntegerv(TOGL_FontGL::TOGL_GL_ARRAY_BUFFER_BINDING, &prev_buffer);
+
+    m_gl.togl_glUseProgram(m_instanced_program);
+    m_gl.togl_glUniform1f(m_instanced_scale_location, GLfloat(m_scale));
+
+    // Buffer is orphaned before upload, so upload doesn't wait for previous draw call.
+    const ptrdiff_t size = ptrdiff_t(group.instances.size() * sizeof(Instance));
+
+    m_gl.togl_glBindBuffer(TOGL_FontGL::TOGL_GL_ARRAY_BUFFER, m_instance_buffer);
+    m_gl.togl_glBufferData(TOGL_FontGL::TOGL_GL_ARRAY_BUFFER, sizeof(s_corners) + size, NULL, TOGL_FontGL::TOGL_GL_STREAM_DRAW);
+    m_gl.togl_glBufferSubData(TOGL_FontGL::TOGL_GL_ARRAY_BUFFER, 0, sizeof(s_corners), s_corners);
+    m_gl.togl_glBufferSubData(TOGL_FontGL::TOGL_GL_ARRAY_BUFFER, sizeof(s_corners), size, group.instances.data());
+
+    // Fixed-function arrays enabled by RenderBatch would be fetched too.
+    glPushClientAttrib(GL_CLIENT_VERTEX_ARRAY_BIT);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glDisableClientState(GL_COLOR_ARRAY);
+
+    const uint8_t* instances = (const uint8_t*)sizeof(s_corners);
+
+    m_gl.togl_glVertexAttribPointer(0, 2, GL_UNSIGNED_BYTE, GL_FALSE, 4, NULL);
+    m_gl.togl_glVertexAttribPointer(1, 2, GL_SHORT, GL_FALSE, sizeof(Instance), instances + offsetof(Instance, x));
+    m_gl.togl_glVertexAttribPointer(2, 2, GL_UNSIGNED_SHORT, GL_FALSE, sizeof(Instance), instances + offsetof(Instance, tex_x));
+    m_gl.togl_glVertexAttribIPointer(3, 1, GL_UNSIGNED_INT, sizeof(Instance), instances + offsetof(Instance, size_layer));
+    m_gl.togl_glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(Instance), instances + offsetof(Instance, color));
+
+    for (GLuint ix = 0; ix < ATTRIB_COUNT; ++ix) {
+        m_gl.togl_glEnableVertexAttribArray(ix);
+        m_gl.togl_glVertexAttribDivisor(ix, (ix == 0) ? 0 : 1);
+    }
+
+    m_gl.togl_glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, GLsizei(group.instances.size()));
+
+    for (GLuint ix = 0; ix < ATTRIB_COUNT; ++ix) {
+        m_gl.togl_glVertexAttribDivisor(ix, 0);
+        m_gl.togl_glDisableVertexAttribArray(ix);
+    }
+
+    glPopClientAttrib();
+
+    m_gl.togl_glBindBuffer(TOGL_FontGL::TOGL_GL_ARRAY_BUFFER, GLuint(prev_buffer));
+    m_gl.togl_glUseProgram(GLuint(prev_program));
+}
+
+inline bool TOGL_Font::PrepareInstancing() {
+    if (!m_is_instancing_prepared && m_is_loaded) {
+        m_is_instancing_prepared = true;
+
+        m_instanced_program = CreateProgram(m_data.tex_array_obj != 0, m_data.options.is_sdf, true);
+
+        if (m_instanced_program != 0) {
+            m_instanced_scale_location = m_gl.togl_glGetUniformLocation(m_instanced_program, "scale");
+            m_gl.togl_glGenBuffers(1, &m_instance_buffer);
+        }
+    }
+    return m_instanced_program != 0;
+}
+
+inline void TOGL_Font::RequestGlyph(uint32_t code) {
+    if (m_is_recording) m_code_point_record.Add(code);
+
+    if (m_is_loaded) {
+        TOGL_Font*      style_font  = ToStyleFont(code, m_style);
+        const uint8_t   font_ix     = style_font ? 0 : ToFontIx(code);
+
+        if (style_font) {
+            style_font->RequestOwnGlyph(code);
+        } else if (font_ix != 0) {
+            m_fallback_fonts[font_ix - 1]->RequestOwnGlyph(code);
+        } else {
+            RequestOwnGlyph(code);
+        }
+    }
+}
+
+inline void TOGL_Font::RequestOwnGlyph(uint32_t code) {
+    if (m_is_loaded) {
+        if (m_data.glyph_cache.IsEnabled() && m_data.glyphs.Has(code)) {
+            // Marks glyph as used in current frame, so it isn't evicted before it's rendered.
+            if (!m_data.glyph_cache.Touch(code) && ToGlyphData(code).is_pending) {
+                m_requested_codes.push_back(code);
+            }
+        } else if (ToGlyphData(code).is_pending) {
+            m_requested_codes.push_back(code);
+        }
+    }
+}
+
+inline void TOGL_Font::RequestGlyphs(const std::wstring& text) {
+    if (m_is_loaded && (m_data.glyph_source || !m_fallback_fonts.empty())) {
+        RequestGlyphs(TOGL_ToUTF32(text));
+    }
+}
+
+inline void TOGL_Font::RequestGlyphs(const std::u32string& text) {
+    if (m_is_loaded && (m_data.glyph_source || !m_fallback_fonts.empty())) {
+        for (const uint32_t code : text) {
+            RequestGlyph(code);
+        }
+    }
+}
+
+inline void TOGL_Font::UpdateGlyphs() {
+    UpdateOwnGlyphs();
+
+    for (std::unique_ptr<TOGL_Font>& font : m_style_fonts) {
+        if (font) font->UpdateOwnGlyphs();
+    }
+
+    for (TOGL_Font* font : m_fallback_fonts) {
+        font->UpdateOwnGlyphs();
+    }
+}
+
+inline void TOGL_Font::UpdateOwnGlyphs() {
+    if (m_is_loaded && !m_requested_codes.empty()) {
+        const uint64_t glyph_cache_change_count = GetGlyphCacheChangeCount();
+
+        TOGL_FontDataGenerator font_data_generator;
+
+        font_data_generator.GeneratePendingGlyphs(m_data, m_requested_codes);
+        m_requested_codes.clear();
+
+        if (GetGlyphCacheChangeCount() != glyph_cache_change_count) m_revision += 1;
+
+        if (!font_data_generator.IsOk()) {
+            SetErrMsg(font_data_generator.GetErrMsg());
+        }
+    }
+}
+
+inline void TOGL_Font::NextFrame() {
+    if (m_is_loaded && m_data.glyph_cache.IsEnabled()) {
+        m_data.glyph_cache.NextFrame();
+
+        const uint64_t glyph_cache_change_count = GetGlyphCacheChangeCount();
+
+        TOGL_FontDataGenerator font_data_generator;
+        font_data_generator.CompactGlyphCache(m_data);
+
+        if (GetGlyphCacheChangeCount() != glyph_cache_change_count) m_revision += 1;
+    }
+}
+
+inline uint64_t TOGL_Font::GetRevision() const {
+    uint64_t revision = m_revision;
+
+    for (const TOGL_Font* font : m_fallback_fonts) {
+        revision = revision * 31 + font->GetLoadId();
+        revision = revision * 31 + font->GetRevision();
+    }
+    return revision;
+}
+
+inline uint64_t TOGL_Font::GetLoadId() const {
+    return m_load_id;
+}
+
+inline uint64_t TOGL_Font::GenerateLoadId() {
+    static std::atomic<uint64_t> s_load_counter(0);
+    return ++s_load_counter;
+}
+
+inline uint64_t TOGL_Font::GetGlyphCacheChangeCount() const {
+    const TOGL_GlyphCacheCounters& counters = m_data.glyph_cache.ToCounters();
+
+    return counters.eviction_count + counters.relocation_count;
+}
+
+inline const TOGL_GlyphCacheCounters& TOGL_Font::ToGlyphCacheCounters() const {
+    return m_data.glyph_cache.ToCounters();
+}
+
+inline bool TOGL_Font::HasGlyph(uint32_t code) const {
+    return m_is_loaded && m_data.glyphs.Has(code);
+}
+
+inline void TOGL_Font::SetFallbackFonts(const std::vector<TOGL_Font*>& fonts) {
+    m_fallback_fonts.clear();
+    m_revision += 1;
+
+    for (TOGL_Font* font : fonts) {
+        if (font && font != this && m_fallback_fonts.size() < TOGL_GlyphTable::MAX_FONT_IX) {
+            m_fallback_fonts.push_back(font);
+        }
+    }
+
+    m_data.glyphs.ResetFontIxs();
+    m_resolution_revision = GetRevision();
+}
+
+inline const std::vector<TOGL_Font*>& TOGL_Font::ToFallbackFonts() const {
+    return m_fallback_fonts;
+}
+
+inline void TOGL_Font::StartRecording() {
+    m_is_recording = true;
+}
+
+inline void TOGL_Font::StopRecording() {
+    m_is_recording = false;
+}
+
+inline bool TOGL_Font::IsRecording() const {
+    return m_is_recording;
+}
+
+inline const TOGL_CodePointRecord& TOGL_Font::ToCodePointRecord() const {
+    return m_code_point_record;
+}
+
+inline void TOGL_Font::ClearCodePointRecord() {
+    m_code_point_record.Clear();
+}
+
+inline void TOGL_Font::SetStyle(TOGL_FontStyleId style) {
+    m_style = style;
+}
+
+inline TOGL_FontStyleId TOGL_Font::GetStyle() const {
+    return m_style;
+}
+
+inline bool TOGL_Font::HasStyle(TOGL_FontStyleId style) const {
+    return m_is_loaded && (style == m_data.info.style || (uint32_t(style) < STYLE_COUNT && m_style_fonts[style]));
+}
+
+inline void TOGL_Font::RenderGlyphs(const std::string& text) {
+    if (m_is_loaded) {
+        const std::u32string text_utf32 = TOGL_ToUTF32(TOGL_ToUTF16(text));
+
+        RequestGlyphs(text_utf32);
+        UpdateGlyphs();
+
+        RenderBegin();
+        int x = 0;
+        for (const uint32_t& code : text_utf32) {
+            glPushMatrix();
+            glTranslatef(float(x), 0, 0);
+            RenderGlyph(code);
+            x += GetGlyphSize(code).width + GetDistanceBetweenGlyphs();
+            glPopMatrix();
+        }
+        RenderEnd();
+    }
+}
+
+inline void TOGL_Font::SetOrigin(TOGL_OriginId origin_id) {
+    m_origin_id = origin_id;
+}
+
+inline TOGL_OriginId TOGL_Font::GetOrigin() const {
+    return m_origin_id;
+}
+
+inline void TOGL_Font::SetScale(double scale) {
+    m_scale = scale;
+}
+
+inline double TOGL_Font::GetScale() const {
+    return m_scale;
+}
+
+inline uint32_t TOGL_Font::GetDistanceBetweenGlyphs() const {
+    return ToScaled(m_data.info.distance_between_glyphs);
+}
+
+inline uint32_t TOGL_Font::GetDistanceBetweenLines() const {
+    return ToScaled(m_data.info.distance_between_lines);
+}
+
+inline TOGL_SizeU TOGL_Font::GetGlyphSize(uint32_t code) const {
+    return GetGlyphSize(code, m_style);
+}
+
+inline TOGL_SizeU TOGL_Font::GetGlyphSize(uint32_t code, TOGL_FontStyleId style) const {
+    if (m_is_recording) m_code_point_record.Add(code);
+
+    if (m_is_loaded) {
+        const TOGL_Font* style_font = ToStyleFont(code, style);
+
+        if (style_font) {
+            return {ToScaled(style_font->ToGlyphData(code).width), ToScaled(m_data.font_height)};
+        }
+
+        const uint8_t font_ix = ToFontIx(code);
+
+        if (font_ix != 0) {
+            const TOGL_Font& font = *m_fallback_fonts[font_ix - 1];
+
+            return {font.ToScaled(font.ToGlyphData(code).width), ToScaled(m_data.font_height)};
+        }
+        return {ToScaled(ToGlyphData(code).width), ToScaled(m_data.font_height)};
+    }
+    return {0, 0};
+}
+
+inline uint32_t TOGL_Font::GetHeight() const {
+    return ToScaled(m_data.font_height);
+}
+
+inline uint32_t TOGL_Font::GetDescent() const {
+    return ToScaled(m_data.font_descent);
+}
+
+inline uint32_t TOGL_Font::GetAscent() const {
+    return ToScaled(m_data.font_ascent);
+}
+
+inline uint32_t TOGL_Font::GetInternalLeading() const {
+    return ToScaled(m_data.font_internal_leading);
+}
+
+inline const TOGL_FontInfo& TOGL_Font::ToFontInfo() const {
+    return m_data.info;
+}
+
+inline const TOGL_FontLoadOptions& TOGL_Font::ToLoadOptions() const {
+    return m_data.options;
+}
+
+inline const TOGL_FontStats& TOGL_Font::ToStats() const {
+    return m_data.stats;
+}
+
+inline bool TOGL_Font::IsOk() const {
+    return m_err_msg.empty();
+}
+
+inline std::string TOGL_Font::GetErrMsg() const {
+    return m_err_msg;
+}
+
+inline bool TOGL_Font::SaveAsBMP(const std::string& path) const {
+    bool is_success = false;
+
+    if (m_is_loaded) {
+        std::string file_name_prefix = path;
+
+        if (file_name_prefix.length() > 0 && file_name_prefix[file_name_prefix.length() - 1] != '/' && file_name_prefix[file_name_prefix.length() - 1] != '\\') {
+            file_name_prefix += "/";
+        }
+
+        file_name_prefix += m_data.info.name;
+
+        auto MakeFileName = [&file_name_prefix](size_t ix) {
+            std::string file_name = file_name_prefix;
+            if (ix > 0) file_name += " (" + std::to_string(ix + 1) + ")";
+            file_name += ".bmp";
+            return file_name;
+        };
+
+        if (m_data.tex_array_obj != 0) {
+            // Reads all layers at once, as white pixels with alpha.
+            const uint32_t  width       = m_data.stats.page_width;
+            const uint32_t  height      = m_data.stats.page_height;
+            const size_t    page_size   = size_t(width) * height * 4;
+
+            std::vector<uint8_t> pixels(page_size * m_data.stats.page_count);
+
+            glPushAttrib(GL_TEXTURE_BIT);
+            glPushAttrib(GL_PIXEL_MODE_BIT);
+            glBindTexture(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, m_data.tex_array_obj);
+
+            glPixelTransferf(GL_RED_BIAS, 1.0f);
+            glPixelTransferf(GL_GREEN_BIAS, 1.0f);
+            glPixelTransferf(GL_BLUE_BIAS, 1.0f);
+            glGetTexImage(TOGL_FontGL::TOGL_GL_TEXTURE_2D_ARRAY, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+            glPopAttrib();
+            glPopAttrib();
+
+            for (size_t ix = 0; ix < m_data.stats.page_count; ++ix) {
+                is_success = TOGL_SaveAsBMP(MakeFileName(ix), pixels.data() + page_size * ix, width, height, false);
+                if (!is_success) break;
+            }
+        } else {
+            const std::vector<GLuint>& tex_objs = m_data.atlas ? m_data.atlas->ToTexObjs() : m_data.tex_objs;
+
+            for (size_t ix = 0; ix < tex_objs.size(); ++ix) {
+                is_success = TOGL_SaveTextureAsBMP(MakeFileName(ix), tex_objs[ix]);
+                if (!is_success) break;
+            }
+        }
+    }
+
+    return is_success;
+}
 
-                        pos = {0, y};
-                    } else {
-                        pos.y -= m_data.font_height;
-                    }
-                }
+inline void TOGL_Font::Initialize() {
+    m_revision      += 1;
+    m_load_id       = GenerateLoadId();
 
-                auto ToTexSpace = [](uint16_t pos, uint16_t size) -> double {
-                    return pos / double(size);
-                };
+    m_data          = {};
+    m_origin_id     = TOGL_ORIGIN_ID_LEFT_BOTTOM;
+    m_scale         = 1.0;
+    m_is_loaded     = false;
+    m_err_msg       = "";
 
-                TOGL_GlyphData glyph_data = {};
+    m_program       = 0;
+    m_prev_program  = 0;
+    m_bound_tex_obj = 0;
 
-                glyph_data.width = size.width;
-                glyph_data.tex_obj = tex_obj;
+    m_is_instancing_prepared    = false;
+    m_instanced_program         = 0;
+    m_instanced_scale_location  = -1;
+    m_instance_buffer           = 0;
 
-                glyph_data.x1 = ToTexSpace(pos.x, width);
-                glyph_data.y1 = ToTexSpace(pos.y - m_data.font_descent, height);
-                glyph_data.x2 = ToTexSpace(pos.x + size.width, width);
-                glyph_data.y2 = ToTexSpace(pos.y - m_data.font_descent + m_data.font_height, height);
+    m_requested_codes.clear();
 
-                m_data.glyphs[code] = glyph_data;
-              
-                RenderGlyphToTexture(
-                    display_list_set.base, 
-                    pos.x, pos.y, 
-                    (wchar_t)(code - display_list_set.first) // corrects character code to match glyph index in display list
-                );
-                    
-                // Used as workaround for overlapping glyphs when they are drawn.
-                enum { ADDITIONAL_SAFE_SPACE = 1 };
+    m_pending_generator.reset();
+    m_pending_program = 0;
 
-                pos.x += size.width + ADDITIONAL_SAFE_SPACE;
-            }
-        }
+    // Fallback fonts are kept, but code points are resolved again (font indices are kept in glyph table).
+    m_resolution_revision = 0;
 
-        glMatrixMode(GL_PROJECTION);
-        glPopMatrix();
-        glMatrixMode(GL_MODELVIEW);
-        glPopMatrix();
-                    
-        glPopAttrib();
-        glPopAttrib();
-        glPopAttrib();
-    }
+    m_style = TOGL_FONT_STYLE_ID_NORMAL;
+    for (std::unique_ptr<TOGL_Font>& font : m_style_fonts) font.reset();
+}
 
-    if (!frame_buffer.IsOk()) {
-        SetErrMsg(frame_buffer.GetErrMsg());
-    }
+inline void TOGL_Font::SetErrMsg(const std::string& err_msg) {
+    m_err_msg = err_msg;
 }
 
-inline void TOGL_FontDataGenerator::RenderGlyphToTexture(GLuint list_base, int x, int y, wchar_t c) {
-    glPushAttrib(GL_ENABLE_BIT);
-    glPushAttrib(GL_COLOR_BUFFER_BIT);
-    glPushAttrib(GL_LIST_BIT);
+inline const TOGL_GlyphData& TOGL_Font::ToGlyphData(uint32_t code) const {
+    return m_data.glyphs.Get(code);
+}
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  
-                
-    glColor4ub(255, 255, 255, 255);
-    glRasterPos2i(x, y);
+inline uint8_t TOGL_Font::ToFontIx(uint32_t code) const {
+    if (m_fallback_fonts.empty()) return 0;
 
-    glListBase(list_base);
-    glCallLists(1, GL_UNSIGNED_SHORT, &c);
+    // Fonts of chain might have been reloaded or changed, so code points are resolved again.
+    const uint64_t revision = GetRevision();
+    if (revision != m_resolution_revision) {
+        m_data.glyphs.ResetFontIxs();
+        m_resolution_revision = revision;
+    }
 
-    glPopAttrib();
-    glPopAttrib();
-    glPopAttrib();
+    // Glyphs of this font have font index 0, so only missing glyphs are resolved.
+    return m_data.glyphs.ToFontIx(code, [this](uint32_t code) {
+        for (size_t ix = 0; ix < m_fallback_fonts.size(); ++ix) {
+            if (m_fallback_fonts[ix]->HasGlyph(code)) return uint8_t(ix + 1);
+        }
+        return uint8_t(0);
+    });
 }
 
-inline TOGL_SizeU16 TOGL_FontDataGenerator::GetCharSize(wchar_t c) const {
-    SIZE size;
-    if (GetTextExtentPoint32W(m_device_context_handle, &c, 1, &size)) {
-        return TOGL_SizeU16(size.cx, size.cy);
-    }
-    return {};
+inline uint32_t TOGL_Font::ToScaled(uint32_t length) const {
+    return (m_scale == 1.0) ? length : uint32_t(length * m_scale + 0.5);
 }
 
-inline void TOGL_FontDataGenerator::SetErrMsg(const std::string& err_msg) {
-    m_err_msg = err_msg;
-}
+inline GLuint TOGL_Font::CreateProgram(bool is_texture_array, bool is_sdf, bool is_instanced) {
+    const TOGL_GL_Version version = TOGL_FontGL::GetVersion();
 
-inline uint32_t TOGL_FontDataGenerator::ToPixels(uint32_t size, TOGL_FontSizeUnitId size_unit) {
-    switch (size_unit) {
-    case TOGL_FONT_SIZE_UNIT_ID_PIXELS: return size;
-    case TOGL_FONT_SIZE_UNIT_ID_POINTS: return PointsToPixels(size);
+    if (is_instanced) {
+        if (version.major < 3 || (version.major == 3 && version.minor < 3) || !m_gl.LoadInstancing()) return 0;
+    } else {
+        if (version.major < (is_texture_array ? 3 : 2) || !m_gl.Load()) return 0;
     }
-    return 0;
-}
 
-template <typename Type>
-inline void TOGL_FontDataGenerator::Load(Type& function, const std::string& function_name) {
-    function = (Type)wglGetProcAddress(function_name.c_str());
-    if (!function) {
-        SetErrMsg(std::string() + "Can not load function: \"" + function_name + "\".");
+    const std::string sampler_source = is_texture_array ? "sampler2DArray" : "sampler2D";
+
+    // Compatibility profile. Vertices are passed by fixed-function attributes (glVertex, glTexCoord, glColor).
+    // Instanced program takes corner of quad per vertex and glyph per instance (see TOGL_GlyphBatch::Instance).
+    const std::string vertex_shader_source = is_instanced ?
+        "#version 330 compatibility\n"
+        "layout(location = 0) in vec2 corner;\n"
+        "layout(location = 1) in vec2 instance_pos;\n"
+        "layout(location = 2) in vec2 instance_tex_pos;\n"
+        "layout(location = 3) in uint instance_size_layer;\n"
+        "layout(location = 4) in vec4 instance_color;\n"
+        "uniform " + sampler_source + " atlas;\n"
+        "uniform float scale;\n"
+        "out vec3 tex_coord;\n"
+        "out vec4 color;\n"
+        "void main() {\n"
+        "    vec2 size          = vec2(float(instance_size_layer & 0xFFFu), float((instance_size_layer >> 12) & 0xFFFu));\n"
+        "    float layer        = float((instance_size_layer >> 24) & 0x7Fu);\n"
+        "    vec2 tex_corner    = ((instance_size_layer >> 31) != 0u) ? vec2(corner.x, 1.0 - corner.y) : corner;\n"
+        "    gl_Position        = gl_ModelViewProjectionMatrix * vec4(instance_pos + corner * size * scale, 0.0, 1.0);\n"
+        "    tex_coord          = vec3((instance_tex_pos + tex_corner * size) / vec2(textureSize(atlas, 0).xy), layer);\n"
+        "    color              = instance_color;\n"
+        "}\n"
+        : is_texture_array ? 
+        "#version 130\n"
+        "out vec3 tex_coord;\n"
+        "out vec4 color;\n"
+        "void main() {\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+        "    tex_coord   = gl_MultiTexCoord0.xyz;\n"
+        "    color       = gl_Color;\n"
+        "}\n"
+        :
+        "#version 110\n"
+        "varying vec2 tex_coord;\n"
+        "varying vec4 color;\n"
+        "void main() {\n"
+        "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+        "    tex_coord   = gl_MultiTexCoord0.xy;\n"
+        "    color       = gl_Color;\n"
+        "}\n";
+
+    // Distance field edge (0.5) is smoothed over about one screen pixel, at any scale.
+    const std::string sdf_source = is_sdf ? 
+        "    float smoothing = 0.7 * fwidth(alpha);\n"
+        "    alpha = smoothstep(0.5 - smoothing, 0.5 + smoothing, alpha);\n"
+        : "";
+
+    // The same result as GL_MODULATE texture environment for white glyph pixels.
+    const std::string fragment_shader_source = is_instanced ?
+        "#version 330 compatibility\n"
+        "uniform " + sampler_source + " atlas;\n"
+        "in vec3 tex_coord;\n"
+        "in vec4 color;\n"
+        "out vec4 frag_color;\n"
+        "void main() {\n"
+        "    float alpha = texture(atlas, tex_coord" + (is_texture_array ? "" : ".xy") + ").a;\n"
+        + sdf_source +
+        "    frag_color = vec4(color.rgb, color.a * alpha);\n"
+        "}\n"
+        : is_texture_array ? 
+        "#version 130\n"
+        "uniform sampler2DArray atlas;\n"
+        "in vec3 tex_coord;\n"
+        "in vec4 color;\n"
+        "out vec4 frag_color;\n"
+        "void main() {\n"
+        "    float alpha = texture(atlas, tex_coord).a;\n"
+        + sdf_source +
+        "    frag_color = vec4(color.rgb, color.a * alpha);\n"
+        "}\n"
+        :
+        "#version 110\n"
+        "uniform sampler2D atlas;\n"
+        "varying vec2 tex_coord;\n"
+        "varying vec4 color;\n"
+        "void main() {\n"
+        "    float alpha = texture2D(atlas, tex_coord).a;\n"
+        + sdf_source +
+        "    gl_FragColor = vec4(color.rgb, color.a * alpha);\n"
+        "}\n";
+
+    std::string err_msg;
+    const GLuint program = m_gl.CreateProgram(vertex_shader_source, fragment_shader_source, err_msg);
+
+    if (program != 0) {
+        GLint prev_program = 0;
+        glGetIntegerv(TOGL_FontGL::TOGL_GL_CURRENT_PROGRAM, &prev_program);
+
+        m_gl.togl_glUseProgram(program);
+        m_gl.togl_glUniform1i(m_gl.togl_glGetUniformLocation(program, "atlas"), 0);
+        m_gl.togl_glUseProgram(prev_program);
+
+    } else if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
+        TOGL_LogDebug(err_msg);
     }
+
+    return program;
 }
 
 //-----------------------------------------------------------------------------
-// Global Font
+// TOGL_FontHandle
 //-----------------------------------------------------------------------------
 
-inline TOGL_Font& TOGL_ToGlobalFont() {
-    return TOGL_Global<TOGL_Font>::ToObject();
-}
+inline TOGL_FontHandle::TOGL_FontHandle() : id(0) {}
 
-inline void TOGL_LoadFont(const TOGL_FontInfo& font_info) {
-    TOGL_ToGlobalFont().Load(font_info);
-}
+inline TOGL_FontHandle::TOGL_FontHandle(uint32_t id) : id(id) {}
 
-inline void TOGL_LoadFont(const std::string& name, uint32_t size, TOGL_FontSizeUnitId size_unit, TOGL_FontStyleId style, const TOGL_UnicodeRangeGroup& unicode_range_group) {
-    TOGL_ToGlobalFont().Load(name, size, size_unit, style, unicode_range_group);
+inline bool TOGL_FontHandle::IsNone() const {
+    return id == 0;
 }
 
-inline void TOGL_UnloadFont() {
-    TOGL_ToGlobalFont().Unload();
+inline bool TOGL_FontHandle::operator==(const TOGL_FontHandle& other) const {
+    return id == other.id;
 }
 
-inline bool TOGL_IsFontLoaded() {
-    return TOGL_ToGlobalFont().IsLoaded();
+inline bool TOGL_FontHandle::operator!=(const TOGL_FontHandle& other) const {
+    return id != other.id;
 }
 
-inline uint32_t TOGL_GetFontHeight() {
-    return TOGL_ToGlobalFont().GetHeight();
-}
+//-----------------------------------------------------------------------------
+// Global Font Registry
+//-----------------------------------------------------------------------------
 
-inline uint32_t TOGL_GetFontAscent() {
-    return TOGL_ToGlobalFont().GetAscent();
+inline TOGL_FontRegistry& TOGL_ToGlobalFontRegistry() {
+    return TOGL_Global<TOGL_FontRegistry>::ToObject();
 }
 
-inline uint32_t TOGL_GetFontDescent() {
-    return TOGL_ToGlobalFont().GetDescent();
-}
+//-----------------------------------------------------------------------------
+// TOGL_FontRegistry
+//-----------------------------------------------------------------------------
 
-inline uint32_t TOGL_GetInternalLeading() {
-    return TOGL_ToGlobalFont().GetInternalLeading();
-}
+inline TOGL_FontRegistry::TOGL_FontRegistry() {
 
-inline TOGL_FontInfo TOGL_GetFontInfo() {
-    return TOGL_ToGlobalFont().ToFontInfo();
 }
 
-inline bool TOGL_IsFontOk() {
-    return TOGL_ToGlobalFont().IsOk();
+inline TOGL_FontRegistry::~TOGL_FontRegistry() {
+    UnloadAll();
 }
 
-inline std::string TOGL_GetFontErrMsg() {
-    return TOGL_ToGlobalFont().GetErrMsg();
-}
+inline TOGL_FontHandle TOGL_FontRegistry::Load(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options) {
+    m_err_msg = "";
 
-//-----------------------------------------------------------------------------
-// TOGL_Font
-//-----------------------------------------------------------------------------
+    TOGL_FontLoadOptions registry_options = MakeRegistryOptions(options);
 
-inline TOGL_Font::TOGL_Font() {
-    Initialize();
-}
-inline TOGL_Font::~TOGL_Font() {
-    Unload();
-}
+    const uint64_t key = TOGL_FontCache::MakeKey(font_info, registry_options);
 
-inline void TOGL_Font::Load(const TOGL_FontInfo& font_info) {
-    Unload();
+    for (size_t ix = 0; ix < m_slots.size(); ++ix) {
+        Slot& slot = m_slots[ix];
 
-    if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
-        TOGL_LogDebug("Font Unicode Ranges:");
-        for (const auto& range : font_info.unicode_range_group.ToRanges()) {
-            if (range.from == range.to) { 
-                TOGL_LogDebug(std::string() + "[" + TOGL_HexToStr(range.from) + "]");
-            } else {
-                TOGL_LogDebug(std::string() + "[" + TOGL_HexToStr(range.from) + ".." + TOGL_HexToStr(range.to) + "]");
-            }
+        if (slot.font && slot.key == key) {
+            slot.ref_count += 1;
+            return TOGL_FontHandle((uint32_t(slot.generation) << 16) | uint32_t(ix + 1));
         }
     }
 
-    TOGL_FontDataGenerator font_data_generator;
+    AssignSharedAtlas(registry_options);
 
-    if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
-        TOGL_LogDebug("Generating font textures...");
+    std::unique_ptr<TOGL_Font> font(new TOGL_Font());
+    font->Load(font_info, registry_options);
+
+    if (!font->IsOk() || !font->IsLoaded()) {
+        m_err_msg = font->GetErrMsg();
+        font.reset();
+        registry_options.shared_atlas = nullptr;
+
+        ReleaseUnusedAtlases();
+        return TOGL_FontHandle();
     }
 
-    m_data = font_data_generator.Generate(font_info);
-    if (font_data_generator.IsOk()) {
+    return AddSlot(std::move(font), key);
+}
 
-        if (TOGL_IsLogLevelAtLeast(TOGL_LOG_LEVEL_DEBUG)) {
-            TOGL_LogDebug("Font textures has been generated.");
-        }
+inline TOGL_FontHandle TOGL_FontRegistry::LoadAsync(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options) {
+    m_err_msg = "";
 
-        m_is_loaded = true;
-    } else {
-        SetErrMsg(font_data_generator.GetErrMsg());
-    }
-} 
+    TOGL_FontLoadOptions registry_options = MakeRegistryOptions(options);
 
-inline void TOGL_Font::Load(const std::string& name, uint32_t size, TOGL_FontSizeUnitId size_unit, TOGL_FontStyleId style, const TOGL_UnicodeRangeGroup& unicode_range_group) {
-    Load(TOGL_FontInfo(name, size, size_unit, style, unicode_range_group));
-} 
+    const uint64_t key = TOGL_FontCache::MakeKey(font_info, registry_options);
 
-inline void TOGL_Font::Unload() {
-    for (auto& tex_obj : m_data.tex_objs) {
-        glDeleteTextures(1, &tex_obj);
+    for (size_t ix = 0; ix < m_slots.size(); ++ix) {
+        Slot& slot = m_slots[ix];
+
+        if (slot.font && slot.key == key) {
+            slot.ref_count += 1;
+            return TOGL_FontHandle((uint32_t(slot.generation) << 16) | uint32_t(ix + 1));
+        }
     }
-    Initialize();
-}
 
-inline bool TOGL_Font::IsLoaded() const {
-    return m_is_loaded;
-}
+    AssignSharedAtlas(registry_options);
 
-inline void TOGL_Font::RenderBegin() {
-    glPushAttrib(GL_TEXTURE_BIT);
-    glPushAttrib(GL_ENABLE_BIT);
-    glPushAttrib(GL_COLOR_BUFFER_BIT);
-    glPushAttrib(GL_LIST_BIT);
+    std::unique_ptr<TOGL_Font> font(new TOGL_Font());
+    font->LoadAsync(font_info, registry_options);
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);  
-}
+    if (!font->IsOk()) {
+        m_err_msg = font->GetErrMsg();
+        font.reset();
+        registry_options.shared_atlas = nullptr;
 
-inline void TOGL_Font::RenderEnd() {
-    glPopAttrib();
-    glPopAttrib();
-    glPopAttrib();
-    glPopAttrib();
-}
+        ReleaseUnusedAtlases();
+        return TOGL_FontHandle();
+    }
 
-inline void TOGL_Font::RenderGlyph(uint32_t code) {
-    if (m_is_loaded) {
-        const TOGL_GlyphData* glyph_data = FindGlyphData(code);
+    return AddSlot(std::move(font), key);
+}
 
-        if (glyph_data != nullptr && glyph_data->tex_obj != 0) {
-            glBindTexture(GL_TEXTURE_2D, glyph_data->tex_obj);
-            glEnable(GL_TEXTURE_2D);
+inline void TOGL_FontRegistry::ReloadAsync(TOGL_FontHandle handle, const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options) {
+    const int64_t slot_ix = FindSlot(handle);
 
-            glBegin(GL_TRIANGLE_FAN);
+    if (slot_ix >= 0) {
+        Slot& slot = m_slots[size_t(slot_ix)];
 
-            if (m_origin_id == TOGL_ORIGIN_ID_LEFT_BOTTOM) {
-                glTexCoord2d(glyph_data->x1, glyph_data->y1);
-                glVertex2i(0, 0);
+        TOGL_FontLoadOptions registry_options = MakeRegistryOptions(options);
 
-                glTexCoord2d(glyph_data->x2, glyph_data->y1);
-                glVertex2i(glyph_data->width, 0);
+        slot.key = TOGL_FontCache::MakeKey(font_info, registry_options);
 
-                glTexCoord2d(glyph_data->x2, glyph_data->y2);
-                glVertex2i(glyph_data->width, m_data.font_height);
-                
-                glTexCoord2d(glyph_data->x1, glyph_data->y2);
-                glVertex2i(0, m_data.font_height);
-            } else {
-                glTexCoord2d(glyph_data->x1, glyph_data->y2);
-                glVertex2i(0, 0);
-                
-                glTexCoord2d(glyph_data->x2, glyph_data->y2);
-                glVertex2i(glyph_data->width, 0);
-                
-                glTexCoord2d(glyph_data->x2, glyph_data->y1);
-                glVertex2i(glyph_data->width, m_data.font_height);
-                
-                glTexCoord2d(glyph_data->x1, glyph_data->y1);
-                glVertex2i(0, m_data.font_height);
-            }
+        AssignSharedAtlas(registry_options);
+        slot.font->LoadAsync(font_info, registry_options);
+        if (!slot.font->IsOk()) m_err_msg = slot.font->GetErrMsg();
+    }
+}
 
-            glEnd();
-        } else {
-            // Renders replacement for missing glyph.
-            glDisable(GL_TEXTURE_2D);
+inline void TOGL_FontRegistry::Update(double time_budget) {
+    const auto start = std::chrono::steady_clock::now();
 
-            glBegin(GL_TRIANGLE_FAN);
-            glVertex2i(0, 0);
-            glVertex2i(m_data.font_height, 0);
-            glVertex2i(m_data.font_height, m_data.font_height);
-            glVertex2i(0, m_data.font_height);
-            glEnd();
-        }
-    }
-} 
+    bool is_any_loaded = false;
 
-inline void TOGL_Font::RenderGlyphs(const std::string& text) {
-    if (m_is_loaded) {
-        const std::wstring text_utf16 = TOGL_ToUTF16(text);
+    for (Slot& slot : m_slots) {
+        if (slot.font && slot.font->IsLoadingAsync()) {
+            const double time_left = time_budget - std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (time_left <= 0) break;
 
-        RenderBegin();
-        int x = 0;
-        for (const uint32_t& code : text_utf16) {
-            glPushMatrix();
-            glTranslatef(float(x), 0, 0);
-            RenderGlyph(code);
-            x += GetGlyphSize(code).width + m_data.info.distance_between_glyphs;
-            glPopMatrix();
+            if (slot.font->UpdateLoading(time_left)) {
+                if (!slot.font->IsOk()) m_err_msg = slot.font->GetErrMsg();
+                is_any_loaded = true;
+            }
         }
-        RenderEnd();
     }
-}
 
-inline void TOGL_Font::SetOrigin(TOGL_OriginId origin_id) {
-    m_origin_id = origin_id;
+    // Reloaded font might have replaced font from other atlas.
+    if (is_any_loaded) ReleaseUnusedAtlases();
 }
 
-inline TOGL_OriginId TOGL_Font::GetOrigin() const {
-    return m_origin_id;
-}
+inline bool TOGL_FontRegistry::IsPending(TOGL_FontHandle handle) const {
+    const int64_t slot_ix = FindSlot(handle);
 
-inline uint32_t TOGL_Font::GetDistanceBetweenGlyphs() const {
-    return m_data.info.distance_between_glyphs;
+    return slot_ix >= 0 && m_slots[size_t(slot_ix)].font->IsLoadingAsync();
 }
 
-inline uint32_t TOGL_Font::GetDistanceBetweenLines() const {
-    return m_data.info.distance_between_lines;
+inline TOGL_FontHandle TOGL_FontRegistry::Load(const std::string& name, uint32_t size, TOGL_FontSizeUnitId size_unit, TOGL_FontStyleId style, const TOGL_UnicodeRangeGroup& unicode_range_group) {
+    return Load(TOGL_FontInfo(name, size, size_unit, style, unicode_range_group));
 }
 
-inline TOGL_SizeU TOGL_Font::GetGlyphSize(uint32_t code) const {
-    TOGL_SizeU size = {0, 0};
-    if (m_is_loaded) {
-        const TOGL_GlyphData* glyph_data = FindGlyphData(code);
-        if (glyph_data) {
-            size = {glyph_data->width, m_data.font_height};
-        } else {
-            size = {m_data.font_height, m_data.font_height};
+inline void TOGL_FontRegistry::Unload(TOGL_FontHandle handle) {
+    const int64_t slot_ix = FindSlot(handle);
+
+    if (slot_ix >= 0) {
+        Slot& slot = m_slots[size_t(slot_ix)];
+
+        slot.ref_count -= 1;
+
+        if (slot.ref_count == 0) {
+            slot.font.reset();
+            slot.key        = 0;
+            slot.generation += 1;
+
+            ReleaseUnusedAtlases();
         }
     }
-    return size;
 }
 
-inline uint32_t TOGL_Font::GetHeight() const {
-    return m_data.font_height;
+inline void TOGL_FontRegistry::UnloadAll() {
+    for (Slot& slot : m_slots) {
+        if (slot.font) {
+            slot.font.reset();
+            slot.key        = 0;
+            slot.ref_count  = 0;
+            slot.generation += 1;
+        }
+    }
+    ReleaseUnusedAtlases();
 }
 
-inline uint32_t TOGL_Font::GetDescent() const {
-    return m_data.font_descent;
-}
+inline bool TOGL_FontRegistry::IsLoaded(TOGL_FontHandle handle) const {
+    const int64_t slot_ix = FindSlot(handle);
 
-inline uint32_t TOGL_Font::GetAscent() const {
-    return m_data.font_ascent;
+    return slot_ix >= 0 && m_slots[size_t(slot_ix)].font->IsLoaded();
 }
 
-inline uint32_t TOGL_Font::GetInternalLeading() const {
-    return m_data.font_internal_leading;
+inline TOGL_Font& TOGL_FontRegistry::ToFont(TOGL_FontHandle handle) {
+    const int64_t slot_ix = FindSlot(handle);
+
+    return (slot_ix >= 0) ? *m_slots[size_t(slot_ix)].font : m_empty_font;
 }
 
-inline uint32_t TOGL_Font::GetGlyphCountInWidth(const std::wstring& text, uint32_t width) const {
-    uint32_t    count           = 0;
-    uint32_t    current_width   = 0;
+inline const TOGL_Font& TOGL_FontRegistry::ToFont(TOGL_FontHandle handle) const {
+    const int64_t slot_ix = FindSlot(handle);
 
-    bool is_first = true;
-    for (const wchar_t c : text) {
-        if (is_first) {
-            is_first = false;
-        } else {
-            current_width += m_data.info.distance_between_glyphs;
-        }
-        current_width += GetGlyphSize(c).width;
-        if (current_width > width) break;
-        count += 1;
+    return (slot_ix >= 0) ? *m_slots[size_t(slot_ix)].font : m_empty_font;
+}
+
+inline uint32_t TOGL_FontRegistry::GetFontCount() const {
+    uint32_t count = 0;
+    for (const Slot& slot : m_slots) {
+        if (slot.font) count += 1;
     }
     return count;
 }
 
-inline const TOGL_FontInfo& TOGL_Font::ToFontInfo() const {
-    return m_data.info;
+inline uint32_t TOGL_FontRegistry::GetPageCount() const {
+    uint32_t count = 0;
+    for (const auto& atlas : m_atlases) {
+        count += atlas->GetPageCount();
+    }
+    return count;
 }
 
-inline bool TOGL_Font::IsOk() const {
+inline bool TOGL_FontRegistry::IsOk() const {
     return m_err_msg.empty();
 }
 
-inline std::string TOGL_Font::GetErrMsg() const {
+inline std::string TOGL_FontRegistry::GetErrMsg() const {
     return m_err_msg;
 }
 
-inline bool TOGL_Font::SaveAsBMP(const std::string& path) const {
-    bool is_success = false;
+inline int64_t TOGL_FontRegistry::FindSlot(TOGL_FontHandle handle) const {
+    const uint32_t slot_number  = handle.id & 0xFFFF;
+    const uint16_t generation   = uint16_t(handle.id >> 16);
 
-    if (m_is_loaded) {
-        std::string file_name_prefix = path;
+    if (slot_number == 0 || slot_number > m_slots.size()) return -1;
 
-        if (file_name_prefix.length() > 0 && file_name_prefix[file_name_prefix.length() - 1] != '/' && file_name_prefix[file_name_prefix.length() - 1] != '\\') {
-            file_name_prefix += "/";
-        }
+    const Slot& slot = m_slots[slot_number - 1];
 
-        file_name_prefix += m_data.info.name;
+    return (slot.font && slot.generation == generation) ? int64_t(slot_number - 1) : -1;
+}
 
-        for (size_t ix = 0; ix < m_data.tex_objs.size(); ++ix) {
-            std::string file_name = file_name_prefix;
-            if (ix > 0) file_name += " (" + std::to_string(ix + 1) + ")";
-            file_name += ".bmp";
+inline TOGL_FontHandle TOGL_FontRegistry::AddSlot(std::unique_ptr<TOGL_Font> font, uint64_t key) {
+    size_t slot_ix = 0;
+    while (slot_ix < m_slots.size() && m_slots[slot_ix].font) ++slot_ix;
 
-            is_success = TOGL_SaveTextureAsBMP(file_name, m_data.tex_objs[ix]);
-            if (!is_success) break;
-        }
+    // Slot index is stored in lower 16 bits of handle.
+    if (slot_ix >= 0xFFFF) {
+        m_err_msg = "Too many fonts in font registry.";
+        return TOGL_FontHandle();
     }
 
-    return is_success;
-}
+    if (slot_ix == m_slots.size()) m_slots.push_back({});
 
-inline void TOGL_Font::Initialize() {
-    m_data          = {};
-    m_origin_id     = TOGL_ORIGIN_ID_LEFT_BOTTOM;
-    m_is_loaded     = false;
-    m_err_msg       = "";
-}
+    Slot& slot = m_slots[slot_ix];
 
-inline void TOGL_Font::SetErrMsg(const std::string& err_msg) {
-    m_err_msg = err_msg;
+    slot.font       = std::move(font);
+    slot.key        = key;
+    slot.ref_count  = 1;
+
+    return TOGL_FontHandle((uint32_t(slot.generation) << 16) | uint32_t(slot_ix + 1));
 }
 
-inline const TOGL_GlyphData* TOGL_Font::FindGlyphData(uint32_t code) const {
-    auto it = m_data.glyphs.find(code);
+inline TOGL_FontLoadOptions TOGL_FontRegistry::MakeRegistryOptions(const TOGL_FontLoadOptions& options) {
+    TOGL_FontLoadOptions registry_options = options;
 
-    if (it == m_data.glyphs.end()) it = m_data.glyphs.find(TOGL_UNICODE_WHITE_SQUARE);
-    if (it == m_data.glyphs.end()) it = m_data.glyphs.find(TOGL_UNICODE_REPLACEMENT_CHARACTER);
+    // Pages are filled on demand, and they can be shared only as separate textures.
+    registry_options.is_lazy            = true;
+    registry_options.is_texture_array   = false;
 
-    if (it != m_data.glyphs.end()) {
-        return &(it->second);
-    } 
-    return nullptr;
+    if (registry_options.page_width == 0)   registry_options.page_width     = DEFAULT_PAGE_SIZE;
+    if (registry_options.page_height == 0)  registry_options.page_height    = DEFAULT_PAGE_SIZE;
+
+    return registry_options;
+}
+
+inline void TOGL_FontRegistry::AssignSharedAtlas(TOGL_FontLoadOptions& registry_options) {
+    // Glyph cache needs own atlas.
+    if (!registry_options.shared_atlas && registry_options.glyph_cache_page_budget == 0) {
+        for (const auto& atlas : m_atlases) {
+            if (atlas->IsCompatible(registry_options)) {
+                registry_options.shared_atlas = atlas;
+                break;
+            }
+        }
+        if (!registry_options.shared_atlas) {
+            registry_options.shared_atlas = std::make_shared<TOGL_FontAtlas>();
+            m_atlases.push_back(registry_options.shared_atlas);
+        }
+    }
+}
+
+inline void TOGL_FontRegistry::ReleaseUnusedAtlases() {
+    for (size_t ix = 0; ix < m_atlases.size();) {
+        if (m_atlases[ix].use_count() == 1) {
+            m_atlases.erase(m_atlases.begin() + ix);
+        } else {
+            ++ix;
+        }
+    }
 }
 
 #endif // TRIVIALOPENGL_FONT_H_
@@ -0,0 +1,1601 @@
+/**
+* @file TrivialOpenGL_FontCore.h
+* @author underwatergrasshopper
+*/
+
+#ifndef TRIVIALOPENGL_FONTCORE_H_
+#define TRIVIALOPENGL_FONTCORE_H_
+
+// Parts of font, which don't use window, device context nor OpenGL (font description, load options, glyph table, font metrics for text layout and atlas cache file format).
+
+#include "TrivialOpenGL_Common.h"
+#include "TrivialOpenGL_TrueType.h"
+
+#include <memory>
+
+//==========================================================================
+// Declarations
+//==========================================================================
+
+enum TOGL_FontSizeUnitId {
+    TOGL_FONT_SIZE_UNIT_ID_PIXELS,
+    TOGL_FONT_SIZE_UNIT_ID_POINTS,
+};
+
+enum TOGL_FontStyleId {
+    TOGL_FONT_STYLE_ID_NORMAL,
+    TOGL_FONT_STYLE_ID_BOLD,
+    TOGL_FONT_STYLE_ID_ITALIC,
+};
+    
+// Ranges are from unicode space.
+// Font might not have all glyphs from this ranges.
+enum TOGL_FontCharSetId {
+    TOGL_FONT_CHAR_SET_ID_CUSTOM,
+
+    // Unicode Plane 0 - BMP - Basic Multilingual Plane 
+    TOGL_FONT_CHAR_SET_ID_RANGE_0000_FFFF,
+
+    TOGL_FONT_CHAR_SET_ID_ENGLISH,
+};
+
+enum TOGL_FontAtlasPackerId {
+    // Glyph cells (glyph width x font height) are placed in rows, from left to right.
+    TOGL_FONT_ATLAS_PACKER_ID_ROWS,
+
+    // Glyph ink boxes are placed by skyline bottom-left algorithm. Glyphs are packed from highest to lowest.
+    TOGL_FONT_ATLAS_PACKER_ID_SKYLINE,
+};
+
+enum TOGL_FontAtlasFormatId {
+    // Glyphs are stored as white pixels with coverage in alpha channel (GL_RGBA8).
+    TOGL_FONT_ATLAS_FORMAT_ID_RGBA8,
+
+    // Only glyph coverage is stored (GL_ALPHA8). Uses 4 times less texture memory than TOGL_FONT_ATLAS_FORMAT_ID_RGBA8.
+    // Glyphs are always rasterized on CPU (see TOGL_GlyphSource), since they can't be rendered to single channel atlas from display lists.
+    TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8,
+};
+
+enum TOGL_FontRasterizerId {
+    // Glyphs are rasterized by Windows (wglUseFontBitmapsW, or GetGlyphOutlineW with lazy loading). Glyphs are not anti-aliased.
+    TOGL_FONT_RASTERIZER_ID_WIN,
+
+    // Glyph outlines are read from TrueType font data and rasterized on CPU by built-in anti-aliased rasterizer (see TOGL_TrueTypeFont and TOGL_GlyphRasterizer).
+    // Each atlas page is composed in memory and uploaded by single glTexImage2D call. Font must have TrueType outlines.
+    TOGL_FONT_RASTERIZER_ID_TRUE_TYPE,
+};
+
+enum {
+    // "WHITE SQUARE" 
+    // Represents missing glyph in unicode space.
+    TOGL_UNICODE_WHITE_SQUARE               = 0x25A1,
+
+    // "REPLACEMENT CHARACTER"
+    // Represent out of range character code from unicode space.
+    TOGL_UNICODE_REPLACEMENT_CHARACTER      = 0xFFFD,
+};
+
+//-----------------------------------------------------------------------------
+// TOGL_UnicodeRange
+//-----------------------------------------------------------------------------
+
+struct TOGL_UnicodeRange {
+    uint32_t from;
+    uint32_t to;
+        
+    TOGL_UnicodeRange() : from(0), to(0) {}
+    TOGL_UnicodeRange(uint32_t code) : from(code), to(code) {}
+    TOGL_UnicodeRange(uint32_t from, uint32_t to) : from(from), to(to) {}
+};
+
+std::vector<TOGL_UnicodeRange> TOGL_GetUnicodeRanges(TOGL_FontCharSetId char_set);
+
+//-----------------------------------------------------------------------------
+// TOGL_UnicodeRangeGroup
+//-----------------------------------------------------------------------------
+
+class TOGL_UnicodeRangeGroup {
+public:
+    TOGL_UnicodeRangeGroup()                                                    : m_char_set(TOGL_FONT_CHAR_SET_ID_CUSTOM) {}
+    TOGL_UnicodeRangeGroup(TOGL_FontCharSetId char_set)                         : m_char_set(char_set),  m_ranges(TOGL_GetUnicodeRanges(char_set)) {}
+    template <uint32_t NUMBER>
+    explicit TOGL_UnicodeRangeGroup(const TOGL_UnicodeRange (&ranges)[NUMBER])  : m_char_set(TOGL_FONT_CHAR_SET_ID_CUSTOM), m_ranges(ranges, ranges + NUMBER) {}
+    explicit TOGL_UnicodeRangeGroup(const std::vector<TOGL_UnicodeRange>& ranges) : m_char_set(TOGL_FONT_CHAR_SET_ID_CUSTOM), m_ranges(ranges) {}
+
+    virtual ~TOGL_UnicodeRangeGroup() {}
+
+    TOGL_FontCharSetId GetCharSet() const;
+    std::vector<TOGL_UnicodeRange> GetRanges() const;
+    const std::vector<TOGL_UnicodeRange>& ToRanges() const;
+
+private:
+    TOGL_FontCharSetId              m_char_set;
+    std::vector<TOGL_UnicodeRange>  m_ranges;
+
+};
+
+//-----------------------------------------------------------------------------
+// TOGL_UnicodeRangeSet
+//-----------------------------------------------------------------------------
+
+// Set of code points. Stored as sorted ranges, which don't overlap and aren't adjacent.
+class TOGL_UnicodeRangeSet {
+public:
+    TOGL_UnicodeRangeSet();
+    explicit TOGL_UnicodeRangeSet(const std::vector<TOGL_UnicodeRange>& ranges);
+    virtual ~TOGL_UnicodeRangeSet();
+
+    void Clear();
+    bool IsEmpty() const;
+
+    // Range with 'from' greater than 'to' is ignored.
+    void Add(const TOGL_UnicodeRange& range);
+    void Add(const TOGL_UnicodeRangeSet& set);
+    void Remove(const TOGL_UnicodeRange& range);
+
+    // Keeps only code points, which are also in set.
+    void Intersect(const TOGL_UnicodeRangeSet& set);
+
+    bool Contains(uint32_t code) const;
+
+    // Returns number of code points in set.
+    uint64_t GetCodeCount() const;
+
+    const std::vector<TOGL_UnicodeRange>& ToRanges() const;
+
+private:
+    std::vector<TOGL_UnicodeRange> m_ranges;
+};
+
+//-----------------------------------------------------------------------------
+// TOGL_CodePointRecord
+//-----------------------------------------------------------------------------
+
+// Set of code points used by application (see TOGL_Font::StartRecording), stored as bitmap.
+// Code points from range 0000 to 10FFFF are grouped in pages of 256 bits. Only pages with at least one code point are allocated and saved.
+// File format: signature "TOGLCPR", version, number of pages, and for each page: page index (code point / 256) and 32 bytes of bits 
+// (bit n of byte m refers to code point page_ix * 256 + m * 8 + n). Numbers are 32 bit, little endian.
+class TOGL_CodePointRecord {
+public:
+    enum : uint32_t { VERSION = 1 };
+
+    TOGL_CodePointRecord();
+    virtual ~TOGL_CodePointRecord();
+
+    void Clear();
+
+    // Code point out of range 0000 to 10FFFF is ignored.
+    void Add(uint32_t code);
+
+    // Adds all code points from record (for example, recorded by other run of application).
+    void Add(const TOGL_CodePointRecord& record);
+
+    bool Contains(uint32_t code) const;
+
+    // Returns number of recorded code points.
+    uint32_t GetCount() const;
+
+    // Returns recorded code points as ascending ranges. Adjacent code points are coalesced into one range.
+    std::vector<TOGL_UnicodeRange> GetRanges() const;
+
+    std::vector<uint8_t> Encode() const;
+
+    // Returns false if data isn't valid record. Then record is empty.
+    bool Decode(const uint8_t* data, size_t size);
+
+    // file_name    - Encoding format: UTF8.
+    // Returns true if record has been saved to file.
+    bool Save(const std::string& file_name) const;
+
+    // Replaces record with record from file. Returns false if file can't be read or isn't valid record.
+    bool Load(const std::string& file_name);
+
+private:
+    enum : uint32_t {
+        PAGE_SIZE           = 256,                  // in code points
+        PAGE_BYTE_COUNT     = PAGE_SIZE / 8,
+        END_CODE            = 0x110000,
+        NO_PAGE_IX          = 0,                    // page 0 of m_bits is never used
+    };
+
+    std::vector<uint16_t>   m_page_ixs;     // indexed by (code point / PAGE_SIZE)
+    std::vector<uint8_t>    m_bits;         // pages one after another, PAGE_BYTE_COUNT bytes each
+    uint32_t                m_count;
+};
+
+// Loads unicode ranges for font from file saved by TOGL_CodePointRecord::Save. Adjacent code points are coalesced into ranges.
+// is_fallback_included - If true, then TOGL_UNICODE_WHITE_SQUARE and TOGL_UNICODE_REPLACEMENT_CHARACTER are added, 
+//                        so code points, which haven't been recorded, are rendered as fallback glyph of font.
+// Returns false if file can't be read or isn't valid record.
+bool TOGL_LoadUnicodeRangeGroup(const std::string& file_name, TOGL_UnicodeRangeGroup& unicode_range_group, bool is_fallback_included = true);
+
+//-----------------------------------------------------------------------------
+// TOGL_FontInfo
+//-----------------------------------------------------------------------------
+
+struct TOGL_FontInfo {
+    std::string             name;                   // encoding format: UTF8
+    uint32_t                size;
+    TOGL_FontSizeUnitId     size_unit;
+    TOGL_FontStyleId        style;
+    TOGL_UnicodeRangeGroup  unicode_range_group;
+    uint32_t                distance_between_glyphs;
+    uint32_t                distance_between_lines;
+
+    TOGL_FontInfo();
+    TOGL_FontInfo(
+        const std::string& name, 
+        uint32_t size, 
+        TOGL_FontSizeUnitId size_unit, 
+        TOGL_FontStyleId style, 
+        const TOGL_UnicodeRangeGroup& unicode_range_group,
+        uint32_t distance_between_glyphs = 0,
+        uint32_t distance_between_lines = 0);
+};
+
+// Returns font size in pixels (height of glyph cell).
+uint32_t TOGL_FontSizeToPixels(uint32_t size, TOGL_FontSizeUnitId size_unit);
+
+//-----------------------------------------------------------------------------
+// TOGL_FontLoadOptions
+//-----------------------------------------------------------------------------
+
+class TOGL_FontAtlas;
+
+// Options of font generation, which don't change look of glyphs.
+struct TOGL_FontLoadOptions {
+    TOGL_FontRasterizerId   rasterizer;
+    TOGL_FontAtlasPackerId  packer;
+    TOGL_FontAtlasFormatId  format;
+
+    // Size of single atlas page (texture) in pixels. 
+    // If 0, then size is chosen automatically, from range 64 to GL_MAX_TEXTURE_SIZE (but not more than 4096), to fit all glyphs with least number of pages.
+    uint16_t                page_width;
+    uint16_t                page_height;
+
+    // Space (in pixels) between glyphs packed by TOGL_FONT_ATLAS_PACKER_ID_SKYLINE. 
+    // Should be greater than 0 if glyphs are rendered scaled with linear texture filtering.
+    uint16_t                glyph_padding;
+
+    // If true, then only glyph metrics are generated at load. 
+    // Each glyph is rasterized and packed into atlas when it's needed for the first time (see TOGL_Font::RequestGlyphs and TOGL_Font::UpdateGlyphs).
+    bool                    is_lazy;
+
+    // If true, then all atlas pages are stored as layers of one GL_TEXTURE_2D_ARRAY texture, and text is rendered by shader with single texture binding.
+    // Requires OpenGL 3.0. If it's not supported (or with lazy loading), then each page is stored as separate texture.
+    bool                    is_texture_array;
+
+    // If true, then atlas stores signed distance field of each glyph instead of coverage (see TOGL_MakeDistanceField). 
+    // Such font can be rendered at any scale (see TOGL_Font::SetScale) with sharp edges, so one atlas can serve many text sizes. 
+    // Edges are smoothed by shader (OpenGL 2.0), otherwise they are cut by alpha test. Glyphs are rasterized on CPU (see TOGL_GlyphSource).
+    bool                    is_sdf;
+
+    // Distance (in pixels of generated font) from glyph edge to the furthest stored distance. Used only by distance field atlas.
+    // Font scaled down by more than sdf_spread times looses edge smoothing. Loading of distance field font fails if it's 0.
+    uint16_t                sdf_spread;
+
+    // Number of threads which rasterize glyphs on CPU (see TOGL_RasterizeGlyphs). If 0, then number of hardware threads is used. Not used with lazy loading.
+    // If 1, then font with TOGL_FONT_RASTERIZER_ID_WIN rasterizer (without distance field and in TOGL_FONT_ATLAS_FORMAT_ID_RGBA8 format) 
+    // is rendered to atlas by OpenGL from wglUseFontBitmapsW display lists.
+    uint32_t                thread_count;
+
+    // Directory for font atlas cache files. Encoding format: UTF8. 
+    // If not empty, then generated atlas is saved to cache file, and next load with the same font info and options reads atlas from this file instead of generating it.
+    // Directory must exist. Not used with lazy loading.
+    std::string             cache_dir;
+
+    // Lazy loading only. If not null, then glyphs are packed into pages of this atlas, which can be shared by many fonts (see TOGL_FontRegistry).
+    // Atlas must be compatible with options (see TOGL_FontAtlas::IsCompatible). Not initialized atlas is initialized by first font.
+    std::shared_ptr<TOGL_FontAtlas> shared_atlas;
+
+    // If not 0, then atlas has at most this number of pages, and glyphs are kept in it as in cache (see TOGL_GlyphCache). Implies lazy loading.
+    // When atlas is full, then glyphs least recently used (not requested in current frame) are evicted, and rasterized again when they are requested.
+    // Requires TOGL_Font::NextFrame to be called once per frame. Can't be used with shared atlas.
+    uint32_t                glyph_cache_page_budget;
+
+    // If true, then font is loaded in all styles (normal, bold and italic), which font has. Implies lazy loading, without glyph cache.
+    // Glyphs of all styles are packed into the same atlas pages, so switching style (see TOGL_Font::SetStyle) costs only a glyph table switch.
+    bool                    is_style_set;
+
+    TOGL_FontLoadOptions();
+};
+
+//-----------------------------------------------------------------------------
+// TOGL_FontStats
+//-----------------------------------------------------------------------------
+
+struct TOGL_FontStats {
+    uint32_t    glyph_count;
+    uint32_t    page_count;
+    uint16_t    page_width;     // in pixels
+    uint16_t    page_height;    // in pixels
+    uint64_t    used_area;      // in pixels, sum of areas occupied by glyphs in all pages
+    uint64_t    texture_size;   // in bytes, sum of sizes of all pages
+
+    // Number of glyphs, which share place in atlas with identical glyph (see TOGL_FindDuplicateGlyphs). Their area isn't in used_area.
+    uint32_t    deduplicated_glyph_count;
+
+    TOGL_FontStats();
+
+    // Returns ratio of area occupied by glyphs to area of all pages (from 0 to 1).
+    double GetFillRatio() const;
+
+    // Returns ratio of glyphs, which share place in atlas with identical glyph, to all glyphs (from 0 to 1).
+    double GetDedupeRatio() const;
+};
+
+//-----------------------------------------------------------------------------
+// TOGL_GlyphData
+//-----------------------------------------------------------------------------
+
+struct TOGL_GlyphData {
+    uint16_t    width;      // in pixels
+    uint32_t    tex_obj;    // opengl texture object (name)
+
+    // Glyph quad position (relative to left-bottom corner of glyph cell) and size, in pixels.
+    int16_t     quad_x;
+    int16_t     quad_y;
+    uint16_t    quad_width;
+    uint16_t    quad_height;
+
+    // If true, then glyph is not rasterized yet (lazy loading), and only width is valid.
+    bool        is_pending;
+
+    // Index of atlas page. For texture array atlas it's layer index.
+    uint16_t    layer;
+
+    // texture coordinates
+    double      x1;
+    double      y1;
+    double      x2;
+    double      y2;
+
+    TOGL_GlyphData();
+};
+
+// Returns glyph data, which is used when glyph and all fallback glyphs are missing. Such glyph is rendered as filled square.
+TOGL_GlyphData TOGL_MakeMissingGlyphData(uint32_t font_height);
+
+//-----------------------------------------------------------------------------
+// TOGL_GlyphTable
+//-----------------------------------------------------------------------------
+
+// Sparse table of glyphs for code points from unicode range 0000 to 10FFFF.
+// Code points are grouped in pages of 256 glyphs and pages are grouped in planes of 256 pages. 
+// Only planes and pages, which contain at least one glyph, are allocated.
+// Basic Multilingual Plane (0000 to FFFF) is always allocated, so its lookup is a single page index load followed by glyph load.
+// Missing glyphs are resolved to fallback glyph once (by ResolveFallback), so lookup never searches.
+class TOGL_GlyphTable {
+public:
+    enum : uint8_t {
+        MAX_FONT_IX         = 254,
+        UNRESOLVED_FONT_IX  = 255,
+    };
+
+    TOGL_GlyphTable();
+    virtual ~TOGL_GlyphTable();
+
+    void Clear();
+
+    // Adds glyph for code point or replaces existing one.
+    // code         - From range 0000 to 10FFFF. Code point out of this range is ignored.
+    void Set(uint32_t code, const TOGL_GlyphData& glyph_data);
+
+    // Returns true if glyph for code point has been added by Set().
+    bool Has(uint32_t code) const;
+
+    // Each missing glyph will refer to copy of glyph of first code point from fallback_codes, which has been added by Set(). 
+    // If none of them has been added, then missing glyph will refer to copy of missing_glyph_data.
+    // Code points added by Set() after this call, are resolved in same way.
+    void ResolveFallback(const std::vector<uint32_t>& fallback_codes, const TOGL_GlyphData& missing_glyph_data);
+
+    // Returns glyph for code point. If glyph is missing, then returns fallback glyph.
+    const TOGL_GlyphData& Get(uint32_t code) const;
+
+    // Returns number of glyphs added by Set().
+    uint32_t GetCount() const;
+
+    // Returns code points of glyphs added by Set() (in ascending order).
+    std::vector<uint32_t> GetCodes() const;
+
+    // Returns index of font from fallback chain (see TOGL_Font::SetFallbackFonts), which renders code point. Glyph added by Set() is rendered by own font (0).
+    // Font index of missing glyph is resolved by resolve(code) on first use and kept in its table entry, so next lookup is a single entry load.
+    // Font indices are cache of resolution, so they are resolved also by const functions (page of missing glyph is allocated then).
+    // resolve      - Returns font index from 0 to MAX_FONT_IX.
+    template <typename ResolveT>
+    uint8_t ToFontIx(uint32_t code, ResolveT resolve) const;
+
+    // Makes font indices of missing glyphs unresolved (for example, when fonts of fallback chain change).
+    void ResetFontIxs() const;
+
+private:
+    enum : uint32_t {
+        PAGE_SIZE       = 256,
+        PAGE_COUNT      = 256,      // in one plane
+        PLANE_COUNT     = 17,
+        BMP_PLANE_IX    = 0,        // Basic Multilingual Plane, always allocated
+        EMPTY_PLANE_IX  = 1,        // shared by all not allocated planes, refers only to empty page
+        EMPTY_PAGE_IX   = 0,        // shared by all not allocated pages, contains only fallback glyphs
+        END_CODE        = PLANE_COUNT * PAGE_COUNT * PAGE_SIZE,
+    };
+
+    // Allocates plane of code point if needed. Returns reference to page index of code point.
+    uint16_t& ToAllocatedPageIx(uint32_t code) const;
+    uint16_t ToPageIx(uint32_t code) const;
+
+    // Allocates page of code point if needed (filled with fallback glyph). Returns index of code point entry.
+    size_t AllocateEntry(uint32_t code) const;
+
+    // Pages are allocated also when font index is resolved by const ToFontIx.
+    mutable uint16_t                    m_plane_ixs[PLANE_COUNT];   // indexed by code point plane (bits 16-20)
+    mutable std::vector<uint16_t>       m_page_ixs;     // planes one after another, indexed by (plane_ix * PAGE_COUNT + code point bits 8-15)
+    mutable std::vector<TOGL_GlyphData> m_glyphs;       // pages one after another, indexed by (page_ix * PAGE_SIZE + code point low byte)
+    mutable std::vector<uint8_t>        m_is_set;       // indexed in same way as m_glyphs
+    mutable std::vector<uint8_t>        m_font_ixs;     // indexed in same way as m_glyphs
+    TOGL_GlyphData                      m_fallback;
+    uint32_t                            m_count;
+};
+
+//-----------------------------------------------------------------------------
+// TOGL_FontMetrics
+//-----------------------------------------------------------------------------
+
+// Metrics of font used by text layout (see TOGL_TextAdjuster, TOGL_TextDrawer::GetTextSize). 
+// Implemented by TOGL_Font and by TOGL_MetricsFont (which doesn't need window nor OpenGL).
+class TOGL_FontMetrics {
+public:
+    virtual ~TOGL_FontMetrics() {}
+
+    virtual bool IsLoaded() const = 0;
+
+    // Returns distance between rendered glyphs in pixels.
+    virtual uint32_t GetDistanceBetweenGlyphs() const = 0;
+
+    // Returns distance between rendered lines in pixels.
+    virtual uint32_t GetDistanceBetweenLines() const = 0;
+
+    // Returns glyph size (width and height, both in pixels).
+    virtual TOGL_SizeU GetGlyphSize(uint32_t code) const = 0;
+
+    // Returns size of glyph in style. Font with single style returns GetGlyphSize(code).
+    virtual TOGL_SizeU GetGlyphSize(uint32_t code, TOGL_FontStyleId style) const;
+
+    // Returns style of glyphs measured by GetGlyphSize(code). Styled text is measured from this style (see TOGL_TextStyle).
+    virtual TOGL_FontStyleId GetStyle() const;
+
+    // height = ascent + descent
+
+    // Returns font height in pixels.
+    virtual uint32_t GetHeight() const = 0;
+
+    // Returns font descent length in pixels.
+    virtual uint32_t GetDescent() const = 0;
+
+    // Returns font ascent length in pixels.
+    virtual uint32_t GetAscent() const = 0;
+
+    // Returns font internal leading in pixels.
+    virtual uint32_t GetInternalLeading() const = 0;
+
+    // text         - Each code point is interpreted as single printable glyph (even '\t' and 'n'). Surrogate pair is one code point.
+    // width        - In pixels.
+    // Returns number of UTF16 code units of glyphs from text which will fit in width (surrogate pair is never split).
+    uint32_t GetGlyphCountInWidth(const std::wstring& text, uint32_t width) const;
+    uint32_t GetGlyphCountInWidth(const std::wstring& text, uint32_t width, TOGL_FontStyleId style) const;
+};
+
+//-----------------------------------------------------------------------------
+// TOGL_MetricsFont
+//-----------------------------------------------------------------------------
+
+// Font without glyph images, which provides only metrics for text layout. Doesn't use window, device context nor OpenGL.
+// Metrics are read from TrueType font file ('head', 'hhea', 'hmtx', 'OS/2' and 'cmap' tables), which is mapped to memory.
+// Glyph cell is scaled the same way as by TOGL_FONT_RASTERIZER_ID_TRUE_TYPE rasterizer, 
+// so metrics are the same as metrics of TOGL_Font loaded with this rasterizer from the same font file.
+class TOGL_MetricsFont : public TOGL_FontMetrics {
+public:
+    TOGL_MetricsFont();
+    virtual ~TOGL_MetricsFont();
+
+    // Unloads current font if loaded. Loads new font.
+    // file_name    - Path to font file. Encoding format: UTF8.
+    // font_info    - Name and style are ignored (font is defined by file). Code points outside of unicode ranges have metrics of fallback glyph.
+    void Load(const std::string& file_name, const TOGL_FontInfo& font_info);
+
+    // data         - Content of font file. Can be released after this call.
+    void Load(const uint8_t* data, size_t size, const TOGL_FontInfo& font_info);
+
+    void Unload();
+    bool IsLoaded() const override;
+
+    uint32_t GetDistanceBetweenGlyphs() const override;
+    uint32_t GetDistanceBetweenLines() const override;
+    TOGL_SizeU GetGlyphSize(uint32_t code) const override;
+    using TOGL_FontMetrics::GetGlyphSize;
+    uint32_t GetHeight() const override;
+    uint32_t GetDescent() const override;
+    uint32_t GetAscent() const override;
+    uint32_t GetInternalLeading() const override;
+
+    const TOGL_FontInfo& ToFontInfo() const;
+
+    bool IsOk() const;
+    std::string GetErrMsg() const;
+
+private:
+    TOGL_NO_COPY(TOGL_MetricsFont);
+
+    void SetErrMsg(const std::string& err_msg);
+
+    TOGL_FontInfo   m_info;
+
+    uint32_t        m_font_height;              // in pixels
+    uint32_t        m_font_ascent;              // in pixels
+    uint32_t        m_font_descent;             // in pixels
+    uint32_t        m_font_internal_leading;    // in pixels
+
+    // Only glyph widths are used.
+    TOGL_GlyphTable m_glyphs;
+
+    bool            m_is_loaded;
+    std::string     m_err_msg;
+};
+
+//-----------------------------------------------------------------------------
+// TOGL_FontCache
+//-----------------------------------------------------------------------------
+
+// Binary format of font atlas cache file. Holds font metrics, glyph table and pixels of atlas pages.
+// Doesn't use OpenGL.
+class TOGL_FontCache {
+public:
+    enum : uint32_t { VERSION = 2 };
+
+    struct Glyph {
+        uint32_t        code;
+        uint32_t        page_ix;
+        TOGL_GlyphData  data;       // tex_obj isn't stored
+    };
+
+    uint64_t                    key;
+
+    uint32_t                    font_height;            // in pixels
+    uint32_t                    font_ascent;            // in pixels
+    uint32_t                    font_descent;           // in pixels
+    uint32_t                    font_internal_leading;  // in pixels
+
+    TOGL_FontAtlasFormatId      format;
+    TOGL_FontStats              stats;                  // stats.page_count, stats.page_width and stats.page_height describe pages
+
+    std::vector<Glyph>          glyphs;
+
+    // Pixels of each page (GetPageSize() bytes), first pixel refers to left-bottom corner of page. 
+    // Not owned. After Decode, points to decoded data.
+    std::vector<const uint8_t*> pages;
+
+    TOGL_FontCache();
+
+    // Returns hash of everything which affects generated atlas.
+    // font_data_size       - Size of font file (see GetFontData), so cache isn't used after font file is replaced by other version. 0 if unknown.
+    // font_head_checksum   - Checksum of font 'head' table (see TOGL_ComputeTrueTypeTableChecksum). 0 if unknown.
+    static uint64_t MakeKey(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options, uint64_t font_data_size = 0, uint32_t font_head_checksum = 0);
+
+    // Returns name of cache file (without directory) for key.
+    static std::string MakeFileName(uint64_t key);
+
+    // Returns size of single page in bytes.
+    size_t GetPageSize() const;
+
+    std::vector<uint8_t> Encode() const;
+
+    // Returns false if data is not valid cache (wrong signature, version, truncated, ...).
+    bool Decode(const uint8_t* data, size_t size);
+};
+
+//==========================================================================
+// Definitions
+//==========================================================================
+
+//-----------------------------------------------------------------------------
+// TOGL_UnicodeRange
+//-----------------------------------------------------------------------------
+
+inline std::vector<TOGL_UnicodeRange> TOGL_GetUnicodeRanges(TOGL_FontCharSetId char_set) {
+    switch (char_set) {
+    case TOGL_FONT_CHAR_SET_ID_CUSTOM:
+        return {};
+
+    case TOGL_FONT_CHAR_SET_ID_RANGE_0000_FFFF:
+        return {
+            {0x0000, 0xFFFF}
+        };
+
+    case TOGL_FONT_CHAR_SET_ID_ENGLISH:
+        return {
+            {0x0020, 0x007E},
+            {TOGL_UNICODE_WHITE_SQUARE},
+            {TOGL_UNICODE_REPLACEMENT_CHARACTER}
+        };
+
+    } // switch
+
+    return {};
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_UnicodeRangeGroup
+//-----------------------------------------------------------------------------
+
+inline TOGL_FontCharSetId TOGL_UnicodeRangeGroup::GetCharSet() const {
+    return m_char_set;
+}
+
+inline std::vector<TOGL_UnicodeRange> TOGL_UnicodeRangeGroup::GetRanges() const {
+    return m_ranges;
+}
+
+inline const std::vector<TOGL_UnicodeRange>& TOGL_UnicodeRangeGroup::ToRanges() const {
+    return m_ranges;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_UnicodeRangeSet
+//-----------------------------------------------------------------------------
+
+inline TOGL_UnicodeRangeSet::TOGL_UnicodeRangeSet() {
+
+}
+
+inline TOGL_UnicodeRangeSet::TOGL_UnicodeRangeSet(const std::vector<TOGL_UnicodeRange>& ranges) {
+    for (const TOGL_UnicodeRange& range : ranges) Add(range);
+}
+
+inline TOGL_UnicodeRangeSet::~TOGL_UnicodeRangeSet() {
+
+}
+
+inline void TOGL_UnicodeRangeSet::Clear() {
+    m_ranges.clear();
+}
+
+inline bool TOGL_UnicodeRangeSet::IsEmpty() const {
+    return m_ranges.empty();
+}
+
+inline void TOGL_UnicodeRangeSet::Add(const TOGL_UnicodeRange& range) {
+    if (range.from > range.to) return;
+
+    // Ranges added in ascending order are appended.
+    if (m_ranges.empty() || uint64_t(m_ranges.back().to) + 1 < range.from) {
+        m_ranges.push_back(range);
+        return;
+    }
+
+    std::vector<TOGL_UnicodeRange> ranges;
+    ranges.reserve(m_ranges.size() + 1);
+
+    TOGL_UnicodeRange   merged      = range;
+    bool                is_added    = false;
+
+    for (const TOGL_UnicodeRange& current : m_ranges) {
+        if (uint64_t(current.to) + 1 < merged.from) {
+            ranges.push_back(current);
+        } else if (uint64_t(merged.to) + 1 < current.from) {
+            if (!is_added) {
+                ranges.push_back(merged);
+                is_added = true;
+            }
+            ranges.push_back(current);
+        } else {
+            // Overlapping or adjacent.
+            if (current.from < merged.from) merged.from = current.from;
+            if (current.to > merged.to)     merged.to   = current.to;
+        }
+    }
+    if (!is_added) ranges.push_back(merged);
+
+    m_ranges.swap(ranges);
+}
+
+inline void TOGL_UnicodeRangeSet::Add(const TOGL_UnicodeRangeSet& set) {
+    for (const TOGL_UnicodeRange& range : set.m_ranges) Add(range);
+}
+
+inline void TOGL_UnicodeRangeSet::Remove(const TOGL_UnicodeRange& range) {
+    if (range.from > range.to) return;
+
+    std::vector<TOGL_UnicodeRange> ranges;
+    ranges.reserve(m_ranges.size() + 1);
+
+    for (const TOGL_UnicodeRange& current : m_ranges) {
+        if (current.to < range.from || current.from > range.to) {
+            ranges.push_back(current);
+        } else {
+            if (current.from < range.from)  ranges.push_back({current.from, range.from - 1});
+            if (current.to > range.to)      ranges.push_back({range.to + 1, current.to});
+        }
+    }
+
+    m_ranges.swap(ranges);
+}
+
+inline void TOGL_UnicodeRangeSet::Intersect(const TOGL_UnicodeRangeSet& set) {
+    std::vector<TOGL_UnicodeRange> ranges;
+
+    size_t ix       = 0;
+    size_t other_ix = 0;
+
+    while (ix < m_ranges.size() && other_ix < set.m_ranges.size()) {
+        const TOGL_UnicodeRange& current    = m_ranges[ix];
+        const TOGL_UnicodeRange& other      = set.m_ranges[other_ix];
+
+        const uint32_t from = (current.from > other.from) ? current.from : other.from;
+        const uint32_t to   = (current.to < other.to) ? current.to : other.to;
+
+        if (from <= to) ranges.push_back({from, to});
+
+        if (current.to < other.to) {
+            ++ix;
+        } else {
+            ++other_ix;
+        }
+    }
+
+    m_ranges.swap(ranges);
+}
+
+inline bool TOGL_UnicodeRangeSet::Contains(uint32_t code) const {
+    // Binary search for first range with 'to' not less than code.
+    size_t low  = 0;
+    size_t high = m_ranges.size();
+    while (low < high) {
+        const size_t middle = (low + high) / 2;
+        if (m_ranges[middle].to < code) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low < m_ranges.size() && m_ranges[low].from <= code;
+}
+
+inline uint64_t TOGL_UnicodeRangeSet::GetCodeCount() const {
+    uint64_t count = 0;
+    for (const TOGL_UnicodeRange& range : m_ranges) {
+        count += uint64_t(range.to) - range.from + 1;
+    }
+    return count;
+}
+
+inline const std::vector<TOGL_UnicodeRange>& TOGL_UnicodeRangeSet::ToRanges() const {
+    return m_ranges;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_CodePointRecord
+//-----------------------------------------------------------------------------
+
+namespace _TOGL_CodePointRecordFormat {
+    const uint8_t SIGNATURE[8] = {'T', 'O', 'G', 'L', 'C', 'P', 'R', 0};
+}
+
+inline TOGL_CodePointRecord::TOGL_CodePointRecord() {
+    Clear();
+}
+
+inline TOGL_CodePointRecord::~TOGL_CodePointRecord() {
+
+}
+
+inline void TOGL_CodePointRecord::Clear() {
+    m_page_ixs.assign(END_CODE / PAGE_SIZE, NO_PAGE_IX);
+    m_bits.assign(PAGE_BYTE_COUNT, 0);
+    m_count = 0;
+}
+
+inline void TOGL_CodePointRecord::Add(uint32_t code) {
+    if (code < END_CODE) {
+        uint16_t& page_ix = m_page_ixs[code / PAGE_SIZE];
+
+        if (page_ix == NO_PAGE_IX) {
+            page_ix = uint16_t(m_bits.size() / PAGE_BYTE_COUNT);
+            m_bits.resize(m_bits.size() + PAGE_BYTE_COUNT, 0);
+        }
+
+        uint8_t&        byte = m_bits[size_t(page_ix) * PAGE_BYTE_COUNT + (code % PAGE_SIZE) / 8];
+        const uint8_t   mask = uint8_t(1 << (code % 8));
+
+        if (!(byte & mask)) {
+            byte |= mask;
+            m_count += 1;
+        }
+    }
+}
+
+inline void TOGL_CodePointRecord::Add(const TOGL_CodePointRecord& record) {
+    for (const TOGL_UnicodeRange& range : record.GetRanges()) {
+        for (uint32_t code = range.from; code <= range.to; ++code) Add(code);
+    }
+}
+
+inline bool TOGL_CodePointRecord::Contains(uint32_t code) const {
+    if (code < END_CODE) {
+        const uint16_t page_ix = m_page_ixs[code / PAGE_SIZE];
+
+        return page_ix != NO_PAGE_IX && (m_bits[size_t(page_ix) * PAGE_BYTE_COUNT + (code % PAGE_SIZE) / 8] & (1 << (code % 8)));
+    }
+    return false;
+}
+
+inline uint32_t TOGL_CodePointRecord::GetCount() const {
+    return m_count;
+}
+
+inline std::vector<TOGL_UnicodeRange> TOGL_CodePointRecord::GetRanges() const {
+    std::vector<TOGL_UnicodeRange> ranges;
+
+    for (uint32_t code_page = 0; code_page < END_CODE / PAGE_SIZE; ++code_page) {
+        const uint16_t page_ix = m_page_ixs[code_page];
+        if (page_ix == NO_PAGE_IX) continue;
+
+        const uint8_t* bits = m_bits.data() + size_t(page_ix) * PAGE_BYTE_COUNT;
+
+        for (uint32_t ix = 0; ix < PAGE_SIZE; ++ix) {
+            if (bits[ix / 8] & (1 << (ix % 8))) {
+                const uint32_t code = code_page * PAGE_SIZE + ix;
+
+                if (!ranges.empty() && ranges.back().to + 1 == code) {
+                    ranges.back().to = code;
+                } else {
+                    ranges.push_back({code, code});
+                }
+            }
+        }
+    }
+
+    return ranges;
+}
+
+inline std::vector<uint8_t> TOGL_CodePointRecord::Encode() const {
+    std::vector<uint8_t> data;
+
+    auto PutU32 = [&data](uint32_t value) {
+        for (uint32_t ix = 0; ix < 4; ++ix) data.push_back(uint8_t(value >> (ix * 8)));
+    };
+
+    data.insert(data.end(), _TOGL_CodePointRecordFormat::SIGNATURE, _TOGL_CodePointRecordFormat::SIGNATURE + sizeof(_TOGL_CodePointRecordFormat::SIGNATURE));
+    PutU32(VERSION);
+    PutU32(uint32_t(m_bits.size() / PAGE_BYTE_COUNT - 1));
+
+    // Pages are saved in order of code points.
+    for (uint32_t code_page = 0; code_page < END_CODE / PAGE_SIZE; ++code_page) {
+        const uint16_t page_ix = m_page_ixs[code_page];
+
+        if (page_ix != NO_PAGE_IX) {
+            const uint8_t* bits = m_bits.data() + size_t(page_ix) * PAGE_BYTE_COUNT;
+
+            PutU32(code_page);
+            data.insert(data.end(), bits, bits + PAGE_BYTE_COUNT);
+        }
+    }
+
+    return data;
+}
+
+inline bool TOGL_CodePointRecord::Decode(const uint8_t* data, size_t size) {
+    Clear();
+
+    size_t pos = 0;
+
+    auto GetU32 = [&](uint32_t& value) -> bool {
+        if (size - pos < 4) return false;
+        value = uint32_t(data[pos]) | (uint32_t(data[pos + 1]) << 8) | (uint32_t(data[pos + 2]) << 16) | (uint32_t(data[pos + 3]) << 24);
+        pos += 4;
+        return true;
+    };
+
+    if (!data || size < sizeof(_TOGL_CodePointRecordFormat::SIGNATURE)) return false;
+    if (memcmp(data, _TOGL_CodePointRecordFormat::SIGNATURE, sizeof(_TOGL_CodePointRecordFormat::SIGNATURE)) != 0) return false;
+    pos += sizeof(_TOGL_CodePointRecordFormat::SIGNATURE);
+
+    uint32_t version    = 0;
+    uint32_t page_count = 0;
+
+    if (!GetU32(version) || version != VERSION || !GetU32(page_count)) return false;
+
+    if (page_count > END_CODE / PAGE_SIZE || (size - pos) != size_t(page_count) * (4 + PAGE_BYTE_COUNT)) return false;
+
+    for (uint32_t ix = 0; ix < page_count; ++ix) {
+        uint32_t code_page = 0;
+        GetU32(code_page);
+
+        if (code_page >= END_CODE / PAGE_SIZE) {
+            Clear();
+            return false;
+        }
+
+        for (uint32_t bit_ix = 0; bit_ix < PAGE_SIZE; ++bit_ix) {
+            if (data[pos + bit_ix / 8] & (1 << (bit_ix % 8))) Add(code_page * PAGE_SIZE + bit_ix);
+        }
+        pos += PAGE_BYTE_COUNT;
+    }
+
+    return true;
+}
+
+inline bool TOGL_CodePointRecord::Save(const std::string& file_name) const {
+    const std::vector<uint8_t> data = Encode();
+
+    return TOGL_SaveToFile(file_name, data.data(), data.size());
+}
+
+inline bool TOGL_CodePointRecord::Load(const std::string& file_name) {
+    TOGL_MappedFile file;
+
+    if (!file.Open(file_name)) {
+        Clear();
+        return false;
+    }
+    return Decode(file.ToData(), file.GetSize());
+}
+
+inline bool TOGL_LoadUnicodeRangeGroup(const std::string& file_name, TOGL_UnicodeRangeGroup& unicode_range_group, bool is_fallback_included) {
+    TOGL_CodePointRecord record;
+
+    if (!record.Load(file_name)) return false;
+
+    if (is_fallback_included) {
+        record.Add(TOGL_UNICODE_WHITE_SQUARE);
+        record.Add(TOGL_UNICODE_REPLACEMENT_CHARACTER);
+    }
+
+    unicode_range_group = TOGL_UnicodeRangeGroup(record.GetRanges());
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_FontInfo
+//-----------------------------------------------------------------------------
+
+inline TOGL_FontInfo::TOGL_FontInfo() {
+    name                    = "";
+    size                    = 0;
+    size_unit               = TOGL_FONT_SIZE_UNIT_ID_PIXELS;
+    style                   = TOGL_FONT_STYLE_ID_NORMAL;
+    unicode_range_group     = TOGL_FONT_CHAR_SET_ID_ENGLISH;
+    distance_between_glyphs = 0;
+    distance_between_lines  = 0;
+}
+        
+inline TOGL_FontInfo::TOGL_FontInfo(
+        const std::string& name, 
+        uint32_t size, TOGL_FontSizeUnitId size_unit, 
+        TOGL_FontStyleId style, 
+        const TOGL_UnicodeRangeGroup& unicode_range_group,
+        uint32_t distance_between_glyphs,
+        uint32_t distance_between_lines) {
+    this->name                      = name;
+    this->size                      = size;    
+    this->size_unit                 = size_unit;
+    this->style                     = style;    
+    this->unicode_range_group       = unicode_range_group;
+    this->distance_between_glyphs   = distance_between_glyphs;
+    this->distance_between_lines    = distance_between_lines;
+}
+
+inline uint32_t TOGL_FontSizeToPixels(uint32_t size, TOGL_FontSizeUnitId size_unit) {
+    switch (size_unit) {
+    case TOGL_FONT_SIZE_UNIT_ID_PIXELS: return size;
+    case TOGL_FONT_SIZE_UNIT_ID_POINTS: return size * 4 / 3;
+    }
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_FontLoadOptions
+//-----------------------------------------------------------------------------
+
+inline TOGL_FontLoadOptions::TOGL_FontLoadOptions() {
+    rasterizer          = TOGL_FONT_RASTERIZER_ID_WIN;
+    packer              = TOGL_FONT_ATLAS_PACKER_ID_SKYLINE;
+    format              = TOGL_FONT_ATLAS_FORMAT_ID_RGBA8;
+    page_width          = 0;
+    page_height         = 0;
+    glyph_padding       = 0;
+    is_lazy             = false;
+    is_texture_array    = false;
+    is_sdf              = false;
+    sdf_spread          = 4;
+    thread_count        = 0;
+
+    glyph_cache_page_budget = 0;
+    is_style_set            = false;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_FontStats
+//-----------------------------------------------------------------------------
+
+inline TOGL_FontStats::TOGL_FontStats() {
+    glyph_count                 = 0;
+    page_count                  = 0;
+    page_width                  = 0;
+    page_height                 = 0;
+    used_area                   = 0;
+    texture_size                = 0;
+    deduplicated_glyph_count    = 0;
+}
+
+inline double TOGL_FontStats::GetFillRatio() const {
+    const uint64_t area = uint64_t(page_width) * page_height * page_count;
+    return (area > 0) ? (double(used_area) / area) : 0.0;
+}
+
+inline double TOGL_FontStats::GetDedupeRatio() const {
+    return (glyph_count > 0) ? (double(deduplicated_glyph_count) / glyph_count) : 0.0;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_GlyphData
+//-----------------------------------------------------------------------------
+
+inline TOGL_GlyphData::TOGL_GlyphData() {
+    width       = 0;
+    tex_obj     = 0;
+
+    quad_x      = 0;
+    quad_y      = 0;
+    quad_width  = 0;
+    quad_height = 0;
+
+    is_pending  = false;
+    layer       = 0;
+                
+    x1          = 0;
+    y1          = 0;
+    x2          = 0;
+    y2          = 0;
+}
+
+inline TOGL_GlyphData TOGL_MakeMissingGlyphData(uint32_t font_height) {
+    TOGL_GlyphData glyph_data = {};
+
+    glyph_data.width        = uint16_t(font_height);
+    glyph_data.quad_width   = uint16_t(font_height);
+    glyph_data.quad_height  = uint16_t(font_height);
+
+    return glyph_data;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_GlyphTable
+//-----------------------------------------------------------------------------
+
+inline TOGL_GlyphTable::TOGL_GlyphTable() {
+    Clear();
+}
+
+inline TOGL_GlyphTable::~TOGL_GlyphTable() {
+
+}
+
+inline void TOGL_GlyphTable::Clear() {
+    for (uint16_t& plane_ix : m_plane_ixs) plane_ix = EMPTY_PLANE_IX;
+    m_plane_ixs[0] = BMP_PLANE_IX;
+
+    m_page_ixs.assign(2 * PAGE_COUNT, EMPTY_PAGE_IX); // BMP plane and empty plane
+    m_glyphs.assign(PAGE_SIZE, TOGL_GlyphData());
+    m_is_set.assign(PAGE_SIZE, false);
+    m_font_ixs.assign(PAGE_SIZE, UNRESOLVED_FONT_IX);
+    m_fallback  = {};
+    m_count     = 0;
+}
+
+inline void TOGL_GlyphTable::Set(uint32_t code, const TOGL_GlyphData& glyph_data) {
+    if (code < END_CODE) {
+        const size_t ix = AllocateEntry(code);
+
+        if (!m_is_set[ix]) m_count += 1;
+
+        m_glyphs[ix]    = glyph_data;
+        m_is_set[ix]    = true;
+        m_font_ixs[ix]  = 0;
+    }
+}
+
+inline bool TOGL_GlyphTable::Has(uint32_t code) const {
+    return code < END_CODE && m_is_set[size_t(ToPageIx(code)) * PAGE_SIZE + code % PAGE_SIZE];
+}
+
+inline void TOGL_GlyphTable::ResolveFallback(const std::vector<uint32_t>& fallback_codes, const TOGL_GlyphData& missing_glyph_data) {
+    m_fallback = missing_glyph_data;
+
+    for (const uint32_t code : fallback_codes) {
+        if (Has(code)) {
+            m_fallback = Get(code);
+            break;
+        }
+    }
+
+    for (size_t ix = 0; ix < m_glyphs.size(); ++ix) {
+        if (!m_is_set[ix]) m_glyphs[ix] = m_fallback;
+    }
+}
+
+inline const TOGL_GlyphData& TOGL_GlyphTable::Get(uint32_t code) const {
+    // Basic Multilingual Plane is the first block of m_page_ixs, so it is looked up without plane indirection.
+    if (code < PAGE_COUNT * PAGE_SIZE) {
+        return m_glyphs[size_t(m_page_ixs[code / PAGE_SIZE]) * PAGE_SIZE + code % PAGE_SIZE];
+    }
+    if (code < END_CODE) {
+        return m_glyphs[size_t(ToPageIx(code)) * PAGE_SIZE + code % PAGE_SIZE];
+    }
+    return m_fallback;
+}
+
+inline uint32_t TOGL_GlyphTable::GetCount() const {
+    return m_count;
+}
+
+inline std::vector<uint32_t> TOGL_GlyphTable::GetCodes() const {
+    std::vector<uint32_t> codes;
+    codes.reserve(m_count);
+
+    for (uint32_t plane = 0; plane < PLANE_COUNT; ++plane) {
+        if (m_plane_ixs[plane] == EMPTY_PLANE_IX) continue;
+
+        for (uint32_t page = 0; page < PAGE_COUNT; ++page) {
+            const uint16_t page_ix = m_page_ixs[size_t(m_plane_ixs[plane]) * PAGE_COUNT + page];
+
+            if (page_ix != EMPTY_PAGE_IX) {
+                const size_t first_ix = size_t(page_ix) * PAGE_SIZE;
+
+                for (uint32_t slot = 0; slot < PAGE_SIZE; ++slot) {
+                    if (m_is_set[first_ix + slot]) codes.push_back((plane * PAGE_COUNT + page) * PAGE_SIZE + slot);
+                }
+            }
+        }
+    }
+    return codes;
+}
+
+template <typename ResolveT>
+inline uint8_t TOGL_GlyphTable::ToFontIx(uint32_t code, ResolveT resolve) const {
+    if (code >= END_CODE) return 0;
+
+    const uint8_t font_ix = m_font_ixs[size_t(ToPageIx(code)) * PAGE_SIZE + code % PAGE_SIZE];
+    if (font_ix != UNRESOLVED_FONT_IX) return font_ix;
+
+    const uint8_t resolved_font_ix = std::min<uint8_t>(resolve(code), MAX_FONT_IX);
+
+    m_font_ixs[AllocateEntry(code)] = resolved_font_ix;
+    return resolved_font_ix;
+}
+
+inline void TOGL_GlyphTable::ResetFontIxs() const {
+    for (size_t ix = 0; ix < m_font_ixs.size(); ++ix) {
+        if (!m_is_set[ix]) m_font_ixs[ix] = UNRESOLVED_FONT_IX;
+    }
+}
+
+inline uint16_t& TOGL_GlyphTable::ToAllocatedPageIx(uint32_t code) const {
+    uint16_t& plane_ix = m_plane_ixs[code / (PAGE_COUNT * PAGE_SIZE)];
+
+    if (plane_ix == EMPTY_PLANE_IX) {
+        plane_ix = uint16_t(m_page_ixs.size() / PAGE_COUNT);
+        m_page_ixs.resize(m_page_ixs.size() + PAGE_COUNT, EMPTY_PAGE_IX);
+    }
+
+    return m_page_ixs[size_t(plane_ix) * PAGE_COUNT + (code / PAGE_SIZE) % PAGE_COUNT];
+}
+
+inline uint16_t TOGL_GlyphTable::ToPageIx(uint32_t code) const {
+    return m_page_ixs[size_t(m_plane_ixs[code / (PAGE_COUNT * PAGE_SIZE)]) * PAGE_COUNT + (code / PAGE_SIZE) % PAGE_COUNT];
+}
+
+inline size_t TOGL_GlyphTable::AllocateEntry(uint32_t code) const {
+    uint16_t& page_ix = ToAllocatedPageIx(code);
+
+    if (page_ix == EMPTY_PAGE_IX) {
+        page_ix = uint16_t(m_glyphs.size() / PAGE_SIZE);
+
+        m_glyphs.resize(m_glyphs.size() + PAGE_SIZE, m_fallback);
+        m_is_set.resize(m_is_set.size() + PAGE_SIZE, false);
+        m_font_ixs.resize(m_font_ixs.size() + PAGE_SIZE, UNRESOLVED_FONT_IX);
+    }
+
+    return size_t(page_ix) * PAGE_SIZE + code % PAGE_SIZE;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_FontMetrics
+//-----------------------------------------------------------------------------
+
+inline TOGL_SizeU TOGL_FontMetrics::GetGlyphSize(uint32_t code, TOGL_FontStyleId) const {
+    return GetGlyphSize(code);
+}
+
+inline TOGL_FontStyleId TOGL_FontMetrics::GetStyle() const {
+    return TOGL_FONT_STYLE_ID_NORMAL;
+}
+
+inline uint32_t TOGL_FontMetrics::GetGlyphCountInWidth(const std::wstring& text, uint32_t width) const {
+    return GetGlyphCountInWidth(text, width, GetStyle());
+}
+
+inline uint32_t TOGL_FontMetrics::GetGlyphCountInWidth(const std::wstring& text, uint32_t width, TOGL_FontStyleId style) const {
+    uint32_t    count           = 0;
+    uint32_t    current_width   = 0;
+
+    bool is_first = true;
+    for (size_t index = 0; index < text.length(); index += TOGL_GetUTF16_CharLength(text, index)) {
+        if (is_first) {
+            is_first = false;
+        } else {
+            current_width += GetDistanceBetweenGlyphs();
+        }
+        current_width += GetGlyphSize(TOGL_DecodeUTF16_Char(text, index), style).width;
+        if (current_width > width) break;
+        count += TOGL_GetUTF16_CharLength(text, index);
+    }
+    return count;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_MetricsFont
+//-----------------------------------------------------------------------------
+
+inline TOGL_MetricsFont::TOGL_MetricsFont() {
+    m_font_height           = 0;
+    m_font_ascent           = 0;
+    m_font_descent          = 0;
+    m_font_internal_leading = 0;
+
+    m_is_loaded             = false;
+}
+
+inline TOGL_MetricsFont::~TOGL_MetricsFont() {
+
+}
+
+inline void TOGL_MetricsFont::Load(const std::string& file_name, const TOGL_FontInfo& font_info) {
+    TOGL_MappedFile file;
+
+    if (!file.Open(file_name)) {
+        Unload();
+        SetErrMsg("Can not open font file \"" + file_name + "\".");
+        return;
+    }
+    Load(file.ToData(), file.GetSize(), font_info);
+}
+
+inline void TOGL_MetricsFont::Load(const uint8_t* data, size_t size, const TOGL_FontInfo& font_info) {
+    Unload();
+
+    std::shared_ptr<TOGL_TrueTypeFont> font = std::make_shared<TOGL_TrueTypeFont>();
+
+    if (!font->Load(data, size, true)) {
+        SetErrMsg("Can not load TrueType font metrics. " + font->GetErrMsg());
+        return;
+    }
+
+    m_info = font_info;
+
+    // The same metrics as used by TOGL_FONT_RASTERIZER_ID_TRUE_TYPE rasterizer.
+    TOGL_TrueTypeGlyphSource glyph_source(font, TOGL_FontSizeToPixels(font_info.size, font_info.size_unit));
+
+    m_font_height           = glyph_source.GetFontHeight();
+    m_font_ascent           = glyph_source.GetFontAscent();
+    m_font_descent          = glyph_source.GetFontDescent();
+    m_font_internal_leading = glyph_source.GetFontInternalLeading();
+
+    // Only glyphs, which font has, are added. Others are resolved to fallback glyph.
+    for (const TOGL_UnicodeRange& range : font_info.unicode_range_group.ToRanges()) {
+        for (uint32_t code = range.from; code <= range.to && code <= 0x10FFFF; ++code) {
+            if (font->HasGlyph(code)) {
+                TOGL_GlyphData glyph_data = {};
+                glyph_data.width = glyph_source.GetGlyphWidth(code);
+
+                m_glyphs.Set(code, glyph_data);
+            }
+        }
+    }
+    m_glyphs.ResolveFallback({TOGL_UNICODE_WHITE_SQUARE, TOGL_UNICODE_REPLACEMENT_CHARACTER}, TOGL_MakeMissingGlyphData(m_font_height));
+
+    m_is_loaded = true;
+}
+
+inline void TOGL_MetricsFont::Unload() {
+    m_info                  = {};
+
+    m_font_height           = 0;
+    m_font_ascent           = 0;
+    m_font_descent          = 0;
+    m_font_internal_leading = 0;
+
+    m_glyphs.Clear();
+
+    m_is_loaded             = false;
+    m_err_msg               = "";
+}
+
+inline bool TOGL_MetricsFont::IsLoaded() const {
+    return m_is_loaded;
+}
+
+inline uint32_t TOGL_MetricsFont::GetDistanceBetweenGlyphs() const {
+    return m_info.distance_between_glyphs;
+}
+
+inline uint32_t TOGL_MetricsFont::GetDistanceBetweenLines() const {
+    return m_info.distance_between_lines;
+}
+
+inline TOGL_SizeU TOGL_MetricsFont::GetGlyphSize(uint32_t code) const {
+    if (m_is_loaded) {
+        return {m_glyphs.Get(code).width, m_font_height};
+    }
+    return {0, 0};
+}
+
+inline uint32_t TOGL_MetricsFont::GetHeight() const {
+    return m_font_height;
+}
+
+inline uint32_t TOGL_MetricsFont::GetDescent() const {
+    return m_font_descent;
+}
+
+inline uint32_t TOGL_MetricsFont::GetAscent() const {
+    return m_font_ascent;
+}
+
+inline uint32_t TOGL_MetricsFont::GetInternalLeading() const {
+    return m_font_internal_leading;
+}
+
+inline const TOGL_FontInfo& TOGL_MetricsFont::ToFontInfo() const {
+    return m_info;
+}
+
+inline bool TOGL_MetricsFont::IsOk() const {
+    return m_err_msg.empty();
+}
+
+inline std::string TOGL_MetricsFont::GetErrMsg() const {
+    return m_err_msg;
+}
+
+inline void TOGL_MetricsFont::SetErrMsg(const std::string& err_msg) {
+    m_err_msg = err_msg;
+}
+
+//-----------------------------------------------------------------------------
+// TOGL_FontCache
+//-----------------------------------------------------------------------------
+
+inline TOGL_FontCache::TOGL_FontCache() {
+    key                     = 0;
+
+    font_height             = 0;
+    font_ascent             = 0;
+    font_descent            = 0;
+    font_internal_leading   = 0;
+
+    format                  = TOGL_FONT_ATLAS_FORMAT_ID_RGBA8;
+}
+
+inline uint64_t TOGL_FontCache::MakeKey(const TOGL_FontInfo& font_info, const TOGL_FontLoadOptions& options, uint64_t font_data_size, uint32_t font_head_checksum) {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+
+    auto Add = [&hash](const void* data, size_t size) {
+        for (size_t ix = 0; ix < size; ++ix) {
+            hash ^= ((const uint8_t*)data)[ix];
+            hash *= 1099511628211ULL;
+        }
+    };
+    auto AddU32 = [&Add](uint32_t value) {
+        Add(&value, sizeof(value));
+    };
+    auto AddU64 = [&Add](uint64_t value) {
+        Add(&value, sizeof(value));
+    };
+
+    AddU32(VERSION);
+
+    AddU32(uint32_t(font_info.name.size()));
+    Add(font_info.name.data(), font_info.name.size());
+    AddU32(font_info.size);
+    AddU32(font_info.size_unit);
+    AddU32(font_info.style);
+
+    const std::vector<TOGL_UnicodeRange>& ranges = font_info.unicode_range_group.ToRanges();
+    AddU32(uint32_t(ranges.size()));
+    for (const TOGL_UnicodeRange& range : ranges) {
+        AddU32(range.from);
+        AddU32(range.to);
+    }
+
+    AddU32(font_info.distance_between_glyphs);
+    AddU32(font_info.distance_between_lines);
+
+    AddU32(options.rasterizer);
+    AddU32(options.packer);
+    AddU32(options.format);
+    AddU32(options.page_width);
+    AddU32(options.page_height);
+    AddU32(options.glyph_padding);
+    AddU32(options.is_sdf);
+    AddU32(options.sdf_spread);
+
+    // Added only if used, so keys of fonts without glyph cache don't change.
+    if (options.glyph_cache_page_budget != 0) AddU32(options.glyph_cache_page_budget);
+    if (options.is_style_set) AddU32(options.is_style_set);
+
+    // Added only if known, so keys without font file identity (for example, keys of fonts in registry) don't change.
+    if (font_data_size != 0) AddU64(font_data_size);
+    if (font_head_checksum != 0) AddU32(font_head_checksum);
+
+    return hash;
+}
+
+inline std::string TOGL_FontCache::MakeFileName(uint64_t key) {
+    std::stringstream stream;
+    stream << std::setfill('0') << std::setw(16) << std::hex << std::uppercase << key << ".toglfc";
+    return stream.str();
+}
+
+inline size_t TOGL_FontCache::GetPageSize() const {
+    const size_t pixel_size = (format == TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8) ? 1 : 4;
+    return size_t(stats.page_width) * stats.page_height * pixel_size;
+}
+
+// Layout (all values little endian):
+//  signature           char[8]
+//  version             u32
+//  key                 u64
+//  font metrics        u32 * 4
+//  format              u32
+//  stats               u32 glyph_count, u32 page_count, u16 page_width, u16 page_height, u64 used_area, u64 texture_size
+//  glyph count         u32
+//  glyphs              u32 code, u32 page_ix, u16 width, i16 quad_x, i16 quad_y, u16 quad_width, u16 quad_height, f64 x1, y1, x2, y2
+//  padding             to 16 bytes
+//  pages               page_count * GetPageSize() bytes
+
+namespace _TOGL_FontCacheFormat {
+    static const char SIGNATURE[8] = {'T', 'O', 'G', 'L', 'F', 'C', 'H', '\0'};
+
+    enum : size_t { PAGES_ALIGNMENT = 16 };
+}
+
+inline std::vector<uint8_t> TOGL_FontCache::Encode() const {
+    std::vector<uint8_t> data;
+
+    auto Put = [&data](const auto& value) {
+        const uint8_t* bytes = (const uint8_t*)&value;
+        data.insert(data.end(), bytes, bytes + sizeof(value));
+    };
+
+    data.insert(data.end(), _TOGL_FontCacheFormat::SIGNATURE, _TOGL_FontCacheFormat::SIGNATURE + sizeof(_TOGL_FontCacheFormat::SIGNATURE));
+    Put(uint32_t(VERSION));
+    Put(key);
+
+    Put(font_height);
+    Put(font_ascent);
+    Put(font_descent);
+    Put(font_internal_leading);
+
+    Put(uint32_t(format));
+
+    Put(stats.glyph_count);
+    Put(stats.page_count);
+    Put(stats.page_width);
+    Put(stats.page_height);
+    Put(stats.used_area);
+    Put(stats.texture_size);
+    Put(stats.deduplicated_glyph_count);
+
+    Put(uint32_t(glyphs.size()));
+    for (const Glyph& glyph : glyphs) {
+        Put(glyph.code);
+        Put(glyph.page_ix);
+        Put(glyph.data.width);
+        Put(glyph.data.quad_x);
+        Put(glyph.data.quad_y);
+        Put(glyph.data.quad_width);
+        Put(glyph.data.quad_height);
+        Put(glyph.data.x1);
+        Put(glyph.data.y1);
+        Put(glyph.data.x2);
+        Put(glyph.data.y2);
+    }
+
+    data.resize((data.size() + _TOGL_FontCacheFormat::PAGES_ALIGNMENT - 1) / _TOGL_FontCacheFormat::PAGES_ALIGNMENT * _TOGL_FontCacheFormat::PAGES_ALIGNMENT, 0);
+
+    const size_t page_size = GetPageSize();
+    for (uint32_t ix = 0; ix < stats.page_count; ++ix) {
+        const uint8_t* page = (ix < pages.size()) ? pages[ix] : NULL;
+
+        if (page) {
+            data.insert(data.end(), page, page + page_size);
+        } else {
+            data.resize(data.size() + page_size, 0);
+        }
+    }
+
+    return data;
+}
+
+inline bool TOGL_FontCache::Decode(const uint8_t* data, size_t size) {
+    *this = {};
+
+    size_t pos = 0;
+
+    auto Get = [&](auto& value) -> bool {
+        if (size - pos < sizeof(value)) return false;
+        memcpy(&value, data + pos, sizeof(value));
+        pos += sizeof(value);
+        return true;
+    };
+
+    if (!data || size < sizeof(_TOGL_FontCacheFormat::SIGNATURE)) return false;
+    if (memcmp(data, _TOGL_FontCacheFormat::SIGNATURE, sizeof(_TOGL_FontCacheFormat::SIGNATURE)) != 0) return false;
+    pos += sizeof(_TOGL_FontCacheFormat::SIGNATURE);
+
+    uint32_t version = 0;
+    if (!Get(version) || version != VERSION) return false;
+
+    uint32_t format_id = 0;
+    uint32_t glyph_count = 0;
+
+    const bool is_header_read = Get(key) 
+        && Get(font_height) && Get(font_ascent) && Get(font_descent) && Get(font_internal_leading) 
+        && Get(format_id) 
+        && Get(stats.glyph_count) && Get(stats.page_count) && Get(stats.page_width) && Get(stats.page_height) && Get(stats.used_area) && Get(stats.texture_size)
+        && Get(stats.deduplicated_glyph_count)
+        && Get(glyph_count);
+
+    if (!is_header_read) return false;
+
+    if (format_id != TOGL_FONT_ATLAS_FORMAT_ID_RGBA8 && format_id != TOGL_FONT_ATLAS_FORMAT_ID_ALPHA8) return false;
+    format = TOGL_FontAtlasFormatId(format_id);
+
+    if (stats.page_count > 0 && (stats.page_width == 0 || stats.page_height == 0)) return false;
+
+    enum { GLYPH_SIZE = 4 + 4 + 2 * 5 + 8 * 4 };
+    if (glyph_count > (size - pos) / GLYPH_SIZE) return false;
+
+    glyphs.resize(glyph_count);
+    for (Glyph& glyph : glyphs) {
+        glyph.data = {};
+
+        Get(glyph.code);
+        Get(glyph.page_ix);
+        Get(glyph.data.width);
+        Get(glyph.data.quad_x);
+        Get(glyph.data.quad_y);
+        Get(glyph.data.quad_width);
+        Get(glyph.data.quad_height);
+        Get(glyph.data.x1);
+        Get(glyph.data.y1);
+        Get(glyph.data.x2);
+        Get(glyph.data.y2);
+
+        if (glyph.code > 0x10FFFF || glyph.page_ix >= stats.page_count) return false;
+    }
+
+    pos = (pos + _TOGL_FontCacheFormat::PAGES_ALIGNMENT - 1) / _TOGL_FontCacheFormat::PAGES_ALIGNMENT * _TOGL_FontCacheFormat::PAGES_ALIGNMENT;
+
+    const size_t page_size = GetPageSize();
+    if (pos > size || (stats.page_count > 0 && (size - pos) / stats.page_count < page_size)) return false;
+
+    for (uint32_t ix = 0; ix < stats.page_count; ++ix) {
+        pages.push_back(data + pos);
+        pos += page_size;
+    }
+
+    return true;
+}
+
+#endif // TRIVIALOPENGL_FONTCORE_H_
@@ -19,9 +19,16 @@
 
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <stack>
 #include <vector>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <future>
+#include <chrono>
 
 #endif // TRIVIALOPENGL_HEADERS_H_
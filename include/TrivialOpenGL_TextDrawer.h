@@ -48,7 +48,7 @@ public:
     void SetNumberOfSpacesInTab(uint32_t number);
 
     // Adjust text by using word wrapping and replaces tabs with equivalent in length (in pixels) in spaces.
-    TOGL_FineText AdjustText(const TOGL_Font& font, const  TOGL_FineText& text) const;
+    TOGL_FineText AdjustText(const TOGL_FontMetrics& font, const  TOGL_FineText& text) const;
 
 private:
     uint32_t            m_num_of_spaces_in_tab;
@@ -65,13 +65,13 @@ private:
     //     '[^\t\n ]'   # word (any array of characters which doesn't contain tab, new line or space
     static size_t GetSentencePartPos(const std::wstring& sentence, size_t current_pos);
 
-    TOGL_SizeU GetSentenceSize(const TOGL_Font& font, const std::wstring& sentence) const;
-    uint32_t GetSentenceWidth(const TOGL_Font& font, const std::wstring& sentence) const;
+    TOGL_SizeU GetSentenceSize(const TOGL_FontMetrics& font, const std::wstring& sentence, TOGL_FontStyleId style) const;
+    uint32_t GetSentenceWidth(const TOGL_FontMetrics& font, const std::wstring& sentence, TOGL_FontStyleId style) const;
 
     static std::vector<std::wstring> SplitSentenceToParts(const std::wstring& sentence);
 
-    TOGL_FineText PrepareTextElementHorizontalSpacer(const TOGL_Font & font, uint32_t text_horizontal_space_width, uint32_t & line_width) const;
-    TOGL_FineText PrepareTextElementText(const TOGL_Font& font, const std::wstring& text, uint32_t& line_width) const;
+    TOGL_FineText PrepareTextElementHorizontalSpacer(const TOGL_FontMetrics& font, uint32_t text_horizontal_space_width, uint32_t & line_width) const;
+    TOGL_FineText PrepareTextElementText(const TOGL_FontMetrics& font, const std::wstring& text, TOGL_FontStyleId style, uint32_t& line_width) const;
 };
 
 //------------------------------------------------------------------------------
@@ -88,12 +88,19 @@ void TOGL_ResetTextDrawer();
 void TOGL_RenderText(const TOGL_PointI& pos, const TOGL_Color4U8& color, const std::string& text);
 void TOGL_RenderText(const TOGL_PointI& pos, const TOGL_Color4U8& color, const TOGL_FineText& fine_text);
 
+// Renders text by font from global font registry, accessed by TOGL_ToGlobalFontRegistry().
+void TOGL_RenderText(TOGL_FontHandle font_handle, const TOGL_PointI& pos, const TOGL_Color4U8& color, const std::string& text);
+void TOGL_RenderText(TOGL_FontHandle font_handle, const TOGL_PointI& pos, const TOGL_Color4U8& color, const TOGL_FineText& fine_text);
+
 void TOGL_AdjustAndRenderText(const TOGL_PointI& pos, const TOGL_Color4U8& color, const std::string& text);
 void TOGL_AdjustAndRenderText(const TOGL_PointI& pos, const TOGL_Color4U8& color, const TOGL_FineText& fine_text);
 
 TOGL_SizeU TOGL_GetTextSize(const std::string& text);
 TOGL_SizeU TOGL_GetTextSize(const TOGL_FineText& fine_text);
 
+TOGL_SizeU TOGL_GetTextSize(TOGL_FontHandle font_handle, const std::string& text);
+TOGL_SizeU TOGL_GetTextSize(TOGL_FontHandle font_handle, const TOGL_FineText& fine_text);
+
 // Adjusts with global text adjuster, accessed by TOGL_ToGlobalTextAdjuster().
 TOGL_SizeU TOGL_AdjustAndGetTextSize(const std::string& text);
 TOGL_SizeU TOGL_AdjustAndGetTextSize(const TOGL_FineText& fine_text);
@@ -103,6 +110,102 @@ void TOGL_SetOrigin(TOGL_OriginId origin_id);
 
 TOGL_OriginId TOGL_GetOrigin();
 
+//------------------------------------------------------------------------------
+// TOGL_TextDrawerStats
+//------------------------------------------------------------------------------
+
+// Counted by TOGL_TextDrawer::RenderText, since last TOGL_TextDrawer::ResetStats call.
+struct TOGL_TextDrawerStats {
+    uint32_t glyph_count;           // rendered glyphs (new lines excluded)
+    uint32_t draw_call_count;       // batched: one per font and atlas page for each RenderText call, not batched: one per glyph
+    uint32_t run_cache_hit_count;   // RenderText calls, which have rendered glyph quads from run cache (see TOGL_GlyphRunCache)
+    uint32_t run_cache_miss_count;  // RenderText calls, which have computed glyph quads and added them to run cache
+    uint32_t culled_line_count;     // lines outside of clip area, skipped without glyph lookup (see TOGL_TextDrawer::SetCulling)
+    uint32_t culled_glyph_count;    // glyphs outside of clip area, also glyphs of culled lines
+
+    TOGL_TextDrawerStats();
+};
+
+//------------------------------------------------------------------------------
+// TOGL_GlyphRunCache
+//------------------------------------------------------------------------------
+
+// Glyph quads of texts rendered by TOGL_TextDrawer::RenderText, kept for next calls with the same text. Doesn't use OpenGL.
+// Run is found by key, which contains everything what affects glyph quads (font, its revision, color, origin, text, ...).
+// Quads are relative to start position of text, so text rendered again at any position is taken from cache.
+// Runs, which aren't used for some number of frames (see NextFrame), or least recently used runs, when memory budget is exceeded, are evicted.
+// Runs evicted because of memory budget are evicted in batch, until a quarter of budget is free, so that next runs can be added without eviction.
+class TOGL_GlyphRunCache {
+public:
+    enum : uint32_t { DEFAULT_MAX_UNUSED_FRAME_COUNT = 30 };
+    enum : size_t   { DEFAULT_MEMORY_BUDGET = 4 * 1024 * 1024 };   // in bytes
+
+    struct Run {
+        TOGL_GlyphBatch     batch;          // quads relative to start position of text
+        TOGL_PointI         end_pos;        // position after text, relative to start position of text
+        uint32_t            glyph_count;
+    };
+
+    TOGL_GlyphRunCache();
+    virtual ~TOGL_GlyphRunCache();
+
+    // Removes all runs. Settings are kept.
+    void Clear();
+
+    // Run, which hasn't been used for more than count frames, is evicted by NextFrame.
+    void SetMaxUnusedFrameCount(uint32_t count);
+    uint32_t GetMaxUnusedFrameCount() const;
+
+    // Sets limit of memory used by runs. When it's exceeded, then least recently used runs are evicted. Run bigger than limit isn't kept.
+    // budget           - In bytes. If 0, then no run is kept.
+    void SetMemoryBudget(size_t budget);
+    size_t GetMemoryBudget() const;
+
+    // Starts next frame. Evicts runs, which haven't been used for more than max unused frame count.
+    void NextFrame();
+    uint64_t GetFrame() const;
+
+    // Returns run with the same key, or nullptr if there isn't any. Found run is marked as used in current frame.
+    const Run* Find(const std::vector<uint32_t>& key);
+
+    // Adds run, which replaces run with the same key (or the same key hash).
+    // Returns false if run is bigger than memory budget.
+    bool Add(const std::vector<uint32_t>& key, Run&& run);
+
+    uint32_t GetRunCount() const;
+
+    // Returns memory used by runs, in bytes (approximated by capacity of containers).
+    size_t GetMemorySize() const;
+
+    // Returns number of runs evicted since last Clear.
+    uint64_t GetEvictionCount() const;
+
+private:
+    struct Entry {
+        std::vector<uint32_t>   key;
+        Run                     run;
+        uint64_t                last_frame;
+        size_t                  memory_size;    // in bytes
+    };
+
+    using EntryMap = std::unordered_map<uint64_t, Entry>;
+
+    static uint64_t Hash(const std::vector<uint32_t>& key);
+    static size_t ToMemorySize(const Entry& entry);
+
+    EntryMap::iterator Evict(EntryMap::iterator it);
+
+    // Evicts least recently used runs, until run of size (in bytes) can be added and a quarter of memory budget is free.
+    void EvictLeastRecentlyUsed(size_t size);
+
+    EntryMap            m_entries;                  // by hash of key
+    uint64_t            m_frame;
+    uint32_t            m_max_unused_frame_count;
+    size_t              m_memory_budget;
+    size_t              m_memory_size;
+    uint64_t            m_eviction_count;
+};
+
 //------------------------------------------------------------------------------
 // TOGL_TextDrawer
 //------------------------------------------------------------------------------
@@ -119,6 +222,9 @@ public:
     // Sets start position of text.
     void SetPos(int x, int y);
     void SetPos(const TOGL_PointI& pos);
+
+    // Returns current position (moved by rendered text).
+    TOGL_PointI GetPos() const;
     
     // Sets color of text.
     void SetColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a);
@@ -127,12 +233,32 @@ public:
     // ---
 
     // Renders text by using provided font.
+    // If run caching is on, then quads of text rendered again are taken from run cache (see SetRunCaching).
     void RenderText(TOGL_Font& font, const std::string& text);
     void RenderText(TOGL_Font& font, const TOGL_FineText& fine_text);
 
+    // Renders text by using font from global font registry (see TOGL_ToGlobalFontRegistry()). 
+    // Nothing is rendered if handle doesn't refer to loaded font.
+    void RenderText(TOGL_FontHandle font_handle, const std::string& text);
+    void RenderText(TOGL_FontHandle font_handle, const TOGL_FineText& fine_text);
+
     // text             - Encoding format: UTF8.
-    TOGL_SizeU GetTextSize(TOGL_Font& font, const std::string& text) const;
-    TOGL_SizeU GetTextSize(TOGL_Font& font, const  TOGL_FineText& fine_text) const;
+    TOGL_SizeU GetTextSize(const TOGL_FontMetrics& font, const std::string& text) const;
+    TOGL_SizeU GetTextSize(const TOGL_FontMetrics& font, const  TOGL_FineText& fine_text) const;
+
+    TOGL_SizeU GetTextSize(TOGL_FontHandle font_handle, const std::string& text) const;
+    TOGL_SizeU GetTextSize(TOGL_FontHandle font_handle, const  TOGL_FineText& fine_text) const;
+
+    // Adds glyph quads of text to batch, the same way as RenderText would render them, without rendering (see TOGL_Font::RenderBatch).
+    // Batch isn't cleared. Color of batch is set to color of text drawer at start.
+    // Glyphs, which aren't rasterized yet (lazy loading), aren't uploaded. They stay pending in batch, 
+    // so glyphs of all texts batched in frame can be uploaded together by TOGL_Font::UpdateBatch.
+    void BatchText(TOGL_Font& font, const TOGL_FineText& fine_text, TOGL_GlyphBatch& batch);
+
+    // Moves position to end of text, the same way as RenderText would, without rendering. 
+    // With culling (see SetCulling), lines and glyphs outside of clip area are skipped and counted in stats, as by RenderText.
+    // Returns number of glyphs, which would be rendered.
+    uint32_t AdvanceText(const TOGL_FontMetrics& font, const TOGL_FineText& fine_text);
 
     // ---
 
@@ -140,9 +266,86 @@ public:
     void SetOrigin(TOGL_OriginId orientation);
     TOGL_OriginId GetOrigin() const;
 
+    // If true (default), then RenderText computes glyph quads on CPU and renders them with one draw call per font and atlas page (see TOGL_GlyphBatch).
+    // Otherwise, each glyph is rendered separately by TOGL_Font::RenderGlyph.
+    void SetBatching(bool is_batching);
+    bool IsBatching() const;
+
+    // If true (default), then batched glyphs are rendered as instances expanded into quads by shader, 
+    // when font supports it (OpenGL 3.3 or higher). Otherwise, or when font doesn't support it, quads are computed on CPU.
+    void SetInstancing(bool is_instancing);
+    bool IsInstancing() const;
+
+    // If true, then batched glyph quads of rendered texts are kept in run cache (see TOGL_GlyphRunCache), 
+    // and text rendered again with the same font and state is rendered from cache without decoding, layout and glyph lookup.
+    // Not used with fonts, which have glyph cache or record code points (also in fallback chain), since their glyphs must be requested each frame.
+    // Not used while culling is on (see SetCulling), since cached run has all glyphs of text, also these outside of clip area.
+    // False by default. When enabled, NextFrame should be called once per frame, so unused runs are evicted.
+    void SetRunCaching(bool is_run_caching);
+    bool IsRunCaching() const;
+
+    // Settings and content of run cache. Run cache is cleared by Reset.
+    TOGL_GlyphRunCache& ToRunCache();
+    const TOGL_GlyphRunCache& ToRunCache() const;
+
+    // Starts next frame of run cache (see TOGL_GlyphRunCache::NextFrame). Should be called once per frame. 
+    // If it isn't called, then runs are evicted only when memory budget of run cache is exceeded.
+    void NextFrame();
+
+    // If true, then RenderText skips lines and glyphs outside of clip area (see SetClipArea). False by default.
+    // Lines are skipped by line height alone, without glyph lookup, so cost depends on visible text instead of all text.
+    // Position after rendered text is the same as without culling. Run cache isn't used while culling is on (see SetRunCaching).
+    void SetCulling(bool is_culling);
+    bool IsCulling() const;
+
+    // Sets area outside of which text is culled, in the same coordinates as text position (see SetPos and SetOrigin).
+    // By default (and after ResetClipArea), it's draw area (see TOGL_GetDrawArea), from (0, 0) to draw area size, taken at each RenderText call.
+    // area             - In pixels.
+    void SetClipArea(const TOGL_AreaI& area);
+    void ResetClipArea();
+    TOGL_AreaI GetClipArea() const;
+
+    const TOGL_TextDrawerStats& ToStats() const;
+    void ResetStats();
+
 private:
+    enum RunKeyTypeId : uint32_t {
+        RUN_KEY_TYPE_ID_TEXT,
+        RUN_KEY_TYPE_ID_FINE_TEXT,
+    };
+
     static void ReplaceAll(std::string& text, const std::string& from, const std::string& to);
 
+    // Renders text, or adds its glyph quads to batch if batch isn't null. Font must be loaded.
+    // clip_area        - If not null, then lines and glyphs outside of this area are culled.
+    void ProcessText(TOGL_Font& font, const TOGL_FineText& fine_text, TOGL_GlyphBatch* batch, const TOGL_AreaI* clip_area);
+
+    // Returns true if glyph cell of line at line_y crosses clip area. Glyph cell spans from line position to line position plus font height, for both origins.
+    static bool IsLineVisible(const TOGL_FontMetrics& font, const TOGL_AreaI& clip_area, int line_y);
+
+    // Moves position through code points of text element. For each glyph, which isn't culled, calls on_visible_glyph(code) before position is moved.
+    // clip_area        - If not null, then lines and glyphs outside of this area are culled and counted in stats.
+    // is_line_visible  - Visibility of current line. Updated at each new line.
+    template <typename GetGlyphWidthT, typename OnVisibleGlyphT>
+    void LayOutCodePoints(const TOGL_FontMetrics& font, const std::u32string& code_points, const TOGL_AreaI* clip_area, bool& is_line_visible, 
+                          GetGlyphWidthT get_glyph_width, OnVisibleGlyphT on_visible_glyph);
+
+    bool IsRunCacheUsable(const TOGL_Font& font) const;
+
+    // Makes key of run cache in m_run_key.
+    void MakeRunKey(const TOGL_Font& font, const std::string& text);
+    void MakeRunKey(const TOGL_Font& font, const TOGL_FineText& fine_text);
+    void MakeRunKeyHead(const TOGL_Font& font, RunKeyTypeId type_id);
+
+    // Renders run found by m_run_key. Returns false if there isn't any.
+    bool RenderCachedRun();
+
+    // Computes quads of text, renders them, and adds them to run cache with m_run_key.
+    void RenderAndCacheRun(TOGL_Font& font, const TOGL_FineText& fine_text);
+
+    // Renders quads of run at current position, and moves position to end of run.
+    void RenderRun(const TOGL_GlyphRunCache::Run& run);
+
     TOGL_OriginId                   m_origin_id;
     uint32_t                        m_orientation_factor_y;
 
@@ -152,6 +355,95 @@ private:
     TOGL_Color4U8                   m_color;
 
     TOGL_FineText                   m_text;
+
+    bool                            m_is_batching;
+    bool                            m_is_instancing;
+    TOGL_GlyphBatch                 m_batch;        // reused by each RenderText call
+    TOGL_TextDrawerStats            m_stats;
+
+    bool                            m_is_run_caching;
+    TOGL_GlyphRunCache              m_run_cache;
+    std::vector<uint32_t>           m_run_key;      // reused by each RenderText call
+
+    bool                            m_is_culling;
+    bool                            m_is_clip_area_set;
+    TOGL_AreaI                      m_clip_area;
+};
+
+//------------------------------------------------------------------------------
+// TOGL_StaticText
+//------------------------------------------------------------------------------
+
+// Text, which is adjusted (see TOGL_TextAdjuster) and converted to glyph quads once, and kept in GPU memory: 
+// in vertex buffer object (OpenGL 2.0 and above), or in display list otherwise.
+// Render costs one draw call per font and atlas page, without any processing of text (no decoding, wrapping or glyph lookup).
+// Text is rebuilt only when any of its inputs has been changed, or when font has changed placement of glyphs (see TOGL_Font::GetRevision).
+// Must be rendered and released in the same OpenGL rendering context.
+class TOGL_StaticText {
+public:
+    TOGL_StaticText();
+    virtual ~TOGL_StaticText();
+
+    // Font must outlive this object, or be replaced.
+    void SetFont(TOGL_Font& font);
+    TOGL_Font* ToFont() const;
+
+    // Text is always rebuilt after this call, so it should be set only when it has changed.
+    // text             - Encoding format: UTF8.
+    void SetText(const std::string& text);
+    void SetText(const TOGL_FineText& fine_text);
+    const TOGL_FineText& ToText() const;
+
+    // Sets color of text, which is used until first color element of text.
+    void SetColor(const TOGL_Color4U8& color);
+
+    void SetOrigin(TOGL_OriginId origin_id);
+
+    // width        - In pixels. If 0, then lines aren't wrapped.
+    void SetLineWrapWidth(uint32_t width);
+    void SetNumberOfSpacesInTab(uint32_t number);
+
+    // Rebuilds text if needed.
+    void Build();
+    bool IsBuildNeeded() const;
+
+    // Rebuilds text if needed. Renders text with its origin at position (in pixels).
+    void Render(const TOGL_PointI& pos);
+
+    // Releases vertex buffer object (or display list). Text is rebuilt by next Render.
+    void Release();
+
+    // Returns size of adjusted text (see TOGL_TextDrawer::GetTextSize). Valid after build.
+    TOGL_SizeU GetSize() const;
+
+    // Returns number of draw calls issued by each Render call.
+    uint32_t GetDrawCallCount() const;
+
+    // Returns number of builds done so far.
+    uint32_t GetBuildCount() const;
+
+private:
+    TOGL_NO_COPY(TOGL_StaticText);
+
+    TOGL_Font*                      m_font;
+    TOGL_FineText                   m_text;
+    TOGL_Color4U8                   m_color;
+    TOGL_OriginId                   m_origin_id;
+    uint32_t                        m_wrap_line_width;
+    uint32_t                        m_num_of_spaces_in_tab;
+
+    bool                            m_is_changed;
+    uint64_t                        m_font_revision;    // of font at last build
+    uint32_t                        m_build_count;
+    TOGL_SizeU                      m_size;
+    uint32_t                        m_draw_call_count;
+
+    // Vertex buffer object only. Ranges of buffer, from which groups are rendered.
+    std::vector<TOGL_GlyphBatch::BufferGroup>   m_groups;
+
+    TOGL_FontGL                     m_gl;
+    GLuint                          m_vertex_buffer;
+    GLuint                          m_display_list;
 };
 
 //==========================================================================
@@ -211,16 +503,17 @@ inline void TOGL_TextAdjuster::SetNumberOfSpacesInTab(uint32_t number) {
     m_num_of_spaces_in_tab = number;
 }
 
-inline TOGL_FineText TOGL_TextAdjuster::AdjustText(const TOGL_Font& font, const TOGL_FineText& fine_text) const {
+inline TOGL_FineText TOGL_TextAdjuster::AdjustText(const TOGL_FontMetrics& font, const TOGL_FineText& fine_text) const {
     TOGL_FineText adjusted_fine_text;
 
     if (font.IsLoaded()) {
-        uint32_t line_width = 0; // in pixels
+        uint32_t            line_width  = 0; // in pixels
+        TOGL_FontStyleId    style       = font.GetStyle();
 
         for (const TOGL_FineTextElementContainer& element_container : fine_text.ToElementContainers()) {
             switch (element_container.GetTypeId()) {
             case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT:
-                adjusted_fine_text += PrepareTextElementText(font, element_container.GetText(), line_width);
+                adjusted_fine_text += PrepareTextElementText(font, element_container.GetText(), style, line_width);
                 break;
             case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_HORIZONTAL_SPACER:
                 adjusted_fine_text += PrepareTextElementHorizontalSpacer(font, element_container.GetTextHorizontalSpaceWidth(), line_width);
@@ -228,6 +521,10 @@ inline TOGL_FineText TOGL_TextAdjuster::AdjustText(const TOGL_Font& font, const
             case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_COLOR:
                 adjusted_fine_text.Append(element_container);
                 break;
+            case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE:
+                style = element_container.GetTextStyle();
+                adjusted_fine_text.Append(element_container);
+                break;
             } // switch
             
         }
@@ -240,20 +537,22 @@ inline TOGL_FineText TOGL_TextAdjuster::AdjustText(const TOGL_Font& font, const
 
 //------------------------------------------------------------------------------
 
-inline TOGL_SizeU TOGL_TextAdjuster::GetSentenceSize(const TOGL_Font& font, const std::wstring& sentence) const {
-    return {GetSentenceWidth(font, sentence), font.GetHeight()};
+inline TOGL_SizeU TOGL_TextAdjuster::GetSentenceSize(const TOGL_FontMetrics& font, const std::wstring& sentence, TOGL_FontStyleId style) const {
+    return {GetSentenceWidth(font, sentence, style), font.GetHeight()};
 }
 
-inline uint32_t TOGL_TextAdjuster::GetSentenceWidth(const TOGL_Font& font, const std::wstring& sentence) const {
+inline uint32_t TOGL_TextAdjuster::GetSentenceWidth(const TOGL_FontMetrics& font, const std::wstring& sentence, TOGL_FontStyleId style) const {
     uint32_t width = 0;
 
     bool is_glyph_before = false;
 
-    for (const wchar_t c : sentence) {
+    for (size_t index = 0; index < sentence.length(); index += TOGL_GetUTF16_CharLength(sentence, index)) {
+        const uint32_t c = TOGL_DecodeUTF16_Char(sentence, index);
+
         if (c == L'\t') {
             if (is_glyph_before) width += font.GetDistanceBetweenGlyphs();
 
-            width += font.GetGlyphSize(L' ').width * m_num_of_spaces_in_tab;
+            width += font.GetGlyphSize(L' ', style).width * m_num_of_spaces_in_tab;
             if (m_num_of_spaces_in_tab > 1) width += (font.GetDistanceBetweenGlyphs() * (m_num_of_spaces_in_tab - 1));
 
             is_glyph_before = true;
@@ -262,7 +561,7 @@ inline uint32_t TOGL_TextAdjuster::GetSentenceWidth(const TOGL_Font& font, const
         } else {
             if (is_glyph_before) width += font.GetDistanceBetweenGlyphs();
 
-            width += font.GetGlyphSize(c).width;
+            width += font.GetGlyphSize(c, style).width;
             is_glyph_before = true;
         }
     }
@@ -300,7 +599,7 @@ inline std::vector<std::wstring> TOGL_TextAdjuster::SplitSentenceToParts(const s
     return parts;
 };
 
-inline TOGL_FineText TOGL_TextAdjuster::PrepareTextElementHorizontalSpacer(const TOGL_Font & font, uint32_t text_horizontal_space_width, uint32_t & line_width) const {
+inline TOGL_FineText TOGL_TextAdjuster::PrepareTextElementHorizontalSpacer(const TOGL_FontMetrics& font, uint32_t text_horizontal_space_width, uint32_t & line_width) const {
     TOGL_FineText prepared_fine_text;
 
     if (text_horizontal_space_width + line_width > m_wrap_line_width) {
@@ -313,7 +612,7 @@ inline TOGL_FineText TOGL_TextAdjuster::PrepareTextElementHorizontalSpacer(const
     return prepared_fine_text;
 }
 
-inline TOGL_FineText TOGL_TextAdjuster::PrepareTextElementText(const TOGL_Font& font, const std::wstring& text, uint32_t& line_width) const {
+inline TOGL_FineText TOGL_TextAdjuster::PrepareTextElementText(const TOGL_FontMetrics& font, const std::wstring& text, TOGL_FontStyleId style, uint32_t& line_width) const {
     TOGL_FineText prepared_fine_text;
     std::wstring prepared_text;
 
@@ -323,7 +622,7 @@ inline TOGL_FineText TOGL_TextAdjuster::PrepareTextElementText(const TOGL_Font&
 
     for (const auto& part : sentence_parts) {
         // Any first glyph in line don't have spacing. Only following ones.
-        const uint32_t part_width = GetSentenceWidth(font, part) + (is_glyph_before ? font.GetDistanceBetweenGlyphs() : 0);
+        const uint32_t part_width = GetSentenceWidth(font, part, style) + (is_glyph_before ? font.GetDistanceBetweenGlyphs() : 0);
 
         if (part == L"\n") {
             // New line.
@@ -370,14 +669,14 @@ inline TOGL_FineText TOGL_TextAdjuster::PrepareTextElementText(const TOGL_Font&
                         while (long_part_width > m_wrap_line_width) {
                             const uint32_t line_width_left = m_wrap_line_width - line_width;
 
-                            const size_t glyph_count = font.GetGlyphCountInWidth(long_part, line_width_left);
+                            const size_t glyph_count = font.GetGlyphCountInWidth(long_part, line_width_left, style);
 
                             prepared_text   += long_part.substr(0, glyph_count);
                             prepared_text   += L"\n";
                             line_width      = 0;
 
                             long_part       = long_part.substr(glyph_count);
-                            long_part_width = GetSentenceWidth(font, long_part);
+                            long_part_width = GetSentenceWidth(font, long_part, style);
                         }
 
                         prepared_text   += long_part;
@@ -418,7 +717,10 @@ inline void TOGL_ResetTextDrawer() {
 }
 
 inline void TOGL_RenderText(const TOGL_PointI& pos, const TOGL_Color4U8& color, const std::string& text) {
-    TOGL_RenderText(pos, color, TOGL_FineText(text));
+    TOGL_TextDrawer& drawer = TOGL_ToGlobalTextDrawer();
+    drawer.SetPos(pos);
+    drawer.SetColor(color);
+    drawer.RenderText(TOGL_ToGlobalFont(), text);
 }
 
 inline void TOGL_RenderText(const TOGL_PointI& pos, const TOGL_Color4U8& color, const TOGL_FineText& fine_text) {
@@ -428,6 +730,20 @@ inline void TOGL_RenderText(const TOGL_PointI& pos, const TOGL_Color4U8& color,
     drawer.RenderText(TOGL_ToGlobalFont(), fine_text);
 }
 
+inline void TOGL_RenderText(TOGL_FontHandle font_handle, const TOGL_PointI& pos, const TOGL_Color4U8& color, const std::string& text) {
+    TOGL_TextDrawer& drawer = TOGL_ToGlobalTextDrawer();
+    drawer.SetPos(pos);
+    drawer.SetColor(color);
+    drawer.RenderText(font_handle, text);
+}
+
+inline void TOGL_RenderText(TOGL_FontHandle font_handle, const TOGL_PointI& pos, const TOGL_Color4U8& color, const TOGL_FineText& fine_text) {
+    TOGL_TextDrawer& drawer = TOGL_ToGlobalTextDrawer();
+    drawer.SetPos(pos);
+    drawer.SetColor(color);
+    drawer.RenderText(font_handle, fine_text);
+}
+
 inline void TOGL_AdjustAndRenderText(const TOGL_PointI& pos, const TOGL_Color4U8& color, const std::string& text) {
     TOGL_AdjustAndRenderText(pos, color, TOGL_FineText(text));
 }
@@ -453,6 +769,14 @@ inline TOGL_SizeU TOGL_GetTextSize(const TOGL_FineText& fine_text) {
     return drawer.GetTextSize(font, fine_text);
 }
 
+inline TOGL_SizeU TOGL_GetTextSize(TOGL_FontHandle font_handle, const std::string& text) {
+    return TOGL_GetTextSize(font_handle, TOGL_FineText(text));
+}
+
+inline TOGL_SizeU TOGL_GetTextSize(TOGL_FontHandle font_handle, const TOGL_FineText& fine_text) {
+    return TOGL_ToGlobalTextDrawer().GetTextSize(font_handle, fine_text);
+}
+
 inline TOGL_SizeU TOGL_AdjustAndGetTextSize(const std::string& text) {
     return TOGL_AdjustAndGetTextSize(TOGL_FineText(text));
 }
@@ -473,6 +797,165 @@ inline TOGL_OriginId TOGL_GetOrigin() {
     return TOGL_ToGlobalTextDrawer().GetOrigin();
 }
 
+//------------------------------------------------------------------------------
+// TOGL_TextDrawerStats
+//------------------------------------------------------------------------------
+
+inline TOGL_TextDrawerStats::TOGL_TextDrawerStats() {
+    glyph_count             = 0;
+    draw_call_count         = 0;
+    run_cache_hit_count     = 0;
+    run_cache_miss_count    = 0;
+    culled_line_count       = 0;
+    culled_glyph_count      = 0;
+}
+
+//------------------------------------------------------------------------------
+// TOGL_GlyphRunCache
+//------------------------------------------------------------------------------
+
+inline TOGL_GlyphRunCache::TOGL_GlyphRunCache() {
+    m_frame                     = 0;
+    m_max_unused_frame_count    = DEFAULT_MAX_UNUSED_FRAME_COUNT;
+    m_memory_budget             = DEFAULT_MEMORY_BUDGET;
+    m_memory_size               = 0;
+    m_eviction_count            = 0;
+}
+
+inline TOGL_GlyphRunCache::~TOGL_GlyphRunCache() {
+
+}
+
+inline void TOGL_GlyphRunCache::Clear() {
+    m_entries.clear();
+    m_memory_size       = 0;
+    m_eviction_count    = 0;
+}
+
+inline void TOGL_GlyphRunCache::SetMaxUnusedFrameCount(uint32_t count) {
+    m_max_unused_frame_count = count;
+}
+
+inline uint32_t TOGL_GlyphRunCache::GetMaxUnusedFrameCount() const {
+    return m_max_unused_frame_count;
+}
+
+inline void TOGL_GlyphRunCache::SetMemoryBudget(size_t budget) {
+    m_memory_budget = budget;
+
+    if (m_memory_size > m_memory_budget) EvictLeastRecentlyUsed(0);
+}
+
+inline size_t TOGL_GlyphRunCache::GetMemoryBudget() const {
+    return m_memory_budget;
+}
+
+inline void TOGL_GlyphRunCache::NextFrame() {
+    m_frame += 1;
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (m_frame - it->second.last_frame > m_max_unused_frame_count) {
+            it = Evict(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+inline uint64_t TOGL_GlyphRunCache::GetFrame() const {
+    return m_frame;
+}
+
+inline const TOGL_GlyphRunCache::Run* TOGL_GlyphRunCache::Find(const std::vector<uint32_t>& key) {
+    auto it = m_entries.find(Hash(key));
+    if (it != m_entries.end() && it->second.key == key) {
+        it->second.last_frame = m_frame;
+        return &it->second.run;
+    }
+    return nullptr;
+}
+
+inline bool TOGL_GlyphRunCache::Add(const std::vector<uint32_t>& key, Run&& run) {
+    Entry entry;
+    entry.key           = key;
+    entry.run           = std::move(run);
+    entry.last_frame    = m_frame;
+    entry.memory_size   = ToMemorySize(entry);
+
+    if (entry.memory_size > m_memory_budget) return false;
+
+    const uint64_t hash = Hash(key);
+
+    auto it = m_entries.find(hash);
+    if (it != m_entries.end()) {
+        m_memory_size -= it->second.memory_size;
+        m_entries.erase(it);
+    }
+
+    if (m_memory_size + entry.memory_size > m_memory_budget) EvictLeastRecentlyUsed(entry.memory_size);
+
+    m_memory_size += entry.memory_size;
+    m_entries.emplace(hash, std::move(entry));
+    return true;
+}
+
+inline uint32_t TOGL_GlyphRunCache::GetRunCount() const {
+    return uint32_t(m_entries.size());
+}
+
+inline size_t TOGL_GlyphRunCache::GetMemorySize() const {
+    return m_memory_size;
+}
+
+inline uint64_t TOGL_GlyphRunCache::GetEvictionCount() const {
+    return m_eviction_count;
+}
+
+inline uint64_t TOGL_GlyphRunCache::Hash(const std::vector<uint32_t>& key) {
+    // FNV-1a, but over 4 bytes at once.
+    uint64_t hash = 14695981039346656037ULL;
+
+    for (const uint32_t value : key) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+inline size_t TOGL_GlyphRunCache::ToMemorySize(const Entry& entry) {
+    size_t size = sizeof(Entry) + entry.key.capacity() * sizeof(uint32_t);
+
+    for (const TOGL_GlyphBatch::Group& group : entry.run.batch.ToGroups()) {
+        size += sizeof(TOGL_GlyphBatch::Group);
+        size += group.vertices.capacity() * sizeof(TOGL_GlyphBatch::Vertex);
+        size += group.instances.capacity() * sizeof(TOGL_GlyphBatch::Instance);
+    }
+    return size;
+}
+
+inline TOGL_GlyphRunCache::EntryMap::iterator TOGL_GlyphRunCache::Evict(EntryMap::iterator it) {
+    m_memory_size       -= it->second.memory_size;
+    m_eviction_count    += 1;
+    return m_entries.erase(it);
+}
+
+inline void TOGL_GlyphRunCache::EvictLeastRecentlyUsed(size_t size) {
+    const size_t target_size = m_memory_budget - m_memory_budget / 4;
+
+    std::vector<EntryMap::iterator> its;
+    its.reserve(m_entries.size());
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) its.push_back(it);
+
+    std::sort(its.begin(), its.end(), [](const EntryMap::iterator& l, const EntryMap::iterator& r) {
+        return l->second.last_frame < r->second.last_frame;
+    });
+
+    for (const EntryMap::iterator& it : its) {
+        if (m_memory_size + size <= target_size) break;
+        Evict(it);
+    }
+}
+
 //------------------------------------------------------------------------------
 // TOGL_TextDrawer
 //------------------------------------------------------------------------------
@@ -491,6 +974,17 @@ inline void TOGL_TextDrawer::Reset() {
 
     m_color = {255, 255, 255, 255};
     m_text = {};
+
+    m_is_batching   = true;
+    m_is_instancing = true;
+    m_batch.Clear();
+    ResetStats();
+
+    m_is_run_caching = false;
+    m_run_cache.Clear();
+
+    m_is_culling = false;
+    ResetClipArea();
 }
 
 inline void TOGL_TextDrawer::SetPos(int x, int y) {
@@ -502,6 +996,10 @@ inline void TOGL_TextDrawer::SetPos(const TOGL_PointI& pos) {
     m_base  = pos;
 }
 
+inline TOGL_PointI TOGL_TextDrawer::GetPos() const {
+    return m_pos;
+}
+
 inline void TOGL_TextDrawer::SetColor(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
     SetColor({r, g, b, a});
 }
@@ -511,65 +1009,254 @@ inline void TOGL_TextDrawer::SetColor(const TOGL_Color4U8& color) {
 }
 
 inline void TOGL_TextDrawer::RenderText(TOGL_Font& font, const std::string& text) {
-    RenderText(font, TOGL_FineText(text));
+    // Text is decoded only when it isn't in run cache.
+    if (IsRunCacheUsable(font)) {
+        MakeRunKey(font, text);
+        if (!RenderCachedRun()) RenderAndCacheRun(font, TOGL_FineText(text));
+    } else {
+        RenderText(font, TOGL_FineText(text));
+    }
 }
 
 inline void TOGL_TextDrawer::RenderText(TOGL_Font& font, const TOGL_FineText& fine_text) {
     if (font.IsLoaded()) {
-        const TOGL_OriginId old_origin_id = font.GetOrigin();
-        font.SetOrigin(m_origin_id);
+        if (IsRunCacheUsable(font)) {
+            MakeRunKey(font, fine_text);
+            if (!RenderCachedRun()) RenderAndCacheRun(font, fine_text);
+        } else if (m_is_batching) {
+            const TOGL_AreaI clip_area = m_is_culling ? GetClipArea() : TOGL_AreaI();
+
+            m_batch.Clear();
+            m_batch.SetInstanced(m_is_instancing);
+            ProcessText(font, fine_text, &m_batch, m_is_culling ? &clip_area : nullptr);
+            TOGL_Font::UpdateBatch(m_batch);
+
+            // Color array of batch changes current color.
+            glPushAttrib(GL_CURRENT_BIT);
+            TOGL_Font::RenderBatch(m_batch);
+            glPopAttrib();
+
+            m_stats.draw_call_count += m_batch.GetGroupCount();
+        } else {
+            const TOGL_AreaI clip_area = m_is_culling ? GetClipArea() : TOGL_AreaI();
 
-        glPushAttrib(GL_CURRENT_BIT);
-        glColor4ubv(m_color.ToData());
+            ProcessText(font, fine_text, nullptr, m_is_culling ? &clip_area : nullptr);
+        }
+    }
+}
 
-        for (const TOGL_FineTextElementContainer& element_container : fine_text.ToElementContainers()) {
+inline void TOGL_TextDrawer::RenderText(TOGL_FontHandle font_handle, const std::string& text) {
+    RenderText(TOGL_ToGlobalFontRegistry().ToFont(font_handle), text);
+}
 
+inline void TOGL_TextDrawer::RenderText(TOGL_FontHandle font_handle, const TOGL_FineText& fine_text) {
+    RenderText(TOGL_ToGlobalFontRegistry().ToFont(font_handle), fine_text);
+}
+
+inline void TOGL_TextDrawer::BatchText(TOGL_Font& font, const TOGL_FineText& fine_text, TOGL_GlyphBatch& batch) {
+    if (font.IsLoaded()) {
+        ProcessText(font, fine_text, &batch, nullptr);
+    }
+}
+
+inline uint32_t TOGL_TextDrawer::AdvanceText(const TOGL_FontMetrics& font, const TOGL_FineText& fine_text) {
+    uint32_t glyph_count = 0;
+
+    if (font.IsLoaded()) {
+        const TOGL_AreaI    clip_area       = m_is_culling ? GetClipArea() : TOGL_AreaI();
+        const TOGL_AreaI*   clip_area_ptr   = m_is_culling ? &clip_area : nullptr;
+        TOGL_FontStyleId    style           = font.GetStyle();
+
+        bool is_line_visible = !clip_area_ptr || IsLineVisible(font, clip_area, m_pos.y);
+        if (!is_line_visible) m_stats.culled_line_count += 1;
+
+        auto GetGlyphWidth = [&font, &style](uint32_t code) {
+            return font.GetGlyphSize(code, style).width;
+        };
+        auto CountGlyph = [&glyph_count](uint32_t) {
+            glyph_count += 1;
+        };
+
+        for (const TOGL_FineTextElementContainer& element_container : fine_text.ToElementContainers()) {
             switch (element_container.GetTypeId()) {
+            case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT:
+                LayOutCodePoints(font, element_container.ToCodePoints(), clip_area_ptr, is_line_visible, GetGlyphWidth, CountGlyph);
+                break;
 
-            case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT: {
-                font.RenderBegin();
-                for (const uint32_t code : element_container.GetText()) {
-                    if (code == '\n') {
-                        m_pos.x = m_base.x;
-                        m_pos.y += (font.GetHeight() + font.GetDistanceBetweenLines()) * m_orientation_factor_y;
-                    } else {
-                        glPushMatrix();
-                        glTranslatef(float(m_pos.x), float(m_pos.y), 0);
+            case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_HORIZONTAL_SPACER:
+                m_pos.x += element_container.GetTextHorizontalSpaceWidth();
+                break;
+
+            case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE:
+                style = element_container.GetTextStyle();
+                break;
+
+            default:
+                break;
+            }
+        }
+    }
+    return glyph_count;
+}
+
+inline void TOGL_TextDrawer::ProcessText(TOGL_Font& font, const TOGL_FineText& fine_text, TOGL_GlyphBatch* batch, const TOGL_AreaI* clip_area) {
+    const TOGL_OriginId     old_origin_id   = font.GetOrigin();
+    const TOGL_FontStyleId  old_style       = font.GetStyle();
+    font.SetOrigin(m_origin_id);
 
-                        font.RenderGlyph(code);
-                        m_pos.x += font.GetGlyphSize(code).width + font.GetDistanceBetweenGlyphs();
+    // Glyphs, which are not rasterized yet (lazy loading), are requested, so they are uploaded in one batch. Glyphs of culled lines aren't requested.
+    // When quads are batched, glyphs are uploaded by TOGL_Font::UpdateBatch, so pending glyphs of many texts can be uploaded together.
+    int     line_y              = m_pos.y;
+    bool    is_line_visible     = !clip_area || IsLineVisible(font, *clip_area, line_y);
 
-                        glPopMatrix();
+    for (const TOGL_FineTextElementContainer& element_container : fine_text.ToElementContainers()) {
+        if (element_container.GetTypeId() == TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT) {
+            const std::u32string& code_points = element_container.ToCodePoints();
+
+            if (!clip_area) {
+                font.RequestGlyphs(code_points);
+            } else {
+                for (size_t begin_ix = 0;;) {
+                    const size_t end_ix = std::min(code_points.find(U'\n', begin_ix), code_points.size());
+
+                    if (is_line_visible) {
+                        for (size_t ix = begin_ix; ix < end_ix; ++ix) font.RequestGlyph(code_points[ix]);
                     }
+                    if (end_ix == code_points.size()) break;
+
+                    line_y          += (font.GetHeight() + font.GetDistanceBetweenLines()) * m_orientation_factor_y;
+                    is_line_visible = IsLineVisible(font, *clip_area, line_y);
+                    begin_ix        = end_ix + 1;
                 }
-                font.RenderEnd();
-                break;
             }
+        } else if (element_container.GetTypeId() == TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE) {
+            font.SetStyle(element_container.GetTextStyle());
+        }
+    }
+    if (!batch) font.UpdateGlyphs();
+    font.SetStyle(old_style);
+
+    is_line_visible = !clip_area || IsLineVisible(font, *clip_area, m_pos.y);
+    if (!is_line_visible) m_stats.culled_line_count += 1;
+
+    if (batch) {
+        batch->SetColor(m_color);
+    } else {
+        glPushAttrib(GL_CURRENT_BIT);
+        glColor4ubv(m_color.ToData());
+    }
+
+    for (const TOGL_FineTextElementContainer& element_container : fine_text.ToElementContainers()) {
 
-            case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_COLOR: {
+        switch (element_container.GetTypeId()) {
+
+        case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT: {
+            if (!batch) font.RenderBegin();
+
+            auto GetGlyphWidth = [&font](uint32_t code) {
+                return font.GetGlyphSize(code).width;
+            };
+            auto RenderGlyph = [this, &font, batch](uint32_t code) {
+                if (batch) {
+                    font.BatchGlyph(*batch, m_pos.x, m_pos.y, code);
+                } else {
+                    glPushMatrix();
+                    glTranslatef(float(m_pos.x), float(m_pos.y), 0);
+
+                    font.RenderGlyph(code);
+
+                    glPopMatrix();
+
+                    m_stats.draw_call_count += 1;
+                }
+                m_stats.glyph_count += 1;
+            };
+
+            LayOutCodePoints(font, element_container.ToCodePoints(), clip_area, is_line_visible, GetGlyphWidth, RenderGlyph);
+
+            if (!batch) font.RenderEnd();
+            break;
+        }
+
+        case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_COLOR: {
+            if (batch) {
+                batch->SetColor(element_container.GetTextColor());
+            } else {
                 glColor4ubv(element_container.GetTextColor().ToData());
-                break;
             }
+            break;
+        }
 
-            case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_HORIZONTAL_SPACER:
-                m_pos.x += element_container.GetTextHorizontalSpaceWidth();
-                break;
-            } // switch
+        case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_HORIZONTAL_SPACER:
+            m_pos.x += element_container.GetTextHorizontalSpaceWidth();
+            break;
+
+        case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE:
+            // Font in style shares atlas pages with font, so only glyph table is switched.
+            font.SetStyle(element_container.GetTextStyle());
+            break;
+        } // switch
+    }
+
+    if (!batch) glPopAttrib();
+
+    font.SetOrigin(old_origin_id);
+    font.SetStyle(old_style);
+}
+
+inline bool TOGL_TextDrawer::IsLineVisible(const TOGL_FontMetrics& font, const TOGL_AreaI& clip_area, int line_y) {
+    return line_y + int(font.GetHeight()) > clip_area.y && line_y < clip_area.y + clip_area.height;
+}
+
+template <typename GetGlyphWidthT, typename OnVisibleGlyphT>
+inline void TOGL_TextDrawer::LayOutCodePoints(const TOGL_FontMetrics& font, const std::u32string& code_points, const TOGL_AreaI* clip_area, bool& is_line_visible, 
+                                              GetGlyphWidthT get_glyph_width, OnVisibleGlyphT on_visible_glyph) {
+    for (size_t ix = 0; ix < code_points.size(); ++ix) {
+        const uint32_t code = code_points[ix];
+
+        if (code == '\n') {
+            m_pos.x = m_base.x;
+            m_pos.y += (font.GetHeight() + font.GetDistanceBetweenLines()) * m_orientation_factor_y;
+
+            if (clip_area) {
+                is_line_visible = IsLineVisible(font, *clip_area, m_pos.y);
+                if (!is_line_visible) m_stats.culled_line_count += 1;
+            }
+            continue;
         }
 
-        glPopAttrib();
+        const bool is_rest_of_line_culled = clip_area && (!is_line_visible || m_pos.x >= clip_area->x + clip_area->width);
+
+        if (is_rest_of_line_culled) {
+            // Glyphs up to new line are skipped without lookup. Glyphs of last line are still measured, so position after text is kept.
+            const size_t new_line_ix = code_points.find(U'\n', ix);
+
+            if (new_line_ix != std::u32string::npos) {
+                m_stats.culled_glyph_count += uint32_t(new_line_ix - ix);
+                ix = new_line_ix - 1;
+                continue;
+            }
+        }
 
-        font.SetOrigin(old_origin_id);
+        const uint32_t glyph_width = get_glyph_width(code);
+
+        if (is_rest_of_line_culled || (clip_area && m_pos.x + int(glyph_width) <= clip_area->x)) {
+            m_stats.culled_glyph_count += 1;
+        } else {
+            on_visible_glyph(code);
+        }
+        m_pos.x += glyph_width + font.GetDistanceBetweenGlyphs();
     }
 }
 
-inline TOGL_SizeU TOGL_TextDrawer::GetTextSize(TOGL_Font& font, const std::string& text) const {
+inline TOGL_SizeU TOGL_TextDrawer::GetTextSize(const TOGL_FontMetrics& font, const std::string& text) const {
     return GetTextSize(font, TOGL_FineText(text));
 }
 
-inline TOGL_SizeU TOGL_TextDrawer::GetTextSize(TOGL_Font& font, const  TOGL_FineText& fine_text) const {
-    TOGL_SizeU size = {0, font.GetHeight()};
-    uint32_t width = 0;
+inline TOGL_SizeU TOGL_TextDrawer::GetTextSize(const TOGL_FontMetrics& font, const  TOGL_FineText& fine_text) const {
+    TOGL_SizeU          size    = {0, font.GetHeight()};
+    uint32_t            width   = 0;
+    TOGL_FontStyleId    style   = font.GetStyle();
 
     bool is_glyph_before = false;
     
@@ -578,7 +1265,7 @@ inline TOGL_SizeU TOGL_TextDrawer::GetTextSize(TOGL_Font& font, const  TOGL_Fine
             switch (element_container.GetTypeId()) {
 
             case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT: {
-                for (const uint32_t code : element_container.GetText()) {
+                for (const uint32_t code : element_container.ToCodePoints()) {
                     if (code == '\n') {
                         size.height += font.GetHeight() + font.GetDistanceBetweenLines();
 
@@ -589,7 +1276,7 @@ inline TOGL_SizeU TOGL_TextDrawer::GetTextSize(TOGL_Font& font, const  TOGL_Fine
                     } else {
                         if (is_glyph_before) width += font.GetDistanceBetweenGlyphs();
 
-                        width += font.GetGlyphSize(code).width;
+                        width += font.GetGlyphSize(code, style).width;
 
                         is_glyph_before = true;
                     }
@@ -606,6 +1293,10 @@ inline TOGL_SizeU TOGL_TextDrawer::GetTextSize(TOGL_Font& font, const  TOGL_Fine
                 is_glyph_before = false;
                 break;
             }
+
+            case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE:
+                style = element_container.GetTextStyle();
+                break;
             }
         }
         if (size.width < width) size.width = width;
@@ -614,6 +1305,14 @@ inline TOGL_SizeU TOGL_TextDrawer::GetTextSize(TOGL_Font& font, const  TOGL_Fine
     return size;
 }
 
+inline TOGL_SizeU TOGL_TextDrawer::GetTextSize(TOGL_FontHandle font_handle, const std::string& text) const {
+    return GetTextSize(font_handle, TOGL_FineText(text));
+}
+
+inline TOGL_SizeU TOGL_TextDrawer::GetTextSize(TOGL_FontHandle font_handle, const  TOGL_FineText& fine_text) const {
+    return GetTextSize(TOGL_ToGlobalFontRegistry().ToFont(font_handle), fine_text);
+}
+
 inline void TOGL_TextDrawer::SetOrigin(TOGL_OriginId origin_id) {
     m_origin_id = origin_id;
 
@@ -631,8 +1330,221 @@ inline TOGL_OriginId TOGL_TextDrawer::GetOrigin() const {
     return m_origin_id;
 }
 
+inline void TOGL_TextDrawer::SetBatching(bool is_batching) {
+    m_is_batching = is_batching;
+}
+
+inline bool TOGL_TextDrawer::IsBatching() const {
+    return m_is_batching;
+}
+
+inline void TOGL_TextDrawer::SetInstancing(bool is_instancing) {
+    m_is_instancing = is_instancing;
+}
+
+inline bool TOGL_TextDrawer::IsInstancing() const {
+    return m_is_instancing;
+}
+
+inline void TOGL_TextDrawer::SetRunCaching(bool is_run_caching) {
+    m_is_run_caching = is_run_caching;
+}
+
+inline bool TOGL_TextDrawer::IsRunCaching() const {
+    return m_is_run_caching;
+}
+
+inline TOGL_GlyphRunCache& TOGL_TextDrawer::ToRunCache() {
+    return m_run_cache;
+}
+
+inline const TOGL_GlyphRunCache& TOGL_TextDrawer::ToRunCache() const {
+    return m_run_cache;
+}
+
+inline void TOGL_TextDrawer::NextFrame() {
+    m_run_cache.NextFrame();
+}
+
+inline void TOGL_TextDrawer::SetCulling(bool is_culling) {
+    m_is_culling = is_culling;
+}
+
+inline bool TOGL_TextDrawer::IsCulling() const {
+    return m_is_culling;
+}
+
+inline void TOGL_TextDrawer::SetClipArea(const TOGL_AreaI& area) {
+    m_clip_area         = area;
+    m_is_clip_area_set  = true;
+}
+
+inline void TOGL_TextDrawer::ResetClipArea() {
+    m_clip_area         = {};
+    m_is_clip_area_set  = false;
+}
+
+inline TOGL_AreaI TOGL_TextDrawer::GetClipArea() const {
+    if (m_is_clip_area_set) return m_clip_area;
+
+    const TOGL_AreaIU16 draw_area = TOGL_GetDrawArea();
+    return TOGL_AreaI(0, 0, draw_area.width, draw_area.height);
+}
+
+inline const TOGL_TextDrawerStats& TOGL_TextDrawer::ToStats() const {
+    return m_stats;
+}
+
+inline void TOGL_TextDrawer::ResetStats() {
+    m_stats = {};
+}
+
 //------------------------------------------------------------------------------
 
+inline bool TOGL_TextDrawer::IsRunCacheUsable(const TOGL_Font& font) const {
+    // Cached run is complete, so culled lines and glyphs aren't skipped nor counted when it's rendered.
+    if (!m_is_run_caching || !m_is_batching || m_is_culling || !font.IsLoaded()) return false;
+
+    // Glyphs of glyph cache are evicted if they aren't requested in each frame (see TOGL_GlyphCache::Touch).
+    // Code points are recorded only when glyphs are rendered.
+    auto IsRequestedEachFrame = [](const TOGL_Font& font) {
+        return font.ToLoadOptions().glyph_cache_page_budget != 0 || font.IsRecording();
+    };
+
+    if (IsRequestedEachFrame(font)) return false;
+    for (const TOGL_Font* fallback_font : font.ToFallbackFonts()) {
+        if (IsRequestedEachFrame(*fallback_font)) return false;
+    }
+    return true;
+}
+
+inline void TOGL_TextDrawer::MakeRunKey(const TOGL_Font& font, const std::string& text) {
+    MakeRunKeyHead(font, RUN_KEY_TYPE_ID_TEXT);
+
+    m_run_key.push_back(uint32_t(text.size()));
+
+    for (size_t ix = 0; ix < text.size(); ix += sizeof(uint32_t)) {
+        uint32_t value = 0;
+        memcpy(&value, text.data() + ix, std::min(sizeof(uint32_t), text.size() - ix));
+        m_run_key.push_back(value);
+    }
+}
+
+inline void TOGL_TextDrawer::MakeRunKey(const TOGL_Font& font, const TOGL_FineText& fine_text) {
+    MakeRunKeyHead(font, RUN_KEY_TYPE_ID_FINE_TEXT);
+
+    for (const TOGL_FineTextElementContainer& element_container : fine_text.ToElementContainers()) {
+        m_run_key.push_back(uint32_t(element_container.GetTypeId()));
+
+        switch (element_container.GetTypeId()) {
+        case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_TEXT: {
+            const std::u32string& code_points = element_container.ToCodePoints();
+
+            m_run_key.push_back(uint32_t(code_points.size()));
+            m_run_key.insert(m_run_key.end(), code_points.begin(), code_points.end());
+            break;
+        }
+        case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_COLOR: {
+            uint32_t color = 0;
+            memcpy(&color, element_container.GetTextColor().ToData(), sizeof(color));
+            m_run_key.push_back(color);
+            break;
+        }
+        case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_HORIZONTAL_SPACER:
+            m_run_key.push_back(element_container.GetTextHorizontalSpaceWidth());
+            break;
+
+        case TOGL_FINE_TEXT_ELEMENT_TYPE_ID_STYLE:
+            m_run_key.push_back(uint32_t(element_container.GetTextStyle()));
+            break;
+        }
+    }
+}
+
+inline void TOGL_TextDrawer::MakeRunKeyHead(const TOGL_Font& font, RunKeyTypeId type_id) {
+    auto AddU64 = [this](uint64_t value) {
+        m_run_key.push_back(uint32_t(value));
+        m_run_key.push_back(uint32_t(value >> 32));
+    };
+
+    const double    scale = font.GetScale();
+    uint64_t        scale_bits;
+    memcpy(&scale_bits, &scale, sizeof(scale_bits));
+
+    uint32_t color = 0;
+    memcpy(&color, m_color.ToData(), sizeof(color));
+
+    m_run_key.clear();
+    m_run_key.push_back(type_id);
+
+    // Font revision changes when font is reloaded or glyphs are moved in atlas, so cached quads are no longer found.
+    AddU64(font.GetLoadId());
+    AddU64(font.GetRevision());
+    AddU64(scale_bits);
+    m_run_key.push_back(uint32_t(font.GetStyle()));
+
+    m_run_key.push_back(uint32_t(m_origin_id));
+    m_run_key.push_back(color);
+    m_run_key.push_back(uint32_t(m_base.x - m_pos.x));    // new line starts at base
+    m_run_key.push_back(m_is_instancing ? 1 : 0);
+}
+
+inline bool TOGL_TextDrawer::RenderCachedRun() {
+    const TOGL_GlyphRunCache::Run* run = m_run_cache.Find(m_run_key);
+
+    if (run) {
+        RenderRun(*run);
+        m_stats.run_cache_hit_count += 1;
+        return true;
+    }
+    return false;
+}
+
+inline void TOGL_TextDrawer::RenderAndCacheRun(TOGL_Font& font, const TOGL_FineText& fine_text) {
+    TOGL_GlyphRunCache::Run run;
+    run.batch.SetInstanced(m_is_instancing);
+
+    // Quads are computed relative to start position.
+    const TOGL_PointI   pos         = m_pos;
+    const uint32_t      glyph_count = m_stats.glyph_count;
+
+    m_pos   = {0, 0};
+    m_base  = {m_base.x - pos.x, m_base.y - pos.y};
+
+    ProcessText(font, fine_text, &run.batch, nullptr);
+    TOGL_Font::UpdateBatch(run.batch);
+
+    run.end_pos     = m_pos;
+    run.glyph_count = m_stats.glyph_count - glyph_count;
+
+    m_pos               = pos;
+    m_base              = {m_base.x + pos.x, m_base.y + pos.y};
+    m_stats.glyph_count = glyph_count;
+
+    RenderRun(run);
+    m_stats.run_cache_miss_count += 1;
+
+    m_run_cache.Add(m_run_key, std::move(run));
+}
+
+inline void TOGL_TextDrawer::RenderRun(const TOGL_GlyphRunCache::Run& run) {
+    glPushMatrix();
+    glTranslatef(float(m_pos.x), float(m_pos.y), 0);
+
+    // Color array of batch changes current color.
+    glPushAttrib(GL_CURRENT_BIT);
+    TOGL_Font::RenderBatch(run.batch);
+    glPopAttrib();
+
+    glPopMatrix();
+
+    m_pos.x += run.end_pos.x;
+    m_pos.y += run.end_pos.y;
+
+    m_stats.glyph_count     += run.glyph_count;
+    m_stats.draw_call_count += run.batch.GetGroupCount();
+}
+
 inline void TOGL_TextDrawer::ReplaceAll(std::string& text, const std::string& from, const std::string& to) {
     if (!from.empty()) {
         size_t pos = 0;
@@ -643,4 +1555,196 @@ inline void TOGL_TextDrawer::ReplaceAll(std::string& text, const std::string& fr
     }
 }
 
+//------------------------------------------------------------------------------
+// TOGL_StaticText
+//------------------------------------------------------------------------------
+
+inline TOGL_StaticText::TOGL_StaticText() {
+    m_font                  = nullptr;
+    m_color                 = {255, 255, 255, 255};
+    m_origin_id             = TOGL_ORIGIN_ID_LEFT_BOTTOM;
+    m_wrap_line_width       = 0;
+    m_num_of_spaces_in_tab  = 4;
+
+    m_is_changed            = true;
+    m_font_revision         = 0;
+    m_build_count           = 0;
+    m_size                  = {};
+    m_draw_call_count       = 0;
+
+    m_vertex_buffer         = 0;
+    m_display_list          = 0;
+}
+
+inline TOGL_StaticText::~TOGL_StaticText() {
+    Release();
+}
+
+inline void TOGL_StaticText::SetFont(TOGL_Font& font) {
+    if (m_font != &font) {
+        m_font          = &font;
+        m_is_changed    = true;
+    }
+}
+
+inline TOGL_Font* TOGL_StaticText::ToFont() const {
+    return m_font;
+}
+
+inline void TOGL_StaticText::SetText(const std::string& text) {
+    SetText(TOGL_FineText(text));
+}
+
+inline void TOGL_StaticText::SetText(const TOGL_FineText& fine_text) {
+    m_text          = fine_text;
+    m_is_changed    = true;
+}
+
+inline const TOGL_FineText& TOGL_StaticText::ToText() const {
+    return m_text;
+}
+
+inline void TOGL_StaticText::SetColor(const TOGL_Color4U8& color) {
+    if (m_color.r != color.r || m_color.g != color.g || m_color.b != color.b || m_color.a != color.a) {
+        m_color         = color;
+        m_is_changed    = true;
+    }
+}
+
+inline void TOGL_StaticText::SetOrigin(TOGL_OriginId origin_id) {
+    if (m_origin_id != origin_id) {
+        m_origin_id     = origin_id;
+        m_is_changed    = true;
+    }
+}
+
+inline void TOGL_StaticText::SetLineWrapWidth(uint32_t width) {
+    if (m_wrap_line_width != width) {
+        m_wrap_line_width   = width;
+        m_is_changed        = true;
+    }
+}
+
+inline void TOGL_StaticText::SetNumberOfSpacesInTab(uint32_t number) {
+    if (m_num_of_spaces_in_tab != number) {
+        m_num_of_spaces_in_tab  = number;
+        m_is_changed            = true;
+    }
+}
+
+inline bool TOGL_StaticText::IsBuildNeeded() const {
+    return m_is_changed || (m_font && m_font->GetRevision() != m_font_revision);
+}
+
+inline void TOGL_StaticText::Build() {
+    if (IsBuildNeeded()) {
+        Release();
+
+        if (m_font && m_font->IsLoaded()) {
+            TOGL_TextAdjuster text_adjuster;
+            text_adjuster.SetLineWrapWidth(m_wrap_line_width);
+            text_adjuster.SetNumberOfSpacesInTab(m_num_of_spaces_in_tab);
+
+            const TOGL_FineText adjusted_text = text_adjuster.AdjustText(*m_font, m_text);
+
+            TOGL_TextDrawer text_drawer;
+            text_drawer.SetOrigin(m_origin_id);
+            text_drawer.SetColor(m_color);
+
+            // Batch isn't instanced. Quads are uploaded once, so there is nothing to save per frame.
+            TOGL_GlyphBatch batch;
+            text_drawer.BatchText(*m_font, adjusted_text, batch);
+            TOGL_Font::UpdateBatch(batch);
+
+            m_size              = text_drawer.GetTextSize(*m_font, adjusted_text);
+            m_draw_call_count   = batch.GetGroupCount();
+
+            if (!batch.IsEmpty()) {
+                if (TOGL_FontGL::GetVersion().major >= 2 && m_gl.Load()) {
+                    std::vector<TOGL_GlyphBatch::Vertex> vertices;
+                    vertices.reserve(batch.GetQuadCount() * 4);
+
+                    // Vertices of groups are uploaded one after another.
+                    for (const TOGL_GlyphBatch::Group& group : batch.ToGroups()) {
+                        if (!group.vertices.empty()) {
+                            m_groups.push_back({group.font, group.tex_obj, uint32_t(vertices.size()), uint32_t(group.vertices.size())});
+                            vertices.insert(vertices.end(), group.vertices.begin(), group.vertices.end());
+                        }
+                    }
+
+                    m_gl.togl_glGenBuffers(1, &m_vertex_buffer);
+                    m_gl.togl_glBindBuffer(TOGL_FontGL::TOGL_GL_ARRAY_BUFFER, m_vertex_buffer);
+                    m_gl.togl_glBufferData(TOGL_FontGL::TOGL_GL_ARRAY_BUFFER, vertices.size() * sizeof(TOGL_GlyphBatch::Vertex), vertices.data(), TOGL_FontGL::TOGL_GL_STATIC_DRAW);
+                    m_gl.togl_glBindBuffer(TOGL_FontGL::TOGL_GL_ARRAY_BUFFER, 0);
+                } else {
+                    // Vertex arrays are copied into display list, when it's compiled.
+                    m_display_list = glGenLists(1);
+                    if (m_display_list != 0) {
+                        glNewList(m_display_list, GL_COMPILE);
+                        TOGL_Font::RenderBatch(batch);
+                        glEndList();
+                    }
+                }
+            }
+        }
+
+        // Taken after build, since rasterization of glyphs might change glyph cache.
+        m_font_revision = m_font ? m_font->GetRevision() : 0;
+        m_is_changed    = false;
+        m_build_count   += 1;
+    }
+}
+
+inline void TOGL_StaticText::Render(const TOGL_PointI& pos) {
+    Build();
+
+    if (m_vertex_buffer != 0 || m_display_list != 0) {
+        glPushMatrix();
+        glTranslatef(float(pos.x), float(pos.y), 0);
+
+        // Color array changes current color.
+        glPushAttrib(GL_CURRENT_BIT);
+
+        if (m_vertex_buffer != 0) {
+            m_gl.togl_glBindBuffer(TOGL_FontGL::TOGL_GL_ARRAY_BUFFER, m_vertex_buffer);
+            TOGL_Font::RenderBufferGroups(m_groups);
+            m_gl.togl_glBindBuffer(TOGL_FontGL::TOGL_GL_ARRAY_BUFFER, 0);
+        } else {
+            glCallList(m_display_list);
+        }
+
+        glPopAttrib();
+        glPopMatrix();
+    }
+}
+
+inline void TOGL_StaticText::Release() {
+    if (m_vertex_buffer != 0) {
+        m_gl.togl_glDeleteBuffers(1, &m_vertex_buffer);
+        m_vertex_buffer = 0;
+    }
+    if (m_display_list != 0) {
+        glDeleteLists(m_display_list, 1);
+        m_display_list = 0;
+    }
+
+    m_groups.clear();
+
+    m_size              = {};
+    m_draw_call_count   = 0;
+    m_is_changed        = true;
+}
+
+inline TOGL_SizeU TOGL_StaticText::GetSize() const {
+    return m_size;
+}
+
+inline uint32_t TOGL_StaticText::GetDrawCallCount() const {
+    return m_draw_call_count;
+}
+
+inline uint32_t TOGL_StaticText::GetBuildCount() const {
+    return m_build_count;
+}
+
 #endif // TRIVIALOPENGL_TEXTDRAWER_H_
@@ -0,0 +1,1232 @@
+/**
+* @file TrivialOpenGL_TrueType.h
+* @author underwatergrasshopper
+*/
+
+#ifndef TRIVIALOPENGL_TRUETYPE_H_
+#define TRIVIALOPENGL_TRUETYPE_H_
+
+// Depends only on standard library (doesn't use Windows nor OpenGL).
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+
+//==============================================================================
+// Declarations
+//==============================================================================
+
+// Returns table tag as big endian number (the same as stored in font file). For example: TOGL_MakeTrueTypeTag('c', 'm', 'a', 'p').
+constexpr uint32_t TOGL_MakeTrueTypeTag(char a, char b, char c, char d) {
+    return (uint32_t(uint8_t(a)) << 24) | (uint32_t(uint8_t(b)) << 16) | (uint32_t(uint8_t(c)) << 8) | uint32_t(uint8_t(d));
+}
+
+// Returns checksum of font table: sum of big endian 32-bit words (last word is padded with zeros), as stored in table directory of font file.
+uint32_t TOGL_ComputeTrueTypeTableChecksum(const uint8_t* data, size_t size);
+
+//------------------------------------------------------------------------------
+// TOGL_TrueTypePoint
+//------------------------------------------------------------------------------
+
+// Point of glyph outline.
+struct TOGL_TrueTypePoint {
+    float   x;
+    float   y;
+    bool    is_on_curve;    // if false, then point is control point of quadratic bezier curve
+};
+
+typedef std::vector<TOGL_TrueTypePoint> TOGL_TrueTypeContour;
+
+//------------------------------------------------------------------------------
+// TOGL_TrueTypeFont
+//------------------------------------------------------------------------------
+
+// Parser of font file with TrueType outlines (TTF, OTF with 'glyf' table, first font of TTC).
+// Reads tables: 'head', 'maxp', 'hhea', 'hmtx', 'OS/2' (optional), 'cmap', 'loca', 'glyf'.
+// All values are in font units, unless stated otherwise.
+class TOGL_TrueTypeFont {
+public:
+    // Returns content of table with tag, or empty vector if there is no such table.
+    typedef std::function<std::vector<uint8_t> (uint32_t tag)> GetTableFnT;
+
+    TOGL_TrueTypeFont();
+    virtual ~TOGL_TrueTypeFont();
+
+    // Loads font from content of font file. Only tables are copied, so content can be released after this call.
+    // is_metrics_only  - If true, then outlines ('loca' and 'glyf' tables) aren't loaded (also aren't required), and GetGlyphContours always fails.
+    // Returns true if font has been loaded. Otherwise error message can be retrieved by GetErrMsg().
+    bool Load(const uint8_t* data, size_t size, bool is_metrics_only = false);
+
+    // Loads font from separate tables (for example, provided by GetFontData).
+    bool Load(const GetTableFnT& get_table, bool is_metrics_only = false);
+
+    void Unload();
+    bool IsLoaded() const;
+
+    uint16_t GetUnitsPerEm() const;
+
+    // Distance from baseline to top of glyph cell. From 'OS/2' table (usWinAscent) if present, otherwise from 'hhea'.
+    int32_t GetAscent() const;
+
+    // Distance from baseline to bottom of glyph cell (positive value).
+    int32_t GetDescent() const;
+
+    int32_t GetLineGap() const;
+
+    uint32_t GetGlyphCount() const;
+
+    // Returns glyph index for unicode code point, or 0 (missing glyph) if font doesn't have glyph for code point.
+    uint32_t GetGlyphIndex(uint32_t code) const;
+    bool HasGlyph(uint32_t code) const;
+
+    uint16_t GetAdvanceWidth(uint32_t glyph_index) const;
+    int16_t GetLeftSideBearing(uint32_t glyph_index) const;
+
+    // Returns outline of glyph. Components of composite glyph are merged into contours.
+    // Returns false if glyph data is corrupted.
+    bool GetGlyphContours(uint32_t glyph_index, std::vector<TOGL_TrueTypeContour>& contours) const;
+
+    bool IsOk() const;
+    std::string GetErrMsg() const;
+
+private:
+    bool GetGlyphContours(uint32_t glyph_index, std::vector<TOGL_TrueTypeContour>& contours, uint32_t depth) const;
+
+    // Returns false if glyph index is out of range. Empty glyph has size equal 0.
+    bool GetGlyphLocation(uint32_t glyph_index, size_t& offset, size_t& size) const;
+
+    uint32_t GetGlyphIndexFormat4(uint32_t code) const;
+    uint32_t GetGlyphIndexFormat12(uint32_t code) const;
+
+    static uint8_t  ReadU8(const std::vector<uint8_t>& data, size_t pos);
+    static uint16_t ReadU16(const std::vector<uint8_t>& data, size_t pos);
+    static int16_t  ReadI16(const std::vector<uint8_t>& data, size_t pos);
+    static uint32_t ReadU32(const std::vector<uint8_t>& data, size_t pos);
+
+    void SetErrMsg(const std::string& err_msg);
+
+    std::vector<uint8_t>    m_head;
+    std::vector<uint8_t>    m_maxp;
+    std::vector<uint8_t>    m_hhea;
+    std::vector<uint8_t>    m_hmtx;
+    std::vector<uint8_t>    m_cmap;
+    std::vector<uint8_t>    m_loca;
+    std::vector<uint8_t>    m_glyf;
+
+    uint16_t                m_units_per_em;
+    bool                    m_is_long_loca;
+    uint32_t                m_glyph_count;
+    uint32_t                m_h_metric_count;
+    int32_t                 m_ascent;
+    int32_t                 m_descent;
+    int32_t                 m_line_gap;
+
+    size_t                  m_cmap_subtable_pos;
+    uint16_t                m_cmap_format;
+
+    bool                    m_is_loaded;
+    std::string             m_err_msg;
+};
+
+//------------------------------------------------------------------------------
+// TOGL_GlyphRasterizer
+//------------------------------------------------------------------------------
+
+// Anti-aliased scanline rasterizer.
+// Each line of outline adds signed area, which it covers, to accumulation buffer.
+// Coverage of pixel is absolute value of sum of accumulated areas from left end of row to pixel (non-zero winding rule).
+// Coordinates are in pixels, origin is in left-bottom corner of bitmap.
+class TOGL_GlyphRasterizer {
+public:
+    TOGL_GlyphRasterizer();
+    virtual ~TOGL_GlyphRasterizer();
+
+    // Clears accumulation buffer and sets bitmap size.
+    void Reset(uint16_t width, uint16_t height);
+
+    void AddLine(float x0, float y0, float x1, float y1);
+
+    // Adds quadratic bezier curve. Curve is split into lines.
+    void AddQuad(float x0, float y0, float cx, float cy, float x1, float y1);
+
+    // Adds closed contours. Each point p is transformed to (p.x * scale + offset_x, p.y * scale + offset_y).
+    void AddContours(const std::vector<TOGL_TrueTypeContour>& contours, float scale, float offset_x, float offset_y);
+
+    // Writes coverage of each pixel (value range: 0 - 255). Rows are in order of y axis.
+    void Accumulate(std::vector<uint8_t>& alphas) const;
+
+    uint16_t GetWidth() const;
+    uint16_t GetHeight() const;
+
+private:
+    uint16_t            m_width;
+    uint16_t            m_height;
+    size_t              m_stride;           // row length of accumulation buffer (two additional cells for area which spills over right edge)
+
+    std::vector<float>  m_accumulation;
+};
+
+//------------------------------------------------------------------------------
+// TOGL_GlyphBitmap
+//------------------------------------------------------------------------------
+
+// Rasterized glyph ink box.
+struct TOGL_GlyphBitmap {
+    // Position of left-bottom corner of bitmap relative to left-bottom corner of glyph cell, in pixels.
+    int16_t                 x;
+    int16_t                 y;
+
+    uint16_t                width;      // in pixels
+    uint16_t                height;     // in pixels
+
+    // Glyph coverage, one byte per pixel (value range: 0 - 255).
+    // Orientation: First pixel refers to left-bottom corner of bitmap.
+    std::vector<uint8_t>    alphas;
+
+    TOGL_GlyphBitmap();
+};
+
+// Returns signed distance field of glyph bitmap. Pixel is inside of glyph if its coverage is at least 128.
+// Returned bitmap has margin with width of spread pixels on each side. 
+// Value 128 is at glyph edge. Values above are inside of glyph. Distance of spread pixels or more maps to 0 (outside) or 255 (inside).
+TOGL_GlyphBitmap TOGL_MakeDistanceField(const TOGL_GlyphBitmap& bitmap, uint16_t spread);
+
+// Returns hash of bitmap size and coverage. Position of bitmap isn't hashed.
+uint64_t TOGL_HashGlyphBitmap(const TOGL_GlyphBitmap& bitmap);
+
+//------------------------------------------------------------------------------
+// TOGL_GlyphSource
+//------------------------------------------------------------------------------
+
+// Rasterizes glyphs on demand.
+class TOGL_GlyphSource {
+public:
+    virtual ~TOGL_GlyphSource() {}
+
+    // Returns false if glyph can not be rasterized.
+    virtual bool GetGlyphBitmap(uint32_t code, TOGL_GlyphBitmap& bitmap) = 0;
+
+    // Returns width of glyph cell (advance) in pixels.
+    virtual uint16_t GetGlyphWidth(uint32_t code) = 0;
+
+    // Returns independent glyph source, which produces the same glyphs and can be used by other thread at the same time as this one.
+    // Returns null if glyph source can't be copied.
+    virtual std::shared_ptr<TOGL_GlyphSource> Clone() const { return nullptr; }
+};
+
+//------------------------------------------------------------------------------
+// TOGL_TrueTypeGlyphSource
+//------------------------------------------------------------------------------
+
+// Rasterizes glyphs from TrueType outlines by TOGL_GlyphRasterizer (anti-aliased). Doesn't use Windows nor OpenGL.
+class TOGL_TrueTypeGlyphSource : public TOGL_GlyphSource {
+public:
+    // font             - Loaded font.
+    // font_height      - Height of glyph cell in pixels (ascent + descent).
+    TOGL_TrueTypeGlyphSource(std::shared_ptr<const TOGL_TrueTypeFont> font, uint32_t font_height);
+    virtual ~TOGL_TrueTypeGlyphSource();
+
+    bool GetGlyphBitmap(uint32_t code, TOGL_GlyphBitmap& bitmap) override;
+    uint16_t GetGlyphWidth(uint32_t code) override;
+
+    // Copy shares font, which is only read.
+    std::shared_ptr<TOGL_GlyphSource> Clone() const override;
+
+    // Font metrics in pixels.
+    uint32_t GetFontHeight() const;
+    uint32_t GetFontAscent() const;
+    uint32_t GetFontDescent() const;
+    uint32_t GetFontInternalLeading() const;
+
+private:
+    std::shared_ptr<const TOGL_TrueTypeFont>    m_font;
+    float                                       m_scale;    // from font units to pixels
+
+    uint32_t                                    m_font_height;
+    uint32_t                                    m_font_ascent;
+    uint32_t                                    m_font_descent;
+    uint32_t                                    m_font_internal_leading;
+
+    TOGL_GlyphRasterizer                        m_rasterizer;
+    std::vector<TOGL_TrueTypeContour>           m_contours;
+};
+
+//==============================================================================
+// Definitions
+//==============================================================================
+
+inline uint32_t TOGL_ComputeTrueTypeTableChecksum(const uint8_t* data, size_t size) {
+    uint32_t checksum = 0;
+
+    for (size_t pos = 0; pos < size; pos += 4) {
+        uint32_t word = 0;
+        for (size_t ix = 0; ix < 4; ++ix) {
+            word = (word << 8) | ((pos + ix < size) ? data[pos + ix] : 0);
+        }
+        checksum += word;
+    }
+
+    return checksum;
+}
+
+//------------------------------------------------------------------------------
+// TOGL_TrueTypeFont
+//------------------------------------------------------------------------------
+
+inline TOGL_TrueTypeFont::TOGL_TrueTypeFont() {
+    Unload();
+}
+
+inline TOGL_TrueTypeFont::~TOGL_TrueTypeFont() {
+
+}
+
+inline bool TOGL_TrueTypeFont::Load(const uint8_t* data, size_t size, bool is_metrics_only) {
+    // Content is read in place (it might be mapped file), only requested tables are copied.
+    auto ReadU16At = [data, size](size_t pos) -> uint32_t {
+        return (pos + 2 <= size) ? ((uint32_t(data[pos]) << 8) | uint32_t(data[pos + 1])) : 0;
+    };
+    auto ReadU32At = [data, size](size_t pos) -> uint32_t {
+        return (pos + 4 <= size) ? ((uint32_t(data[pos]) << 24) | (uint32_t(data[pos + 1]) << 16) | (uint32_t(data[pos + 2]) << 8) | uint32_t(data[pos + 3])) : 0;
+    };
+
+    const uint32_t TAG_TTCF = TOGL_MakeTrueTypeTag('t', 't', 'c', 'f');
+
+    // Font collection. Only first font is loaded.
+    size_t font_pos = 0;
+    if (ReadU32At(0) == TAG_TTCF) {
+        font_pos = ReadU32At(12);
+    }
+
+    const uint32_t table_count = ReadU16At(font_pos + 4);
+
+    return Load([&](uint32_t tag) -> std::vector<uint8_t> {
+        for (uint32_t ix = 0; ix < table_count; ++ix) {
+            const size_t record_pos = font_pos + 12 + ix * 16;
+
+            if (ReadU32At(record_pos) == tag) {
+                const size_t offset = ReadU32At(record_pos + 8);
+                const size_t length = ReadU32At(record_pos + 12);
+
+                if (offset <= size && length <= size - offset) {
+                    return std::vector<uint8_t>(data + offset, data + offset + length);
+                }
+                break;
+            }
+        }
+        return {};
+    }, is_metrics_only);
+}
+
+inline bool TOGL_TrueTypeFont::Load(const GetTableFnT& get_table, bool is_metrics_only) {
+    Unload();
+
+    m_head = get_table(TOGL_MakeTrueTypeTag('h', 'e', 'a', 'd'));
+    m_maxp = get_table(TOGL_MakeTrueTypeTag('m', 'a', 'x', 'p'));
+    m_hhea = get_table(TOGL_MakeTrueTypeTag('h', 'h', 'e', 'a'));
+    m_hmtx = get_table(TOGL_MakeTrueTypeTag('h', 'm', 't', 'x'));
+    m_cmap = get_table(TOGL_MakeTrueTypeTag('c', 'm', 'a', 'p'));
+    if (!is_metrics_only) {
+        m_loca = get_table(TOGL_MakeTrueTypeTag('l', 'o', 'c', 'a'));
+        m_glyf = get_table(TOGL_MakeTrueTypeTag('g', 'l', 'y', 'f'));
+    }
+
+    const std::vector<uint8_t> os2 = get_table(TOGL_MakeTrueTypeTag('O', 'S', '/', '2'));
+
+    if (m_head.size() < 54 || ReadU32(m_head, 12) != 0x5F0F3CF5) {
+        SetErrMsg("Missing or corrupted 'head' table.");
+    } else if (m_maxp.size() < 6 || m_hhea.size() < 36 || m_hmtx.empty() || m_cmap.size() < 4) {
+        SetErrMsg("Missing or corrupted one of tables: 'maxp', 'hhea', 'hmtx', 'cmap'.");
+    } else if (!is_metrics_only && (m_loca.empty() || m_glyf.empty())) {
+        SetErrMsg("Font doesn't have TrueType outlines ('loca' and 'glyf' tables).");
+    }
+
+    if (IsOk()) {
+        m_units_per_em      = ReadU16(m_head, 18);
+        m_is_long_loca      = ReadI16(m_head, 50) != 0;
+        m_glyph_count       = ReadU16(m_maxp, 4);
+        m_h_metric_count    = ReadU16(m_hhea, 34);
+
+        m_ascent            = ReadI16(m_hhea, 4);
+        m_descent           = -ReadI16(m_hhea, 6);
+        m_line_gap          = ReadI16(m_hhea, 8);
+
+        // The same metrics as used by GDI.
+        if (os2.size() >= 78) {
+            m_ascent        = ReadU16(os2, 74);
+            m_descent       = ReadU16(os2, 76);
+        }
+
+        if (m_units_per_em == 0 || m_h_metric_count == 0 || m_hmtx.size() < m_h_metric_count * 4) {
+            SetErrMsg("Corrupted font metrics.");
+        }
+    }
+
+    if (IsOk()) {
+        // Chooses unicode subtable. Full unicode (format 12) is preferred over basic multilingual plane (format 4).
+        int best_score = 0;
+
+        const uint32_t subtable_count = ReadU16(m_cmap, 2);
+        for (uint32_t ix = 0; ix < subtable_count; ++ix) {
+            const size_t    record_pos      = 4 + ix * 8;
+            const uint16_t  platform_id     = ReadU16(m_cmap, record_pos);
+            const uint16_t  encoding_id     = ReadU16(m_cmap, record_pos + 2);
+            const size_t    subtable_pos    = ReadU32(m_cmap, record_pos + 4);
+            const uint16_t  format          = ReadU16(m_cmap, subtable_pos);
+
+            const bool is_unicode = (platform_id == 0) || (platform_id == 3 && (encoding_id == 1 || encoding_id == 10));
+
+            int score = 0;
+            if (is_unicode && format == 12) score = 2;
+            if (is_unicode && format == 4)  score = 1;
+
+            if (score > best_score) {
+                best_score          = score;
+                m_cmap_subtable_pos = subtable_pos;
+                m_cmap_format       = format;
+            }
+        }
+
+        if (best_score == 0) {
+            SetErrMsg("Font doesn't have unicode character map.");
+        }
+    }
+
+    m_is_loaded = IsOk();
+    return m_is_loaded;
+}
+
+inline void TOGL_TrueTypeFont::Unload() {
+    m_head.clear();
+    m_maxp.clear();
+    m_hhea.clear();
+    m_hmtx.clear();
+    m_cmap.clear();
+    m_loca.clear();
+    m_glyf.clear();
+
+    m_units_per_em      = 0;
+    m_is_long_loca      = false;
+    m_glyph_count       = 0;
+    m_h_metric_count    = 0;
+    m_ascent            = 0;
+    m_descent           = 0;
+    m_line_gap          = 0;
+
+    m_cmap_subtable_pos = 0;
+    m_cmap_format       = 0;
+
+    m_is_loaded         = false;
+    m_err_msg           = "";
+}
+
+inline bool TOGL_TrueTypeFont::IsLoaded() const {
+    return m_is_loaded;
+}
+
+inline uint16_t TOGL_TrueTypeFont::GetUnitsPerEm() const {
+    return m_units_per_em;
+}
+
+inline int32_t TOGL_TrueTypeFont::GetAscent() const {
+    return m_ascent;
+}
+
+inline int32_t TOGL_TrueTypeFont::GetDescent() const {
+    return m_descent;
+}
+
+inline int32_t TOGL_TrueTypeFont::GetLineGap() const {
+    return m_line_gap;
+}
+
+inline uint32_t TOGL_TrueTypeFont::GetGlyphCount() const {
+    return m_glyph_count;
+}
+
+inline uint32_t TOGL_TrueTypeFont::GetGlyphIndex(uint32_t code) const {
+    if (m_is_loaded) {
+        const uint32_t glyph_index = (m_cmap_format == 12) ? GetGlyphIndexFormat12(code) : GetGlyphIndexFormat4(code);
+        return (glyph_index < m_glyph_count) ? glyph_index : 0;
+    }
+    return 0;
+}
+
+inline bool TOGL_TrueTypeFont::HasGlyph(uint32_t code) const {
+    return GetGlyphIndex(code) != 0;
+}
+
+inline uint16_t TOGL_TrueTypeFont::GetAdvanceWidth(uint32_t glyph_index) const {
+    // Glyphs after last metric have the same advance width as last one.
+    const uint32_t ix = (glyph_index < m_h_metric_count) ? glyph_index : (m_h_metric_count - 1);
+    return m_is_loaded ? ReadU16(m_hmtx, ix * 4) : 0;
+}
+
+inline int16_t TOGL_TrueTypeFont::GetLeftSideBearing(uint32_t glyph_index) const {
+    if (!m_is_loaded) return 0;
+
+    if (glyph_index < m_h_metric_count) {
+        return ReadI16(m_hmtx, glyph_index * 4 + 2);
+    }
+    return ReadI16(m_hmtx, m_h_metric_count * 4 + (glyph_index - m_h_metric_count) * 2);
+}
+
+inline bool TOGL_TrueTypeFont::GetGlyphContours(uint32_t glyph_index, std::vector<TOGL_TrueTypeContour>& contours) const {
+    contours.clear();
+    return m_is_loaded && GetGlyphContours(glyph_index, contours, 0);
+}
+
+inline bool TOGL_TrueTypeFont::IsOk() const {
+    return m_err_msg.empty();
+}
+
+inline std::string TOGL_TrueTypeFont::GetErrMsg() const {
+    return m_err_msg;
+}
+
+inline bool TOGL_TrueTypeFont::GetGlyphContours(uint32_t glyph_index, std::vector<TOGL_TrueTypeContour>& contours, uint32_t depth) const {
+    enum { MAX_COMPOSITE_DEPTH = 8 };
+
+    size_t offset   = 0;
+    size_t size     = 0;
+
+    if (depth > MAX_COMPOSITE_DEPTH || !GetGlyphLocation(glyph_index, offset, size)) return false;
+    if (size == 0) return true; // glyph without outline
+
+    const int16_t contour_count = ReadI16(m_glyf, offset);
+
+    if (contour_count >= 0) {
+        // --- Simple Glyph --- //
+
+        size_t pos = offset + 10;
+
+        std::vector<uint16_t> end_point_ixs(contour_count);
+        for (auto& end_point_ix : end_point_ixs) {
+            end_point_ix = ReadU16(m_glyf, pos);
+            pos += 2;
+        }
+        const uint32_t point_count = contour_count ? (uint32_t(end_point_ixs.back()) + 1) : 0;
+
+        const uint16_t instruction_length = ReadU16(m_glyf, pos);
+        pos += 2 + instruction_length;
+
+        if (pos > offset + size) return false;
+
+        enum {
+            ON_CURVE_POINT                          = 0x01,
+            X_SHORT_VECTOR                          = 0x02,
+            Y_SHORT_VECTOR                          = 0x04,
+            REPEAT_FLAG                             = 0x08,
+            X_IS_SAME_OR_POSITIVE_X_SHORT_VECTOR    = 0x10,
+            Y_IS_SAME_OR_POSITIVE_Y_SHORT_VECTOR    = 0x20,
+        };
+
+        std::vector<uint8_t> flags;
+        flags.reserve(point_count);
+
+        while (flags.size() < point_count) {
+            if (pos >= offset + size) return false;
+
+            const uint8_t flag = ReadU8(m_glyf, pos++);
+            flags.push_back(flag);
+
+            if (flag & REPEAT_FLAG) {
+                uint32_t repeat_count = ReadU8(m_glyf, pos++);
+                while (repeat_count-- > 0 && flags.size() < point_count) flags.push_back(flag);
+            }
+        }
+
+        auto ReadCoords = [&](uint8_t short_flag, uint8_t same_or_positive_flag, std::vector<int32_t>& coords) {
+            int32_t value = 0;
+            for (const uint8_t flag : flags) {
+                if (flag & short_flag) {
+                    const int32_t delta = ReadU8(m_glyf, pos++);
+                    value += (flag & same_or_positive_flag) ? delta : -delta;
+                } else if (!(flag & same_or_positive_flag)) {
+                    value += ReadI16(m_glyf, pos);
+                    pos += 2;
+                }
+                coords.push_back(value);
+            }
+        };
+
+        std::vector<int32_t> xs;
+        std::vector<int32_t> ys;
+        xs.reserve(point_count);
+        ys.reserve(point_count);
+
+        ReadCoords(X_SHORT_VECTOR, X_IS_SAME_OR_POSITIVE_X_SHORT_VECTOR, xs);
+        ReadCoords(Y_SHORT_VECTOR, Y_IS_SAME_OR_POSITIVE_Y_SHORT_VECTOR, ys);
+
+        if (pos > offset + size) return false;
+
+        uint32_t first_ix = 0;
+        for (const uint16_t end_point_ix : end_point_ixs) {
+            if (end_point_ix < first_ix || end_point_ix >= point_count) return false;
+
+            TOGL_TrueTypeContour contour;
+            for (uint32_t ix = first_ix; ix <= end_point_ix; ++ix) {
+                contour.push_back({float(xs[ix]), float(ys[ix]), (flags[ix] & ON_CURVE_POINT) != 0});
+            }
+            contours.push_back(contour);
+
+            first_ix = end_point_ix + 1;
+        }
+    } else {
+        // --- Composite Glyph --- //
+
+        enum {
+            ARG_1_AND_2_ARE_WORDS       = 0x0001,
+            ARGS_ARE_XY_VALUES          = 0x0002,
+            WE_HAVE_A_SCALE             = 0x0008,
+            MORE_COMPONENTS             = 0x0020,
+            WE_HAVE_AN_X_AND_Y_SCALE    = 0x0040,
+            WE_HAVE_A_TWO_BY_TWO        = 0x0080,
+        };
+
+        auto ReadF2Dot14 = [this](size_t pos) -> float {
+            return ReadI16(m_glyf, pos) / 16384.0f;
+        };
+
+        size_t pos = offset + 10;
+        uint16_t flags = 0;
+
+        do {
+            if (pos + 4 > offset + size) return false;
+
+            flags = ReadU16(m_glyf, pos);
+            const uint16_t component_glyph_index = ReadU16(m_glyf, pos + 2);
+            pos += 4;
+
+            float dx = 0;
+            float dy = 0;
+
+            if (flags & ARG_1_AND_2_ARE_WORDS) {
+                if (flags & ARGS_ARE_XY_VALUES) {
+                    dx = ReadI16(m_glyf, pos);
+                    dy = ReadI16(m_glyf, pos + 2);
+                }
+                pos += 4;
+            } else {
+                if (flags & ARGS_ARE_XY_VALUES) {
+                    dx = int8_t(ReadU8(m_glyf, pos));
+                    dy = int8_t(ReadU8(m_glyf, pos + 1));
+                }
+                pos += 2;
+            }
+            // Note: Anchor points (ARGS_ARE_XY_VALUES not set) are not supported, component is placed without offset.
+
+            float a = 1, b = 0, c = 0, d = 1;
+
+            if (flags & WE_HAVE_A_SCALE) {
+                a = d = ReadF2Dot14(pos);
+                pos += 2;
+            } else if (flags & WE_HAVE_AN_X_AND_Y_SCALE) {
+                a = ReadF2Dot14(pos);
+                d = ReadF2Dot14(pos + 2);
+                pos += 4;
+            } else if (flags & WE_HAVE_A_TWO_BY_TWO) {
+                a = ReadF2Dot14(pos);
+                b = ReadF2Dot14(pos + 2);
+                c = ReadF2Dot14(pos + 4);
+                d = ReadF2Dot14(pos + 6);
+                pos += 8;
+            }
+
+            std::vector<TOGL_TrueTypeContour> component_contours;
+            if (!GetGlyphContours(component_glyph_index, component_contours, depth + 1)) return false;
+
+            for (auto& contour : component_contours) {
+                for (auto& point : contour) {
+                    const float x = point.x;
+                    const float y = point.y;
+
+                    point.x = a * x + c * y + dx;
+                    point.y = b * x + d * y + dy;
+                }
+                contours.push_back(contour);
+            }
+        } while (flags & MORE_COMPONENTS);
+    }
+
+    return true;
+}
+
+inline bool TOGL_TrueTypeFont::GetGlyphLocation(uint32_t glyph_index, size_t& offset, size_t& size) const {
+    if (glyph_index >= m_glyph_count) return false;
+
+    size_t begin    = 0;
+    size_t end      = 0;
+
+    if (m_is_long_loca) {
+        if ((glyph_index + 2) * 4 > m_loca.size()) return false;
+
+        begin   = ReadU32(m_loca, glyph_index * 4);
+        end     = ReadU32(m_loca, glyph_index * 4 + 4);
+    } else {
+        if ((glyph_index + 2) * 2 > m_loca.size()) return false;
+
+        begin   = size_t(ReadU16(m_loca, glyph_index * 2)) * 2;
+        end     = size_t(ReadU16(m_loca, glyph_index * 2 + 2)) * 2;
+    }
+
+    if (begin > end || end > m_glyf.size()) return false;
+
+    offset  = begin;
+    size    = end - begin;
+    return true;
+}
+
+inline uint32_t TOGL_TrueTypeFont::GetGlyphIndexFormat4(uint32_t code) const {
+    if (code > 0xFFFF) return 0;
+
+    const size_t    pos                     = m_cmap_subtable_pos;
+    const uint32_t  segment_count           = ReadU16(m_cmap, pos + 6) / 2;
+    const size_t    end_codes_pos           = pos + 14;
+    const size_t    start_codes_pos         = end_codes_pos + segment_count * 2 + 2;
+    const size_t    id_deltas_pos           = start_codes_pos + segment_count * 2;
+    const size_t    id_range_offsets_pos    = id_deltas_pos + segment_count * 2;
+
+    // Binary search for first segment with end code not less than code.
+    uint32_t low    = 0;
+    uint32_t high   = segment_count;
+    while (low < high) {
+        const uint32_t middle = (low + high) / 2;
+        if (ReadU16(m_cmap, end_codes_pos + middle * 2) < code) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low >= segment_count) return 0;
+
+    const uint16_t start_code = ReadU16(m_cmap, start_codes_pos + low * 2);
+    if (start_code > code) return 0;
+
+    const uint16_t  id_delta                = ReadU16(m_cmap, id_deltas_pos + low * 2);
+    const size_t    id_range_offset_pos     = id_range_offsets_pos + low * 2;
+    const uint16_t  id_range_offset         = ReadU16(m_cmap, id_range_offset_pos);
+
+    if (id_range_offset == 0) {
+        return (code + id_delta) & 0xFFFF;
+    }
+
+    const uint16_t glyph_index = ReadU16(m_cmap, id_range_offset_pos + id_range_offset + (code - start_code) * 2);
+    return (glyph_index != 0) ? ((glyph_index + id_delta) & 0xFFFF) : 0;
+}
+
+inline uint32_t TOGL_TrueTypeFont::GetGlyphIndexFormat12(uint32_t code) const {
+    const size_t    pos         = m_cmap_subtable_pos;
+    const uint32_t  group_count = ReadU32(m_cmap, pos + 12);
+    const size_t    groups_pos  = pos + 16;
+
+    uint32_t low    = 0;
+    uint32_t high   = group_count;
+    while (low < high) {
+        const uint32_t middle = (low + high) / 2;
+        if (ReadU32(m_cmap, groups_pos + middle * 12 + 4) < code) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low >= group_count) return 0;
+
+    const uint32_t start_code = ReadU32(m_cmap, groups_pos + low * 12);
+    if (start_code > code) return 0;
+
+    return ReadU32(m_cmap, groups_pos + low * 12 + 8) + (code - start_code);
+}
+
+inline uint8_t TOGL_TrueTypeFont::ReadU8(const std::vector<uint8_t>& data, size_t pos) {
+    return (pos < data.size()) ? data[pos] : 0;
+}
+
+inline uint16_t TOGL_TrueTypeFont::ReadU16(const std::vector<uint8_t>& data, size_t pos) {
+    return (pos + 2 <= data.size()) ? uint16_t((data[pos] << 8) | data[pos + 1]) : 0;
+}
+
+inline int16_t TOGL_TrueTypeFont::ReadI16(const std::vector<uint8_t>& data, size_t pos) {
+    return int16_t(ReadU16(data, pos));
+}
+
+inline uint32_t TOGL_TrueTypeFont::ReadU32(const std::vector<uint8_t>& data, size_t pos) {
+    return (pos + 4 <= data.size()) ? ((uint32_t(data[pos]) << 24) | (uint32_t(data[pos + 1]) << 16) | (uint32_t(data[pos + 2]) << 8) | uint32_t(data[pos + 3])) : 0;
+}
+
+inline void TOGL_TrueTypeFont::SetErrMsg(const std::string& err_msg) {
+    m_err_msg = err_msg;
+}
+
+//------------------------------------------------------------------------------
+// TOGL_GlyphRasterizer
+//------------------------------------------------------------------------------
+
+inline TOGL_GlyphRasterizer::TOGL_GlyphRasterizer() {
+    Reset(0, 0);
+}
+
+inline TOGL_GlyphRasterizer::~TOGL_GlyphRasterizer() {
+
+}
+
+inline void TOGL_GlyphRasterizer::Reset(uint16_t width, uint16_t height) {
+    m_width     = width;
+    m_height    = height;
+    m_stride    = size_t(width) + 2;
+
+    m_accumulation.assign(m_stride * height, 0.0f);
+}
+
+inline void TOGL_GlyphRasterizer::AddLine(float x0, float y0, float x1, float y1) {
+    if (y0 == y1) return;
+
+    // Line goes always up, direction is remembered as sign of covered area.
+    float direction = 1.0f;
+    if (y0 > y1) {
+        direction = -1.0f;
+
+        float temp;
+        temp = x0; x0 = x1; x1 = temp;
+        temp = y0; y0 = y1; y1 = temp;
+    }
+
+    auto Clamp = [](float value, float min, float max) {
+        return (value < min) ? min : ((value > max) ? max : value);
+    };
+
+    const float dxdy = (x1 - x0) / (y1 - y0);
+
+    float x = x0;
+    if (y0 < 0.0f) x -= y0 * dxdy;
+
+    const int row_begin = (y0 > 0.0f) ? int(y0) : 0;
+    const int row_end   = (int(ceilf(y1)) < int(m_height)) ? int(ceilf(y1)) : int(m_height);
+
+    for (int row = row_begin; row < row_end; ++row) {
+        float* line = m_accumulation.data() + m_stride * row;
+
+        const float dy      = ((float(row + 1) < y1) ? float(row + 1) : y1) - ((float(row) > y0) ? float(row) : y0);
+        const float x_next  = x + dxdy * dy;
+        const float d       = dy * direction;
+
+        // Pixels covered by line in this row.
+        const float xa      = Clamp((x < x_next) ? x : x_next, 0.0f, float(m_width));
+        const float xb      = Clamp((x < x_next) ? x_next : x, 0.0f, float(m_width));
+
+        const float xa_floor    = floorf(xa);
+        const int   xa_ix       = int(xa_floor);
+        const float xb_ceil     = ceilf(xb);
+        const int   xb_ix       = int(xb_ceil);
+
+        if (xb_ix <= xa_ix + 1) {
+            // Line is within one pixel.
+            const float xm = 0.5f * (xa + xb) - xa_floor;
+
+            line[xa_ix]     += d - d * xm;
+            line[xa_ix + 1] += d * xm;
+        } else {
+            const float s       = 1.0f / (xb - xa);
+            const float xa_f    = xa - xa_floor;
+            const float a0      = 0.5f * s * (1.0f - xa_f) * (1.0f - xa_f);
+            const float xb_f    = xb - xb_ceil + 1.0f;
+            const float am      = 0.5f * s * xb_f * xb_f;
+
+            line[xa_ix] += d * a0;
+
+            if (xb_ix == xa_ix + 2) {
+                line[xa_ix + 1] += d * (1.0f - a0 - am);
+            } else {
+                const float a1 = s * (1.5f - xa_f);
+                line[xa_ix + 1] += d * (a1 - a0);
+
+                for (int ix = xa_ix + 2; ix < xb_ix - 1; ++ix) {
+                    line[ix] += d * s;
+                }
+
+                const float a2 = a1 + (xb_ix - xa_ix - 3) * s;
+                line[xb_ix - 1] += d * (1.0f - a2 - am);
+            }
+
+            line[xb_ix] += d * am;
+        }
+
+        x = x_next;
+    }
+}
+
+inline void TOGL_GlyphRasterizer::AddQuad(float x0, float y0, float cx, float cy, float x1, float y1) {
+    // Number of lines depends on how far control point is from straight line.
+    const float dev_x       = x0 - 2.0f * cx + x1;
+    const float dev_y       = y0 - 2.0f * cy + y1;
+    const float dev_sq      = dev_x * dev_x + dev_y * dev_y;
+
+    if (dev_sq < 0.333f) {
+        AddLine(x0, y0, x1, y1);
+        return;
+    }
+
+    const float tolerance   = 3.0f;
+    const int   count       = 1 + int(floorf(sqrtf(sqrtf(tolerance * dev_sq))));
+
+    float prev_x = x0;
+    float prev_y = y0;
+
+    for (int ix = 1; ix <= count; ++ix) {
+        const float t   = float(ix) / count;
+        const float mt  = 1.0f - t;
+
+        const float x   = mt * mt * x0 + 2.0f * mt * t * cx + t * t * x1;
+        const float y   = mt * mt * y0 + 2.0f * mt * t * cy + t * t * y1;
+
+        AddLine(prev_x, prev_y, x, y);
+
+        prev_x = x;
+        prev_y = y;
+    }
+}
+
+inline void TOGL_GlyphRasterizer::AddContours(const std::vector<TOGL_TrueTypeContour>& contours, float scale, float offset_x, float offset_y) {
+    struct Point {
+        float x;
+        float y;
+    };
+
+    for (const TOGL_TrueTypeContour& contour : contours) {
+        const size_t count = contour.size();
+        if (count == 0) continue;
+
+        auto ToPoint = [&](size_t ix) -> Point {
+            return {contour[ix].x * scale + offset_x, contour[ix].y * scale + offset_y};
+        };
+        auto Middle = [](const Point& a, const Point& b) -> Point {
+            return {(a.x + b.x) * 0.5f, (a.y + b.y) * 0.5f};
+        };
+
+        // Contour starts from on-curve point. If there is none, then starts from implied point between first and last control point.
+        Point   start;
+        size_t  begin_ix    = 0;
+        size_t  end_ix      = count;
+
+        if (contour[0].is_on_curve) {
+            start       = ToPoint(0);
+            begin_ix    = 1;
+        } else if (contour[count - 1].is_on_curve) {
+            start       = ToPoint(count - 1);
+            end_ix      = count - 1;
+        } else {
+            start       = Middle(ToPoint(0), ToPoint(count - 1));
+        }
+
+        Point   current         = start;
+        Point   control         = {};
+        bool    has_control     = false;
+
+        for (size_t ix = begin_ix; ix < end_ix; ++ix) {
+            const Point point = ToPoint(ix);
+
+            if (contour[ix].is_on_curve) {
+                if (has_control) {
+                    AddQuad(current.x, current.y, control.x, control.y, point.x, point.y);
+                    has_control = false;
+                } else {
+                    AddLine(current.x, current.y, point.x, point.y);
+                }
+                current = point;
+            } else {
+                if (has_control) {
+                    // Between two control points there is implied on-curve point.
+                    const Point middle = Middle(control, point);
+                    AddQuad(current.x, current.y, control.x, control.y, middle.x, middle.y);
+                    current = middle;
+                }
+                control     = point;
+                has_control = true;
+            }
+        }
+
+        if (has_control) {
+            AddQuad(current.x, current.y, control.x, control.y, start.x, start.y);
+        } else {
+            AddLine(current.x, current.y, start.x, start.y);
+        }
+    }
+}
+
+inline void TOGL_GlyphRasterizer::Accumulate(std::vector<uint8_t>& alphas) const {
+    alphas.resize(size_t(m_width) * m_height);
+
+    for (uint32_t row = 0; row < m_height; ++row) {
+        const float*    line        = m_accumulation.data() + m_stride * row;
+        uint8_t*        alpha_row   = alphas.data() + size_t(m_width) * row;
+
+        float sum = 0.0f;
+        for (uint32_t ix = 0; ix < m_width; ++ix) {
+            sum += line[ix];
+
+            const float coverage = fabsf(sum);
+            alpha_row[ix] = uint8_t((coverage < 1.0f ? coverage : 1.0f) * 255.0f + 0.5f);
+        }
+    }
+}
+
+inline uint16_t TOGL_GlyphRasterizer::GetWidth() const {
+    return m_width;
+}
+
+inline uint16_t TOGL_GlyphRasterizer::GetHeight() const {
+    return m_height;
+}
+
+//------------------------------------------------------------------------------
+// TOGL_GlyphBitmap
+//------------------------------------------------------------------------------
+
+inline TOGL_GlyphBitmap::TOGL_GlyphBitmap() {
+    x       = 0;
+    y       = 0;
+    width   = 0;
+    height  = 0;
+}
+
+namespace _TOGL_DistanceField {
+    // Squared euclidean distance transform of one row or column (Felzenszwalb and Huttenlocher). 
+    // f        - 0 for feature pixels, INF for others.
+    // d        - Output, squared distance to nearest feature pixel.
+    // v, z     - Buffers with sizes count and count + 1.
+    inline void Transform(const float* f, uint32_t count, float* d, uint32_t* v, float* z) {
+        const float INF = 1e20f;
+
+        uint32_t k = 0;
+        v[0] = 0;
+        z[0] = -INF;
+        z[1] = INF;
+
+        // Intersection of parabolas rooted in q and r.
+        auto Intersect = [f](uint32_t q, uint32_t r) -> float {
+            return ((f[q] + float(q) * q) - (f[r] + float(r) * r)) / (2.0f * q - 2.0f * r);
+        };
+
+        for (uint32_t q = 1; q < count; ++q) {
+            float s = Intersect(q, v[k]);
+            while (s <= z[k]) {
+                k -= 1;
+                s = Intersect(q, v[k]);
+            }
+            k += 1;
+            v[k]        = q;
+            z[k]        = s;
+            z[k + 1]    = INF;
+        }
+
+        k = 0;
+        for (uint32_t q = 0; q < count; ++q) {
+            while (z[k + 1] < q) k += 1;
+
+            const float delta = float(q) - float(v[k]);
+            d[q] = delta * delta + f[v[k]];
+        }
+    }
+
+    // Returns squared distance from each pixel to nearest pixel, which is marked in features.
+    inline std::vector<float> Transform(const std::vector<bool>& features, uint32_t width, uint32_t height) {
+        const float INF = 1e20f;
+        const uint32_t max_size = (width > height) ? width : height;
+
+        std::vector<float>      grid(size_t(width) * height);
+        std::vector<float>      f(max_size);
+        std::vector<float>      d(max_size);
+        std::vector<uint32_t>   v(max_size);
+        std::vector<float>      z(max_size + 1);
+
+        for (size_t ix = 0; ix < grid.size(); ++ix) grid[ix] = features[ix] ? 0.0f : INF;
+
+        for (uint32_t x = 0; x < width; ++x) {
+            for (uint32_t y = 0; y < height; ++y) f[y] = grid[size_t(y) * width + x];
+            Transform(f.data(), height, d.data(), v.data(), z.data());
+            for (uint32_t y = 0; y < height; ++y) grid[size_t(y) * width + x] = d[y];
+        }
+
+        for (uint32_t y = 0; y < height; ++y) {
+            float* row = grid.data() + size_t(y) * width;
+            Transform(row, width, d.data(), v.data(), z.data());
+            std::copy(d.data(), d.data() + width, row);
+        }
+
+        return grid;
+    }
+}
+
+inline TOGL_GlyphBitmap TOGL_MakeDistanceField(const TOGL_GlyphBitmap& bitmap, uint16_t spread) {
+    if (bitmap.width == 0 || bitmap.height == 0) return bitmap;
+
+    TOGL_GlyphBitmap field;
+
+    field.x         = int16_t(bitmap.x - spread);
+    field.y         = int16_t(bitmap.y - spread);
+    field.width     = uint16_t(bitmap.width + spread * 2);
+    field.height    = uint16_t(bitmap.height + spread * 2);
+
+    const size_t count = size_t(field.width) * field.height;
+
+    std::vector<bool> insides(count, false);
+    std::vector<bool> outsides(count, true);
+
+    for (uint32_t row_ix = 0; row_ix < bitmap.height; ++row_ix) {
+        for (uint32_t ix = 0; ix < bitmap.width; ++ix) {
+            const bool is_inside = bitmap.alphas[size_t(row_ix) * bitmap.width + ix] >= 128;
+            const size_t field_ix = size_t(row_ix + spread) * field.width + ix + spread;
+
+            insides[field_ix]   = is_inside;
+            outsides[field_ix]  = !is_inside;
+        }
+    }
+
+    // Distances between pixel centers. Edge is in the middle between inside and outside pixel.
+    const std::vector<float> distances_to_inside    = _TOGL_DistanceField::Transform(insides, field.width, field.height);
+    const std::vector<float> distances_to_outside   = _TOGL_DistanceField::Transform(outsides, field.width, field.height);
+
+    field.alphas.resize(count);
+
+    for (size_t ix = 0; ix < count; ++ix) {
+        // Positive inside of glyph.
+        const float distance = insides[ix] ? (sqrtf(distances_to_outside[ix]) - 0.5f) : (0.5f - sqrtf(distances_to_inside[ix]));
+
+        float value = 0.5f + distance / (2.0f * spread);
+        value = (value < 0.0f) ? 0.0f : ((value > 1.0f) ? 1.0f : value);
+
+        field.alphas[ix] = uint8_t(value * 255.0f + 0.5f);
+    }
+
+    return field;
+}
+
+inline uint64_t TOGL_HashGlyphBitmap(const TOGL_GlyphBitmap& bitmap) {
+    // FNV-1a, but over 8 bytes at once.
+    uint64_t hash = 14695981039346656037ULL;
+
+    auto AddU64 = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+    };
+
+    AddU64((uint64_t(bitmap.width) << 16) | bitmap.height);
+
+    const uint8_t*  data = bitmap.alphas.data();
+    const size_t    size = bitmap.alphas.size();
+    size_t          ix   = 0;
+
+    for (; ix + 8 <= size; ix += 8) {
+        uint64_t value;
+        memcpy(&value, data + ix, 8);
+        AddU64(value);
+    }
+
+    uint64_t tail = 0;
+    for (; ix < size; ++ix) {
+        tail = (tail << 8) | data[ix];
+    }
+    AddU64(tail ^ (uint64_t(size % 8) << 56));
+
+    return hash;
+}
+
+//------------------------------------------------------------------------------
+// TOGL_TrueTypeGlyphSource
+//------------------------------------------------------------------------------
+
+inline TOGL_TrueTypeGlyphSource::TOGL_TrueTypeGlyphSource(std::shared_ptr<const TOGL_TrueTypeFont> font, uint32_t font_height) {
+    m_font                  = font;
+
+    // Glyph cell is scaled the same way as by CreateFontW with positive height.
+    const int32_t cell_height = m_font->GetAscent() + m_font->GetDescent();
+
+    m_scale                 = (cell_height > 0) ? (float(font_height) / cell_height) : 0.0f;
+
+    m_font_height           = font_height;
+    m_font_ascent           = uint32_t(lroundf(m_font->GetAscent() * m_scale));
+    m_font_descent          = (m_font_height > m_font_ascent) ? (m_font_height - m_font_ascent) : 0;
+
+    const uint32_t em_size  = uint32_t(lroundf(m_font->GetUnitsPerEm() * m_scale));
+    m_font_internal_leading = (m_font_height > em_size) ? (m_font_height - em_size) : 0;
+}
+
+inline TOGL_TrueTypeGlyphSource::~TOGL_TrueTypeGlyphSource() {
+
+}
+
+inline bool TOGL_TrueTypeGlyphSource::GetGlyphBitmap(uint32_t code, TOGL_GlyphBitmap& bitmap) {
+    bitmap = {};
+
+    if (!m_font->GetGlyphContours(m_font->GetGlyphIndex(code), m_contours)) return false;
+
+    // Bitmap covers all points of outline (curves don't go outside of their control points).
+    bool    is_first    = true;
+    float   min_x       = 0;
+    float   min_y       = 0;
+    float   max_x       = 0;
+    float   max_y       = 0;
+
+    for (const TOGL_TrueTypeContour& contour : m_contours) {
+        for (const TOGL_TrueTypePoint& point : contour) {
+            if (is_first || point.x < min_x) min_x = point.x;
+            if (is_first || point.y < min_y) min_y = point.y;
+            if (is_first || point.x > max_x) max_x = point.x;
+            if (is_first || point.y > max_y) max_y = point.y;
+            is_first = false;
+        }
+    }
+
+    // Glyph without outline (for example: space).
+    if (is_first) return true;
+
+    const int x1 = int(floorf(min_x * m_scale));
+    const int y1 = int(floorf(min_y * m_scale));
+    const int x2 = int(ceilf(max_x * m_scale));
+    const int y2 = int(ceilf(max_y * m_scale));
+
+    if (x2 <= x1 || y2 <= y1) return true;
+
+    bitmap.x        = int16_t(x1);
+    bitmap.y        = int16_t(y1 + int(m_font_descent));
+    bitmap.width    = uint16_t(x2 - x1);
+    bitmap.height   = uint16_t(y2 - y1);
+
+    m_rasterizer.Reset(bitmap.width, bitmap.height);
+    m_rasterizer.AddContours(m_contours, m_scale, -float(x1), -float(y1));
+    m_rasterizer.Accumulate(bitmap.alphas);
+
+    return true;
+}
+
+inline uint16_t TOGL_TrueTypeGlyphSource::GetGlyphWidth(uint32_t code) {
+    return uint16_t(lroundf(m_font->GetAdvanceWidth(m_font->GetGlyphIndex(code)) * m_scale));
+}
+
+inline std::shared_ptr<TOGL_GlyphSource> TOGL_TrueTypeGlyphSource::Clone() const {
+    return std::make_shared<TOGL_TrueTypeGlyphSource>(m_font, m_font_height);
+}
+
+inline uint32_t TOGL_TrueTypeGlyphSource::GetFontHeight() const {
+    return m_font_height;
+}
+
+inline uint32_t TOGL_TrueTypeGlyphSource::GetFontAscent() const {
+    return m_font_ascent;
+}
+
+inline uint32_t TOGL_TrueTypeGlyphSource::GetFontDescent() const {
+    return m_font_descent;
+}
+
+inline uint32_t TOGL_TrueTypeGlyphSource::GetFontInternalLeading() const {
+    return m_font_internal_leading;
+}
+
+#endif // TRIVIALOPENGL_TRUETYPE_H_
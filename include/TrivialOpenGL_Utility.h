@@ -7,6 +7,7 @@
 #define TRIVIALOPENGL_UTILITY_H_
 
 #include "TrivialOpenGL_Headers.h"
+#include "TrivialOpenGL_Common.h"
 
 //==============================================================================
 // Declarations
@@ -14,13 +15,6 @@
 
 #define togl_print_i32(variable) { printf(#variable"=%d\n", int(variable)); fflush(stdout); } (void)0
 
-// Disables copy ability of class.
-#define TOGL_NO_COPY(Class) \
-    Class(const Class&) = delete; \
-    Class& operator=(const Class&) = delete
-
-#define TOGL_CASE_STR(name) case name: return #name
-
 //------------------------------------------------------------------------------
 // TOGL_GL_Version
 //------------------------------------------------------------------------------
@@ -30,291 +24,10 @@ struct TOGL_GL_Version {
     int minor;
 };
 
-//------------------------------------------------------------------------------
-// TOGL_Point
-//------------------------------------------------------------------------------
-
-template <typename Type>
-struct TOGL_Point {
-    Type x;
-    Type y;
-
-    TOGL_Point() : x(Type()), y(Type()) {}
-
-    template<typename S_Type>
-    explicit TOGL_Point(const S_Type& s) : x(Type(s)), y(Type(s)) {}
-
-    template<typename X_Type, typename Y_Type>
-    TOGL_Point(const X_Type& x, const Y_Type& y) : x(Type(x)), y(Type(y)) {}
-
-    template <typename SizeType>
-    explicit TOGL_Point(const TOGL_Point<SizeType>& p) : x(Type(p.x)), y(Type(p.y)) {}
-
-    virtual ~TOGL_Point() {}
-};
-
-using TOGL_PointI16  = TOGL_Point<int16_t>;
-using TOGL_PointI    = TOGL_Point<int32_t>;
-using TOGL_PointI64  = TOGL_Point<int64_t>;
-
-using TOGL_PointU16  = TOGL_Point<uint16_t>;
-using TOGL_PointU    = TOGL_Point<uint32_t>;
-using TOGL_PointU64  = TOGL_Point<uint64_t>;
-
-using TOGL_PointF    = TOGL_Point<float>;
-using TOGL_PointD    = TOGL_Point<float>;
-
-template <typename Type>
-inline bool operator==(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
-    return l.x == r.x && l.y == r.y;
-}
-
-template <typename Type>
-inline bool operator!=(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
-    return l.x != r.x || l.y != r.y;
-}
-
-template <typename Type>
-inline bool operator>(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
-    return l.x > r.x && l.y > r.y;
-}
-
-template <typename Type>
-inline bool operator<(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
-    return l.x < r.x && l.y < r.y;
-}
-
-template <typename Type>
-inline bool operator>=(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
-    return l.x >= r.x && l.y >= r.y;
-}
-
-template <typename Type>
-inline bool operator<=(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
-    return l.x <= r.x && l.y <= r.y;
-}
-
-
-template <typename Type>
-inline TOGL_Point<Type> operator+(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
-    return {l.x + r.x, l.y + r.y};
-}
-
-template <typename Type>
-inline TOGL_Point<Type> operator-(const TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
-    return {l.x - r.x, l.y - r.y};
-}
-
-template <typename Type>
-inline TOGL_Point<Type> operator*(const TOGL_Point<Type>& l, const Type& r) {
-    return {l.x * r, l.y * r};
-}
-
-template <typename Type>
-inline TOGL_Point<Type> operator/(const TOGL_Point<Type>& l, const Type& r) {
-    return {l.x / r, l.y / r};
-}
-
-
-template <typename Type>
-inline TOGL_Point<Type>& operator+=(TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
-    l = l + r;
-    return l;
-}
-    
-template <typename Type>
-inline TOGL_Point<Type>& operator-=(TOGL_Point<Type>& l, const TOGL_Point<Type>& r) {
-    l = l - r;
-    return l;
-}
-    
-template <typename Type>
-inline TOGL_Point<Type>& operator*=(TOGL_Point<Type>& l, const Type& r) {
-    l = l * r;
-    return l;
-}
-    
-template <typename Type>
-inline TOGL_Point<Type>& operator/=(TOGL_Point<Type>& l, const Type& r) {
-    l = l / r;
-    return l;
-}
-
-//------------------------------------------------------------------------------
-// TOGL_Size
-//------------------------------------------------------------------------------
-
-template <typename Type>
-struct TOGL_Size {
-    Type width;
-    Type height;
-
-    TOGL_Size() : width(Type()), height(Type()) {}
-
-    template <typename S_Type>
-    explicit TOGL_Size(const S_Type& s) : width(Type(s)), height(Type(s)) {}
-
-    template <typename WidthType, typename HeightType>
-    TOGL_Size(const WidthType& width, const HeightType& height) : width(Type(width)), height(Type(height)) {}
-
-    template <typename SizeType>
-    explicit TOGL_Size(const TOGL_Size<SizeType>& s) : width(Type(s.width)), height(Type(s.height)) {}
-
-    virtual ~TOGL_Size() {}
-};
-
-using TOGL_SizeI16  = TOGL_Size<int16_t>;
-using TOGL_SizeI    = TOGL_Size<int32_t>;
-using TOGL_SizeI64  = TOGL_Size<int64_t>;
-
-using TOGL_SizeU16  = TOGL_Size<uint16_t>;
-using TOGL_SizeU    = TOGL_Size<uint32_t>;
-using TOGL_SizeU64  = TOGL_Size<uint64_t>;
-
-using TOGL_SizeF    = TOGL_Size<float>;
-using TOGL_SizeD    = TOGL_Size<float>;
-
-template <typename Type>
-inline bool operator==(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
-    return l.width == r.width && l.height == r.height;
-}
-
-template <typename Type>
-inline bool operator!=(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
-    return l.width != r.width || l.height != r.height;
-}
-
-template <typename Type>
-inline bool operator>(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
-    return l.width > r.width && l.height > r.height;
-}
-
-template <typename Type>
-inline bool operator<(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
-    return l.width < r.width && l.height < r.height;
-}
-
-template <typename Type>
-inline bool operator>=(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
-    return l.width >= r.width && l.height >= r.height;
-}
-
-template <typename Type>
-inline bool operator<=(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
-    return l.width <= r.width && l.height <= r.height;
-}
-
-
-template <typename Type>
-inline TOGL_Size<Type> operator+(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
-    return {l.width + r.width, l.height + r.height};
-}
-
-template <typename Type>
-inline TOGL_Size<Type> operator-(const TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
-    return {l.width - r.width, l.height - r.height};
-}
-
-template <typename Type>
-inline TOGL_Size<Type> operator*(const TOGL_Size<Type>& l, const Type& r) {
-    return {l.width * r, l.height * r};
-}
-
-template <typename Type>
-inline TOGL_Size<Type> operator/(const TOGL_Size<Type>& l, const Type& r) {
-    return {l.width / r, l.height / r};
-}
-
-
-template <typename Type>
-inline TOGL_Size<Type>& operator+=(TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
-    l = l + r;
-    return l;
-}
-
-template <typename Type>
-inline TOGL_Size<Type>& operator-=(TOGL_Size<Type>& l, const TOGL_Size<Type>& r) {
-    l = l - r;
-    return l;
-}
-
-template <typename Type>
-inline TOGL_Size<Type>& operator*=(TOGL_Size<Type>& l, const Type& r) {
-    l = l * r;
-    return l;
-}
-
-template <typename Type>
-inline TOGL_Size<Type>& operator/=(TOGL_Size<Type>& l, const Type& r) {
-    l = l / r;
-    return l;
-}
-
 //------------------------------------------------------------------------------
 // TOGL_Area
 //------------------------------------------------------------------------------
 
-template <typename PointType, typename SizeType = PointType>
-struct TOGL_Area {
-    PointType  x;
-    PointType  y;
-    SizeType   width;
-    SizeType   height;
-
-    TOGL_Area() : x(PointType()), y(PointType()), width(SizeType()), height(SizeType()) {}
-
-    TOGL_Area(const PointType& x, const PointType& y, const SizeType& width, const SizeType& height) : x(x), y(y), width(width), height(height) {}
-
-    template <typename PointType2, typename SizeType2 = PointType2>
-    explicit TOGL_Area(const TOGL_Area<PointType2, SizeType2>& area) : x(PointType(area.x)), y(PointType(area.y)), width(SizeType(area.width)), height(SizeType(area.height)) {}
-
-    TOGL_Area(const TOGL_Point<PointType>& pos, const TOGL_Size<SizeType>& size) : x(pos.x), y(pos.y), width(size.width), height(size.height) {}
-
-    explicit TOGL_Area(const TOGL_Point<PointType>& pos) : x(pos.x), y(pos.y), width(SizeType()), height(SizeType()) {}
-    explicit TOGL_Area(const TOGL_Size<SizeType>& size) : x(PointType()), y(PointType()), width(size.width), height(size.height) {}
-
-    void SetPos(const TOGL_Point<PointType>& pos) {  
-        x = pos.x;
-        y = pos.y;
-    }
-
-    void SetSize(const TOGL_Size<SizeType>& size) {  
-        width   = size.width;
-        height  = size.height;
-    }
-
-    TOGL_Point<PointType> GetPos() const { return TOGL_Point<PointType>(x, y); }
-    TOGL_Size<SizeType> GetSize() const { return TOGL_Size<SizeType>(width, height); }
-
-    bool IsIn(const TOGL_Point<PointType>& pos) const {
-        return TOGL_Point<PointType>(x, y) <= pos && pos < TOGL_Point<PointType>(x + width, y + height);
-    }
-
-    virtual ~TOGL_Area() {}
-};
-
-using TOGL_AreaI    = TOGL_Area<int32_t>;
-using TOGL_AreaI64  = TOGL_Area<int64_t>;
-
-using TOGL_AreaU    = TOGL_Area<uint32_t>;
-using TOGL_AreaU64  = TOGL_Area<uint64_t>;
-
-using TOGL_AreaF    = TOGL_Area<float>;
-using TOGL_AreaD    = TOGL_Area<float>;
-
-using TOGL_AreaIU   = TOGL_Area<int32_t, uint32_t>;
-using TOGL_AreaIU16 = TOGL_Area<int32_t, uint16_t>;
-
-template <typename PointType, typename SizeType = PointType>
-inline bool operator==(const TOGL_Area<PointType, SizeType>& l, const TOGL_Area<PointType, SizeType>& r) {
-    return l.x == r.x && l.y == r.y && l.width == r.width && l.height == r.height;
-}
-
-template <typename PointType, typename SizeType = PointType>
-inline bool operator!=(const TOGL_Area<PointType, SizeType>& l, const TOGL_Area<PointType, SizeType>& r) {
-    return l.x != r.x || l.y != r.y || l.width != r.width || l.height != r.height;
-}
-
 template <typename PointType, typename SizeType = PointType>
 inline RECT MakeRECT(const TOGL_Area<PointType, SizeType>& area) {
     return {LONG(area.x), LONG(area.y), LONG(area.x + area.width), LONG(area.y + area.height)};
@@ -324,56 +37,10 @@ TOGL_AreaI TOGL_MakeArea(const RECT& r);
 TOGL_AreaIU TOGL_MakeAreaIU(const RECT& r);
 TOGL_AreaIU16 TOGL_MakeAreaIU16(const RECT& r);
 
-//------------------------------------------------------------------------------
-// TOGL_Color
-//------------------------------------------------------------------------------
-
-template <typename Type>
-struct TOGL_Color4 {
-    Type r;
-    Type g;
-    Type b;
-    Type a;
-
-    TOGL_Color4() : r(0), g(0), b(0), a(0) {}
-
-    template <typename TypeR, typename TypeG, typename TypeB, typename TypeA>
-    TOGL_Color4(const TypeR& r, const TypeG& g, const TypeB& b, const TypeA& a) : r(Type(r)), g(Type(g)), b(Type(b)), a(Type(a)) {}
-
-    Type* ToData() {
-        return (Type*)this;
-    }
-
-    const Type* ToData() const {
-        return (const Type*)this;
-    }
-};
-
-using TOGL_Color4U8 = TOGL_Color4<uint8_t>;
-
-//------------------------------------------------------------------------------
-// TOGL_Global
-//------------------------------------------------------------------------------
-
-// Makes global object of specified type in header-only library.
-template <typename Type>
-class TOGL_Global {
-public:
-    static Type& ToObject() { return sm_object; }
-private:
-    static Type sm_object;
-};
-
-template <typename Type>
-Type TOGL_Global<Type>::sm_object;
-
 //------------------------------------------------------------------------------
 // Conversion
 //------------------------------------------------------------------------------
 
-// Converts ascii string to utf-16 string.
-std::wstring TOGL_ASCII_ToUTF16(const std::string& text_ascii);
-
 // Converts utf-8 string to utf-16 string.
 std::wstring TOGL_ToUTF16(const std::string& text_utf8);
 
@@ -486,6 +153,7 @@ private:
 bool TOGL_SaveAsBMP(const std::string& file_name, const uint8_t* pixel_data, uint32_t width, uint32_t height, bool is_reverse_rows = true);
 
 // Saves content of OpenGL texture to file as BMP image.
+// Texture with only alpha channel (GL_ALPHA8) is saved as white pixels with alpha.
 // file_name        - Full name with extension of BMP file. Variable encoding format: UTF8.
 // tex_obj          - OpneGL Texture Object (Name).
 // Returns true if image was saved to file.
@@ -501,11 +169,6 @@ TOGL_SizeU16 TOGL_GetDesktopAreaSizeNoTaskBar();
 TOGL_SizeU16 TOGL_GetScreenSize();
 TOGL_PointI TOGL_GetCursorPosInScreen();
 
-//------------------------------------------------------------------------------
-
-std::string TOGL_HexToStr(uint16_t value);
-std::vector<std::string> TOGL_Split(const std::string& text, char c);
-
 //==============================================================================
 // Definitions
 //==============================================================================
@@ -547,12 +210,6 @@ inline TOGL_AreaIU16 TOGL_MakeAreaIU16(const RECT& r) {
 
 enum { _TOGL_CONVERSION_STACK_BUFFER_LENGTH = 4096 };
 
-inline std::wstring TOGL_ASCII_ToUTF16(const std::string& text_ascii) {
-    std::wstring text_utf16;
-    for (size_t index = 0; index < text_ascii.length(); ++index) text_utf16 += wchar_t(text_ascii[index]);
-    return text_utf16;
-}
-
 inline std::wstring TOGL_ToUTF16(const std::string& text_utf8) {
     std::wstring text_utf16;
 
@@ -817,8 +474,27 @@ inline bool TOGL_SaveTextureAsBMP(const std::string& file_name, GLuint tex_obj)
 
         const uint32_t  data_size   = width * height * PIXEL_SIZE;
         uint8_t*        data        = new uint8_t[data_size];
-                   
-        glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+
+        GLint internal_format = 0;
+        glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &internal_format);
+
+        if (internal_format == GL_ALPHA8 || internal_format == GL_ALPHA) {
+            // Single channel texture is saved as white pixels with alpha.
+            glPushClientAttrib(GL_CLIENT_PIXEL_STORE_BIT);
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_ALPHA, GL_UNSIGNED_BYTE, data);
+
+            glPopClientAttrib();
+
+            for (uint32_t ix = width * height; ix > 0; --ix) {
+                uint8_t* pixel = data + (ix - 1) * PIXEL_SIZE;
+                pixel[3] = data[ix - 1];
+                pixel[0] = pixel[1] = pixel[2] = 255;
+            }
+        } else {
+            glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        }
 
         is_success = TOGL_SaveAsBMP(file_name, data, width, height, false);
                     
@@ -860,30 +536,4 @@ inline TOGL_PointI TOGL_GetCursorPosInScreen() {
     return {};
 }
 
-//------------------------------------------------------------------------------
-
-inline std::vector<std::string> TOGL_Split(const std::string& text, char c) {
-    std::string temp = text;
-    std::vector<std::string> list;
-
-    while (true) {
-        size_t pos = temp.find(c, 0);
-
-        if (pos == std::string::npos) {
-            list.push_back(temp);
-            break;
-        } else {
-            list.push_back(temp.substr(0, pos));
-            temp = temp.substr(pos + 1);
-        }
-    }
-    return list;
-}
-
-inline std::string TOGL_HexToStr(uint16_t value) {
-    std::stringstream stream;
-    stream << std::hex << std::setfill('0') << std::setw(4) << std::right << std::uppercase << value;
-    return stream.str();
-};
-
 #endif // TRIVIALOPENGL_UTILITY_H_